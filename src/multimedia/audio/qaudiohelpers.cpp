@@ -4,13 +4,49 @@
 #include "qaudiohelpers_p.h"
 
 #include <QtCore/qdebug.h>
+#include <QtCore/private/qsimd_p.h>
 #include <QtMultimedia/private/qaudio_qspan_support_p.h>
 #include <QtMultimedia/private/qmultimedia_enum_to_string_converter_p.h>
 
+#include <atomic>
 #include <limits>
 
 QT_BEGIN_NAMESPACE
 
+// Vectorized kernels, see qaudiohelpers_sse2.cpp. They convert as many samples as they can and
+// return their number; the remaining samples are converted by the scalar code.
+#define QT_MM_DECLARE_AUDIO_KERNELS(ARCH) \
+    qsizetype QT_FASTCALL qt_convert_float_to_int16_##ARCH(const std::byte *src, std::byte *dst, \
+            qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_convert_int16_to_float_##ARCH(const std::byte *src, std::byte *dst, \
+            qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_convert_float_to_int32_##ARCH(const std::byte *src, std::byte *dst, \
+            qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_convert_int32_to_float_##ARCH(const std::byte *src, std::byte *dst, \
+            qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_convert_float_to_int24_3b_##ARCH(const std::byte *src, \
+            std::byte *dst, qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_convert_int24_3b_to_float_##ARCH(const std::byte *src, \
+            std::byte *dst, qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_multiply_samples_int16_##ARCH(float factor, const std::byte *src, \
+            std::byte *dst, qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_multiply_samples_int32_##ARCH(float factor, const std::byte *src, \
+            std::byte *dst, qsizetype samples) noexcept QT_MM_NONBLOCKING; \
+    qsizetype QT_FASTCALL qt_multiply_samples_float_##ARCH(float factor, const std::byte *src, \
+            std::byte *dst, qsizetype samples) noexcept QT_MM_NONBLOCKING;
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+QT_MM_DECLARE_AUDIO_KERNELS(sse2)
+#endif
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+QT_MM_DECLARE_AUDIO_KERNELS(avx2)
+#endif
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+QT_MM_DECLARE_AUDIO_KERNELS(neon)
+#endif
+
+#undef QT_MM_DECLARE_AUDIO_KERNELS
+
 namespace QAudioHelperInternal
 {
 
@@ -24,6 +60,98 @@ namespace QAudioHelperInternal
 
 namespace {
 
+using ConvertKernel = qsizetype(QT_FASTCALL *)(const std::byte *, std::byte *,
+                                               qsizetype) noexcept QT_MM_NONBLOCKING;
+using MultiplyKernel = qsizetype(QT_FASTCALL *)(float, const std::byte *, std::byte *,
+                                                qsizetype) noexcept QT_MM_NONBLOCKING;
+
+struct SimdKernels
+{
+    ConvertKernel floatToInt16 = nullptr;
+    ConvertKernel int16ToFloat = nullptr;
+    ConvertKernel floatToInt32 = nullptr;
+    ConvertKernel int32ToFloat = nullptr;
+    ConvertKernel floatToInt24_3b = nullptr;
+    ConvertKernel int24_3bToFloat = nullptr;
+    MultiplyKernel multiplyInt16 = nullptr;
+    MultiplyKernel multiplyInt32 = nullptr;
+    MultiplyKernel multiplyFloat = nullptr;
+
+    ConvertKernel converter(NativeSampleFormat from,
+                            NativeSampleFormat to) const noexcept QT_MM_NONBLOCKING
+    {
+        using F = NativeSampleFormat;
+        if (from == F::float32_t && to == F::int16_t)
+            return floatToInt16;
+        if (from == F::int16_t && to == F::float32_t)
+            return int16ToFloat;
+        if (from == F::float32_t && to == F::int32_t)
+            return floatToInt32;
+        if (from == F::int32_t && to == F::float32_t)
+            return int32ToFloat;
+        if (from == F::float32_t && to == F::int24_t_3b)
+            return floatToInt24_3b;
+        if (from == F::int24_t_3b && to == F::float32_t)
+            return int24_3bToFloat;
+        return nullptr;
+    }
+
+    MultiplyKernel multiplier(QAudioFormat::SampleFormat format) const noexcept QT_MM_NONBLOCKING
+    {
+        switch (format) {
+        case QAudioFormat::Int16:
+            return multiplyInt16;
+        case QAudioFormat::Int32:
+            return multiplyInt32;
+        case QAudioFormat::Float:
+            return multiplyFloat;
+        default:
+            return nullptr;
+        }
+    }
+};
+
+#define QT_MM_ASSIGN_AUDIO_KERNELS(KERNELS, ARCH)                 \
+    KERNELS.floatToInt16 = qt_convert_float_to_int16_##ARCH;       \
+    KERNELS.int16ToFloat = qt_convert_int16_to_float_##ARCH;       \
+    KERNELS.floatToInt32 = qt_convert_float_to_int32_##ARCH;       \
+    KERNELS.int32ToFloat = qt_convert_int32_to_float_##ARCH;       \
+    KERNELS.floatToInt24_3b = qt_convert_float_to_int24_3b_##ARCH; \
+    KERNELS.int24_3bToFloat = qt_convert_int24_3b_to_float_##ARCH; \
+    KERNELS.multiplyInt16 = qt_multiply_samples_int16_##ARCH;      \
+    KERNELS.multiplyInt32 = qt_multiply_samples_int32_##ARCH;      \
+    KERNELS.multiplyFloat = qt_multiply_samples_float_##ARCH;
+
+SimdKernels selectSimdKernels() noexcept
+{
+    SimdKernels kernels;
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+    if (qCpuHasFeature(SSE2)) {
+        QT_MM_ASSIGN_AUDIO_KERNELS(kernels, sse2)
+    }
+#endif
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+    if (qCpuHasFeature(AVX2)) {
+        QT_MM_ASSIGN_AUDIO_KERNELS(kernels, avx2)
+    }
+#endif
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    QT_MM_ASSIGN_AUDIO_KERNELS(kernels, neon)
+#endif
+    return kernels;
+}
+
+#undef QT_MM_ASSIGN_AUDIO_KERNELS
+
+std::atomic_bool simdEnabled = true;
+
+// Initialized on first use; bestNativeSampleFormat() takes care of it before streams start
+const SimdKernels *simdKernels() noexcept
+{
+    static const SimdKernels kernels = selectSimdKernels();
+    return simdEnabled.load(std::memory_order_relaxed) ? &kernels : nullptr;
+}
+
 template<class T>
 inline T applyVolumeOnSample(T sample, float factor)
 {
@@ -58,13 +186,25 @@ void qMultiplySamples(float factor,
                       void *dest,
                       int len) noexcept QT_MM_NONBLOCKING
 {
-    const int samplesCount = len / qMax(1, format.bytesPerSample());
+    int samplesCount = len / qMax(1, format.bytesPerSample());
 
     auto clamp = [](float arg) {
         float realVolume = std::clamp<float>(arg, 0.f, 1.f);
         return realVolume;
     };
 
+    const SimdKernels *kernels = simdKernels();
+    if (const MultiplyKernel multiply = kernels ? kernels->multiplier(format.sampleFormat())
+                                                : nullptr) {
+        const float realFactor = format.sampleFormat() == QAudioFormat::Float ? factor
+                                                                              : clamp(factor);
+        const auto done = multiply(realFactor, static_cast<const std::byte *>(src),
+                                   static_cast<std::byte *>(dest), samplesCount);
+        src = static_cast<const std::byte *>(src) + done * format.bytesPerSample();
+        dest = static_cast<std::byte *>(dest) + done * format.bytesPerSample();
+        samplesCount -= int(done);
+    }
+
     switch (format.sampleFormat()) {
     case QAudioFormat::UInt8:
         return QAudioHelperInternal::adjustSamples<quint8>(clamp(factor), src, dest, samplesCount);
@@ -152,7 +292,7 @@ Q_ALWAYS_INLINE constexpr int32_t toInt32(QSpan<const std::byte> source) noexcep
 
         std::copy_n(source.data(), 4, castUnion.b);
         constexpr double range = std::numeric_limits<int32_t>::max();
-        int32_t val = (castUnion.f32 * range);
+        int32_t val = std::clamp(double(castUnion.f32), -1.0, 1.0) * range;
         return val;
     }
     case NativeSampleFormat::int32_t: {
@@ -215,10 +355,57 @@ Q_ALWAYS_INLINE constexpr void storeSampleWithFormat(QSpan<std::byte> destinatio
     }
 }
 
-template <NativeSampleFormat sourceFormat, NativeSampleFormat destinationFormat>
+struct NoDither
+{
+    constexpr int32_t operator()(int32_t value) const noexcept QT_MM_NONBLOCKING { return value; }
+};
+
+// Adds triangular noise of +-1 LSB of the destination format before the samples are
+// truncated. This decorrelates the quantization error from the signal, which is otherwise
+// audible as distortion in quiet passages.
+template <NativeSampleFormat destinationFormat>
+class TriangularDither
+{
+public:
+    explicit TriangularDither(uint32_t seed) noexcept : m_state(seed | 1) { }
+
+    int32_t operator()(int32_t value) noexcept QT_MM_NONBLOCKING
+    {
+        const int64_t noise = int64_t(next() >> (32 - lsbShift))
+                - int64_t(next() >> (32 - lsbShift));
+        return int32_t(std::clamp<int64_t>(int64_t(value) + noise,
+                                           std::numeric_limits<int32_t>::min(),
+                                           std::numeric_limits<int32_t>::max()));
+    }
+
+private:
+    // samples are converted via the int32 range, of which the destination keeps the upper bits
+    static constexpr int lsbShift = 32 - 8 * int(bytesPerSample(destinationFormat));
+
+    uint32_t next() noexcept QT_MM_NONBLOCKING
+    {
+        // xorshift32
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    uint32_t m_state;
+};
+
+uint32_t nextDitherSeed() noexcept QT_MM_NONBLOCKING
+{
+    static std::atomic<uint32_t> seed = 0x9e3779b9;
+    return seed.fetch_add(0x9e3779b9, std::memory_order_relaxed);
+}
+
+template <NativeSampleFormat sourceFormat, NativeSampleFormat destinationFormat,
+          typename Dither = NoDither>
 struct WordConverter
 {
-    void operator()(QSpan<const std::byte> source, QSpan<std::byte> destination)
+    void operator()(QSpan<const std::byte> source, QSpan<std::byte> destination,
+                    Dither dither = {})
     {
         if constexpr (sourceFormat == destinationFormat) {
             std::copy(source.begin(), source.end(), destination.begin());
@@ -255,16 +442,16 @@ struct WordConverter
                     auto destSampleRange4 = take(destination, bytesPerSampleDest);
                     destination = drop(destination, bytesPerSampleDest);
 
-                    storeSampleWithFormat<destinationFormat>(destSampleRange1, value1);
-                    storeSampleWithFormat<destinationFormat>(destSampleRange2, value2);
-                    storeSampleWithFormat<destinationFormat>(destSampleRange3, value3);
-                    storeSampleWithFormat<destinationFormat>(destSampleRange4, value4);
+                    storeSampleWithFormat<destinationFormat>(destSampleRange1, dither(value1));
+                    storeSampleWithFormat<destinationFormat>(destSampleRange2, dither(value2));
+                    storeSampleWithFormat<destinationFormat>(destSampleRange3, dither(value3));
+                    storeSampleWithFormat<destinationFormat>(destSampleRange4, dither(value4));
                 } else {
                     auto sourceSampleRange = take(source, bytesPerSampleSource);
                     int32_t value = toInt32<sourceFormat>(sourceSampleRange);
 
                     auto destSampleRange = take(destination, bytesPerSampleDest);
-                    storeSampleWithFormat<destinationFormat>(destSampleRange, value);
+                    storeSampleWithFormat<destinationFormat>(destSampleRange, dither(value));
 
                     source = drop(source, bytesPerSampleSource);
                     destination = drop(destination, bytesPerSampleDest);
@@ -274,27 +461,31 @@ struct WordConverter
     }
 };
 
-template <NativeSampleFormat destinationFormat>
+template <NativeSampleFormat destinationFormat, typename Dither = NoDither>
 void convertSampleFormatWithDestinationFormat(QSpan<const std::byte> source,
                                               NativeSampleFormat sourceFormat,
-                                              QSpan<std::byte> destination) noexcept QT_MM_NONBLOCKING
+                                              QSpan<std::byte> destination,
+                                              Dither dither = {}) noexcept QT_MM_NONBLOCKING
 {
     switch (sourceFormat) {
     case NativeSampleFormat::uint8_t:
-        return WordConverter<NativeSampleFormat::uint8_t, destinationFormat>()(source, destination);
+        return WordConverter<NativeSampleFormat::uint8_t, destinationFormat, Dither>()(
+                source, destination, dither);
     case NativeSampleFormat::int16_t:
-        return WordConverter<NativeSampleFormat::int16_t, destinationFormat>()(source, destination);
+        return WordConverter<NativeSampleFormat::int16_t, destinationFormat, Dither>()(
+                source, destination, dither);
     case NativeSampleFormat::int32_t:
-        return WordConverter<NativeSampleFormat::int32_t, destinationFormat>()(source, destination);
+        return WordConverter<NativeSampleFormat::int32_t, destinationFormat, Dither>()(
+                source, destination, dither);
     case NativeSampleFormat::int24_t_3b:
-        return WordConverter<NativeSampleFormat::int24_t_3b, destinationFormat>()(source,
-                                                                                  destination);
+        return WordConverter<NativeSampleFormat::int24_t_3b, destinationFormat, Dither>()(
+                source, destination, dither);
     case NativeSampleFormat::int24_t_4b_low:
-        return WordConverter<NativeSampleFormat::int24_t_4b_low, destinationFormat>()(source,
-                                                                                      destination);
+        return WordConverter<NativeSampleFormat::int24_t_4b_low, destinationFormat, Dither>()(
+                source, destination, dither);
     case NativeSampleFormat::float32_t:
-        return WordConverter<NativeSampleFormat::float32_t, destinationFormat>()(source,
-                                                                                 destination);
+        return WordConverter<NativeSampleFormat::float32_t, destinationFormat, Dither>()(
+                source, destination, dither);
     default:
         Q_UNREACHABLE_RETURN();
     }
@@ -303,8 +494,8 @@ void convertSampleFormatWithDestinationFormat(QSpan<const std::byte> source,
 } // namespace
 
 void convertSampleFormat(QSpan<const std::byte> source, NativeSampleFormat sourceFormat,
-                         QSpan<std::byte> destination,
-                         NativeSampleFormat destinationFormat) noexcept QT_MM_NONBLOCKING
+                         QSpan<std::byte> destination, NativeSampleFormat destinationFormat,
+                         Dithering dithering) noexcept QT_MM_NONBLOCKING
 {
     using namespace QtMultimediaPrivate;
 
@@ -313,11 +504,36 @@ void convertSampleFormat(QSpan<const std::byte> source, NativeSampleFormat sourc
 
     Q_ASSERT(source.size() * bytesPerSampleDest == destination.size() * bytesPerSampleSource);
 
+    // dithering only makes sense when precision is lost, i.e. for 16 and 8 bit destinations
+    const bool dither = dithering == Dithering::Triangular && bytesPerSampleDest <= 2
+            && bytesPerSampleSource > bytesPerSampleDest;
+
+    // The vectorized kernels don't dither. They convert the bulk of the samples, and leave
+    // the rest to the scalar code below.
+    if (const SimdKernels *kernels = simdKernels(); kernels && !dither) {
+        if (const ConvertKernel convert = kernels->converter(sourceFormat, destinationFormat)) {
+            const qsizetype converted = convert(source.data(), destination.data(),
+                                                source.size() / qsizetype(bytesPerSampleSource));
+            source = drop(source, converted * qsizetype(bytesPerSampleSource));
+            destination = drop(destination, converted * qsizetype(bytesPerSampleDest));
+        }
+    }
+
     switch (destinationFormat) {
     case NativeSampleFormat::uint8_t:
+        if (dither) {
+            return convertSampleFormatWithDestinationFormat<NativeSampleFormat::uint8_t>(
+                    source, sourceFormat, destination,
+                    TriangularDither<NativeSampleFormat::uint8_t>(nextDitherSeed()));
+        }
         return convertSampleFormatWithDestinationFormat<NativeSampleFormat::uint8_t>(
                 source, sourceFormat, destination);
     case NativeSampleFormat::int16_t:
+        if (dither) {
+            return convertSampleFormatWithDestinationFormat<NativeSampleFormat::int16_t>(
+                    source, sourceFormat, destination,
+                    TriangularDither<NativeSampleFormat::int16_t>(nextDitherSeed()));
+        }
         return convertSampleFormatWithDestinationFormat<NativeSampleFormat::int16_t>(
                 source, sourceFormat, destination);
     case NativeSampleFormat::int32_t:
@@ -342,6 +558,10 @@ NativeSampleFormat bestNativeSampleFormat(const QAudioFormat &fmt,
 {
     Q_ASSERT(!supportedNativeFormats.empty());
 
+    // streams call this before they start, so the realtime thread doesn't need to
+    // select the conversion kernels
+    simdKernels();
+
     auto resolveCandidate = [&](QSpan<const NativeSampleFormat> candidates) {
         auto it = std::find_first_of(candidates.begin(), candidates.end(),
                                      supportedNativeFormats.begin(), supportedNativeFormats.end());
@@ -440,6 +660,11 @@ QAudioFormat::SampleFormat bestSampleFormat(const NativeSampleFormat fmt)
     }
 }
 
+void setSimdEnabled(bool enabled) noexcept
+{
+    simdEnabled.store(enabled, std::memory_order_relaxed);
+}
+
 std::optional<float> sanitizeVolume(float volume, float lastValue)
 {
     constexpr float epsilon = 1.f / (1 << 22); // good enough for 22bit resolution
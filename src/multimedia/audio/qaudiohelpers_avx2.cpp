@@ -0,0 +1,210 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qaudiohelpers_p.h"
+
+#include <private/qsimd_p.h>
+
+#include <cstring>
+#include <limits>
+
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+
+QT_BEGIN_NAMESPACE
+
+// See qaudiohelpers_sse2.cpp
+
+namespace {
+
+Q_ALWAYS_INLINE __m256i floatToInt32(__m256 value)
+{
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(-1.f)), _mm256_set1_ps(1.f));
+
+    const __m256d range = _mm256_set1_pd(std::numeric_limits<int32_t>::max());
+    const __m128i low = _mm256_cvttpd_epi32(
+            _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(value)), range));
+    const __m128i high = _mm256_cvttpd_epi32(
+            _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(value, 1)), range));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+}
+
+Q_ALWAYS_INLINE __m256 int32ToFloat(__m256i value)
+{
+    const __m256d factor = _mm256_set1_pd(1.0 / std::numeric_limits<int32_t>::max());
+    const __m128 low = _mm256_cvtpd_ps(
+            _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(value)), factor));
+    const __m128 high = _mm256_cvtpd_ps(
+            _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(value, 1)), factor));
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+}
+
+// Packs the upper 16 bits of 8 int32 samples
+Q_ALWAYS_INLINE __m128i int32ToInt16(__m256i value)
+{
+    value = _mm256_srai_epi32(value, 16);
+    return _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+}
+
+Q_ALWAYS_INLINE int32_t loadInt32(const std::byte *src)
+{
+    int32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+Q_ALWAYS_INLINE void storeInt32(std::byte *dst, int32_t value)
+{
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+// Loads 8 packed 24 bit samples, shifted to the int32 range. Reads one byte past the last
+// sample, which is dropped by the shift.
+Q_ALWAYS_INLINE __m256i loadInt24_3b(const std::byte *src)
+{
+    const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    const __m256i value =
+            _mm256_i32gather_epi32(reinterpret_cast<const int *>(src), offsets, 1);
+    return _mm256_slli_epi32(value, 8);
+}
+
+// Stores 8 samples of the int32 range as packed 24 bit samples. Writes one byte past the last
+// sample, which is overwritten by the next sample.
+Q_ALWAYS_INLINE void storeInt24_3b(std::byte *dst, __m256i value)
+{
+    alignas(32) int32_t samples[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(samples), _mm256_srai_epi32(value, 8));
+    for (int i = 0; i < 8; ++i)
+        storeInt32(dst + i * 3, samples[i]);
+}
+
+} // namespace
+
+qsizetype QT_FASTCALL qt_convert_float_to_int16_avx2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    __m128i *out = reinterpret_cast<__m128i *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8)
+        _mm_storeu_si128(out++, int32ToInt16(floatToInt32(_mm256_loadu_ps(in + i))));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int16_to_float_avx2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m128i *in = reinterpret_cast<const __m128i *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m256i value = _mm256_slli_epi32(_mm256_cvtepi16_epi32(_mm_loadu_si128(in++)), 16);
+        _mm256_storeu_ps(out + i, int32ToFloat(value));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_float_to_int32_avx2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    __m256i *out = reinterpret_cast<__m256i *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8)
+        _mm256_storeu_si256(out++, floatToInt32(_mm256_loadu_ps(in + i)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int32_to_float_avx2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m256i *in = reinterpret_cast<const __m256i *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8)
+        _mm256_storeu_ps(out + i, int32ToFloat(_mm256_loadu_si256(in++)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_float_to_int24_3b_avx2(const std::byte *src, std::byte *dst,
+                                                         qsizetype samples)
+        noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+
+    // the last sample is left to the caller, as the stores write past it
+    qsizetype i = 0;
+    for (; i + 8 < samples; i += 8)
+        storeInt24_3b(dst + i * 3, floatToInt32(_mm256_loadu_ps(in + i)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int24_3b_to_float_avx2(const std::byte *src, std::byte *dst,
+                                                         qsizetype samples)
+        noexcept QT_MM_NONBLOCKING
+{
+    float *out = reinterpret_cast<float *>(dst);
+
+    // the last sample is left to the caller, as the loads read past it
+    qsizetype i = 0;
+    for (; i + 8 < samples; i += 8)
+        _mm256_storeu_ps(out + i, int32ToFloat(loadInt24_3b(src + i * 3)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_int16_avx2(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m128i *in = reinterpret_cast<const __m128i *>(src);
+    __m128i *out = reinterpret_cast<__m128i *>(dst);
+    const __m256 f = _mm256_set1_ps(factor);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m256i value = _mm256_cvtepi16_epi32(_mm_loadu_si128(in++));
+        const __m256i result = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(value), f));
+        _mm_storeu_si128(out++, _mm_packs_epi32(_mm256_castsi256_si128(result),
+                                                _mm256_extracti128_si256(result, 1)));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_int32_avx2(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m256i *in = reinterpret_cast<const __m256i *>(src);
+    __m256i *out = reinterpret_cast<__m256i *>(dst);
+    const __m256 f = _mm256_set1_ps(factor);
+    // the largest float below 2^31, which would not fit into an int32
+    const __m256 maxValue = _mm256_set1_ps(2147483520.f);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m256 value = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(in++)), f);
+        _mm256_storeu_si256(out++, _mm256_cvttps_epi32(_mm256_min_ps(value, maxValue)));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_float_avx2(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+    const __m256 f = _mm256_set1_ps(factor);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), f));
+    return i;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_AVX2
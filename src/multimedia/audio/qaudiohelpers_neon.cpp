@@ -0,0 +1,202 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qaudiohelpers_p.h"
+
+#include <private/qsimd_p.h>
+
+#include <cstring>
+#include <limits>
+
+// The conversions are done in double precision, which requires AArch64
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+
+QT_BEGIN_NAMESPACE
+
+// See qaudiohelpers_sse2.cpp
+
+namespace {
+
+Q_ALWAYS_INLINE int32x4_t floatToInt32(float32x4_t value)
+{
+    value = vminq_f32(vmaxq_f32(value, vdupq_n_f32(-1.f)), vdupq_n_f32(1.f));
+
+    constexpr double range = std::numeric_limits<int32_t>::max();
+    const int64x2_t low = vcvtq_s64_f64(vmulq_n_f64(vcvt_f64_f32(vget_low_f32(value)), range));
+    const int64x2_t high = vcvtq_s64_f64(vmulq_n_f64(vcvt_high_f64_f32(value), range));
+    return vcombine_s32(vmovn_s64(low), vmovn_s64(high));
+}
+
+Q_ALWAYS_INLINE float32x4_t int32ToFloat(int32x4_t value)
+{
+    constexpr double factor = 1.0 / std::numeric_limits<int32_t>::max();
+    const float64x2_t low = vmulq_n_f64(vcvtq_f64_s64(vmovl_s32(vget_low_s32(value))), factor);
+    const float64x2_t high = vmulq_n_f64(vcvtq_f64_s64(vmovl_high_s32(value)), factor);
+    return vcvt_high_f32_f64(vcvt_f32_f64(low), high);
+}
+
+Q_ALWAYS_INLINE int32_t loadInt32(const std::byte *src)
+{
+    int32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+Q_ALWAYS_INLINE void storeInt32(std::byte *dst, int32_t value)
+{
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+// Loads 4 packed 24 bit samples, shifted to the int32 range. Reads one byte past the last
+// sample, which is dropped by the shift.
+Q_ALWAYS_INLINE int32x4_t loadInt24_3b(const std::byte *src)
+{
+    const int32_t samples[4] = { loadInt32(src), loadInt32(src + 3), loadInt32(src + 6),
+                                 loadInt32(src + 9) };
+    return vshlq_n_s32(vld1q_s32(samples), 8);
+}
+
+// Stores 4 samples of the int32 range as packed 24 bit samples. Writes one byte past the last
+// sample, which is overwritten by the next sample.
+Q_ALWAYS_INLINE void storeInt24_3b(std::byte *dst, int32x4_t value)
+{
+    int32_t samples[4];
+    vst1q_s32(samples, vshrq_n_s32(value, 8));
+    storeInt32(dst, samples[0]);
+    storeInt32(dst + 3, samples[1]);
+    storeInt32(dst + 6, samples[2]);
+    storeInt32(dst + 9, samples[3]);
+}
+
+} // namespace
+
+qsizetype QT_FASTCALL qt_convert_float_to_int16_neon(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    int16_t *out = reinterpret_cast<int16_t *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const int16x4_t low = vshrn_n_s32(floatToInt32(vld1q_f32(in + i)), 16);
+        const int16x4_t high = vshrn_n_s32(floatToInt32(vld1q_f32(in + i + 4)), 16);
+        vst1q_s16(out + i, vcombine_s16(low, high));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int16_to_float_neon(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const int16_t *in = reinterpret_cast<const int16_t *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const int16x8_t value = vld1q_s16(in + i);
+        vst1q_f32(out + i, int32ToFloat(vshll_n_s16(vget_low_s16(value), 16)));
+        vst1q_f32(out + i + 4, int32ToFloat(vshll_high_n_s16(value, 16)));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_float_to_int32_neon(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    int32_t *out = reinterpret_cast<int32_t *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4)
+        vst1q_s32(out + i, floatToInt32(vld1q_f32(in + i)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int32_to_float_neon(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const int32_t *in = reinterpret_cast<const int32_t *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4)
+        vst1q_f32(out + i, int32ToFloat(vld1q_s32(in + i)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_float_to_int24_3b_neon(const std::byte *src, std::byte *dst,
+                                                         qsizetype samples)
+        noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+
+    // the last sample is left to the caller, as the stores write past it
+    qsizetype i = 0;
+    for (; i + 4 < samples; i += 4)
+        storeInt24_3b(dst + i * 3, floatToInt32(vld1q_f32(in + i)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int24_3b_to_float_neon(const std::byte *src, std::byte *dst,
+                                                         qsizetype samples)
+        noexcept QT_MM_NONBLOCKING
+{
+    float *out = reinterpret_cast<float *>(dst);
+
+    // the last sample is left to the caller, as the loads read past it
+    qsizetype i = 0;
+    for (; i + 4 < samples; i += 4)
+        vst1q_f32(out + i, int32ToFloat(loadInt24_3b(src + i * 3)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_int16_neon(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const int16_t *in = reinterpret_cast<const int16_t *>(src);
+    int16_t *out = reinterpret_cast<int16_t *>(dst);
+
+    auto multiply = [&](int32x4_t value) {
+        return vmovn_s32(vcvtq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(value), factor)));
+    };
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const int16x8_t value = vld1q_s16(in + i);
+        vst1q_s16(out + i, vcombine_s16(multiply(vmovl_s16(vget_low_s16(value))),
+                                        multiply(vmovl_high_s16(value))));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_int32_neon(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const int32_t *in = reinterpret_cast<const int32_t *>(src);
+    int32_t *out = reinterpret_cast<int32_t *>(dst);
+
+    // vcvtq_s32_f32 saturates, so there is no need to clamp
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4)
+        vst1q_s32(out + i, vcvtq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(in + i)), factor)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_float_neon(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4)
+        vst1q_f32(out + i, vmulq_n_f32(vld1q_f32(in + i), factor));
+    return i;
+}
+
+QT_END_NAMESPACE
+
+#endif // defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
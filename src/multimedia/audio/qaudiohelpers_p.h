@@ -44,10 +44,21 @@ enum class NativeSampleFormat : uint8_t {
     float32_t,
 };
 
+enum class Dithering : uint8_t {
+    None,
+    // triangular noise of +-1 LSB, when converting to int16_t or uint8_t from a format
+    // with more precision
+    Triangular,
+};
+
 Q_MULTIMEDIA_EXPORT
 void convertSampleFormat(QSpan<const std::byte> source, NativeSampleFormat sourceFormat,
-                         QSpan<std::byte> destination,
-                         NativeSampleFormat destinationFormat) noexcept QT_MM_NONBLOCKING;
+                         QSpan<std::byte> destination, NativeSampleFormat destinationFormat,
+                         Dithering dithering = Dithering::None) noexcept QT_MM_NONBLOCKING;
+
+// Vectorized conversions are used if the CPU supports them. They give the same results as
+// the portable code; disabling them is meant for tests and benchmarks.
+Q_MULTIMEDIA_EXPORT void setSimdEnabled(bool enabled) noexcept;
 
 Q_MULTIMEDIA_EXPORT
 NativeSampleFormat bestNativeSampleFormat(const QAudioFormat &fmt,
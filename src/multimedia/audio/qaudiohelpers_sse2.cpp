@@ -0,0 +1,214 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qaudiohelpers_p.h"
+
+#include <private/qsimd_p.h>
+
+#include <cstring>
+#include <limits>
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+
+QT_BEGIN_NAMESPACE
+
+// The kernels produce the same results as the scalar code in qaudiohelpers.cpp: integer
+// samples are scaled to the int32 range, and converted from and to float in double precision.
+// They return the number of samples they have converted; the caller converts the rest.
+
+namespace {
+
+Q_ALWAYS_INLINE __m128i floatToInt32(__m128 value)
+{
+    value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.f)), _mm_set1_ps(1.f));
+
+    const __m128d range = _mm_set1_pd(std::numeric_limits<int32_t>::max());
+    const __m128i low = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(value), range));
+    const __m128i high =
+            _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(value, value)), range));
+    return _mm_unpacklo_epi64(low, high);
+}
+
+Q_ALWAYS_INLINE __m128 int32ToFloat(__m128i value)
+{
+    const __m128d factor = _mm_set1_pd(1.0 / std::numeric_limits<int32_t>::max());
+    const __m128 low = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(value), factor));
+    const __m128 high =
+            _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(value, value)), factor));
+    return _mm_movelh_ps(low, high);
+}
+
+Q_ALWAYS_INLINE int32_t loadInt32(const std::byte *src)
+{
+    int32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+Q_ALWAYS_INLINE void storeInt32(std::byte *dst, int32_t value)
+{
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+// Loads 4 packed 24 bit samples, shifted to the int32 range. Reads one byte past the last
+// sample, which is dropped by the shift.
+Q_ALWAYS_INLINE __m128i loadInt24_3b(const std::byte *src)
+{
+    const __m128i value = _mm_setr_epi32(loadInt32(src), loadInt32(src + 3), loadInt32(src + 6),
+                                         loadInt32(src + 9));
+    return _mm_slli_epi32(value, 8);
+}
+
+// Stores 4 samples of the int32 range as packed 24 bit samples. Writes one byte past the last
+// sample, which is overwritten by the next sample.
+Q_ALWAYS_INLINE void storeInt24_3b(std::byte *dst, __m128i value)
+{
+    alignas(16) int32_t samples[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(samples), _mm_srai_epi32(value, 8));
+    storeInt32(dst, samples[0]);
+    storeInt32(dst + 3, samples[1]);
+    storeInt32(dst + 6, samples[2]);
+    storeInt32(dst + 9, samples[3]);
+}
+
+} // namespace
+
+qsizetype QT_FASTCALL qt_convert_float_to_int16_sse2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    __m128i *out = reinterpret_cast<__m128i *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128i low = _mm_srai_epi32(floatToInt32(_mm_loadu_ps(in + i)), 16);
+        const __m128i high = _mm_srai_epi32(floatToInt32(_mm_loadu_ps(in + i + 4)), 16);
+        _mm_storeu_si128(out++, _mm_packs_epi32(low, high));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int16_to_float_sse2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m128i *in = reinterpret_cast<const __m128i *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+    const __m128i zero = _mm_setzero_si128();
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128i value = _mm_loadu_si128(in++);
+        _mm_storeu_ps(out + i, int32ToFloat(_mm_unpacklo_epi16(zero, value)));
+        _mm_storeu_ps(out + i + 4, int32ToFloat(_mm_unpackhi_epi16(zero, value)));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_float_to_int32_sse2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    __m128i *out = reinterpret_cast<__m128i *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4)
+        _mm_storeu_si128(out++, floatToInt32(_mm_loadu_ps(in + i)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int32_to_float_sse2(const std::byte *src, std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m128i *in = reinterpret_cast<const __m128i *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4)
+        _mm_storeu_ps(out + i, int32ToFloat(_mm_loadu_si128(in++)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_float_to_int24_3b_sse2(const std::byte *src, std::byte *dst,
+                                                         qsizetype samples)
+        noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+
+    // the last sample is left to the caller, as the stores write past it
+    qsizetype i = 0;
+    for (; i + 4 < samples; i += 4)
+        storeInt24_3b(dst + i * 3, floatToInt32(_mm_loadu_ps(in + i)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_convert_int24_3b_to_float_sse2(const std::byte *src, std::byte *dst,
+                                                         qsizetype samples)
+        noexcept QT_MM_NONBLOCKING
+{
+    float *out = reinterpret_cast<float *>(dst);
+
+    // the last sample is left to the caller, as the loads read past it
+    qsizetype i = 0;
+    for (; i + 4 < samples; i += 4)
+        _mm_storeu_ps(out + i, int32ToFloat(loadInt24_3b(src + i * 3)));
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_int16_sse2(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m128i *in = reinterpret_cast<const __m128i *>(src);
+    __m128i *out = reinterpret_cast<__m128i *>(dst);
+    const __m128 f = _mm_set1_ps(factor);
+
+    auto multiply = [&](__m128i value) {
+        return _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(value), f));
+    };
+
+    qsizetype i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128i value = _mm_loadu_si128(in++);
+        // sign extend to int32
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+        _mm_storeu_si128(out++, _mm_packs_epi32(multiply(low), multiply(high)));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_int32_sse2(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const __m128i *in = reinterpret_cast<const __m128i *>(src);
+    __m128i *out = reinterpret_cast<__m128i *>(dst);
+    const __m128 f = _mm_set1_ps(factor);
+    // the largest float below 2^31, which would not fit into an int32
+    const __m128 maxValue = _mm_set1_ps(2147483520.f);
+
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(in++)), f);
+        _mm_storeu_si128(out++, _mm_cvttps_epi32(_mm_min_ps(value, maxValue)));
+    }
+    return i;
+}
+
+qsizetype QT_FASTCALL qt_multiply_samples_float_sse2(float factor, const std::byte *src,
+                                                      std::byte *dst,
+                                                      qsizetype samples) noexcept QT_MM_NONBLOCKING
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    float *out = reinterpret_cast<float *>(dst);
+    const __m128 f = _mm_set1_ps(factor);
+
+    qsizetype i = 0;
+    for (; i + 4 <= samples; i += 4)
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), f));
+    return i;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_SSE2
@@ -231,6 +231,13 @@ public:
     QAudioSink &audioSink() { return m_sink; }
     const auto &voices() const { return m_voices; }
 
+    // runs the audio callback on the calling thread. The audio sink has to be stopped, so that
+    // the callback is not run concurrently
+    void renderForTesting(QSpan<float> outputBuffer) noexcept QT_MM_NONBLOCKING
+    {
+        audioCallback(outputBuffer);
+    }
+
 Q_SIGNALS:
     void voiceFinished(VoiceId);
 
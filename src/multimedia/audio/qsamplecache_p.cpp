@@ -10,6 +10,8 @@
 #include <QtCore/qfile.h>
 #include <QtCore/qfuturewatcher.h>
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qtenvironmentvariables.h>
 
 #if QT_CONFIG(network)
 #  include <QtNetwork/qnetworkaccessmanager.h>
@@ -19,6 +21,7 @@
 
 #include "dr_wav.h"
 
+#include <algorithm>
 #include <utility>
 
 Q_STATIC_LOGGING_CATEGORY(qLcSampleCache, "qt.multimedia.samplecache")
@@ -29,8 +32,8 @@ Q_STATIC_LOGGING_CATEGORY(qLcSampleCache, "qt.multimedia.samplecache")
 
 QT_BEGIN_NAMESPACE
 
-QSampleCache::QSampleCache(QObject *parent)
-    : QObject(parent)
+QSampleCache::QSampleCache(QObject *parent, qsizetype retentionBudget)
+    : QObject(parent), m_retentionBudget(std::max<qsizetype>(retentionBudget, 0))
 {
 #if QT_CONFIG(thread)
     // we limit the number of loader threads to avoid thread explosion
@@ -54,6 +57,10 @@ QSampleCache::~QSampleCache()
     m_threadPool.waitForDone();
 #endif
 
+    const Statistics stats = statistics();
+    qCDebug(qLcSampleCache) << "cache statistics: hits" << stats.hits << "misses" << stats.misses
+                            << "evictions" << stats.evictions;
+
     for (auto &entry : m_loadedSamples) {
         auto samplePtr = entry.second.lock();
         if (samplePtr)
@@ -76,8 +83,9 @@ QSampleCache::SampleLoadResult QSampleCache::loadSample(QByteArray data)
     if (!success)
         return std::nullopt;
 
-    // using float as internal format. one could argue to use int16 and save half the ram at the
-    // cost of potential run-time conversions
+    auto cleanup = qScopeGuard([&] { drwav_uninit(&wavParser); });
+
+    // samples are played as float, see QSample::format()
     QAudioFormat audioFormat;
     audioFormat.setChannelCount(wavParser.channels);
     audioFormat.setSampleFormat(QAudioFormat::Float);
@@ -85,18 +93,44 @@ QSampleCache::SampleLoadResult QSampleCache::loadSample(QByteArray data)
     audioFormat.setChannelConfig(
             QAudioFormat::defaultChannelConfigForChannelCount(wavParser.channels));
 
+    // Integer PCM is stored in its native width (8 bit is widened to 16 bit), which takes
+    // half or three quarters of the memory of float samples. Other encodings are decoded
+    // to float.
+    const bool isPcm = wavParser.translatedFormatTag == DR_WAVE_FORMAT_PCM;
+    const QSample::Encoding encoding = [&] {
+        if (isPcm && wavParser.bitsPerSample <= 16)
+            return QSample::Encoding::Int16;
+        if (isPcm && wavParser.bitsPerSample == 24)
+            return QSample::Encoding::PackedInt24;
+        return QSample::Encoding::Float;
+    }();
+
     QByteArray sampleData;
-    sampleData.resizeForOverwrite(sizeof(float) * wavParser.channels
+    sampleData.resizeForOverwrite(QSample::bytesPerSample(encoding) * wavParser.channels
                                   * wavParser.totalPCMFrameCount);
-    uint64_t framesRead = drwav_read_pcm_frames_f32(&wavParser, wavParser.totalPCMFrameCount,
-                                                    reinterpret_cast<float *>(sampleData.data()));
+
+    const uint64_t framesRead = [&] {
+        switch (encoding) {
+        case QSample::Encoding::Int16:
+            return drwav_read_pcm_frames_s16(&wavParser, wavParser.totalPCMFrameCount,
+                                             reinterpret_cast<drwav_int16 *>(sampleData.data()));
+        case QSample::Encoding::PackedInt24:
+            return drwav_read_pcm_frames_le(&wavParser, wavParser.totalPCMFrameCount,
+                                            sampleData.data());
+        case QSample::Encoding::Float:
+            break;
+        }
+        return drwav_read_pcm_frames_f32(&wavParser, wavParser.totalPCMFrameCount,
+                                         reinterpret_cast<float *>(sampleData.data()));
+    }();
 
     if (framesRead != wavParser.totalPCMFrameCount)
         return std::nullopt;
 
-    return std::pair{
+    return DecodedSample{
         std::move(sampleData),
         audioFormat,
+        encoding,
     };
 }
 
@@ -263,6 +297,7 @@ bool QSampleCache::isCached(const QUrl &url) const
 
 QFuture<SharedSamplePtr> QSampleCache::requestSampleFuture(const QUrl &url)
 {
+    ReleasedSamples released;
     std::lock_guard guard(m_mutex);
 
     auto promise = std::make_shared<QPromise<SharedSamplePtr>>();
@@ -271,22 +306,29 @@ QFuture<SharedSamplePtr> QSampleCache::requestSampleFuture(const QUrl &url)
     // found and ready
     auto found = m_loadedSamples.find(url);
     if (found != m_loadedSamples.end()) {
-        SharedSamplePtr foundSample = found->second.lock();
-        Q_ASSERT(foundSample);
-        Q_ASSERT(foundSample->state() == QSample::Ready);
-        promise->start();
-        promise->addResult(std::move(foundSample));
-        promise->finish();
-        return future;
+        // the sample might be in the process of being destroyed on another thread
+        if (SharedSamplePtr foundSample = found->second.lock()) {
+            Q_ASSERT(foundSample->state() == QSample::Ready);
+            ++m_statistics.hits;
+            retain(foundSample, released);
+            promise->start();
+            promise->addResult(std::move(foundSample));
+            promise->finish();
+            return future;
+        }
+        m_loadedSamples.erase(found);
     }
 
     // already in the process of being loaded
     auto pending = m_pendingSamples.find(url);
     if (pending != m_pendingSamples.end()) {
+        ++m_statistics.hits;
         pending->second.second.append(promise);
         return future;
     }
 
+    ++m_statistics.misses;
+
     // we need to start a new load process
     SharedSamplePtr sample = std::make_shared<QSample>(url, this);
     m_pendingSamples.emplace(url, std::pair{ sample, QList<SharedSamplePromise>{ promise } });
@@ -303,10 +345,11 @@ QFuture<SharedSamplePtr> QSampleCache::requestSampleFuture(const QUrl &url)
     futureResult.then(this,
                       [this, url, sample = std::move(sample)](SampleLoadResult loadResult) mutable {
         if (loadResult)
-            sample->setData(loadResult->first, loadResult->second);
+            sample->setData(loadResult->data, loadResult->format, loadResult->encoding);
         else
             sample->setError();
 
+        ReleasedSamples released;
         std::lock_guard guard(m_mutex);
 
         auto pending = m_pendingSamples.find(url);
@@ -318,8 +361,12 @@ QFuture<SharedSamplePtr> QSampleCache::requestSampleFuture(const QUrl &url)
             }
         }
 
-        if (loadResult)
-            m_loadedSamples.emplace(url, sample);
+        if (loadResult) {
+            m_loadedSamples.insert_or_assign(url, sample);
+            if (m_pinnedUrls.count(url))
+                m_pinnedSamples.insert_or_assign(url, sample);
+            retain(sample, released);
+        }
 
         if (pending != m_pendingSamples.end())
             m_pendingSamples.erase(pending);
@@ -341,7 +388,141 @@ QSample::~QSample()
 void QSampleCache::removeUnreferencedSample(const QUrl &url)
 {
     std::lock_guard guard(m_mutex);
-    m_loadedSamples.erase(url);
+
+    // the url might have been loaded again in the meantime
+    auto found = m_loadedSamples.find(url);
+    if (found != m_loadedSamples.end() && found->second.expired())
+        m_loadedSamples.erase(found);
+}
+
+void QSampleCache::setRetentionBudget(qsizetype bytes)
+{
+    ReleasedSamples released;
+    std::lock_guard guard(m_mutex);
+
+    m_retentionBudget = std::max<qsizetype>(bytes, 0);
+    evictToBudget(released);
+}
+
+qsizetype QSampleCache::retentionBudget() const
+{
+    std::lock_guard guard(m_mutex);
+    return m_retentionBudget;
+}
+
+qsizetype QSampleCache::retainedBytes() const
+{
+    std::lock_guard guard(m_mutex);
+    return m_retainedBytes;
+}
+
+qsizetype QSampleCache::defaultRetentionBudget()
+{
+    constexpr qsizetype defaultBudgetKiB = 8 * 1024;
+
+    bool ok = false;
+    const int budgetKiB = qEnvironmentVariableIntValue("QT_MEDIA_SAMPLE_CACHE_SIZE", &ok);
+    return (ok && budgetKiB >= 0 ? qsizetype(budgetKiB) : defaultBudgetKiB) * 1024;
+}
+
+void QSampleCache::preload(const QUrl &url)
+{
+    // the loaded sample is retained on completion
+    requestSampleFuture(url);
+}
+
+void QSampleCache::pin(const QUrl &url)
+{
+    std::lock_guard guard(m_mutex);
+
+    if (!m_pinnedUrls.insert(url).second)
+        return;
+
+    auto found = m_loadedSamples.find(url);
+    if (found != m_loadedSamples.end()) {
+        if (SharedSamplePtr sample = found->second.lock()) {
+            m_pinnedSamples.insert_or_assign(url, std::move(sample));
+            return;
+        }
+    }
+
+    // the sample is pinned when the load completes
+    requestSampleFuture(url);
+}
+
+void QSampleCache::unpin(const QUrl &url)
+{
+    ReleasedSamples released;
+    std::lock_guard guard(m_mutex);
+
+    m_pinnedUrls.erase(url);
+
+    auto found = m_pinnedSamples.find(url);
+    if (found == m_pinnedSamples.end())
+        return;
+
+    // keep the sample around as a recently used one
+    SharedSamplePtr sample = std::move(found->second);
+    m_pinnedSamples.erase(found);
+    retain(sample, released);
+    released.push_back(std::move(sample));
+}
+
+bool QSampleCache::isPinned(const QUrl &url) const
+{
+    std::lock_guard guard(m_mutex);
+    return m_pinnedUrls.count(url) != 0;
+}
+
+QSampleCache::Statistics QSampleCache::statistics() const
+{
+    std::lock_guard guard(m_mutex);
+    return m_statistics;
+}
+
+void QSampleCache::retain(const SharedSamplePtr &sample, ReleasedSamples &released)
+{
+    const qsizetype size = sample->m_soundData.size();
+
+    auto found = m_retainedSampleLookup.find(sample->m_url);
+    if (found != m_retainedSampleLookup.end()) {
+        if (*found->second == sample) {
+            m_retainedSamples.splice(m_retainedSamples.begin(), m_retainedSamples,
+                                     found->second);
+            return;
+        }
+
+        // an older sample for the same url
+        m_retainedBytes -= (*found->second)->m_soundData.size();
+        released.push_back(std::move(*found->second));
+        m_retainedSamples.erase(found->second);
+        m_retainedSampleLookup.erase(found);
+    }
+
+    if (size > m_retentionBudget)
+        return;
+
+    m_retainedSamples.push_front(sample);
+    m_retainedSampleLookup.emplace(sample->m_url, m_retainedSamples.begin());
+    m_retainedBytes += size;
+
+    evictToBudget(released);
+}
+
+void QSampleCache::evictToBudget(ReleasedSamples &released)
+{
+    while (m_retainedBytes > m_retentionBudget) {
+        Q_ASSERT(!m_retainedSamples.empty());
+
+        SharedSamplePtr &leastRecentlyUsed = m_retainedSamples.back();
+        qCDebug(qLcSampleCache) << "evicting" << leastRecentlyUsed->m_url;
+
+        m_retainedBytes -= leastRecentlyUsed->m_soundData.size();
+        m_retainedSampleLookup.erase(leastRecentlyUsed->m_url);
+        released.push_back(std::move(leastRecentlyUsed));
+        m_retainedSamples.pop_back();
+        ++m_statistics.evictions;
+    }
 }
 
 void QSample::setError()
@@ -349,11 +530,71 @@ void QSample::setError()
     m_state = State::Error;
 }
 
-void QSample::setData(QByteArray data, QAudioFormat format)
+void QSample::setData(QByteArray data, QAudioFormat format, Encoding encoding)
 {
+    Q_ASSERT(format.sampleFormat() == QAudioFormat::Float);
     m_state = State::Ready;
     m_soundData = std::move(data);
     m_audioFormat = format;
+    m_encoding = encoding;
+}
+
+int QSample::bytesPerSample(Encoding encoding)
+{
+    switch (encoding) {
+    case Encoding::Float:
+        return sizeof(float);
+    case Encoding::Int16:
+        return sizeof(qint16);
+    case Encoding::PackedInt24:
+        return 3;
+    }
+    Q_UNREACHABLE_RETURN(sizeof(float));
+}
+
+qsizetype QSample::frameCount() const
+{
+    const int channelCount = format().channelCount();
+    if (channelCount <= 0)
+        return 0;
+    return m_soundData.size() / (bytesPerSample(m_encoding) * channelCount);
+}
+
+std::optional<QAudioFormat> QSample::dataFormat() const
+{
+    switch (encoding()) {
+    case Encoding::Float:
+        return format();
+    case Encoding::Int16: {
+        QAudioFormat int16Format = format();
+        int16Format.setSampleFormat(QAudioFormat::Int16);
+        return int16Format;
+    }
+    case Encoding::PackedInt24:
+        return std::nullopt;
+    }
+    Q_UNREACHABLE_RETURN(std::nullopt);
+}
+
+QByteArray QSample::toFloat() const
+{
+    if (encoding() == Encoding::Float)
+        return data();
+
+    const qsizetype sampleCount = frameCount() * format().channelCount();
+    QByteArray result;
+    result.resizeForOverwrite(sampleCount * sizeof(float));
+    float *out = reinterpret_cast<float *>(result.data());
+
+    const uchar *in = reinterpret_cast<const uchar *>(data().constData());
+    if (encoding() == Encoding::Int16) {
+        for (qsizetype i = 0; i < sampleCount; ++i)
+            out[i] = sampleToFloat<Encoding::Int16>(in + i * sizeof(qint16));
+    } else {
+        for (qsizetype i = 0; i < sampleCount; ++i)
+            out[i] = sampleToFloat<Encoding::PackedInt24>(in + i * 3);
+    }
+    return result;
 }
 
 QSample::State QSample::state() const
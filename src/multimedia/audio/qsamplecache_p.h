@@ -21,13 +21,18 @@
 #include <QtCore/qset.h>
 #include <QtCore/qthread.h>
 #include <QtCore/qfuture.h>
+#include <QtCore/qendian.h>
 #include <QtCore/qurl.h>
 #include <QtCore/private/qglobal_p.h>
 #include <QtCore/private/qexpected_p.h>
 #include <QtMultimedia/qaudioformat.h>
 
+#include <list>
+#include <map>
 #include <memory>
 #include <optional>
+#include <set>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -43,20 +48,53 @@ public:
         Ready,
     };
     using SharedSamplePromise = QSharedPointer<QPromise<q23::expected<QSample *, QSample::State>>>;
+
+    // How the samples are stored in data(). Integer PCM sources are kept in their
+    // native width to save memory, and converted to float while they are mixed.
+    enum class Encoding : uint8_t {
+        Float,
+        Int16,
+        PackedInt24, // 3 bytes per sample, little endian
+    };
+
     ~QSample();
 
     State state() const;
     const QByteArray& data() const { Q_ASSERT(state() == Ready); return m_soundData; }
+    Encoding encoding() const { Q_ASSERT(state() == Ready); return m_encoding; }
+
+    // The format in which the sample is played: float samples with the channel count and
+    // sample rate of the source, independently of the encoding of data().
     const QAudioFormat& format() const { Q_ASSERT(state() == Ready); return m_audioFormat; }
 
+    qsizetype frameCount() const;
+    static int bytesPerSample(Encoding);
+
+    // The format of data(), if it can be described by QAudioFormat
+    std::optional<QAudioFormat> dataFormat() const;
+
+    // data() as float samples in format()
+    QByteArray toFloat() const;
+
+    // Reads one sample stored with the given encoding
+    template <Encoding>
+    static float sampleToFloat(const uchar *) noexcept;
+
     void setError();
-    void setData(QByteArray, QAudioFormat);
+    void setData(QByteArray, QAudioFormat, Encoding = Encoding::Float);
 
     QSample(QUrl url, QSampleCache *parent);
 
     // For testing only
-    QSample(QByteArray data, QAudioFormat format)
-        : m_parent(nullptr), m_soundData(std::move(data)), m_audioFormat(format), m_url(), m_state(Ready) {}
+    QSample(QByteArray data, QAudioFormat format, Encoding encoding = Encoding::Float)
+        : m_parent(nullptr),
+          m_soundData(std::move(data)),
+          m_audioFormat(format),
+          m_url(),
+          m_state(Ready),
+          m_encoding(encoding)
+    {
+    }
 
 private:
     QSample();
@@ -67,12 +105,34 @@ private:
     QAudioFormat m_audioFormat;
     const QUrl   m_url;
     State        m_state = State::Creating;
+    Encoding     m_encoding = Encoding::Float;
     // clang-format on
 
     friend class QSampleCache;
     void clearParent();
 };
 
+template <>
+inline float QSample::sampleToFloat<QSample::Encoding::Float>(const uchar *data) noexcept
+{
+    return qFromUnaligned<float>(data);
+}
+
+template <>
+inline float QSample::sampleToFloat<QSample::Encoding::Int16>(const uchar *data) noexcept
+{
+    return float(qFromUnaligned<qint16>(data)) * (1.f / 32768.f);
+}
+
+template <>
+inline float QSample::sampleToFloat<QSample::Encoding::PackedInt24>(const uchar *data) noexcept
+{
+    // shift into the upper bytes of an int32 for sign extension
+    const qint32 value = qint32(quint32(data[0]) << 8 | quint32(data[1]) << 16
+                                | quint32(data[2]) << 24);
+    return float(value) * (1.f / 2147483648.f);
+}
+
 using SharedSamplePtr = std::shared_ptr<QSample>;
 using WeakSamplePtr = std::weak_ptr<QSample>;
 
@@ -87,13 +147,39 @@ public:
         NetworkManager,
     };
 
-    explicit QSampleCache(QObject *parent = nullptr);
+    explicit QSampleCache(QObject *parent = nullptr, qsizetype retentionBudget = 0);
     ~QSampleCache() override;
 
     QFuture<SharedSamplePtr> requestSampleFuture(const QUrl &);
 
     bool isCached(const QUrl& url) const;
 
+    // Samples that are not referenced anymore, e.g. after the last QSoundEffect using them
+    // has been destroyed, are retained in least-recently-used order up to a byte budget.
+    void setRetentionBudget(qsizetype bytes);
+    qsizetype retentionBudget() const;
+    qsizetype retainedBytes() const;
+
+    // QT_MEDIA_SAMPLE_CACHE_SIZE in KiB, or 8 MiB by default
+    static qsizetype defaultRetentionBudget();
+
+    // Loads the sample in the background; it's kept according to the retention budget
+    void preload(const QUrl &url);
+
+    // Keeps the sample loaded until it's unpinned, independently of the retention budget
+    void pin(const QUrl &url);
+    void unpin(const QUrl &url);
+    bool isPinned(const QUrl &url) const;
+
+    struct Statistics
+    {
+        quint64 hits = 0; // requests served by a loaded or loading sample
+        quint64 misses = 0; // requests that had to load the sample
+        quint64 evictions = 0; // samples dropped from the retention tier to fit the budget
+    };
+
+    Statistics statistics() const;
+
     // For tests only
     void setSampleSourceType(SampleSourceType sampleSourceType)
     {
@@ -111,9 +197,33 @@ private:
     std::map<QUrl, WeakSamplePtr> m_loadedSamples;
     std::map<QUrl, std::pair<SharedSamplePtr, QList<SharedSamplePromise>>> m_pendingSamples;
 
+    // Samples that are released by the retention tier are destroyed by the callers after
+    // unlocking the mutex, since the destructor of QSample calls back into the cache.
+    using ReleasedSamples = std::vector<SharedSamplePtr>;
+
+    void retain(const SharedSamplePtr &sample, ReleasedSamples &released);
+    void evictToBudget(ReleasedSamples &released);
+
+    // Most recently used first
+    std::list<SharedSamplePtr> m_retainedSamples;
+    std::map<QUrl, std::list<SharedSamplePtr>::iterator> m_retainedSampleLookup;
+    qsizetype m_retainedBytes = 0;
+    qsizetype m_retentionBudget = 0;
+
+    std::set<QUrl> m_pinnedUrls;
+    std::map<QUrl, SharedSamplePtr> m_pinnedSamples;
+
+    Statistics m_statistics;
+
     void removeUnreferencedSample(const QUrl &url);
 
-    using SampleLoadResult = std::optional<std::pair<QByteArray, QAudioFormat>>;
+    struct DecodedSample
+    {
+        QByteArray data;
+        QAudioFormat format;
+        QSample::Encoding encoding;
+    };
+    using SampleLoadResult = std::optional<DecodedSample>;
 
     static SampleLoadResult loadSample(QByteArray);
 
@@ -18,7 +18,7 @@
 
 QT_BEGIN_NAMESPACE
 
-Q_APPLICATION_STATIC(QSampleCache, sampleCache)
+Q_APPLICATION_STATIC(QSampleCache, sampleCache, nullptr, QSampleCache::defaultRetentionBudget())
 Q_LOGGING_CATEGORY(qLcSoundEffect, "qt.multimedia.soundeffect")
 
 namespace {
@@ -66,6 +66,13 @@ QSoundEffectPrivate *makeSoundEffectPrivate(QSoundEffect *fx, const QAudioDevice
 
     \snippet multimedia-snippets/qsound.cpp 3
 
+    Decoded sounds are shared between sound effects with the same source. After the
+    last sound effect using a sound has been destroyed, recently used sounds are kept
+    in memory, so that sound effects that are created again for the same source don't
+    need to load it anew. The memory used for this is limited to 8 MiB by default; set
+    the environment variable \c QT_MEDIA_SAMPLE_CACHE_SIZE to a size in KiB to change
+    it, or to 0 to disable it.
+
     Since QSoundEffect requires slightly more resources to achieve lower
     latency playback, the platform may limit the number of simultaneously playing
     sound effects.
@@ -98,6 +105,10 @@ QSoundEffectPrivate *makeSoundEffectPrivate(QSoundEffect *fx, const QAudioDevice
 
     \snippet multimedia-snippets/soundeffect.qml complete snippet
 
+    Sounds that were used recently stay in memory after the last SoundEffect using them
+    has been destroyed, for example in delegates of a scrolling list, so they don't need
+    to be loaded anew. See QSoundEffect for how to limit the memory used for this.
+
     Since SoundEffect requires slightly more resources to achieve lower
     latency playback, the platform may limit the number of simultaneously playing
     sound effects.
@@ -153,6 +164,57 @@ QStringList QSoundEffect::supportedMimeTypes()
     return mimeTypes;
 }
 
+/*!
+    \since 6.11
+
+    Starts loading the sound at \a url in the background, so that a sound effect
+    with this source is ready to play without waiting for the file to be read
+    and decoded.
+
+    Sounds that are no longer used by any sound effect stay loaded while they
+    fit into the sample cache, 8 MiB by default. The \c QT_MEDIA_SAMPLE_CACHE_SIZE
+    environment variable sets the size of the cache in KiB.
+
+    \sa setSourcePinned()
+*/
+void QSoundEffect::preload(const QUrl &url)
+{
+    sampleCache()->preload(url);
+}
+
+/*!
+    \since 6.11
+
+    Keeps the sound at \a url loaded if \a pinned is \c true, even when no sound
+    effect uses it and the sample cache is full. Starts loading the sound if
+    needed. If \a pinned is \c false, the sound is kept only as long as it fits
+    into the sample cache.
+
+    The \a url must be the same as the \l source of the sound effects that
+    use the sound.
+
+    \sa isSourcePinned(), preload()
+*/
+void QSoundEffect::setSourcePinned(const QUrl &url, bool pinned)
+{
+    if (pinned)
+        sampleCache()->pin(url);
+    else
+        sampleCache()->unpin(url);
+}
+
+/*!
+    \since 6.11
+
+    Returns whether the sound at \a url is pinned.
+
+    \sa setSourcePinned()
+*/
+bool QSoundEffect::isSourcePinned(const QUrl &url)
+{
+    return sampleCache()->isPinned(url);
+}
+
 /*!
     \qmlproperty url QtMultimedia::SoundEffect::source
 
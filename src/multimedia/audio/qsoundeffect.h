@@ -52,6 +52,10 @@ public:
 
     static QStringList supportedMimeTypes();
 
+    static void preload(const QUrl &url);
+    static void setSourcePinned(const QUrl &url, bool pinned);
+    static bool isSourcePinned(const QUrl &url);
+
     QUrl source() const;
     void setSource(const QUrl &url);
 
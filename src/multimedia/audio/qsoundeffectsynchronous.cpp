@@ -164,7 +164,10 @@ bool QSoundEffectPrivateSynchronous::updateAudioOutput()
 
     Q_ASSERT(m_sample);
 
-    const auto &sampleFormat = m_sample->format();
+    // int16 samples can be played as they are, packed 24-bit samples are converted to float
+    const std::optional<QAudioFormat> nativeFormat = m_sample->dataFormat();
+    const QByteArray sampleData = nativeFormat ? m_sample->data() : m_sample->toFloat();
+    const QAudioFormat sampleFormat = nativeFormat ? *nativeFormat : m_sample->format();
     const auto sampleChannelConfig =
             sampleFormat.channelConfig() == QAudioFormat::ChannelConfigUnknown
             ? QAudioFormat::defaultChannelConfigForChannelCount(sampleFormat.channelCount())
@@ -179,16 +182,15 @@ bool QSoundEffectPrivateSynchronous::updateAudioOutput()
         outputFormat.setChannelConfig(audioDevice.channelConfiguration());
 
         const auto resampler = QPlatformMediaIntegration::instance()->createAudioResampler(
-                m_sample->format(), outputFormat);
+                sampleFormat, outputFormat);
         if (resampler)
-            m_audioBuffer = resampler.value()->resample(m_sample->data().constData(),
-                                                        m_sample->data().size());
+            m_audioBuffer = resampler.value()->resample(sampleData.constData(), sampleData.size());
         else
             qCDebug(qLcSoundEffect) << "Cannot create resampler for channels mapping";
     }
 
     if (!m_audioBuffer.isValid())
-        m_audioBuffer = QAudioBuffer(m_sample->data(), m_sample->format());
+        m_audioBuffer = QAudioBuffer(sampleData, sampleFormat);
 
     m_audioSink.reset(new QAudioSink(audioDevice, m_audioBuffer.format()));
 
@@ -14,12 +14,50 @@ namespace QtMultimediaPrivate {
 
 namespace {
 
-QSpan<const float> toFloatSpan(QSpan<const char> byteArray)
+enum ConversionType : uint8_t { SameChannels, MonoToStereo, StereoToMono };
+
+// Mixes samples of the given encoding into the output, converting them to float on the fly
+template <QSample::Encoding encoding>
+void mixFrames(const uchar *samples, int sampleCh, QSpan<float> outputBuffer, int engineCh,
+               qsizetype framesToPlay, ConversionType conversion, float volume) noexcept
 {
-    return QSpan{
-        reinterpret_cast<const float *>(byteArray.data()),
-        qsizetype(byteArray.size_bytes() / sizeof(float)),
+    constexpr int bytesPerSample = encoding == QSample::Encoding::Float ? sizeof(float)
+            : encoding == QSample::Encoding::Int16                      ? sizeof(qint16)
+                                                                        : 3;
+    const auto sampleAt = [samples](qsizetype index) {
+        return QSample::sampleToFloat<encoding>(samples + index * bytesPerSample);
     };
+
+    // later: (auto)vectorize?
+    switch (conversion) {
+    case SameChannels:
+        for (qsizetype frame = 0; frame < framesToPlay; ++frame) {
+            const qsizetype sampleBase = frame * sampleCh;
+            const qsizetype outputBase = frame * engineCh;
+            for (int ch = 0; ch < sampleCh; ++ch) {
+                outputBuffer[outputBase + ch] += sampleAt(sampleBase + ch) * volume;
+            }
+        }
+        break;
+    case MonoToStereo:
+        for (qsizetype frame = 0; frame < framesToPlay; ++frame) {
+            const qsizetype sampleBase = frame * sampleCh;
+            const qsizetype outputBase = frame * engineCh;
+            const float val = sampleAt(sampleBase) * volume;
+            outputBuffer[outputBase] += val;
+            outputBuffer[outputBase + 1] += val;
+        }
+        break;
+    case StereoToMono:
+        float scale = 0.5f * volume;
+        for (qsizetype frame = 0; frame < framesToPlay; ++frame) {
+            const qsizetype sampleBase = frame * sampleCh;
+            const qsizetype outputBase = frame * engineCh;
+            const float val = (sampleAt(sampleBase) + sampleAt(sampleBase + 1)) * scale;
+            outputBuffer[outputBase] += val;
+        }
+        break;
+    }
 }
 
 } // namespace
@@ -68,23 +106,23 @@ VoicePlayResult QSoundEffectVoice::play(QSpan<float> outputBuffer) noexcept QT_M
 qsizetype QSoundEffectVoice::playVoice(QSpan<float> outputBuffer) noexcept QT_MM_NONBLOCKING
 {
     const QAudioFormat &format = m_sample->format();
-    const int totalSamples = m_totalFrames * format.channelCount();
-    const int currentSample = format.channelCount() * m_currentFrame;
-
-    const QSpan fullSample = toFloatSpan(m_sample->data());
-    const QSpan playbackRange = take(drop(fullSample, currentSample), totalSamples);
-
-    Q_ASSERT(!playbackRange.empty());
+    const QSample::Encoding encoding = m_sample->encoding();
 
     const int sampleCh = format.channelCount();
     const int engineCh = m_engineFormat.channelCount();
-    const qsizetype sampleSamples = playbackRange.size();
+    const qsizetype remainingFrames = m_totalFrames - m_currentFrame;
+
+    Q_ASSERT(remainingFrames > 0);
+
     const qsizetype outputSamples = outputBuffer.size();
-    const qsizetype maxFrames = std::min(sampleSamples / sampleCh, outputSamples / engineCh);
+    const qsizetype maxFrames = std::min(remainingFrames, outputSamples / engineCh);
     const qsizetype framesToPlay = maxFrames;
     const qsizetype outputSamplesPlayed = framesToPlay * engineCh;
 
-    enum ConversionType : uint8_t { SameChannels, MonoToStereo, StereoToMono };
+    // the sample data is read in place, whatever the encoding
+    const uchar *samples = reinterpret_cast<const uchar *>(m_sample->data().constData())
+            + qsizetype(m_currentFrame) * sampleCh * QSample::bytesPerSample(encoding);
+
     const ConversionType conversion = [&] {
         if (sampleCh == engineCh)
             return SameChannels;
@@ -100,34 +138,18 @@ qsizetype QSoundEffectVoice::playVoice(QSpan<float> outputBuffer) noexcept QT_MM
         return framesToPlay;
     }
 
-    // later: (auto)vectorize?
-    switch (conversion) {
-    case SameChannels:
-        for (qsizetype frame = 0; frame < framesToPlay; ++frame) {
-            const qsizetype sampleBase = frame * sampleCh;
-            const qsizetype outputBase = frame * engineCh;
-            for (int ch = 0; ch < sampleCh; ++ch) {
-                outputBuffer[outputBase + ch] += playbackRange[sampleBase + ch] * m_volume;
-            }
-        }
+    switch (encoding) {
+    case QSample::Encoding::Float:
+        mixFrames<QSample::Encoding::Float>(samples, sampleCh, outputBuffer, engineCh,
+                                            framesToPlay, conversion, m_volume);
         break;
-    case MonoToStereo:
-        for (qsizetype frame = 0; frame < framesToPlay; ++frame) {
-            const qsizetype sampleBase = frame * sampleCh;
-            const qsizetype outputBase = frame * engineCh;
-            const float val = playbackRange[sampleBase] * m_volume;
-            outputBuffer[outputBase] += val;
-            outputBuffer[outputBase + 1] += val;
-        }
+    case QSample::Encoding::Int16:
+        mixFrames<QSample::Encoding::Int16>(samples, sampleCh, outputBuffer, engineCh,
+                                            framesToPlay, conversion, m_volume);
         break;
-    case StereoToMono:
-        float scale = 0.5f * m_volume;
-        for (qsizetype frame = 0; frame < framesToPlay; ++frame) {
-            const qsizetype sampleBase = frame * sampleCh;
-            const qsizetype outputBase = frame * engineCh;
-            const float val = (playbackRange[sampleBase] + playbackRange[sampleBase + 1]) * scale;
-            outputBuffer[outputBase] += val;
-        }
+    case QSample::Encoding::PackedInt24:
+        mixFrames<QSample::Encoding::PackedInt24>(samples, sampleCh, outputBuffer, engineCh,
+                                                  framesToPlay, conversion, m_volume);
         break;
     }
 
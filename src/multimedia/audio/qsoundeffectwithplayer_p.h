@@ -51,7 +51,7 @@ public:
 
     const std::shared_ptr<const QSample> m_sample;
     const int m_totalFrames{
-        m_sample->format().framesForBytes(m_sample->data().size()),
+        int(m_sample->frameCount()),
     };
 
     const QAudioFormat m_engineFormat;
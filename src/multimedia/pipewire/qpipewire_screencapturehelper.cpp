@@ -10,6 +10,7 @@
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qrandom.h>
+#include <QtCore/qscopeguard.h>
 #include <QtCore/qurlquery.h>
 #include <QtCore/quuid.h>
 #include <QtCore/qvariantmap.h>
@@ -22,6 +23,7 @@
 #include <QtDBus/qdbusreply.h>
 #include <QtDBus/qdbusunixfiledescriptor.h>
 #include <QtGui/qguiapplication.h>
+#include <QtGui/qregion.h>
 #include <QtGui/qpa/qplatformintegration.h>
 #include <QtGui/qscreen.h>
 #include <QtGui/qwindow.h>
@@ -33,7 +35,10 @@
 #include <QtMultimedia/private/qmemoryvideobuffer_p.h>
 #include <QtMultimedia/private/qvideoframeconversionhelper_p.h>
 
+#include <spa/buffer/meta.h>
+
 #include <fcntl.h>
+#include <optional>
 
 // pipewire's macros tend to emit unused value warnings
 QT_WARNING_PUSH
@@ -77,6 +82,40 @@ struct PipeWireCaptureGlobalState
 
 Q_GLOBAL_STATIC(PipeWireCaptureGlobalState, globalState)
 
+namespace {
+
+// Upper bound of stream buffers referenced by video frames at a time. If consumers hold
+// more frames, e.g. in the encoder queue, the data of further frames is copied.
+constexpr int maxLentBuffers = 4;
+
+constexpr int maxDamageRegions = 16;
+
+// Returns the region that changed since the previous buffer, if the producer reports it
+std::optional<QRegion> damageRegion(const spa_buffer &buffer)
+{
+    spa_meta *damage = spa_buffer_find_meta(&buffer, SPA_META_VideoDamage);
+    if (!damage)
+        return std::nullopt;
+
+    QRegion region;
+    spa_meta_region *r;
+    spa_meta_for_each(r, damage) {
+        if (!spa_meta_region_is_valid(r))
+            break;
+        region += QRect(r->region.position.x, r->region.position.y, r->region.size.width,
+                        r->region.size.height);
+    }
+
+    // Treat empty damage as unknown rather than as "nothing changed",
+    // since not all producers fill in the metadata.
+    if (region.isEmpty())
+        return std::nullopt;
+
+    return region;
+}
+
+} // namespace
+
 bool QPipeWireCaptureHelper::setActiveInternal(bool active)
 {
     if (isSupported()) {
@@ -579,12 +618,10 @@ void QPipeWireCaptureHelper::recreateStream()
             reinterpret_cast<QPipeWireCaptureHelper *>(data)->onParamChanged(id, param);
         },
         .add_buffer = [](void *data, struct pw_buffer *buffer) {
-            Q_UNUSED(data)
-            Q_UNUSED(buffer)
+            reinterpret_cast<QPipeWireCaptureHelper *>(data)->m_bufferPool->addBuffer(buffer);
         },
         .remove_buffer = [](void *data, struct pw_buffer *buffer) {
-            Q_UNUSED(data)
-            Q_UNUSED(buffer)
+            reinterpret_cast<QPipeWireCaptureHelper *>(data)->m_bufferPool->removeBuffer(buffer);
         },
         .process = [](void *data) {
             reinterpret_cast<QPipeWireCaptureHelper *>(data)->onProcess();
@@ -607,6 +644,9 @@ void QPipeWireCaptureHelper::recreateStream()
 
     destroyStream(true);
 
+    m_bufferPool = std::make_shared<QPipeWireBufferPool>(maxLentBuffers);
+    m_frameSequence = 0;
+
     auto streamInfo = m_streams[0];
     struct spa_dict_item items[4];
     struct spa_dict info;
@@ -692,6 +732,11 @@ void QPipeWireCaptureHelper::destroyStream(bool forceDrain)
     }
 
     LoopLocker locker(m_threadLoop.get());
+
+    // Frames may outlive the stream; they keep copies of the data then
+    if (m_bufferPool)
+        m_bufferPool->invalidate();
+
     m_ignoreStateChange = true;
     pw_stream_disconnect(m_stream.get());
     m_stream = {};
@@ -737,37 +782,66 @@ void QPipeWireCaptureHelper::onStateChanged(pw_stream_state old, pw_stream_state
 }
 void QPipeWireCaptureHelper::onProcess()
 {
-    struct pw_buffer *b;
-    struct spa_buffer *buf;
-    int sstride = 0;
-    void *sdata;
-    qsizetype size = 0;
+    // Buffers of released video frames
+    for (pw_buffer *returned : m_bufferPool->takeReturnedBuffers())
+        pw_stream_queue_buffer(m_stream.get(), returned);
 
+    struct pw_buffer *b;
     if ((b = pw_stream_dequeue_buffer(m_stream.get())) == nullptr) {
         updateError(QPlatformSurfaceCapture::InternalError,
                     u"Out of buffers in pipewire stream dequeue."_s);
         return;
     }
 
-    buf = b->buffer;
-    if ((sdata = buf->datas[0].data) == nullptr)
+    auto queueBuffer = qScopeGuard([&] { pw_stream_queue_buffer(m_stream.get(), b); });
+
+    const spa_buffer *buf = b->buffer;
+    const spa_data &data = buf->datas[0];
+    if (!data.data || !data.chunk)
+        return;
+
+    // Producers send buffers without data if only the metadata, e.g. the cursor, has changed
+    if (data.chunk->size == 0)
+        return;
+
+    if (data.chunk->flags & SPA_CHUNK_FLAG_CORRUPTED) {
+        ++m_frameSequence; // consumers must not rely on the damage of the next frame
+        return;
+    }
+
+    if (quint64(data.chunk->offset) + data.chunk->size > data.maxsize) {
+        qCWarning(qLcPipeWireCapture) << "Invalid chunk in pipewire buffer";
         return;
+    }
 
-    sstride = buf->datas[0].chunk->stride;
+    const uchar *sdata = static_cast<const uchar *>(data.data) + data.chunk->offset;
+    const qsizetype size = data.chunk->size;
+    int sstride = data.chunk->stride;
     if (sstride == 0)
-        sstride = buf->datas[0].chunk->size / m_size.height();
-    size = buf->datas[0].chunk->size;
+        sstride = size / m_size.height();
 
     if (m_videoFrameFormat.frameSize() != m_size || m_videoFrameFormat.pixelFormat() != m_pixelFormat)
         m_videoFrameFormat = QVideoFrameFormat(m_size, m_pixelFormat);
 
-    m_currentFrame = QVideoFramePrivate::createFrame(
-            std::make_unique<QMemoryVideoBuffer>(QByteArray(static_cast<const char *>(sdata), size), sstride),
-            m_videoFrameFormat);
-    emit m_capture.newVideoFrame(m_currentFrame);
-    qCDebug(qLcPipeWireCaptureMore) << "got a frame of size " << buf->datas[0].chunk->size;
+    std::unique_ptr<QAbstractVideoBuffer> videoBuffer;
+    if (m_bufferPool->canLend()) {
+        // The buffer is queued back once the video frame is released
+        videoBuffer = m_bufferPool->lend(b, sdata, size, sstride);
+        queueBuffer.dismiss();
+    } else {
+        videoBuffer = std::make_unique<QMemoryVideoBuffer>(
+                QByteArray(reinterpret_cast<const char *>(sdata), size), sstride);
+    }
+
+    QVideoFrame frame = QVideoFramePrivate::createFrame(std::move(videoBuffer), m_videoFrameFormat);
 
-    pw_stream_queue_buffer(m_stream.get(), b);
+    ++m_frameSequence;
+    if (auto region = damageRegion(*buf))
+        QVideoFramePrivate::handle(frame)->damage =
+                QVideoFramePrivate::Damage{ m_frameSequence, std::move(*region) };
+
+    emit m_capture.newVideoFrame(frame);
+    qCDebug(qLcPipeWireCaptureMore) << "got a frame of size " << size;
 
     signalLoop(true, false);
 }
@@ -817,6 +891,43 @@ void QPipeWireCaptureHelper::onParamChanged(uint32_t id, const struct spa_pod *p
     m_size = QSize(m_format.info.raw.size.width, m_format.info.raw.size.height);
     m_pixelFormat = QPipeWireCaptureHelper::toQtPixelFormat(m_format.info.raw.format);
     qCDebug(qLcPipeWireCapture) << "m_pixelFormat=" << m_pixelFormat;
+
+    updateStreamParams();
+}
+
+void QPipeWireCaptureHelper::updateStreamParams()
+{
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_GCC("-Wmissing-field-initializers")
+    QT_WARNING_DISABLE_CLANG("-Wmissing-field-initializers")
+
+    uint8_t buffer[1024];
+    struct spa_pod_builder b = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+    const struct spa_pod *params[2];
+
+    // Enough buffers to lend some of them to video frames; memory that
+    // the stream maps for us, so that frames can refer to it.
+    params[0] = static_cast<const spa_pod *>(spa_pod_builder_add_object(
+            &b,
+            SPA_TYPE_OBJECT_ParamBuffers, SPA_PARAM_Buffers,
+            SPA_PARAM_BUFFERS_buffers,  SPA_POD_CHOICE_RANGE_Int(
+                                            maxLentBuffers + 4, 2, maxLentBuffers + 12),
+            SPA_PARAM_BUFFERS_dataType, SPA_POD_CHOICE_FLAGS_Int(
+                                            (1 << SPA_DATA_MemPtr) | (1 << SPA_DATA_MemFd)))
+    );
+
+    params[1] = static_cast<const spa_pod *>(spa_pod_builder_add_object(
+            &b,
+            SPA_TYPE_OBJECT_ParamMeta,  SPA_PARAM_Meta,
+            SPA_PARAM_META_type,        SPA_POD_Id(SPA_META_VideoDamage),
+            SPA_PARAM_META_size,        SPA_POD_CHOICE_RANGE_Int(
+                                            sizeof(spa_meta_region) * maxDamageRegions,
+                                            sizeof(spa_meta_region),
+                                            sizeof(spa_meta_region) * maxDamageRegions))
+    );
+    QT_WARNING_POP
+
+    pw_stream_update_params(m_stream.get(), params, 2);
 }
 
 // align with qt_videoFormatLookup in src/plugins/multimedia/gstreamer/common/qgst.cpp
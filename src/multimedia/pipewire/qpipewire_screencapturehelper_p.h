@@ -17,6 +17,7 @@
 
 #include "qpipewire_screencapture_p.h"
 #include "qpipewire_support_p.h"
+#include "qpipewire_videobuffer_p.h"
 
 #include <QtMultimedia/qvideoframe.h>
 
@@ -63,6 +64,7 @@ private:
     void onStateChanged(pw_stream_state old, pw_stream_state state, const char *error);
     void onProcess();
     void onParamChanged(uint32_t id, const struct spa_pod *param);
+    void updateStreamParams();
 
     void updateCoreInitSeq();
 
@@ -90,7 +92,6 @@ private:
     std::shared_ptr<QPipeWireInstance> m_instance;
     QPipeWireCapture &m_capture;
 
-    QVideoFrame m_currentFrame;
     QVideoFrameFormat m_videoFrameFormat;
     QVideoFrameFormat::PixelFormat m_pixelFormat{};
     QSize m_size;
@@ -107,6 +108,10 @@ private:
     PwStreamHandle m_stream = nullptr;
     spa_hook m_streamListener = {};
 
+    // Lends stream buffers to video frames instead of copying them
+    std::shared_ptr<QPipeWireBufferPool> m_bufferPool;
+    quint64 m_frameSequence = 0;
+
     spa_video_info m_format{};
 
     bool m_err = false;
@@ -46,6 +46,7 @@ INIT_FUNC(pw_stream_disconnect);
 INIT_FUNC(pw_stream_set_active);
 INIT_FUNC(pw_stream_dequeue_buffer);
 INIT_FUNC(pw_stream_queue_buffer);
+INIT_FUNC(pw_stream_update_params);
 INIT_OPT_FUNC(pw_stream_get_time_n);
 INIT_FUNC(pw_proxy_destroy);
 INIT_FUNC(pw_get_library_version);
@@ -81,6 +82,7 @@ DEFINE_FUNC(pw_stream_disconnect, 1);
 DEFINE_FUNC(pw_stream_set_active, 2);
 DEFINE_FUNC(pw_stream_dequeue_buffer, 1);
 DEFINE_FUNC(pw_stream_queue_buffer, 2);
+DEFINE_FUNC(pw_stream_update_params, 3);
 DEFINE_FUNC(pw_stream_get_time_n, 3, -1);
 DEFINE_FUNC(pw_proxy_destroy, 1);
 DEFINE_FUNC(pw_get_library_version, 0);
@@ -0,0 +1,201 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qpipewire_videobuffer_p.h"
+
+#include <QtCore/qloggingcategory.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(qLcPipeWireVideoBuffer, "qt.multimedia.pipewire.videobuffer");
+
+namespace QtPipeWire {
+
+QPipeWireBufferPool::~QPipeWireBufferPool()
+{
+    // video buffers keep a reference to the pool
+    Q_ASSERT(m_lentBuffers.empty());
+}
+
+void QPipeWireBufferPool::addBuffer(pw_buffer *buffer)
+{
+    Q_UNUSED(buffer);
+    QMutexLocker locker(&m_mutex);
+    ++m_bufferCount;
+}
+
+void QPipeWireBufferPool::removeBuffer(pw_buffer *buffer)
+{
+    QMutexLocker locker(&m_mutex);
+    --m_bufferCount;
+
+    m_returnedBuffers.erase(
+            std::remove(m_returnedBuffers.begin(), m_returnedBuffers.end(), buffer),
+            m_returnedBuffers.end());
+
+    auto it = std::find_if(m_lentBuffers.begin(), m_lentBuffers.end(),
+                           [buffer](const LentBuffer &lent) { return lent.buffer == buffer; });
+    if (it != m_lentBuffers.end()) {
+        qCDebug(qLcPipeWireVideoBuffer) << "Stream buffer removed while lent; copying its data";
+        QPipeWireVideoBuffer *videoBuffer = it->videoBuffer;
+        m_lentBuffers.erase(it);
+        detachUnlocked(locker, videoBuffer);
+    }
+}
+
+bool QPipeWireBufferPool::canLend()
+{
+    QMutexLocker locker(&m_mutex);
+    const int limit = std::min(m_maxLentBuffers, m_bufferCount - 2);
+    return int(m_lentBuffers.size() + m_returnedBuffers.size()) < limit;
+}
+
+std::unique_ptr<QPipeWireVideoBuffer>
+QPipeWireBufferPool::lend(pw_buffer *buffer, const uchar *data, qsizetype size, int bytesPerLine)
+{
+    auto videoBuffer = std::make_unique<QPipeWireVideoBuffer>(shared_from_this(), buffer, data,
+                                                              size, bytesPerLine);
+    QMutexLocker locker(&m_mutex);
+    m_lentBuffers.push_back({ videoBuffer.get(), buffer });
+    return videoBuffer;
+}
+
+std::vector<pw_buffer *> QPipeWireBufferPool::takeReturnedBuffers()
+{
+    QMutexLocker locker(&m_mutex);
+    return std::exchange(m_returnedBuffers, {});
+}
+
+void QPipeWireBufferPool::invalidate()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_lentBuffers.empty()) {
+        QPipeWireVideoBuffer *videoBuffer = m_lentBuffers.back().videoBuffer;
+        m_lentBuffers.pop_back();
+        detachUnlocked(locker, videoBuffer);
+    }
+
+    // Includes buffers returned while we were copying
+    m_returnedBuffers.clear();
+}
+
+void QPipeWireBufferPool::detachUnlocked(QMutexLocker<QMutex> &locker,
+                                         QPipeWireVideoBuffer *videoBuffer)
+{
+    // The copy may have to wait until the frame is unmapped. Other frames must still
+    // be able to return their buffers meanwhile, so don't hold the pool mutex.
+    m_detachingBuffer = videoBuffer;
+    locker.unlock();
+
+    videoBuffer->detach();
+
+    locker.relock();
+    m_detachingBuffer = nullptr;
+    m_detached.wakeAll();
+}
+
+void QPipeWireBufferPool::giveBack(QPipeWireVideoBuffer *videoBuffer, pw_buffer *buffer)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // The video buffer must not be destroyed while it's being detached
+    while (m_detachingBuffer == videoBuffer)
+        m_detached.wait(locker.mutex());
+
+    auto it = std::find_if(m_lentBuffers.begin(), m_lentBuffers.end(),
+                           [videoBuffer](const LentBuffer &lent) {
+                               return lent.videoBuffer == videoBuffer;
+                           });
+
+    // the buffer has been removed from the stream in the meantime
+    if (it == m_lentBuffers.end())
+        return;
+
+    Q_ASSERT(!buffer || it->buffer == buffer);
+    m_returnedBuffers.push_back(it->buffer);
+    m_lentBuffers.erase(it);
+}
+
+QPipeWireVideoBuffer::QPipeWireVideoBuffer(std::shared_ptr<QPipeWireBufferPool> pool,
+                                           pw_buffer *buffer, const uchar *data, qsizetype size,
+                                           int bytesPerLine)
+    : m_pool(std::move(pool)),
+      m_buffer(buffer),
+      m_data(data),
+      m_size(size),
+      m_bytesPerLine(bytesPerLine)
+{
+}
+
+QPipeWireVideoBuffer::~QPipeWireVideoBuffer()
+{
+    pw_buffer *buffer = nullptr;
+    {
+        QMutexLocker locker(&m_mutex);
+        buffer = m_buffer;
+    }
+
+    m_pool->giveBack(this, buffer);
+}
+
+QAbstractVideoBuffer::MapData QPipeWireVideoBuffer::map(QVideoFrame::MapMode mode)
+{
+    MapData mapData;
+
+    QMutexLocker locker(&m_mutex);
+
+    // The stream buffer is mapped read-only; writing requires a copy of our own,
+    // and then the stream buffer can be returned right away
+    if (mode != QVideoFrame::ReadOnly && m_buffer) {
+        pw_buffer *buffer = detachLocked(locker);
+        locker.unlock();
+        m_pool->giveBack(this, buffer);
+        locker.relock();
+    }
+
+    if (!m_data)
+        return mapData;
+
+    ++m_mapCount;
+
+    mapData.planeCount = 1;
+    mapData.bytesPerLine[0] = m_bytesPerLine;
+    mapData.data[0] = mode == QVideoFrame::ReadOnly
+            ? const_cast<uchar *>(m_data)
+            : reinterpret_cast<uchar *>(m_detachedData.data());
+    mapData.dataSize[0] = int(m_size);
+    return mapData;
+}
+
+void QPipeWireVideoBuffer::unmap()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_mapCount > 0 && --m_mapCount == 0)
+        m_unmapped.wakeAll();
+}
+
+pw_buffer *QPipeWireVideoBuffer::detach()
+{
+    QMutexLocker locker(&m_mutex);
+    return detachLocked(locker);
+}
+
+pw_buffer *QPipeWireVideoBuffer::detachLocked(QMutexLocker<QMutex> &locker)
+{
+    if (!m_buffer)
+        return nullptr;
+
+    // Consumers keep frames mapped only for the duration of a conversion or an upload
+    while (m_mapCount > 0)
+        m_unmapped.wait(locker.mutex());
+
+    m_detachedData = QByteArray(reinterpret_cast<const char *>(m_data), m_size);
+    m_data = reinterpret_cast<const uchar *>(m_detachedData.constData());
+    return std::exchange(m_buffer, nullptr);
+}
+
+} // namespace QtPipeWire
+
+QT_END_NAMESPACE
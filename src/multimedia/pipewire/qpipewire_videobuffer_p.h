@@ -0,0 +1,127 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPIPEWIRE_VIDEOBUFFER_P_H
+#define QPIPEWIRE_VIDEOBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qabstractvideobuffer.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+
+#include "qpipewire_support_p.h"
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPipeWire {
+
+class QPipeWireVideoBuffer;
+
+// Tracks the stream buffers that are lent to video frames. Video frames can be released
+// on any thread, while buffers can only be queued back to the stream on the pipewire
+// thread, so released buffers are collected and handed back by takeReturnedBuffers().
+//
+// Lock order: pipewire thread loop lock -> pool mutex -> video buffer mutex. The pool
+// mutex is not held while a video buffer waits for its frame to be unmapped.
+class Q_MULTIMEDIA_EXPORT QPipeWireBufferPool : public std::enable_shared_from_this<QPipeWireBufferPool>
+{
+public:
+    explicit QPipeWireBufferPool(int maxLentBuffers) : m_maxLentBuffers(maxLentBuffers) { }
+    ~QPipeWireBufferPool();
+
+    // The following methods are called on the pipewire thread
+
+    void addBuffer(pw_buffer *buffer);
+    void removeBuffer(pw_buffer *buffer);
+
+    // We always leave at least two buffers to the producer, so that it never stalls
+    // while the frames that refer to lent buffers are processed.
+    bool canLend();
+
+    std::unique_ptr<QPipeWireVideoBuffer> lend(pw_buffer *buffer, const uchar *data,
+                                               qsizetype size, int bytesPerLine);
+
+    std::vector<pw_buffer *> takeReturnedBuffers();
+
+    // Copies the data of all lent buffers, so that the stream can be destroyed.
+    // Waits for frames that are mapped at the moment to be unmapped.
+    void invalidate();
+
+private:
+    friend class QPipeWireVideoBuffer;
+    void giveBack(QPipeWireVideoBuffer *videoBuffer, pw_buffer *buffer);
+
+    // The video buffer must have been removed from m_lentBuffers
+    void detachUnlocked(QMutexLocker<QMutex> &locker, QPipeWireVideoBuffer *videoBuffer);
+
+    struct LentBuffer
+    {
+        QPipeWireVideoBuffer *videoBuffer;
+        pw_buffer *buffer;
+    };
+
+    const int m_maxLentBuffers;
+
+    QMutex m_mutex;
+    int m_bufferCount QT_MM_GUARDED_BY(m_mutex) = 0;
+    std::vector<LentBuffer> m_lentBuffers QT_MM_GUARDED_BY(m_mutex);
+    std::vector<pw_buffer *> m_returnedBuffers QT_MM_GUARDED_BY(m_mutex);
+
+    QWaitCondition m_detached;
+    QPipeWireVideoBuffer *m_detachingBuffer QT_MM_GUARDED_BY(m_mutex) = nullptr;
+};
+
+// Refers to the memory of a pipewire stream buffer (MemPtr, or MemFd mapped by the stream)
+// until the video frame is released. If the stream buffer goes away earlier, its data is
+// copied.
+class Q_MULTIMEDIA_EXPORT QPipeWireVideoBuffer : public QAbstractVideoBuffer
+{
+public:
+    QPipeWireVideoBuffer(std::shared_ptr<QPipeWireBufferPool> pool, pw_buffer *buffer,
+                         const uchar *data, qsizetype size, int bytesPerLine);
+    ~QPipeWireVideoBuffer() override;
+
+    MapData map(QVideoFrame::MapMode mode) override;
+    void unmap() override;
+
+    QVideoFrameFormat format() const override { return {}; }
+
+private:
+    friend class QPipeWireBufferPool;
+
+    // Copies the data and returns the stream buffer, if it has not been detached before
+    pw_buffer *detach();
+    pw_buffer *detachLocked(QMutexLocker<QMutex> &locker);
+
+    const std::shared_ptr<QPipeWireBufferPool> m_pool;
+
+    QMutex m_mutex;
+    QWaitCondition m_unmapped;
+    int m_mapCount QT_MM_GUARDED_BY(m_mutex) = 0;
+    pw_buffer *m_buffer QT_MM_GUARDED_BY(m_mutex) = nullptr;
+    const uchar *m_data QT_MM_GUARDED_BY(m_mutex) = nullptr;
+    QByteArray m_detachedData QT_MM_GUARDED_BY(m_mutex);
+
+    const qsizetype m_size;
+    const int m_bytesPerLine;
+};
+
+} // namespace QtPipeWire
+
+QT_END_NAMESPACE
+
+#endif // QPIPEWIRE_VIDEOBUFFER_P_H
@@ -11,11 +11,17 @@ QPlatformMediaFormatInfo::QPlatformMediaFormatInfo() = default;
 
 QPlatformMediaFormatInfo::~QPlatformMediaFormatInfo() = default;
 
+QList<QPlatformMediaFormatInfo::CodecMap>
+QPlatformMediaFormatInfo::codecMaps(QMediaFormat::ConversionMode m, QMediaFormat::FileFormat) const
+{
+    return (m == QMediaFormat::Encode) ? encoders : decoders;
+}
+
 QList<QMediaFormat::FileFormat> QPlatformMediaFormatInfo::supportedFileFormats(const QMediaFormat &constraints, QMediaFormat::ConversionMode m) const
 {
     std::set<QMediaFormat::FileFormat> formats;
 
-    const auto &codecMap = (m == QMediaFormat::Encode) ? encoders : decoders;
+    const QList<CodecMap> codecMap = codecMaps(m, QMediaFormat::UnspecifiedFormat);
     for (const auto &m : codecMap) {
         if (constraints.audioCodec() != QMediaFormat::AudioCodec::Unspecified && !m.audio.contains(constraints.audioCodec()))
             continue;
@@ -30,7 +36,7 @@ QList<QMediaFormat::AudioCodec> QPlatformMediaFormatInfo::supportedAudioCodecs(c
 {
     std::set<QMediaFormat::AudioCodec> codecs;
 
-    const auto &codecMap = (m == QMediaFormat::Encode) ? encoders : decoders;
+    const QList<CodecMap> codecMap = codecMaps(m, constraints.fileFormat());
     for (const auto &m : codecMap) {
         if (constraints.fileFormat() != QMediaFormat::UnspecifiedFormat && m.format != constraints.fileFormat())
             continue;
@@ -47,7 +53,7 @@ QList<QMediaFormat::VideoCodec> QPlatformMediaFormatInfo::supportedVideoCodecs(c
 {
     std::set<QMediaFormat::VideoCodec> codecs;
 
-    const auto &codecMap = (m == QMediaFormat::Encode) ? encoders : decoders;
+    const QList<CodecMap> codecMap = codecMaps(m, constraints.fileFormat());
     for (const auto &m : codecMap) {
         if (constraints.fileFormat() != QMediaFormat::UnspecifiedFormat && m.format != constraints.fileFormat())
             continue;
@@ -61,7 +67,7 @@ QList<QMediaFormat::VideoCodec> QPlatformMediaFormatInfo::supportedVideoCodecs(c
 
 bool QPlatformMediaFormatInfo::isSupported(const QMediaFormat &format, QMediaFormat::ConversionMode m) const
 {
-    const auto &codecMap = (m == QMediaFormat::Encode) ? encoders : decoders;
+    const QList<CodecMap> codecMap = codecMaps(m, format.fileFormat());
 
     for (const auto &m : codecMap) {
         if (m.format != format.fileFormat())
@@ -42,6 +42,12 @@ public:
     QList<CodecMap> decoders;
 
     QList<QImageCapture::FileFormat> imageFormats;
+
+protected:
+    // Backends that build the codec maps on demand override this. Unless fileFormat
+    // is unspecified, the returned maps may be limited to those of fileFormat.
+    virtual QList<CodecMap> codecMaps(QMediaFormat::ConversionMode m,
+                                      QMediaFormat::FileFormat fileFormat) const;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,58 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplatformmediaframeextractor_p.h"
+
+#include <QtGui/qimage.h>
+#include <QtMultimedia/qvideoframe.h>
+
+QT_BEGIN_NAMESPACE
+
+QPlatformMediaFrameExtractor::QPlatformMediaFrameExtractor(QMediaFrameExtractor *parent)
+    : q(parent)
+{
+}
+
+QPlatformMediaFrameExtractor::~QPlatformMediaFrameExtractor() = default;
+
+void QPlatformMediaFrameExtractor::setActive(bool active)
+{
+    if (std::exchange(m_active, active) != active)
+        emit q->activeChanged();
+}
+
+void QPlatformMediaFrameExtractor::frameExtracted(qint64 position, const QVideoFrame &frame)
+{
+    emit q->frameExtracted(position, frame);
+}
+
+void QPlatformMediaFrameExtractor::imageExtracted(qint64 position, const QImage &image)
+{
+    emit q->imageExtracted(position, image);
+}
+
+void QPlatformMediaFrameExtractor::finished()
+{
+    setActive(false);
+    emit q->finished();
+}
+
+void QPlatformMediaFrameExtractor::error(QMediaFrameExtractor::Error error,
+                                         const QString &errorString)
+{
+    if (error == m_error && errorString == m_errorString)
+        return;
+
+    m_error = error;
+    m_errorString = errorString;
+    emit q->errorChanged();
+
+    if (m_error != QMediaFrameExtractor::NoError) {
+        setActive(false);
+        emit q->errorOccurred(m_error, m_errorString);
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qplatformmediaframeextractor_p.cpp"
@@ -0,0 +1,67 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLATFORMMEDIAFRAMEEXTRACTOR_P_H
+#define QPLATFORMMEDIAFRAMEEXTRACTOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qmediaframeextractor.h>
+#include <QtCore/qlist.h>
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_MULTIMEDIA_EXPORT QPlatformMediaFrameExtractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~QPlatformMediaFrameExtractor() override;
+
+    // Starts extracting the frames at the positions (in milliseconds), which are sorted
+    // and unique. If the image size is valid, images of that size are delivered instead
+    // of video frames. A running extraction is cancelled.
+    virtual void extractFrames(const QUrl &source, const QList<qint64> &positions,
+                               const QSize &imageSize) = 0;
+
+    // Cancels the running extraction; nothing is reported for it afterwards.
+    virtual void cancel() = 0;
+
+    bool isActive() const { return m_active; }
+
+    QMediaFrameExtractor::Error error() const { return m_error; }
+    QString errorString() const { return m_errorString; }
+
+    // The reporting functions below must be called on the thread of the extractor
+    void setActive(bool active);
+    void frameExtracted(qint64 position, const QVideoFrame &frame);
+    void imageExtracted(qint64 position, const QImage &image);
+    void finished();
+
+    void error(QMediaFrameExtractor::Error error, const QString &errorString);
+    void clearError() { error(QMediaFrameExtractor::NoError, {}); }
+
+protected:
+    explicit QPlatformMediaFrameExtractor(QMediaFrameExtractor *parent);
+
+private:
+    QMediaFrameExtractor *q = nullptr;
+
+    bool m_active = false;
+    QMediaFrameExtractor::Error m_error = QMediaFrameExtractor::NoError;
+    QString m_errorString;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLATFORMMEDIAFRAMEEXTRACTOR_P_H
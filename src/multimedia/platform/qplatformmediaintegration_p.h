@@ -37,6 +37,7 @@ class QCameraDevice;
 class QCapturableWindow;
 class QImageCapture;
 class QMediaDevices;
+class QMediaFrameExtractor;
 class QMediaPlayer;
 class QMediaRecorder;
 class QPlatformAudioDecoder;
@@ -49,6 +50,7 @@ class QPlatformCapturableWindows;
 class QPlatformImageCapture;
 class QPlatformMediaCaptureSession;
 class QPlatformMediaFormatInfo;
+class QPlatformMediaFrameExtractor;
 class QPlatformMediaPlayer;
 class QPlatformMediaRecorder;
 class QPlatformSurfaceCapture;
@@ -86,6 +88,11 @@ public:
     {
         return q23::unexpected{ notAvailable };
     }
+    virtual q23::expected<QPlatformMediaFrameExtractor *, QString>
+    createMediaFrameExtractor(QMediaFrameExtractor *)
+    {
+        return q23::unexpected{ notAvailable };
+    }
     virtual q23::expected<std::unique_ptr<QPlatformAudioResampler>, QString>
     createAudioResampler(const QAudioFormat & /*inputFormat*/,
                          const QAudioFormat & /*outputFormat*/);
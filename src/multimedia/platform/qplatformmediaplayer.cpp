@@ -36,6 +36,11 @@ void QPlatformMediaPlayer::error(QMediaPlayer::Error error, const QString &error
     player->d_func()->setError(error, errorString);
 }
 
+void QPlatformMediaPlayer::nextMediaStarted(const QUrl &media)
+{
+    player->d_func()->nextMediaStarted(media);
+}
+
 QPlatformMediaPlayer::PitchCompensationAvailability
 QPlatformMediaPlayer::pitchCompensationAvailability() const
 {
@@ -63,4 +68,9 @@ QPlaybackOptions QPlatformMediaPlayer::playbackOptions() const
     return player->playbackOptions();
 }
 
+QPlaybackStatistics QPlatformMediaPlayer::playbackStatistics() const
+{
+    return {};
+}
+
 QT_END_NAMESPACE
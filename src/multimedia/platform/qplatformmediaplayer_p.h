@@ -19,6 +19,7 @@
 #include <QtMultimedia/qmediatimerange.h>
 #include <QtMultimedia/qaudiodevice.h>
 #include <QtMultimedia/qmediametadata.h>
+#include <QtMultimedia/qplaybackstatistics.h>
 
 #include <QtCore/private/qglobal_p.h>
 #include <QtCore/qobject.h>
@@ -62,6 +63,11 @@ public:
 
     virtual bool streamPlaybackSupported() const { return false; }
 
+    // Gapless playback. Returns true if the backend switches to the next media by itself,
+    // and reports it with nextMediaStarted(). Otherwise, QMediaPlayer sets the next media
+    // as the source when the current one ends.
+    virtual bool setNextMedia(const QUrl & /*media*/) { return false; }
+
     virtual void setAudioOutput(QPlatformAudioOutput *) {}
 
     virtual void setAudioBufferOutput(QAudioBufferOutput *) { }
@@ -116,6 +122,7 @@ public:
     void stateChanged(QMediaPlayer::PlaybackState newState);
     void mediaStatusChanged(QMediaPlayer::MediaStatus status);
     void error(QMediaPlayer::Error, const QString &errorString);
+    void nextMediaStarted(const QUrl &media);
 
     void resetCurrentLoop() { m_currentLoop = 0; }
     bool doLoop() {
@@ -139,6 +146,8 @@ public:
 
     QPlaybackOptions playbackOptions() const;
 
+    virtual QPlaybackStatistics playbackStatistics() const;
+
     bool qmediaplayerDestructorCalled = false;
 
 protected:
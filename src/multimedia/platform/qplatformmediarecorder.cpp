@@ -39,6 +39,22 @@ void QPlatformMediaRecorder::durationChanged(qint64 duration)
     emit q->durationChanged(duration);
 }
 
+void QPlatformMediaRecorder::skippedVideoFrameCountChanged(qint64 count)
+{
+    if (m_skippedVideoFrameCount == count)
+        return;
+    m_skippedVideoFrameCount = count;
+    emit q->skippedVideoFrameCountChanged(count);
+}
+
+void QPlatformMediaRecorder::droppedAudioDurationChanged(qint64 duration)
+{
+    if (m_droppedAudioDuration == duration)
+        return;
+    m_droppedAudioDuration = duration;
+    emit q->droppedAudioDurationChanged(duration);
+}
+
 void QPlatformMediaRecorder::actualLocationChanged(const QUrl &location)
 {
     if (m_actualLocation == location)
@@ -45,10 +45,19 @@ class Q_MULTIMEDIA_EXPORT QMediaEncoderSettings
     int m_audioBitrate = -1;
     int m_audioSampleRate = -1;
     int m_audioChannels = -1;
+    int m_maxAudioQueueDuration = -1;
+    QMediaRecorder::AudioOverflowPolicy m_audioOverflowPolicy = QMediaRecorder::BlockOnAudioOverflow;
 
     QSize m_videoResolution = QSize(-1, -1);
     int m_videoFrameRate = -1;
     int m_videoBitRate = -1;
+    bool m_skipDuplicateVideoFrames = false;
+
+    QMediaRecorder::MuxingMode m_muxingMode = QMediaRecorder::DefaultMuxing;
+
+    QMediaRecorder::EncoderThreading m_videoEncoderThreading = QMediaRecorder::AutomaticThreading;
+    int m_videoEncoderThreadCount = 0;
+    int m_videoEncoderLookahead = -1;
 public:
 
     QMediaFormat mediaFormat() const { return m_format; }
@@ -95,6 +104,29 @@ public:
     int audioSampleRate() const { return m_audioSampleRate; }
     void setAudioSampleRate(int rate) { m_audioSampleRate = rate; }
 
+    int maxAudioQueueDuration() const { return m_maxAudioQueueDuration; }
+    void setMaxAudioQueueDuration(int milliseconds) { m_maxAudioQueueDuration = milliseconds; }
+
+    QMediaRecorder::AudioOverflowPolicy audioOverflowPolicy() const { return m_audioOverflowPolicy; }
+    void setAudioOverflowPolicy(QMediaRecorder::AudioOverflowPolicy policy)
+    { m_audioOverflowPolicy = policy; }
+
+    bool skipDuplicateVideoFrames() const { return m_skipDuplicateVideoFrames; }
+    void setSkipDuplicateVideoFrames(bool skip) { m_skipDuplicateVideoFrames = skip; }
+
+    QMediaRecorder::MuxingMode muxingMode() const { return m_muxingMode; }
+    void setMuxingMode(QMediaRecorder::MuxingMode mode) { m_muxingMode = mode; }
+
+    QMediaRecorder::EncoderThreading videoEncoderThreading() const { return m_videoEncoderThreading; }
+    void setVideoEncoderThreading(QMediaRecorder::EncoderThreading threading)
+    { m_videoEncoderThreading = threading; }
+
+    int videoEncoderThreadCount() const { return m_videoEncoderThreadCount; }
+    void setVideoEncoderThreadCount(int threadCount) { m_videoEncoderThreadCount = threadCount; }
+
+    int videoEncoderLookahead() const { return m_videoEncoderLookahead; }
+    void setVideoEncoderLookahead(int frames) { m_videoEncoderLookahead = frames; }
+
     bool operator==(const QMediaEncoderSettings &other) const
     {
         return m_format == other.m_format &&
@@ -103,9 +135,16 @@ public:
                m_audioBitrate == other.m_audioBitrate &&
                m_audioSampleRate == other.m_audioSampleRate &&
                m_audioChannels == other.m_audioChannels &&
+               m_maxAudioQueueDuration == other.m_maxAudioQueueDuration &&
+               m_audioOverflowPolicy == other.m_audioOverflowPolicy &&
                m_videoResolution == other.m_videoResolution &&
                m_videoFrameRate == other.m_videoFrameRate &&
-               m_videoBitRate == other.m_videoBitRate;
+               m_videoBitRate == other.m_videoBitRate &&
+               m_skipDuplicateVideoFrames == other.m_skipDuplicateVideoFrames &&
+               m_muxingMode == other.m_muxingMode &&
+               m_videoEncoderThreading == other.m_videoEncoderThreading &&
+               m_videoEncoderThreadCount == other.m_videoEncoderThreadCount &&
+               m_videoEncoderLookahead == other.m_videoEncoderLookahead;
     }
 
     bool operator!=(const QMediaEncoderSettings &other) const
@@ -126,6 +165,8 @@ public:
     virtual void stop() = 0;
 
     virtual qint64 duration() const { return m_duration; }
+    qint64 skippedVideoFrameCount() const { return m_skippedVideoFrameCount; }
+    qint64 droppedAudioDuration() const { return m_droppedAudioDuration; }
 
     virtual void setMetaData(const QMediaMetaData &) {}
     virtual QMediaMetaData metaData() const { return {}; }
@@ -149,6 +190,8 @@ protected:
 
     void stateChanged(QMediaRecorder::RecorderState state);
     void durationChanged(qint64 position);
+    void skippedVideoFrameCountChanged(qint64 count);
+    void droppedAudioDurationChanged(qint64 duration);
     void actualLocationChanged(const QUrl &location);
     void updateError(QMediaRecorder::Error error, const QString &errorString);
     void metaDataChanged();
@@ -164,6 +207,8 @@ private:
     QUrl m_outputLocation;
     QPointer<QIODevice> m_outputDevice;
     qint64 m_duration = 0;
+    qint64 m_skippedVideoFrameCount = 0;
+    qint64 m_droppedAudioDuration = 0;
 
     QMediaRecorder::RecorderState m_state = QMediaRecorder::StoppedState;
 };
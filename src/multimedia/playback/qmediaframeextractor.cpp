@@ -0,0 +1,257 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmediaframeextractor_p.h"
+
+#include <QtMultimedia/private/qmultimediautils_p.h>
+#include <QtMultimedia/private/qplatformmediaintegration_p.h>
+
+#include <QtCore/qdebug.h>
+#include <QtGui/qimage.h>
+#include <QtMultimedia/qvideoframe.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaFrameExtractor
+    \brief The QMediaFrameExtractor class extracts video frames at given positions of a media.
+    \inmodule QtMultimedia
+    \ingroup multimedia
+    \ingroup multimedia_video
+    \since 6.11
+
+    \preliminary
+
+    QMediaFrameExtractor decodes the video frames shown at a list of positions of a
+    media file, without playing it back. This is useful for generating thumbnails
+    or scrub strips:
+
+    \code
+    auto *extractor = new QMediaFrameExtractor(this);
+    extractor->setSource(QUrl::fromLocalFile(fileName));
+    extractor->setImageSize(QSize(160, 90));
+    connect(extractor, &QMediaFrameExtractor::imageExtracted, this,
+            [this](qint64 position, const QImage &image) { setThumbnail(position, image); });
+    extractor->extractFrames({ 0, 10000, 20000, 30000 });
+    \endcode
+
+    Only the parts of the media that are needed to decode the requested frames are read,
+    and the frames are decoded in parallel. The frames are reported as soon as they are
+    decoded, which is not necessarily in the order of the positions.
+
+    \note Frame extraction is currently supported with the FFmpeg media backend only.
+
+    \sa QMediaPlayer, QVideoFrame
+*/
+
+/*!
+    \enum QMediaFrameExtractor::Error
+
+    Defines a media frame extractor error condition.
+
+    \value NoError No error has occurred.
+    \value ResourceError The media could not be opened.
+    \value FormatError The media has no video stream, or the stream cannot be decoded.
+    \value AccessDeniedError There are not the appropriate permissions to open the media.
+    \value NotSupportedError Frame extraction is not supported by the media backend.
+*/
+
+/*!
+    Constructs a media frame extractor with \a parent.
+*/
+QMediaFrameExtractor::QMediaFrameExtractor(QObject *parent)
+    : QObject{ *new QMediaFrameExtractorPrivate, parent }
+{
+    Q_D(QMediaFrameExtractor);
+
+    auto maybeExtractor = QPlatformMediaIntegration::instance()->createMediaFrameExtractor(this);
+    if (maybeExtractor)
+        d->extractor.reset(maybeExtractor.value());
+    else
+        qWarning() << "Failed to initialize QMediaFrameExtractor" << maybeExtractor.error();
+}
+
+/*!
+    Destroys the media frame extractor. A running extraction is cancelled.
+*/
+QMediaFrameExtractor::~QMediaFrameExtractor()
+{
+    Q_D(QMediaFrameExtractor);
+    if (d->extractor)
+        d->extractor->cancel();
+}
+
+/*!
+    Returns \c true if frame extraction is supported by the media backend.
+*/
+bool QMediaFrameExtractor::isSupported() const
+{
+    Q_D(const QMediaFrameExtractor);
+    return bool(d->extractor);
+}
+
+/*!
+    \property QMediaFrameExtractor::source
+    \brief the media to extract the frames from.
+
+    Setting the source cancels a running extraction.
+*/
+QUrl QMediaFrameExtractor::source() const
+{
+    Q_D(const QMediaFrameExtractor);
+    return d->source;
+}
+
+void QMediaFrameExtractor::setSource(const QUrl &source)
+{
+    Q_D(QMediaFrameExtractor);
+    if (d->source == source)
+        return;
+
+    cancel();
+    d->source = source;
+    emit sourceChanged();
+}
+
+/*!
+    \property QMediaFrameExtractor::imageSize
+    \brief the size of the images to deliver.
+
+    If the size is valid, the extracted frames are converted to images and scaled
+    to fit into the size, keeping their aspect ratio, on the worker threads; the images
+    are reported with \l imageExtracted(). Otherwise, the decoded frames are reported
+    with \l frameExtracted().
+
+    The size applies to the extractions started after setting it. By default, the size is
+    invalid.
+
+    \note Video frames may keep the memory of the decoder alive. Prefer requesting
+    images when extracting many frames.
+*/
+QSize QMediaFrameExtractor::imageSize() const
+{
+    Q_D(const QMediaFrameExtractor);
+    return d->imageSize;
+}
+
+void QMediaFrameExtractor::setImageSize(const QSize &size)
+{
+    Q_D(QMediaFrameExtractor);
+    if (d->imageSize == size)
+        return;
+
+    d->imageSize = size;
+    emit imageSizeChanged();
+}
+
+/*!
+    \property QMediaFrameExtractor::active
+    \brief whether frames are being extracted.
+*/
+bool QMediaFrameExtractor::isActive() const
+{
+    Q_D(const QMediaFrameExtractor);
+    return d->extractor && d->extractor->isActive();
+}
+
+/*!
+    \property QMediaFrameExtractor::error
+    \brief the error of the last extraction.
+*/
+QMediaFrameExtractor::Error QMediaFrameExtractor::error() const
+{
+    Q_D(const QMediaFrameExtractor);
+    return d->extractor ? d->extractor->error() : NotSupportedError;
+}
+
+/*!
+    \property QMediaFrameExtractor::errorString
+    \brief a human readable description of the error of the last extraction.
+*/
+QString QMediaFrameExtractor::errorString() const
+{
+    Q_D(const QMediaFrameExtractor);
+    if (!d->extractor)
+        return tr("QMediaFrameExtractor is not supported.");
+    return d->extractor->errorString();
+}
+
+/*!
+    Starts extracting the frames shown at \a positions, in milliseconds, of the source.
+
+    Each frame is reported with the position it has been requested for, once per
+    unique position. Positions beyond the end of the media give the last frame.
+    When all the frames are reported, \l finished() is emitted.
+
+    A running extraction is cancelled.
+
+    \sa cancel(), frameExtracted(), imageExtracted()
+*/
+void QMediaFrameExtractor::extractFrames(const QList<qint64> &positions)
+{
+    Q_D(QMediaFrameExtractor);
+
+    if (!d->extractor)
+        return;
+
+    QList<qint64> sortedPositions;
+    sortedPositions.reserve(positions.size());
+    for (qint64 position : positions)
+        sortedPositions.push_back(std::max(position, qint64(0)));
+
+    std::sort(sortedPositions.begin(), sortedPositions.end());
+    sortedPositions.erase(std::unique(sortedPositions.begin(), sortedPositions.end()),
+                          sortedPositions.end());
+
+    d->extractor->clearError();
+    d->extractor->extractFrames(qMediaFromUserInput(d->source), sortedPositions, d->imageSize);
+}
+
+/*!
+    Cancels the running extraction. No more frames are reported for it, and
+    \l finished() is not emitted.
+*/
+void QMediaFrameExtractor::cancel()
+{
+    Q_D(QMediaFrameExtractor);
+
+    if (d->extractor)
+        d->extractor->cancel();
+}
+
+/*!
+    \fn void QMediaFrameExtractor::frameExtracted(qint64 position, const QVideoFrame &frame)
+
+    Signals that the \a frame shown at \a position, in milliseconds, has been decoded.
+    The frame is invalid if it could not be decoded.
+
+    The signal is emitted when the \l imageSize is invalid.
+*/
+
+/*!
+    \fn void QMediaFrameExtractor::imageExtracted(qint64 position, const QImage &image)
+
+    Signals that the frame shown at \a position, in milliseconds, has been decoded and
+    converted to \a image. The image is null if the frame could not be decoded.
+
+    The signal is emitted when the \l imageSize is valid.
+*/
+
+/*!
+    \fn void QMediaFrameExtractor::finished()
+
+    Signals that all the requested frames have been reported.
+*/
+
+/*!
+    \fn void QMediaFrameExtractor::errorOccurred(QMediaFrameExtractor::Error error, const QString &errorString)
+
+    Signals that the extraction failed with \a error, described by \a errorString.
+    No more frames are reported for the extraction.
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qmediaframeextractor.cpp"
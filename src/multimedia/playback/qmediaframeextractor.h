@@ -0,0 +1,69 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMEDIAFRAMEEXTRACTOR_H
+#define QMEDIAFRAMEEXTRACTOR_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qsize.h>
+#include <QtCore/qurl.h>
+#include <QtMultimedia/qtmultimediaglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QImage;
+class QVideoFrame;
+class QMediaFrameExtractorPrivate;
+
+class Q_MULTIMEDIA_EXPORT QMediaFrameExtractor : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(QSize imageSize READ imageSize WRITE setImageSize NOTIFY imageSizeChanged)
+    Q_PROPERTY(bool active READ isActive NOTIFY activeChanged)
+    Q_PROPERTY(Error error READ error NOTIFY errorChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY errorChanged)
+
+public:
+    enum Error { NoError, ResourceError, FormatError, AccessDeniedError, NotSupportedError };
+    Q_ENUM(Error)
+
+    explicit QMediaFrameExtractor(QObject *parent = nullptr);
+    ~QMediaFrameExtractor() override;
+
+    bool isSupported() const;
+
+    QUrl source() const;
+    void setSource(const QUrl &source);
+
+    QSize imageSize() const;
+    void setImageSize(const QSize &size);
+
+    bool isActive() const;
+
+    Error error() const;
+    QString errorString() const;
+
+public Q_SLOTS:
+    void extractFrames(const QList<qint64> &positions);
+    void cancel();
+
+Q_SIGNALS:
+    void sourceChanged();
+    void imageSizeChanged();
+    void activeChanged();
+    void errorChanged();
+    void errorOccurred(QMediaFrameExtractor::Error error, const QString &errorString);
+
+    void frameExtracted(qint64 position, const QVideoFrame &frame);
+    void imageExtracted(qint64 position, const QImage &image);
+    void finished();
+
+private:
+    Q_DISABLE_COPY(QMediaFrameExtractor)
+    Q_DECLARE_PRIVATE(QMediaFrameExtractor)
+};
+
+QT_END_NAMESPACE
+
+#endif // QMEDIAFRAMEEXTRACTOR_H
@@ -0,0 +1,40 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMEDIAFRAMEEXTRACTOR_P_H
+#define QMEDIAFRAMEEXTRACTOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qmediaframeextractor.h>
+#include <QtMultimedia/private/qplatformmediaframeextractor_p.h>
+#include <QtCore/private/qobject_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QMediaFrameExtractorPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QMediaFrameExtractor)
+
+public:
+    QMediaFrameExtractorPrivate() = default;
+
+    QUrl source;
+    QSize imageSize;
+    std::unique_ptr<QPlatformMediaFrameExtractor> extractor;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMEDIAFRAMEEXTRACTOR_P_H
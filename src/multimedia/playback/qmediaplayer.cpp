@@ -116,6 +116,10 @@ void QMediaPlayerPrivate::setStatus(QMediaPlayer::MediaStatus s)
     Q_Q(QMediaPlayer);
 
     emit q->mediaStatusChanged(s);
+
+    // The backend doesn't switch to the next source by itself
+    if (s == QMediaPlayer::EndOfMedia && !nextSource.isEmpty() && preloadedNextMedia.isEmpty())
+        QMetaObject::invokeMethod(q, [this] { playNextSource(); }, Qt::QueuedConnection);
 }
 
 void QMediaPlayerPrivate::setError(QMediaPlayer::Error error, const QString &errorString)
@@ -228,6 +232,58 @@ void QMediaPlayerPrivate::setMedia(const QUrl &media, QIODevice *stream)
     qrcFile.swap(file); // Cleans up any previous file
 }
 
+void QMediaPlayerPrivate::setNextMedia()
+{
+    preloadedNextMedia = QUrl();
+
+    if (!control)
+        return;
+
+    // Back ends can't preload qrc files, they are set as the source when the current one ends
+    const bool canPreload = !nextSource.isEmpty()
+            && (nextSource.scheme() != QLatin1String("qrc") || control->canPlayQrc());
+    const QUrl media = canPreload ? qMediaFromUserInput(nextSource) : QUrl();
+
+    if (control->setNextMedia(media))
+        preloadedNextMedia = media;
+}
+
+void QMediaPlayerPrivate::nextMediaStarted(const QUrl &media)
+{
+    Q_Q(QMediaPlayer);
+
+    // The next source might have been changed after the back end started switching to it
+    const bool isNextSource = media == preloadedNextMedia;
+
+    source = isNextSource ? std::exchange(nextSource, QUrl()) : media;
+    stream = nullptr;
+
+    // The back end has opened the next source itself; the file of the previous one is released
+    qrcMedia = QUrl();
+    qrcFile.reset();
+
+    if (isNextSource)
+        preloadedNextMedia = QUrl();
+
+    emit q->sourceChanged(source);
+
+    if (isNextSource)
+        emit q->nextSourceChanged(nextSource);
+}
+
+void QMediaPlayerPrivate::playNextSource()
+{
+    Q_Q(QMediaPlayer);
+
+    if (nextSource.isEmpty() || q->mediaStatus() != QMediaPlayer::EndOfMedia)
+        return;
+
+    const QUrl next = std::exchange(nextSource, QUrl());
+    q->setSource(next);
+    emit q->nextSourceChanged(nextSource);
+    q->play();
+}
+
 QList<QMediaMetaData> QMediaPlayerPrivate::trackMetaData(QPlatformMediaPlayer::TrackType s) const
 {
     QList<QMediaMetaData> tracks;
@@ -643,6 +699,7 @@ void QMediaPlayer::setSource(const QUrl &source)
     d->stream = nullptr;
 
     d->setMedia(source, nullptr);
+    d->setNextMedia();
     emit sourceChanged(d->source);
 }
 
@@ -672,9 +729,57 @@ void QMediaPlayer::setSourceDevice(QIODevice *device, const QUrl &sourceUrl)
     d->stream = device;
 
     d->setMedia(d->source, device);
+    d->setNextMedia();
     emit sourceChanged(d->source);
 }
 
+/*!
+    \qmlproperty url QtMultimedia::MediaPlayer::nextSource
+    \since 6.11
+
+    This property holds the source URL of the media to play when the current
+    \l source ends.
+
+    \sa QMediaPlayer::nextSource
+*/
+
+/*!
+    \property QMediaPlayer::nextSource
+    \since 6.11
+    \brief The source of the media to play when the current source ends.
+
+    When the playback of the current source reaches its end, including all its
+    \l loops, the player continues with the next source without stopping. The
+    \l source property changes to the next source, and \c nextSource is reset to
+    an empty URL. To play a sequence of media, set the following source when
+    sourceChanged() is emitted.
+
+    Media backends that support gapless playback open the next source and prepare its
+    decoders in the background, and switch to it at the end timestamp of the current
+    source without a gap. This requires both sources to have the same kinds of tracks;
+    otherwise, the next source is loaded when the current one ends, the same way as with
+    setSource(). The FFmpeg media backend supports gapless playback.
+
+    Setting the source with setSource() keeps the next source.
+*/
+QUrl QMediaPlayer::nextSource() const
+{
+    Q_D(const QMediaPlayer);
+    return d->nextSource;
+}
+
+void QMediaPlayer::setNextSource(const QUrl &source)
+{
+    Q_D(QMediaPlayer);
+
+    if (d->nextSource == source)
+        return;
+
+    d->nextSource = source;
+    d->setNextMedia();
+    emit nextSourceChanged(d->nextSource);
+}
+
 /*!
     \qmlproperty QAudioBufferOutput QtMultimedia::MediaPlayer::audioBufferOutput
     \since 6.8
@@ -1235,6 +1340,36 @@ void QMediaPlayer::resetPlaybackOptions()
         emit playbackOptionsChanged();
 }
 
+/*!
+    \qmlmethod playbackStatistics MediaPlayer::playbackStatistics()
+    \since 6.11
+
+    Returns a snapshot of the playback performance counters of the current source,
+    such as decoded, presented, and dropped video frames, audio underruns, and
+    buffered data. Poll it periodically, for example from a \l Timer, to monitor playback.
+
+    \sa PlaybackStatistics
+*/
+
+/*!
+    \since 6.11
+
+    Returns a snapshot of the playback performance counters of the current source,
+    such as decoded, presented, and dropped video frames, audio underruns, and
+    buffered data. Poll it periodically, for example from a QTimer, to monitor playback.
+
+    Counters are reset when a new source is set, and when the \l nextSource
+    starts playing. If the media backend doesn't provide statistics, all values
+    are zero.
+
+    \sa QPlaybackStatistics
+*/
+QPlaybackStatistics QMediaPlayer::playbackStatistics() const
+{
+    Q_D(const QMediaPlayer);
+    return d->control ? d->control->playbackStatistics() : QPlaybackStatistics{};
+}
+
 // Enums
 /*!
     \enum QMediaPlayer::PlaybackState
@@ -1357,6 +1492,15 @@ void QMediaPlayer::resetPlaybackOptions()
     Signals that the media source has been changed to \a media.
 */
 
+/*!
+    \fn void QMediaPlayer::nextSourceChanged(const QUrl &source);
+    \since 6.11
+
+    Signals that the next media source has been changed to \a source.
+
+    \sa nextSource
+*/
+
 /*!
     \fn void QMediaPlayer::playbackRateChanged(qreal rate);
 
@@ -18,6 +18,7 @@ class QMediaMetaData;
 class QMediaTimeRange;
 class QAudioBufferOutput;
 class QPlaybackOptions;
+class QPlaybackStatistics;
 
 class QMediaPlayerPrivate;
 class Q_MULTIMEDIA_EXPORT QMediaPlayer : public QObject
@@ -67,6 +68,9 @@ class Q_MULTIMEDIA_EXPORT QMediaPlayer : public QObject
     Q_PROPERTY(QPlaybackOptions playbackOptions READ playbackOptions WRITE setPlaybackOptions NOTIFY
                        playbackOptionsChanged RESET resetPlaybackOptions)
 
+    Q_REVISION(6, 11)
+    Q_PROPERTY(QUrl nextSource READ nextSource WRITE setNextSource NOTIFY nextSourceChanged)
+
 public:
     enum PlaybackState
     {
@@ -143,6 +147,7 @@ public:
 
     QUrl source() const;
     const QIODevice *sourceDevice() const;
+    QUrl nextSource() const;
 
     PlaybackState playbackState() const;
     MediaStatus mediaStatus() const;
@@ -175,6 +180,8 @@ public:
 
     QPlaybackOptions playbackOptions() const;
 
+    Q_REVISION(6, 11) Q_INVOKABLE QPlaybackStatistics playbackStatistics() const;
+
 public Q_SLOTS:
     void play();
     void pause();
@@ -186,6 +193,7 @@ public Q_SLOTS:
 
     void setSource(const QUrl &source);
     void setSourceDevice(QIODevice *device, const QUrl &sourceUrl = QUrl());
+    Q_REVISION(6, 11) void setNextSource(const QUrl &source);
 
     void setPitchCompensation(bool) const;
 
@@ -227,6 +235,9 @@ Q_SIGNALS:
     Q_REVISION(6, 10)
     void playbackOptionsChanged();
 
+    Q_REVISION(6, 11)
+    void nextSourceChanged(const QUrl &source);
+
 private:
     Q_DISABLE_COPY(QMediaPlayer)
     Q_DECLARE_PRIVATE(QMediaPlayer)
@@ -21,6 +21,7 @@
 #include "qaudiooutput.h"
 #include "qaudiobufferoutput.h"
 #include "qplaybackoptions.h"
+#include "qplaybackstatistics.h"
 #include <private/qplatformmediaplayer_p.h>
 #include <private/qerrorinfo_p.h>
 
@@ -58,6 +59,8 @@ public:
     std::unique_ptr<QFile> qrcFile;
     QUrl source;
     QIODevice *stream = nullptr;
+    QUrl nextSource;
+    QUrl preloadedNextMedia; // the next media passed to a backend that switches to it itself
     QPlaybackOptions playbackOptions;
 
     QMediaPlayer::PlaybackState state = QMediaPlayer::StoppedState;
@@ -65,6 +68,10 @@ public:
 
     void setMedia(const QUrl &media, QIODevice *stream = nullptr);
 
+    void setNextMedia();
+    void nextMediaStarted(const QUrl &media);
+    void playNextSource();
+
     QList<QMediaMetaData> trackMetaData(QPlatformMediaPlayer::TrackType s) const;
 
     void setState(QMediaPlayer::PlaybackState state);
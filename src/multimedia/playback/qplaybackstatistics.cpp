@@ -0,0 +1,170 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplaybackstatistics_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QPlaybackStatisticsPrivate)
+
+/*!
+    \class QPlaybackStatistics
+    \brief The QPlaybackStatistics class provides a snapshot of media playback performance.
+    \inmodule QtMultimedia
+    \ingroup multimedia
+    \ingroup multimedia_playback
+    \ingroup multimedia_video
+    \since 6.11
+
+    QPlaybackStatistics is returned by \l QMediaPlayer::playbackStatistics() and describes how
+    the media backend is performing: how many video frames have been decoded, presented, or
+    dropped, how long decoding takes, whether the audio output has run dry, how much data is
+    buffered ahead of the playback position, and how well audio and video are synchronized.
+
+    The counters accumulate from the moment a source is loaded and are reset when a new source
+    is set. Poll \l QMediaPlayer::playbackStatistics() periodically, for example from a timer,
+    to monitor playback.
+
+    Statistics rely on support in the media backend. The FFmpeg media backend provides all
+    values. The GStreamer media backend provides the video frame counters and the
+    synchronization offset, based on quality-of-service messages of the video sink;
+    other values are reported as zero.
+
+    \sa QMediaPlayer
+*/
+
+/*!
+    \qmltype PlaybackStatistics
+    \nativetype QPlaybackStatistics
+    \brief A snapshot of media playback performance.
+
+    \inqmlmodule QtMultimedia
+    \ingroup multimedia_qml
+    \ingroup multimedia_video_qml
+    \since 6.11
+
+    PlaybackStatistics is returned by \l MediaPlayer::playbackStatistics() and describes how
+    the media backend is performing.
+
+    \sa MediaPlayer
+*/
+
+/*!
+    \enum QPlaybackStatistics::StreamType
+    \since 6.11
+
+    Identifies the stream for the per-stream statistics.
+
+    \value Video The active video stream.
+    \value Audio The active audio stream.
+    \value Subtitle The active subtitle stream.
+*/
+
+QPlaybackStatistics::QPlaybackStatistics() : d{ new QPlaybackStatisticsPrivate } { }
+QPlaybackStatistics::QPlaybackStatistics(const QPlaybackStatistics &) = default;
+QPlaybackStatistics &QPlaybackStatistics::operator=(const QPlaybackStatistics &) = default;
+QPlaybackStatistics::~QPlaybackStatistics() = default;
+
+/*!
+    \property QPlaybackStatistics::decodedVideoFrames
+
+    The number of video frames that the decoder has produced.
+*/
+qint64 QPlaybackStatistics::decodedVideoFrames() const
+{
+    return d->decodedVideoFrames;
+}
+
+/*!
+    \property QPlaybackStatistics::presentedVideoFrames
+
+    The number of video frames that have been delivered to the video output.
+*/
+qint64 QPlaybackStatistics::presentedVideoFrames() const
+{
+    return d->presentedVideoFrames;
+}
+
+/*!
+    \property QPlaybackStatistics::droppedVideoFrames
+
+    The number of decoded video frames that have been discarded because they
+    were too late to be presented.
+*/
+qint64 QPlaybackStatistics::droppedVideoFrames() const
+{
+    return d->droppedVideoFrames;
+}
+
+/*!
+    \property QPlaybackStatistics::averageVideoDecodeTime
+
+    The average time that the decoder has spent per decoded video frame.
+*/
+std::chrono::microseconds QPlaybackStatistics::averageVideoDecodeTime() const
+{
+    return d->averageVideoDecodeTime;
+}
+
+/*!
+    \property QPlaybackStatistics::audioUnderruns
+
+    The number of times the audio output ran out of data during playback,
+    which is usually audible as a glitch.
+*/
+qint64 QPlaybackStatistics::audioUnderruns() const
+{
+    return d->audioUnderruns;
+}
+
+/*!
+    \property QPlaybackStatistics::audioVideoSyncOffset
+
+    The offset of the most recently presented video frame from the playback clock,
+    which follows the audio output if there is one. Positive values mean that
+    video is behind audio.
+*/
+std::chrono::microseconds QPlaybackStatistics::audioVideoSyncOffset() const
+{
+    return d->audioVideoSyncOffset;
+}
+
+/*!
+    \property QPlaybackStatistics::hardwareDecoding
+
+    This property is \c true if the active video stream is decoded with hardware acceleration.
+*/
+bool QPlaybackStatistics::hardwareDecoding() const
+{
+    return d->hardwareDecoding;
+}
+
+/*!
+    Returns the amount of compressed data, in bytes, that has been demuxed for
+    \a stream but not yet decoded.
+*/
+qint64 QPlaybackStatistics::bufferedBytes(StreamType stream) const
+{
+    return d->bufferedBytes[qToUnderlying(stream)];
+}
+
+/*!
+    Returns the duration of compressed data that has been demuxed for
+    \a stream but not yet decoded.
+*/
+std::chrono::microseconds QPlaybackStatistics::bufferedDuration(StreamType stream) const
+{
+    return d->bufferedDuration[qToUnderlying(stream)];
+}
+
+/*!
+    Returns the number of decoded frames of \a stream waiting to be rendered.
+*/
+int QPlaybackStatistics::renderQueueDepth(StreamType stream) const
+{
+    return d->renderQueueDepth[qToUnderlying(stream)];
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qplaybackstatistics.cpp"
@@ -0,0 +1,73 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLAYBACKSTATISTICS_H
+#define QPLAYBACKSTATISTICS_H
+
+#include <QtMultimedia/qtmultimediaexports.h>
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qshareddata.h>
+
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+class QPlaybackStatisticsPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR(QPlaybackStatisticsPrivate)
+
+class QPlaybackStatistics
+{
+    Q_GADGET_EXPORT(Q_MULTIMEDIA_EXPORT)
+    Q_PROPERTY(qint64 decodedVideoFrames READ decodedVideoFrames FINAL)
+    Q_PROPERTY(qint64 presentedVideoFrames READ presentedVideoFrames FINAL)
+    Q_PROPERTY(qint64 droppedVideoFrames READ droppedVideoFrames FINAL)
+    Q_PROPERTY(std::chrono::microseconds averageVideoDecodeTime READ averageVideoDecodeTime FINAL)
+    Q_PROPERTY(qint64 audioUnderruns READ audioUnderruns FINAL)
+    Q_PROPERTY(std::chrono::microseconds audioVideoSyncOffset READ audioVideoSyncOffset FINAL)
+    Q_PROPERTY(bool hardwareDecoding READ hardwareDecoding FINAL)
+    Q_CLASSINFO("RegisterEnumClassesUnscoped", "false")
+public:
+    enum class StreamType {
+        Video,
+        Audio,
+        Subtitle,
+    };
+    Q_ENUM(StreamType)
+
+    Q_MULTIMEDIA_EXPORT QPlaybackStatistics();
+    Q_MULTIMEDIA_EXPORT QPlaybackStatistics(const QPlaybackStatistics &);
+    Q_MULTIMEDIA_EXPORT QPlaybackStatistics &operator=(const QPlaybackStatistics &);
+    QPlaybackStatistics(QPlaybackStatistics &&) noexcept = default;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QPlaybackStatistics)
+    Q_MULTIMEDIA_EXPORT ~QPlaybackStatistics();
+
+    void swap(QPlaybackStatistics &other) noexcept { d.swap(other.d); }
+
+    Q_MULTIMEDIA_EXPORT qint64 decodedVideoFrames() const;
+    Q_MULTIMEDIA_EXPORT qint64 presentedVideoFrames() const;
+    Q_MULTIMEDIA_EXPORT qint64 droppedVideoFrames() const;
+    Q_MULTIMEDIA_EXPORT std::chrono::microseconds averageVideoDecodeTime() const;
+
+    Q_MULTIMEDIA_EXPORT qint64 audioUnderruns() const;
+
+    Q_MULTIMEDIA_EXPORT std::chrono::microseconds audioVideoSyncOffset() const;
+
+    Q_MULTIMEDIA_EXPORT bool hardwareDecoding() const;
+
+    Q_MULTIMEDIA_EXPORT Q_INVOKABLE qint64 bufferedBytes(QPlaybackStatistics::StreamType stream) const;
+    Q_MULTIMEDIA_EXPORT std::chrono::microseconds
+    bufferedDuration(QPlaybackStatistics::StreamType stream) const;
+    Q_MULTIMEDIA_EXPORT Q_INVOKABLE int
+    renderQueueDepth(QPlaybackStatistics::StreamType stream) const;
+
+private:
+    friend class QPlaybackStatisticsPrivate;
+    QExplicitlySharedDataPointer<QPlaybackStatisticsPrivate> d;
+};
+
+Q_DECLARE_SHARED(QPlaybackStatistics)
+
+QT_END_NAMESPACE
+
+#endif
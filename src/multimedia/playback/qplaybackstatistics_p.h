@@ -0,0 +1,53 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLAYBACKSTATISTICS_P_H
+#define QPLAYBACKSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qplaybackstatistics.h>
+
+#include <array>
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+class QPlaybackStatisticsPrivate : public QSharedData
+{
+public:
+    static constexpr int StreamTypeCount = 3;
+
+    // Used by media backends to fill in the statistics
+    static QPlaybackStatisticsPrivate *get(QPlaybackStatistics &statistics)
+    {
+        statistics.d.detach();
+        return statistics.d.data();
+    }
+
+    qint64 decodedVideoFrames = 0;
+    qint64 presentedVideoFrames = 0;
+    qint64 droppedVideoFrames = 0;
+    std::chrono::microseconds averageVideoDecodeTime{ 0 };
+    qint64 audioUnderruns = 0;
+    std::chrono::microseconds audioVideoSyncOffset{ 0 };
+    bool hardwareDecoding = false;
+
+    // Indexed by QPlaybackStatistics::StreamType
+    std::array<qint64, StreamTypeCount> bufferedBytes = {};
+    std::array<std::chrono::microseconds, StreamTypeCount> bufferedDuration = {};
+    std::array<int, StreamTypeCount> renderQueueDepth = {};
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLAYBACKSTATISTICS_P_H
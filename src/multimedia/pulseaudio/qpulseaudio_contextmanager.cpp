@@ -233,6 +233,8 @@ void QPulseAudioContextManager::sourceInfoCallback(pa_context *context, const pa
     QPulseAudioContextManager *pulseEngine = static_cast<QPulseAudioContextManager *>(userdata);
 
     if (isLast) {
+        // the source list is the last reply of the enumeration, see updateDevices()
+        pulseEngine->setInitialEnumerationDone();
         pa_threaded_mainloop_signal(pulseEngine->mainloop(), 0);
         return;
     }
@@ -331,29 +333,41 @@ void QPulseAudioContextManager::eventCallback(pa_context *context, pa_subscripti
     }
 }
 
-void QPulseAudioContextManager::contextStateCallbackInit(pa_context *context, void *userdata)
-{
-    Q_UNUSED(context);
-
-    if (Q_UNLIKELY(qLcPulseAudioEngine().isEnabled(QtDebugMsg)))
-        qCDebug(qLcPulseAudioEngine) << pa_context_get_state(context);
-
-    QPulseAudioContextManager *pulseEngine =
-            reinterpret_cast<QPulseAudioContextManager *>(userdata);
-    pa_threaded_mainloop_signal(pulseEngine->mainloop(), 0);
-}
-
 void QPulseAudioContextManager::contextStateCallback(pa_context *c, void *userdata)
 {
+    using namespace QPulseAudioInternal;
+
     QPulseAudioContextManager *self = reinterpret_cast<QPulseAudioContextManager *>(userdata);
     pa_context_state_t state = pa_context_get_state(c);
 
     if (Q_UNLIKELY(qLcPulseAudioEngine().isEnabled(QtDebugMsg)))
         qCDebug(qLcPulseAudioEngine) << state;
 
-    if (state == PA_CONTEXT_FAILED)
+    self->setContextState(state);
+
+    switch (state) {
+    case PA_CONTEXT_READY:
+        qCDebug(qLcPulseAudioEngine) << "Connection established.";
+        self->onContextReady();
+        break;
+
+    case PA_CONTEXT_FAILED:
+        qCritical() << "PulseAudioService: Connection failure:" << currentError(c);
+        self->setInitialEnumerationDone();
         QMetaObject::invokeMethod(self, &QPulseAudioContextManager::onContextFailed,
                                   Qt::QueuedConnection);
+        break;
+
+    case PA_CONTEXT_TERMINATED:
+        self->setInitialEnumerationDone();
+        break;
+
+    default:
+        break;
+    }
+
+    // wake up waitForContextReady()
+    pa_threaded_mainloop_signal(self->mainloop(), 0);
 }
 
 Q_GLOBAL_STATIC(QPulseAudioContextManager, pulseEngine);
@@ -371,12 +385,12 @@ QPulseAudioContextManager::~QPulseAudioContextManager()
 void QPulseAudioContextManager::prepare()
 {
     using namespace QPulseAudioInternal;
-    bool keepGoing = true;
-    bool ok = true;
 
     m_mainLoop.reset(pa_threaded_mainloop_new());
     if (m_mainLoop == nullptr) {
         qCritical() << "PulseAudioService: unable to create pulseaudio mainloop";
+        setContextState(PA_CONTEXT_FAILED);
+        setInitialEnumerationDone();
         return;
     }
 
@@ -386,6 +400,8 @@ void QPulseAudioContextManager::prepare()
     if (pa_threaded_mainloop_start(m_mainLoop.get()) != 0) {
         qCritical() << "PulseAudioService: unable to start pulseaudio mainloop";
         m_mainLoop = {};
+        setContextState(PA_CONTEXT_FAILED);
+        setInitialEnumerationDone();
         return;
     }
 
@@ -415,11 +431,16 @@ void QPulseAudioContextManager::prepare()
         qCritical() << "PulseAudioService: Unable to create new pulseaudio context";
         guard.unlock();
         m_mainLoop = {};
+        setContextState(PA_CONTEXT_FAILED);
+        setInitialEnumerationDone();
         onContextFailed();
         return;
     }
 
-    pa_context_set_state_callback(m_context.get(), contextStateCallbackInit, this);
+    // The connection is established asynchronously, so that a slow or missing server doesn't
+    // block the application. The devices are enumerated once the context is ready, and
+    // reported by audioOutputsChanged() and audioInputsChanged().
+    pa_context_set_state_callback(m_context.get(), contextStateCallback, this);
 
     if (pa_context_connect(m_context.get(), nullptr, static_cast<pa_context_flags_t>(0), nullptr)
         < 0) {
@@ -427,68 +448,30 @@ void QPulseAudioContextManager::prepare()
         m_context = {};
         guard.unlock();
         m_mainLoop = {};
+        setContextState(PA_CONTEXT_FAILED);
+        setInitialEnumerationDone();
         return;
     }
+}
 
-    pa_threaded_mainloop_wait(m_mainLoop.get());
-
-    while (keepGoing) {
-        switch (pa_context_get_state(m_context.get())) {
-        case PA_CONTEXT_CONNECTING:
-        case PA_CONTEXT_AUTHORIZING:
-        case PA_CONTEXT_SETTING_NAME:
-            break;
-
-        case PA_CONTEXT_READY:
-            qCDebug(qLcPulseAudioEngine) << "Connection established.";
-            keepGoing = false;
-            break;
-
-        case PA_CONTEXT_TERMINATED:
-            qCritical("PulseAudioService: Context terminated.");
-            keepGoing = false;
-            ok = false;
-            break;
-
-        case PA_CONTEXT_FAILED:
-        default:
-            qCritical() << "PulseAudioService: Connection failure:"
-                        << currentError(m_context.get());
-            keepGoing = false;
-            ok = false;
-        }
-
-        if (keepGoing)
-            pa_threaded_mainloop_wait(m_mainLoop.get());
-    }
-
-    if (ok) {
-        pa_context_set_state_callback(m_context.get(), contextStateCallback, this);
-
-        pa_context_set_subscribe_callback(m_context.get(), eventCallback, this);
-        PAOperationHandle op{
-            pa_context_subscribe(m_context.get(),
-                                 pa_subscription_mask_t(PA_SUBSCRIPTION_MASK_SINK
-                                                        | PA_SUBSCRIPTION_MASK_SOURCE
-                                                        | PA_SUBSCRIPTION_MASK_SERVER),
-                                 nullptr, nullptr),
-            PAOperationHandle::HasRef,
-        };
-
-        if (!op)
-            qWarning() << "PulseAudioService: failed to subscribe to context notifications";
-    } else {
-        m_context = {};
-    }
+void QPulseAudioContextManager::onContextReady()
+{
+    Q_ASSERT(isInMainLoop());
+
+    pa_context_set_subscribe_callback(m_context.get(), eventCallback, this);
+    PAOperationHandle op{
+        pa_context_subscribe(m_context.get(),
+                             pa_subscription_mask_t(PA_SUBSCRIPTION_MASK_SINK
+                                                    | PA_SUBSCRIPTION_MASK_SOURCE
+                                                    | PA_SUBSCRIPTION_MASK_SERVER),
+                             nullptr, nullptr),
+        PAOperationHandle::HasRef,
+    };
 
-    guard.unlock();
+    if (!op)
+        qWarning() << "PulseAudioService: failed to subscribe to context notifications";
 
-    if (ok) {
-        updateDevices();
-    } else {
-        m_mainLoop = {};
-        onContextFailed();
-    }
+    updateDevices();
 }
 
 void QPulseAudioContextManager::release()
@@ -503,32 +486,59 @@ void QPulseAudioContextManager::release()
         pa_threaded_mainloop_stop(m_mainLoop.get());
         m_mainLoop = {};
     }
+
+    setContextState(PA_CONTEXT_TERMINATED);
 }
 
 void QPulseAudioContextManager::updateDevices()
 {
-    std::lock_guard lock(*this);
+    Q_ASSERT(isInMainLoop());
+
+    // The server replies in the order of the requests, so the default devices are known
+    // when the sinks and sources are reported.
 
     // Get default input and output devices
-    bool success = waitForAsyncOperation(
-            pa_context_get_server_info(m_context.get(), serverInfoCallback, this));
+    PAOperationHandle serverInfo{
+        pa_context_get_server_info(m_context.get(), serverInfoCallback, this),
+        PAOperationHandle::HasRef,
+    };
 
-    if (!success)
+    if (!serverInfo)
         qWarning() << "PulseAudioService: failed to get server info";
 
     // Get output devices
-    success = waitForAsyncOperation(
-            pa_context_get_sink_info_list(m_context.get(), sinkInfoCallback, this));
+    PAOperationHandle sinkInfo{
+        pa_context_get_sink_info_list(m_context.get(), sinkInfoCallback, this),
+        PAOperationHandle::HasRef,
+    };
 
-    if (!success)
+    if (!sinkInfo)
         qWarning() << "PulseAudioService: failed to get sink info";
 
     // Get input devices
-    success = waitForAsyncOperation(
-            pa_context_get_source_info_list(m_context.get(), sourceInfoCallback, this));
+    PAOperationHandle sourceInfo{
+        pa_context_get_source_info_list(m_context.get(), sourceInfoCallback, this),
+        PAOperationHandle::HasRef,
+    };
 
-    if (!success)
+    if (!sourceInfo) {
         qWarning() << "PulseAudioService: failed to get source info";
+        setInitialEnumerationDone();
+    }
+}
+
+void QPulseAudioContextManager::setContextState(pa_context_state_t state)
+{
+    QMutexLocker locker(&m_startupMutex);
+    m_contextState = state;
+    m_contextStateChanged.wakeAll();
+}
+
+void QPulseAudioContextManager::setInitialEnumerationDone()
+{
+    QMutexLocker locker(&m_startupMutex);
+    m_initialEnumerationDone = true;
+    m_enumerationDone.wakeAll();
 }
 
 void QPulseAudioContextManager::onContextFailed()
@@ -586,7 +596,7 @@ QByteArray QPulseAudioContextManager::defaultDevice(QAudioDevice::Mode mode) con
 pa_context_state_t QPulseAudioContextManager::getContextState()
 {
     auto lock = std::lock_guard{ *this };
-    return pa_context_get_state(m_context.get());
+    return m_context ? pa_context_get_state(m_context.get()) : PA_CONTEXT_UNCONNECTED;
 }
 
 bool QPulseAudioContextManager::contextIsGood()
@@ -594,6 +604,32 @@ bool QPulseAudioContextManager::contextIsGood()
     return PA_CONTEXT_IS_GOOD(getContextState());
 }
 
+bool QPulseAudioContextManager::waitForContextReady(QDeadlineTimer deadline)
+{
+    Q_ASSERT(!isInMainLoop());
+
+    // pa_threaded_mainloop_wait() cannot time out, so the state is mirrored for waiting
+    QMutexLocker locker(&m_startupMutex);
+    while (m_contextState != PA_CONTEXT_READY && PA_CONTEXT_IS_GOOD(m_contextState)) {
+        if (!m_contextStateChanged.wait(&m_startupMutex, deadline))
+            break;
+    }
+    return m_contextState == PA_CONTEXT_READY;
+}
+
+bool QPulseAudioContextManager::waitForInitialEnumeration(QDeadlineTimer deadline) const
+{
+    if (isInMainLoop())
+        return false;
+
+    QMutexLocker locker(&m_startupMutex);
+    while (!m_initialEnumerationDone) {
+        if (!m_enumerationDone.wait(&m_startupMutex, deadline))
+            return false;
+    }
+    return true;
+}
+
 QString QPulseAudioContextManager::serverName()
 {
     QReadLocker locker(&pulseEngine->m_serverLock);
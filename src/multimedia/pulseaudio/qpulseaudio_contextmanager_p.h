@@ -17,8 +17,13 @@
 
 #include <QtCore/qmap.h>
 #include <QtCore/qbytearray.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qreadwritelock.h>
+#include <QtCore/qwaitcondition.h>
 #include <pulse/pulseaudio.h>
+
+#include <chrono>
 #include "qpulsehelpers_p.h"
 #include <qaudioformat.h>
 
@@ -71,6 +76,19 @@ public:
     pa_context_state_t getContextState();
     bool contextIsGood();
 
+    // Bounds how long the calling thread, typically the GUI thread, is blocked by the first
+    // device query or stream start while the server is still being connected. A responsive
+    // local server is connected within a few milliseconds.
+    static constexpr std::chrono::milliseconds startupTimeout{ 500 };
+
+    // The connection to the server is established asynchronously. Waits until the context
+    // is ready, has failed, or the deadline expires; returns true if it's ready.
+    bool waitForContextReady(QDeadlineTimer deadline);
+
+    // Waits until the devices have been enumerated for the first time, or until the
+    // connection has failed. Returns immediately when called on the mainloop thread.
+    bool waitForInitialEnumeration(QDeadlineTimer deadline) const;
+
     QString serverName();
 
 Q_SIGNALS:
@@ -89,10 +107,12 @@ private:
                                    void *userdata);
     static void eventCallback(pa_context *context, pa_subscription_event_type_t t, uint32_t index,
                               void *userdata);
-    static void contextStateCallbackInit(pa_context *context, void *userdata);
     static void contextStateCallback(pa_context *c, void *userdata);
 
+    void onContextReady();
     void updateDevices();
+    void setContextState(pa_context_state_t state);
+    void setInitialEnumerationDone();
     void release();
 
     QMap<int, QAudioDevice> m_sinks;
@@ -110,6 +130,13 @@ private:
     PAContextHandle m_context;
     bool m_prepared{};
 
+    // Guards the startup state, which is waited for without the mainloop lock
+    mutable QMutex m_startupMutex;
+    mutable QWaitCondition m_contextStateChanged;
+    mutable QWaitCondition m_enumerationDone;
+    pa_context_state_t m_contextState = PA_CONTEXT_UNCONNECTED;
+    bool m_initialEnumerationDone = false;
+
     QString m_serverName;
  };
 
@@ -9,8 +9,25 @@
 #include "qpulseaudiosink_p.h"
 #include "qpulseaudio_contextmanager_p.h"
 
+#include <QtCore/qdebug.h>
+
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+// The server is connected asynchronously. Queries made right at startup wait a bit for the
+// first enumeration, so that they don't see an empty device list; later changes are
+// reported by the change signals. A stalled server thus blocks the first query of the
+// calling thread, usually the GUI thread, for up to the startup timeout.
+void waitForInitialEnumeration(QPulseAudioContextManager *pulseEngine)
+{
+    if (!pulseEngine->waitForInitialEnumeration(
+                QDeadlineTimer(QPulseAudioContextManager::startupTimeout)))
+        qWarning() << "PulseAudioService: devices are not enumerated yet, the list is incomplete";
+}
+
+} // namespace
+
 QPulseAudioDevices::QPulseAudioDevices()
 {
     pulseEngine = new QPulseAudioContextManager();
@@ -30,11 +47,13 @@ QPulseAudioDevices::~QPulseAudioDevices()
 
 QList<QAudioDevice> QPulseAudioDevices::findAudioInputs() const
 {
+    waitForInitialEnumeration(pulseEngine);
     return pulseEngine->availableDevices(QAudioDevice::Input);
 }
 
 QList<QAudioDevice> QPulseAudioDevices::findAudioOutputs() const
 {
+    waitForInitialEnumeration(pulseEngine);
     return pulseEngine->availableDevices(QAudioDevice::Output);
 }
 
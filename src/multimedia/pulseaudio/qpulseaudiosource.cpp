@@ -293,7 +293,9 @@ QPulseAudioSource::QPulseAudioSource(QAudioDevice device, const QAudioFormat &fo
 bool QPulseAudioSource::validatePulseaudio()
 {
     QPulseAudioContextManager *pulseEngine = QPulseAudioContextManager::instance();
-    if (!pulseEngine->contextIsGood()) {
+    // the connection might still be in progress when the first stream is started
+    if (!pulseEngine->waitForContextReady(
+                QDeadlineTimer(QPulseAudioContextManager::startupTimeout))) {
         qWarning() << "Invalid PulseAudio context:" << pulseEngine->getContextState();
         setError(QtAudio::Error::FatalError);
         return false;
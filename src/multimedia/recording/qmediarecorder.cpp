@@ -514,6 +514,27 @@ QT_WARNING_POP
 
         if (settings.audioSampleRate() != d->encoderSettings.audioSampleRate())
             emit audioSampleRateChanged();
+
+        if (settings.muxingMode() != d->encoderSettings.muxingMode())
+            emit muxingModeChanged();
+
+        if (settings.videoEncoderThreading() != d->encoderSettings.videoEncoderThreading())
+            emit videoEncoderThreadingChanged();
+
+        if (settings.videoEncoderThreadCount() != d->encoderSettings.videoEncoderThreadCount())
+            emit videoEncoderThreadCountChanged();
+
+        if (settings.videoEncoderLookahead() != d->encoderSettings.videoEncoderLookahead())
+            emit videoEncoderLookaheadChanged();
+
+        if (settings.skipDuplicateVideoFrames() != d->encoderSettings.skipDuplicateVideoFrames())
+            emit skipDuplicateVideoFramesChanged();
+
+        if (settings.maxAudioQueueDuration() != d->encoderSettings.maxAudioQueueDuration())
+            emit maxAudioQueueDurationChanged();
+
+        if (settings.audioOverflowPolicy() != d->encoderSettings.audioOverflowPolicy())
+            emit audioOverflowPolicyChanged();
     }
 }
 /*!
@@ -747,6 +768,466 @@ void QMediaRecorder::setAutoStop(bool autoStop)
     emit autoStopChanged();
 }
 
+/*!
+    \enum QMediaRecorder::MuxingMode
+    \since 6.11
+
+    Enumerates the layouts the media recorder can write the output file with.
+
+    \value DefaultMuxing The container's standard layout. For MP4 and QuickTime files,
+           the index (\c moov atom) is written when the recording stops. Stopping may
+           take a while for long recordings, and the file is unplayable if the
+           recording is terminated abruptly.
+    \value FragmentedMuxing The media is written as a sequence of self-contained
+           fragments, starting a new fragment at every video key frame and at least
+           once per second. Stopping the recording takes constant time, and the file
+           stays playable up to the last complete fragment if the recording is
+           terminated abruptly.
+    \value CmafMuxing Like \c FragmentedMuxing, but the fragments are laid out as
+           CMAF (Common Media Application Format) segments, which can be served by
+           HLS and DASH players.
+
+    Only the MPEG-4 and QuickTime file formats support fragmented layouts;
+    other formats are always written with \c DefaultMuxing.
+*/
+
+/*!
+    \qmlproperty enumeration QtMultimedia::MediaRecorder::muxingMode
+    \since 6.11
+
+    This property holds the layout of the recorded file.
+
+    \sa QMediaRecorder::MuxingMode
+*/
+
+/*!
+    \property QMediaRecorder::muxingMode
+    \since 6.11
+
+    \brief the layout of the recorded file.
+
+    Defaults to \c DefaultMuxing. The value is applied when \l record() is called.
+
+    QMediaRecorder::muxingMode is only supported with the FFmpeg backend.
+
+    \sa MuxingMode
+*/
+QMediaRecorder::MuxingMode QMediaRecorder::muxingMode() const
+{
+    Q_D(const QMediaRecorder);
+    return d->encoderSettings.muxingMode();
+}
+
+/*!
+    \fn void QMediaRecorder::muxingModeChanged()
+    \since 6.11
+
+    Signals when the muxing mode changes.
+*/
+void QMediaRecorder::setMuxingMode(MuxingMode mode)
+{
+    Q_D(QMediaRecorder);
+    if (d->encoderSettings.muxingMode() == mode)
+        return;
+    d->encoderSettings.setMuxingMode(mode);
+    emit muxingModeChanged();
+}
+
+/*!
+    \enum QMediaRecorder::EncoderThreading
+    \since 6.11
+
+    Enumerates the ways a video encoder can spread its work across threads.
+
+    \value AutomaticThreading The encoder's default. If \l videoEncoderLookahead
+           is \c 0, slice threading is preferred.
+    \value FrameThreading Several frames are encoded in parallel. This gives the
+           best throughput, but every thread adds a frame of delay.
+    \value SliceThreading Every frame is split into slices, which are encoded in
+           parallel. This doesn't add any delay, but scales worse with the number
+           of threads and costs some compression efficiency.
+
+    Encoders that don't support the requested kind of threading use their default.
+*/
+
+/*!
+    \qmlproperty enumeration QtMultimedia::MediaRecorder::videoEncoderThreading
+    \since 6.11
+
+    This property holds the way the video encoder spreads its work across threads.
+
+    \sa QMediaRecorder::EncoderThreading
+*/
+
+/*!
+    \property QMediaRecorder::videoEncoderThreading
+    \since 6.11
+
+    \brief the way the video encoder spreads its work across threads.
+
+    Defaults to \c AutomaticThreading. The value is applied when \l record() is called.
+
+    QMediaRecorder::videoEncoderThreading is only supported with the FFmpeg backend,
+    and only affects software encoders.
+
+    \sa EncoderThreading, videoEncoderThreadCount
+*/
+QMediaRecorder::EncoderThreading QMediaRecorder::videoEncoderThreading() const
+{
+    Q_D(const QMediaRecorder);
+    return d->encoderSettings.videoEncoderThreading();
+}
+
+/*!
+    \fn void QMediaRecorder::videoEncoderThreadingChanged()
+    \since 6.11
+
+    Signals when the video encoder threading changes.
+*/
+void QMediaRecorder::setVideoEncoderThreading(EncoderThreading threading)
+{
+    Q_D(QMediaRecorder);
+    if (d->encoderSettings.videoEncoderThreading() == threading)
+        return;
+    d->encoderSettings.setVideoEncoderThreading(threading);
+    emit videoEncoderThreadingChanged();
+}
+
+/*!
+    \qmlproperty int QtMultimedia::MediaRecorder::videoEncoderThreadCount
+    \since 6.11
+
+    This property holds the number of threads the video encoder uses.
+    \c 0 lets the encoder choose, based on the number of CPU cores.
+*/
+
+/*!
+    \property QMediaRecorder::videoEncoderThreadCount
+    \since 6.11
+
+    \brief the number of threads the video encoder uses.
+
+    Defaults to \c 0, which lets the encoder choose, based on the number of CPU cores.
+    The value is applied when \l record() is called.
+
+    QMediaRecorder::videoEncoderThreadCount is only supported with the FFmpeg backend,
+    and only affects software encoders.
+
+    \sa videoEncoderThreading
+*/
+int QMediaRecorder::videoEncoderThreadCount() const
+{
+    Q_D(const QMediaRecorder);
+    return d->encoderSettings.videoEncoderThreadCount();
+}
+
+/*!
+    \fn void QMediaRecorder::videoEncoderThreadCountChanged()
+    \since 6.11
+
+    Signals when the number of video encoder threads changes.
+*/
+void QMediaRecorder::setVideoEncoderThreadCount(int threadCount)
+{
+    Q_D(QMediaRecorder);
+    threadCount = qMax(threadCount, 0);
+    if (d->encoderSettings.videoEncoderThreadCount() == threadCount)
+        return;
+    d->encoderSettings.setVideoEncoderThreadCount(threadCount);
+    emit videoEncoderThreadCountChanged();
+}
+
+/*!
+    \qmlproperty int QtMultimedia::MediaRecorder::videoEncoderLookahead
+    \since 6.11
+
+    This property holds the maximum number of frames the video encoder may look
+    ahead. \c -1 keeps the encoder's default, and \c 0 selects the low-latency mode.
+
+    \sa QMediaRecorder::videoEncoderLookahead
+*/
+
+/*!
+    \property QMediaRecorder::videoEncoderLookahead
+    \since 6.11
+
+    \brief the maximum number of frames the video encoder may look ahead.
+
+    Encoders buffer frames to plan the bit rate and the frame types. This improves
+    compression, but delays the output by the number of buffered frames.
+
+    Defaults to \c -1, which keeps the encoder's default. \c 0 selects the low-latency
+    mode: no B-frames, no lookahead and no frame threading, so that every frame
+    is output as soon as it has been encoded. This suits live streaming and
+    screen recording, at the expense of compression efficiency.
+    The value is applied when \l record() is called.
+
+    QMediaRecorder::videoEncoderLookahead is only supported with the FFmpeg backend,
+    and the libx264, libx265, libvpx, libaom and NVENC encoders.
+
+    \sa videoEncoderThreading
+*/
+int QMediaRecorder::videoEncoderLookahead() const
+{
+    Q_D(const QMediaRecorder);
+    return d->encoderSettings.videoEncoderLookahead();
+}
+
+/*!
+    \fn void QMediaRecorder::videoEncoderLookaheadChanged()
+    \since 6.11
+
+    Signals when the maximum video encoder lookahead changes.
+*/
+void QMediaRecorder::setVideoEncoderLookahead(int frames)
+{
+    Q_D(QMediaRecorder);
+    frames = qMax(frames, -1);
+    if (d->encoderSettings.videoEncoderLookahead() == frames)
+        return;
+    d->encoderSettings.setVideoEncoderLookahead(frames);
+    emit videoEncoderLookaheadChanged();
+}
+
+/*!
+    \qmlproperty bool QtMultimedia::MediaRecorder::skipDuplicateVideoFrames
+    \since 6.11
+
+    This property holds whether video frames identical to the previous one are
+    skipped instead of being encoded.
+
+    \sa QMediaRecorder::skipDuplicateVideoFrames
+*/
+
+/*!
+    \property QMediaRecorder::skipDuplicateVideoFrames
+    \since 6.11
+
+    \brief whether video frames identical to the previous one are skipped instead
+    of being encoded.
+
+    Static content, like a desktop in a screen recording or slides sent via
+    \l QVideoFrameInput, often produces long runs of identical frames. If this
+    property is \c true, such frames are not encoded; the previous frame is
+    shown until the content changes, which makes the video stream variable
+    frame rate. The last frame of the recording is always encoded, so that the
+    duration is kept.
+
+    Detecting duplicates requires reading every frame that has been mapped to
+    CPU memory, and frames in GPU memory are never skipped. Keep this disabled if
+    the frames are expected to change, or if every frame must be in the output
+    with its timestamp.
+
+    Defaults to \c false. The value is applied when \l record() is called.
+
+    QMediaRecorder::skipDuplicateVideoFrames is only supported with the FFmpeg backend.
+
+    \sa skippedVideoFrameCount
+*/
+bool QMediaRecorder::skipDuplicateVideoFrames() const
+{
+    Q_D(const QMediaRecorder);
+    return d->encoderSettings.skipDuplicateVideoFrames();
+}
+
+/*!
+    \fn void QMediaRecorder::skipDuplicateVideoFramesChanged()
+    \since 6.11
+
+    Signals when skipping duplicate video frames is enabled or disabled.
+*/
+void QMediaRecorder::setSkipDuplicateVideoFrames(bool skip)
+{
+    Q_D(QMediaRecorder);
+    if (d->encoderSettings.skipDuplicateVideoFrames() == skip)
+        return;
+    d->encoderSettings.setSkipDuplicateVideoFrames(skip);
+    emit skipDuplicateVideoFramesChanged();
+}
+
+/*!
+    \qmlproperty qint64 QtMultimedia::MediaRecorder::skippedVideoFrameCount
+    \since 6.11
+
+    This property holds the number of video frames of the current or last
+    recording that have been skipped as duplicates.
+
+    \sa skipDuplicateVideoFrames
+*/
+
+/*!
+    \property QMediaRecorder::skippedVideoFrameCount
+    \since 6.11
+
+    \brief the number of video frames of the current or last recording that have
+    been skipped as duplicates.
+
+    The count is reset when \l record() is called.
+
+    \sa skipDuplicateVideoFrames
+*/
+qint64 QMediaRecorder::skippedVideoFrameCount() const
+{
+    Q_D(const QMediaRecorder);
+    return d->control ? d->control->skippedVideoFrameCount() : 0;
+}
+
+/*!
+    \fn void QMediaRecorder::skippedVideoFrameCountChanged(qint64 count)
+    \since 6.11
+
+    Signals that the number of skipped duplicate video frames has changed to \a count.
+*/
+
+/*!
+    \enum QMediaRecorder::AudioOverflowPolicy
+    \since 6.11
+
+    Enumerates what happens to the audio of an audio input when the encoder cannot
+    keep up with it, and the audio queued for encoding reaches
+    \l maxAudioQueueDuration.
+
+    \value BlockOnAudioOverflow The audio input waits briefly for the encoder. If the
+           queue is still full, the audio is dropped.
+    \value DropOnAudioOverflow The audio is dropped right away.
+    \value ErrorOnAudioOverflow The audio is dropped, and the recorder reports a
+           \l ResourceError.
+
+    Dropped audio is replaced by silence of the same duration, so that audio and video
+    stay in sync. The total duration is reported by \l droppedAudioDuration.
+*/
+
+/*!
+    \qmlproperty int QtMultimedia::MediaRecorder::maxAudioQueueDuration
+    \since 6.11
+
+    This property holds the maximum duration, in milliseconds, of the audio queued
+    for encoding. \c -1 selects the backend's default.
+
+    \sa QMediaRecorder::maxAudioQueueDuration
+*/
+
+/*!
+    \property QMediaRecorder::maxAudioQueueDuration
+    \since 6.11
+
+    \brief the maximum duration, in milliseconds, of the audio queued for encoding.
+
+    Audio inputs deliver audio in real time. If the encoder falls behind, the audio
+    is queued until this duration is reached, then \l audioOverflowPolicy applies.
+    A longer queue bridges longer encoder stalls at the expense of memory.
+
+    Defaults to \c -1, which selects the backend's default of 5 seconds.
+    The value is applied when \l record() is called.
+
+    QMediaRecorder::maxAudioQueueDuration is only supported with the FFmpeg backend.
+
+    \sa audioOverflowPolicy, droppedAudioDuration
+*/
+int QMediaRecorder::maxAudioQueueDuration() const
+{
+    Q_D(const QMediaRecorder);
+    return d->encoderSettings.maxAudioQueueDuration();
+}
+
+/*!
+    \fn void QMediaRecorder::maxAudioQueueDurationChanged()
+    \since 6.11
+
+    Signals when the maximum duration of the queued audio changes.
+*/
+void QMediaRecorder::setMaxAudioQueueDuration(int milliseconds)
+{
+    Q_D(QMediaRecorder);
+    if (milliseconds <= 0)
+        milliseconds = -1;
+    if (d->encoderSettings.maxAudioQueueDuration() == milliseconds)
+        return;
+    d->encoderSettings.setMaxAudioQueueDuration(milliseconds);
+    emit maxAudioQueueDurationChanged();
+}
+
+/*!
+    \qmlproperty enumeration QtMultimedia::MediaRecorder::audioOverflowPolicy
+    \since 6.11
+
+    This property holds what happens to the audio when the audio queued for
+    encoding reaches \l maxAudioQueueDuration.
+
+    \sa QMediaRecorder::AudioOverflowPolicy
+*/
+
+/*!
+    \property QMediaRecorder::audioOverflowPolicy
+    \since 6.11
+
+    \brief what happens to the audio when the audio queued for encoding reaches
+    \l maxAudioQueueDuration.
+
+    Defaults to \c BlockOnAudioOverflow. The audio input is blocked for a few
+    milliseconds at most, so that the audio device doesn't overrun.
+    The value is applied when \l record() is called.
+
+    QMediaRecorder::audioOverflowPolicy is only supported with the FFmpeg backend.
+
+    \sa AudioOverflowPolicy, droppedAudioDuration
+*/
+QMediaRecorder::AudioOverflowPolicy QMediaRecorder::audioOverflowPolicy() const
+{
+    Q_D(const QMediaRecorder);
+    return d->encoderSettings.audioOverflowPolicy();
+}
+
+/*!
+    \fn void QMediaRecorder::audioOverflowPolicyChanged()
+    \since 6.11
+
+    Signals when the audio overflow policy changes.
+*/
+void QMediaRecorder::setAudioOverflowPolicy(AudioOverflowPolicy policy)
+{
+    Q_D(QMediaRecorder);
+    if (d->encoderSettings.audioOverflowPolicy() == policy)
+        return;
+    d->encoderSettings.setAudioOverflowPolicy(policy);
+    emit audioOverflowPolicyChanged();
+}
+
+/*!
+    \qmlproperty qint64 QtMultimedia::MediaRecorder::droppedAudioDuration
+    \since 6.11
+
+    This property holds the duration, in milliseconds, of the audio of the current
+    or last recording that has been dropped because the encoder could not keep up.
+
+    \sa audioOverflowPolicy
+*/
+
+/*!
+    \property QMediaRecorder::droppedAudioDuration
+    \since 6.11
+
+    \brief the duration, in milliseconds, of the audio of the current or last
+    recording that has been dropped because the encoder could not keep up.
+
+    The duration is reset when \l record() is called. It is updated together
+    with \l duration while recording.
+
+    \sa audioOverflowPolicy, maxAudioQueueDuration
+*/
+qint64 QMediaRecorder::droppedAudioDuration() const
+{
+    Q_D(const QMediaRecorder);
+    return d->control ? d->control->droppedAudioDuration() : 0;
+}
+
+/*!
+    \fn void QMediaRecorder::droppedAudioDurationChanged(qint64 duration)
+    \since 6.11
+
+    Signals that the duration of the dropped audio has changed to \a duration.
+*/
+
 /*!
     \qmlsignal QtMultimedia::MediaRecorder::metaDataChanged()
 
@@ -37,6 +37,15 @@ class Q_MULTIMEDIA_EXPORT QMediaRecorder : public QObject
     Q_PROPERTY(int audioChannelCount READ audioChannelCount WRITE setAudioChannelCount NOTIFY audioChannelCountChanged)
     Q_PROPERTY(int audioSampleRate READ audioSampleRate WRITE setAudioSampleRate NOTIFY audioSampleRateChanged)
     Q_PROPERTY(bool autoStop READ autoStop WRITE setAutoStop NOTIFY autoStopChanged REVISION(6, 8))
+    Q_PROPERTY(QMediaRecorder::MuxingMode muxingMode READ muxingMode WRITE setMuxingMode NOTIFY muxingModeChanged REVISION(6, 11))
+    Q_PROPERTY(QMediaRecorder::EncoderThreading videoEncoderThreading READ videoEncoderThreading WRITE setVideoEncoderThreading NOTIFY videoEncoderThreadingChanged REVISION(6, 11))
+    Q_PROPERTY(int videoEncoderThreadCount READ videoEncoderThreadCount WRITE setVideoEncoderThreadCount NOTIFY videoEncoderThreadCountChanged REVISION(6, 11))
+    Q_PROPERTY(int videoEncoderLookahead READ videoEncoderLookahead WRITE setVideoEncoderLookahead NOTIFY videoEncoderLookaheadChanged REVISION(6, 11))
+    Q_PROPERTY(bool skipDuplicateVideoFrames READ skipDuplicateVideoFrames WRITE setSkipDuplicateVideoFrames NOTIFY skipDuplicateVideoFramesChanged REVISION(6, 11))
+    Q_PROPERTY(qint64 skippedVideoFrameCount READ skippedVideoFrameCount NOTIFY skippedVideoFrameCountChanged REVISION(6, 11))
+    Q_PROPERTY(int maxAudioQueueDuration READ maxAudioQueueDuration WRITE setMaxAudioQueueDuration NOTIFY maxAudioQueueDurationChanged REVISION(6, 11))
+    Q_PROPERTY(QMediaRecorder::AudioOverflowPolicy audioOverflowPolicy READ audioOverflowPolicy WRITE setAudioOverflowPolicy NOTIFY audioOverflowPolicyChanged REVISION(6, 11))
+    Q_PROPERTY(qint64 droppedAudioDuration READ droppedAudioDuration NOTIFY droppedAudioDurationChanged REVISION(6, 11))
 public:
     enum Quality
     {
@@ -57,6 +66,30 @@ public:
     };
     Q_ENUM(EncodingMode)
 
+    enum MuxingMode
+    {
+        DefaultMuxing,
+        FragmentedMuxing,
+        CmafMuxing
+    };
+    Q_ENUM(MuxingMode)
+
+    enum EncoderThreading
+    {
+        AutomaticThreading,
+        FrameThreading,
+        SliceThreading
+    };
+    Q_ENUM(EncoderThreading)
+
+    enum AudioOverflowPolicy
+    {
+        BlockOnAudioOverflow,
+        DropOnAudioOverflow,
+        ErrorOnAudioOverflow
+    };
+    Q_ENUM(AudioOverflowPolicy)
+
     enum RecorderState
     {
         StoppedState,
@@ -130,6 +163,29 @@ public:
     bool autoStop() const;
     void setAutoStop(bool autoStop);
 
+    MuxingMode muxingMode() const;
+    void setMuxingMode(MuxingMode mode);
+
+    EncoderThreading videoEncoderThreading() const;
+    void setVideoEncoderThreading(EncoderThreading threading);
+
+    int videoEncoderThreadCount() const;
+    void setVideoEncoderThreadCount(int threadCount);
+
+    int videoEncoderLookahead() const;
+    void setVideoEncoderLookahead(int frames);
+
+    bool skipDuplicateVideoFrames() const;
+    void setSkipDuplicateVideoFrames(bool skip);
+    qint64 skippedVideoFrameCount() const;
+
+    int maxAudioQueueDuration() const;
+    void setMaxAudioQueueDuration(int milliseconds);
+
+    AudioOverflowPolicy audioOverflowPolicy() const;
+    void setAudioOverflowPolicy(AudioOverflowPolicy policy);
+    qint64 droppedAudioDuration() const;
+
     QMediaCaptureSession *captureSession() const;
     QPlatformMediaRecorder *platformRecoder() const;
 
@@ -163,6 +219,15 @@ Q_SIGNALS:
     void audioChannelCountChanged();
     void audioSampleRateChanged();
     Q_REVISION(6, 8) void autoStopChanged();
+    Q_REVISION(6, 11) void muxingModeChanged();
+    Q_REVISION(6, 11) void videoEncoderThreadingChanged();
+    Q_REVISION(6, 11) void videoEncoderThreadCountChanged();
+    Q_REVISION(6, 11) void videoEncoderLookaheadChanged();
+    Q_REVISION(6, 11) void skipDuplicateVideoFramesChanged();
+    Q_REVISION(6, 11) void skippedVideoFrameCountChanged(qint64 count);
+    Q_REVISION(6, 11) void maxAudioQueueDurationChanged();
+    Q_REVISION(6, 11) void audioOverflowPolicyChanged();
+    Q_REVISION(6, 11) void droppedAudioDurationChanged(qint64 duration);
 
 private:
     QMediaRecorderPrivate *d_ptr;
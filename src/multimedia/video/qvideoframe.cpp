@@ -11,6 +11,8 @@
 #include "qimagevideobuffer_p.h"
 #include "qpainter.h"
 #include <qtextlayout.h>
+#include <qthread.h>
+#include <qcoreapplication.h>
 
 #include <qimage.h>
 #include <qsize.h>
@@ -19,6 +21,9 @@
 
 #include <QDebug>
 
+#include <array>
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QVideoFramePrivate);
@@ -563,6 +568,7 @@ bool QVideoFrame::map(QVideoFrame::MapMode mode)
     if ((mode & QVideoFrame::WriteOnly) != 0) {
         QMutexLocker lock(&d->imageMutex);
         d->image = {};
+        d->paintImage = {};
     }
 
     return true;
@@ -883,6 +889,91 @@ void QVideoFrame::setSubtitleText(const QString &text)
     d->subtitleText = text;
 }
 
+namespace {
+
+// Frames show the same subtitles for many seconds, so the layouts of the recently
+// painted ones are kept.
+class SubtitleLayoutCache
+{
+public:
+    SubtitleLayoutCache();
+
+    const QVideoTextureHelper::SubtitleLayout &layout(const QSize &videoSize, QString text)
+    {
+        text.replace(QLatin1Char('\n'), QChar::LineSeparator);
+
+        for (const auto &entry : m_layouts) {
+            if (entry && entry->videoSize == videoSize && entry->layout.text() == text)
+                return *entry;
+        }
+
+        auto &entry = m_layouts[m_next];
+        m_next = (m_next + 1) % m_layouts.size();
+
+        entry.emplace();
+        entry->update(videoSize, std::move(text));
+        return *entry;
+    }
+
+private:
+    std::array<std::optional<QVideoTextureHelper::SubtitleLayout>, 4> m_layouts;
+    size_t m_next = 0;
+};
+
+Q_CONSTINIT thread_local std::optional<SubtitleLayoutCache> g_subtitleLayoutCache;
+
+SubtitleLayoutCache::SubtitleLayoutCache()
+{
+    if (QThread::isMainThread()) {
+        // ensure cleanup in qApp dtor, the fonts must not outlive it
+        qAddPostRoutine([] {
+            g_subtitleLayoutCache.reset();
+        });
+    }
+}
+
+const QVideoTextureHelper::SubtitleLayout &cachedSubtitleLayout(const QSize &videoSize,
+                                                               const QString &text)
+{
+    if (!g_subtitleLayoutCache)
+        g_subtitleLayoutCache.emplace();
+    return g_subtitleLayoutCache->layout(videoSize, text);
+}
+
+// Converts the frame straight into the size of the device pixels it covers if it's scaled
+// down, instead of converting it at full resolution and letting QPainter scale it.
+// The result is cached in the frame for repeated paints of the same size.
+QImage scaledImageForPainting(const QVideoFrame &frame, QVideoFramePrivate &d,
+                              const QPainter &painter, const QSizeF &size,
+                              const VideoTransformation &transformation)
+{
+    const QTransform &deviceTransform = painter.deviceTransform();
+    if (deviceTransform.type() > QTransform::TxScale)
+        return {};
+
+    QSize deviceSize = deviceTransform.mapRect(QRectF({}, size)).size().toSize();
+
+    // Leave the last scaling step to QPainter if it interpolates
+    if (painter.testRenderHint(QPainter::SmoothPixmapTransform))
+        deviceSize *= 2;
+
+    const QSize frameSize = qRotatedFramePresentationSize(frame);
+    deviceSize = deviceSize.boundedTo(frameSize);
+    if (deviceSize.isEmpty() || deviceSize == frameSize)
+        return {};
+
+    QMutexLocker lock(&d.imageMutex);
+
+    if (d.paintImage.size() != deviceSize || d.paintImageTransformation != transformation) {
+        d.paintImage = qScaledImageFromVideoFrame(frame, transformation, deviceSize);
+        d.paintImageTransformation = transformation;
+    }
+
+    return d.paintImage;
+}
+
+} // namespace
+
 /*!
     Uses a QPainter, \a{painter}, to render this QVideoFrame to \a rect.
     The PaintOptions \a options can be used to specify a background color and
@@ -936,11 +1027,17 @@ void QVideoFrame::paint(QPainter *painter, const QRectF &rect, const PaintOption
 
         const bool hasPresentationTransformation =
                 d->presentationTransformation != VideoTransformation{};
+        const VideoTransformation transformation = hasPresentationTransformation
+                ? qNormalizedFrameTransformation(*this)
+                : qNormalizedSurfaceTransformation(d->format);
+
+        QImage image = scaledImageForPainting(*this, *d, *painter, size, transformation);
 
         // Use cache for images without presentation transform
-        const QImage image = hasPresentationTransformation
-                ? qImageFromVideoFrame(*this, qNormalizedFrameTransformation(*this))
-                : toImage();
+        if (image.isNull()) {
+            image = hasPresentationTransformation ? qImageFromVideoFrame(*this, transformation)
+                                                  : toImage();
+        }
 
         painter->drawImage({{}, size}, image, {{},image.size()});
         painter->setTransform(oldTransform);
@@ -956,12 +1053,8 @@ void QVideoFrame::paint(QPainter *painter, const QRectF &rect, const PaintOption
         return;
 
     // draw subtitles
-    auto text = d->subtitleText;
-    text.replace(QLatin1Char('\n'), QChar::LineSeparator);
-
-    QVideoTextureHelper::SubtitleLayout layout;
-    layout.update(targetRect.size().toSize(), this->subtitleText());
-    layout.draw(painter, targetRect.topLeft());
+    cachedSubtitleLayout(targetRect.size().toSize(), d->subtitleText)
+            .draw(painter, targetRect.topLeft());
 }
 
 #ifndef QT_NO_DEBUG_STREAM
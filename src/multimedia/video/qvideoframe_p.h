@@ -20,6 +20,9 @@
 #include "private/qvideotransformation_p.h"
 
 #include <qmutex.h>
+#include <qregion.h>
+
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -71,6 +74,19 @@ public:
         return frame.d ? frame.d->videoBuffer.get() : nullptr;
     }
 
+    // The region that changed since the frame with the previous sequence number
+    // of the same source. Only set by sources that know it, e.g. screen capture.
+    struct Damage
+    {
+        quint64 sequence = 0;
+        QRegion region;
+    };
+
+    static std::optional<Damage> damage(const QVideoFrame &frame)
+    {
+        return frame.d ? frame.d->damage : std::nullopt;
+    }
+
     QVideoFrame adoptThisByVideoFrame()
     {
         QVideoFrame frame;
@@ -89,8 +105,11 @@ public:
     QMutex mapMutex;
     QString subtitleText;
     QImage image;
+    QImage paintImage; // scaled to the size painted by QVideoFrame::paint
+    VideoTransformation paintImageTransformation;
     QMutex imageMutex;
     VideoTransformation presentationTransformation;
+    std::optional<Damage> damage;
 
 private:
     Q_DISABLE_COPY(QVideoFramePrivate)
@@ -4,6 +4,8 @@
 #include "qvideoframeconversionhelper_p.h"
 #include "qrgb.h"
 
+#include <QtCore/qvarlengtharray.h>
+
 #include <mutex>
 
 QT_BEGIN_NAMESPACE
@@ -575,6 +577,192 @@ VideoFrameConvertFunc qConverterForFormat(QVideoFrameFormat::PixelFormat format)
     return convert;
 }
 
+// Source coordinates of the centers of the target pixels, for nearest neighbour sampling
+static QVarLengthArray<int, 1024> scaledCoordinates(int sourceSize, int targetSize)
+{
+    QVarLengthArray<int, 1024> result(targetSize);
+    for (int i = 0; i < targetSize; ++i)
+        result[i] = int((2 * qint64(i) + 1) * sourceSize / (2 * qint64(targetSize)));
+    return result;
+}
+
+static inline void scaledPlanarYUV_to_ARGB32(const uchar *y, int yStride,
+                                             const uchar *u, int uStride,
+                                             const uchar *v, int vStride,
+                                             int uvPixelStride, int uvVerticalShift,
+                                             quint32 *rgb,
+                                             int width, int height, QSize outputSize)
+{
+    const auto columns = scaledCoordinates(width, outputSize.width());
+    const auto rows = scaledCoordinates(height, outputSize.height());
+
+    for (int j : rows) {
+        const uchar *lineY = y + j * yStride;
+        const uchar *lineU = u + (j >> uvVerticalShift) * uStride;
+        const uchar *lineV = v + (j >> uvVerticalShift) * vStride;
+
+        for (int i : columns) {
+            const int uvOffset = (i >> 1) * uvPixelStride;
+            EXPAND_UV(lineU[uvOffset], lineV[uvOffset]);
+            *rgb++ = qYUVToARGB32(lineY[i], rv, guv, bu);
+        }
+    }
+}
+
+static inline void scaledPackedYUV422_to_ARGB32(const uchar *src, int stride,
+                                                int yOffset, int uOffset, int vOffset,
+                                                quint32 *rgb,
+                                                int width, int height, QSize outputSize)
+{
+    const auto columns = scaledCoordinates(width, outputSize.width());
+    const auto rows = scaledCoordinates(height, outputSize.height());
+
+    for (int j : rows) {
+        const uchar *line = src + j * stride;
+
+        for (int i : columns) {
+            const uchar *macroPixel = line + (i >> 1) * 4;
+            EXPAND_UV(macroPixel[uOffset], macroPixel[vOffset]);
+            *rgb++ = qYUVToARGB32(macroPixel[yOffset + (i & 1) * 2], rv, guv, bu);
+        }
+    }
+}
+
+static void QT_FASTCALL qt_scaled_convert_YUV420P_to_ARGB32(const QVideoFrame &frame,
+                                                            uchar *output, QSize outputSize)
+{
+    FETCH_INFO_TRIPLANAR(frame)
+    scaledPlanarYUV_to_ARGB32(plane1, plane1Stride,
+                              plane2, plane2Stride,
+                              plane3, plane3Stride,
+                              1, 1,
+                              reinterpret_cast<quint32 *>(output),
+                              width, height, outputSize);
+}
+
+static void QT_FASTCALL qt_scaled_convert_YUV422P_to_ARGB32(const QVideoFrame &frame,
+                                                            uchar *output, QSize outputSize)
+{
+    FETCH_INFO_TRIPLANAR(frame)
+    scaledPlanarYUV_to_ARGB32(plane1, plane1Stride,
+                              plane2, plane2Stride,
+                              plane3, plane3Stride,
+                              1, 0,
+                              reinterpret_cast<quint32 *>(output),
+                              width, height, outputSize);
+}
+
+static void QT_FASTCALL qt_scaled_convert_YV12_to_ARGB32(const QVideoFrame &frame,
+                                                         uchar *output, QSize outputSize)
+{
+    FETCH_INFO_TRIPLANAR(frame)
+    scaledPlanarYUV_to_ARGB32(plane1, plane1Stride,
+                              plane3, plane3Stride,
+                              plane2, plane2Stride,
+                              1, 1,
+                              reinterpret_cast<quint32 *>(output),
+                              width, height, outputSize);
+}
+
+static void QT_FASTCALL qt_scaled_convert_NV12_to_ARGB32(const QVideoFrame &frame,
+                                                         uchar *output, QSize outputSize)
+{
+    FETCH_INFO_BIPLANAR(frame)
+    scaledPlanarYUV_to_ARGB32(plane1, plane1Stride,
+                              plane2, plane2Stride,
+                              plane2 + 1, plane2Stride,
+                              2, 1,
+                              reinterpret_cast<quint32 *>(output),
+                              width, height, outputSize);
+}
+
+static void QT_FASTCALL qt_scaled_convert_NV21_to_ARGB32(const QVideoFrame &frame,
+                                                         uchar *output, QSize outputSize)
+{
+    FETCH_INFO_BIPLANAR(frame)
+    scaledPlanarYUV_to_ARGB32(plane1, plane1Stride,
+                              plane2 + 1, plane2Stride,
+                              plane2, plane2Stride,
+                              2, 1,
+                              reinterpret_cast<quint32 *>(output),
+                              width, height, outputSize);
+}
+
+static void QT_FASTCALL qt_scaled_convert_UYVY_to_ARGB32(const QVideoFrame &frame,
+                                                         uchar *output, QSize outputSize)
+{
+    FETCH_INFO_PACKED(frame)
+    scaledPackedYUV422_to_ARGB32(src, stride, 1, 0, 2, reinterpret_cast<quint32 *>(output),
+                                 width, height, outputSize);
+}
+
+static void QT_FASTCALL qt_scaled_convert_YUYV_to_ARGB32(const QVideoFrame &frame,
+                                                         uchar *output, QSize outputSize)
+{
+    FETCH_INFO_PACKED(frame)
+    scaledPackedYUV422_to_ARGB32(src, stride, 0, 1, 3, reinterpret_cast<quint32 *>(output),
+                                 width, height, outputSize);
+}
+
+template <typename Pixel, bool premultiply>
+static void QT_FASTCALL qt_scaled_convert_to_ARGB32(const QVideoFrame &frame, uchar *output,
+                                                    QSize outputSize)
+{
+    FETCH_INFO_PACKED(frame)
+
+    const auto columns = scaledCoordinates(width, outputSize.width());
+    const auto rows = scaledCoordinates(height, outputSize.height());
+
+    quint32 *argb = reinterpret_cast<quint32 *>(output);
+
+    for (int j : rows) {
+        const Pixel *line = reinterpret_cast<const Pixel *>(src + j * stride);
+
+        for (int i : columns) {
+            if constexpr (premultiply)
+                *argb++ = qPremultiply(line[i].convert());
+            else
+                *argb++ = line[i].convert();
+        }
+    }
+}
+
+static const VideoFrameScaledConvertFunc qScaledConvertFuncs[QVideoFrameFormat::NPixelFormats] = {
+    /* Format_Invalid */                  nullptr, // Not needed
+    /* Format_ARGB8888 */                 qt_scaled_convert_to_ARGB32<ARGB8888, true>,
+    /* Format_ARGB8888_Premultiplied */   qt_scaled_convert_to_ARGB32<ARGB8888, false>,
+    /* Format_XRGB8888 */                 qt_scaled_convert_to_ARGB32<XRGB8888, false>,
+    /* Format_BGRA8888 */                 qt_scaled_convert_to_ARGB32<BGRA8888, true>,
+    /* Format_BGRA8888_Premultiplied */   qt_scaled_convert_to_ARGB32<BGRA8888, false>,
+    /* Format_BGRX8888 */                 qt_scaled_convert_to_ARGB32<BGRX8888, false>,
+    /* Format_ABGR8888 */                 qt_scaled_convert_to_ARGB32<ABGR8888, true>,
+    /* Format_XBGR8888 */                 qt_scaled_convert_to_ARGB32<XBGR8888, false>,
+    /* Format_RGBA8888 */                 qt_scaled_convert_to_ARGB32<RGBA8888, true>,
+    /* Format_RGBX8888 */                 qt_scaled_convert_to_ARGB32<RGBX8888, false>,
+    /* Format_AYUV */                     nullptr,
+    /* Format_AYUV_Premultiplied */       nullptr,
+    /* Format_YUV420P */                  qt_scaled_convert_YUV420P_to_ARGB32,
+    /* Format_YUV422P */                  qt_scaled_convert_YUV422P_to_ARGB32,
+    /* Format_YV12 */                     qt_scaled_convert_YV12_to_ARGB32,
+    /* Format_UYVY */                     qt_scaled_convert_UYVY_to_ARGB32,
+    /* Format_YUYV */                     qt_scaled_convert_YUYV_to_ARGB32,
+    /* Format_NV12 */                     qt_scaled_convert_NV12_to_ARGB32,
+    /* Format_NV21 */                     qt_scaled_convert_NV21_to_ARGB32,
+    /* Format_IMC1 */                     nullptr,
+    /* Format_IMC2 */                     nullptr,
+    /* Format_IMC3 */                     nullptr,
+    /* Format_IMC4 */                     nullptr,
+    /* Format_Y8 */                       qt_scaled_convert_to_ARGB32<YPixel<uchar>, false>,
+    /* Format_Y16 */                      qt_scaled_convert_to_ARGB32<YPixel<ushort>, false>,
+    /* Format_P010 */                     nullptr,
+    /* Format_P016 */                     nullptr,
+};
+
+VideoFrameScaledConvertFunc qScaledConverterForFormat(QVideoFrameFormat::PixelFormat format)
+{
+    return qScaledConvertFuncs[format];
+}
+
 void Q_MULTIMEDIA_EXPORT qCopyPixelsWithAlphaMask(uint32_t *dst,
                                                   const uint32_t *src,
                                                   size_t pixCount,
@@ -24,7 +24,15 @@ QT_BEGIN_NAMESPACE
 typedef void (QT_FASTCALL *VideoFrameConvertFunc)(const QVideoFrame &frame, uchar *output);
 typedef void(QT_FASTCALL *PixelsCopyFunc)(uint32_t *dst, const uint32_t *src, size_t size, uint32_t mask);
 
-VideoFrameConvertFunc qConverterForFormat(QVideoFrameFormat::PixelFormat format);
+VideoFrameConvertFunc Q_MULTIMEDIA_EXPORT qConverterForFormat(QVideoFrameFormat::PixelFormat format);
+
+// Converts to RGB32 or ARGB32_Premultiplied of the output size, sampling the nearest source pixels.
+// Scaling down this way converts only the pixels that end up in the output.
+typedef void(QT_FASTCALL *VideoFrameScaledConvertFunc)(const QVideoFrame &frame, uchar *output,
+                                                       QSize outputSize);
+
+VideoFrameScaledConvertFunc Q_MULTIMEDIA_EXPORT
+qScaledConverterForFormat(QVideoFrameFormat::PixelFormat format);
 
 void Q_MULTIMEDIA_EXPORT qCopyPixelsWithAlphaMask(uint32_t *dst,
                                                   const uint32_t *src,
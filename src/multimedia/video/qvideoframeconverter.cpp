@@ -234,6 +234,32 @@ static QImage convertCPU(const QVideoFrame &frame, const VideoTransformation &tr
     }
 }
 
+QImage qScaledImageFromVideoFrame(const QVideoFrame &frame,
+                                  const VideoTransformation &transformation, QSize size)
+{
+    VideoFrameScaledConvertFunc convert = qScaledConverterForFormat(frame.pixelFormat());
+    if (!convert || size.isEmpty())
+        return {};
+
+    QVideoFrame varFrame = frame;
+    if (!varFrame.map(QVideoFrame::ReadOnly)) {
+        qCDebug(qLcVideoFrameConverter) << Q_FUNC_INFO << ": frame mapping failed";
+        return {};
+    }
+
+    // The frame is scaled before the transformation is applied
+    if (transformation.rotationIndex() % 2)
+        size.transpose();
+
+    auto format = pixelFormatHasAlpha(varFrame.pixelFormat()) ? QImage::Format_ARGB32_Premultiplied
+                                                               : QImage::Format_RGB32;
+    QImage image(size, format);
+    convert(varFrame, image.bits(), size);
+    varFrame.unmap();
+    rasterTransform(image, transformation);
+    return image;
+}
+
 QImage qImageFromVideoFrame(const QVideoFrame &frame, bool forceCpu)
 {
     // by default, surface transformation is applied, as full transformation is used for presentation only
@@ -27,6 +27,15 @@ Q_MULTIMEDIA_EXPORT QImage qImageFromVideoFrame(const QVideoFrame &frame,
 
 Q_MULTIMEDIA_EXPORT QImage qImageFromVideoFrame(const QVideoFrame &frame, bool forceCpu = false);
 
+/**
+ *  @brief Converts the video frame on the CPU directly into an image of the given size,
+ * which is the size after the transformation. Returns a null image if the pixel format
+ * has no scaled converter.
+ */
+Q_MULTIMEDIA_EXPORT QImage qScaledImageFromVideoFrame(const QVideoFrame &frame,
+                                                      const VideoTransformation &transformation,
+                                                      QSize size);
+
 /**
  *  @brief Maps the video frame and returns an image having a shared ownership for the video frame
  * and referencing to its mapped data.
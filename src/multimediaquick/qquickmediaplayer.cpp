@@ -12,6 +12,7 @@ QQuickMediaPlayer::QQuickMediaPlayer(QObject *parent) : QMediaPlayer(parent)
     connect(this, &QMediaPlayer::durationChanged, this, &QQuickMediaPlayer::onDurationChanged);
     connect(this, &QMediaPlayer::mediaStatusChanged, this,
             &QQuickMediaPlayer::onMediaStatusChanged);
+    connect(this, &QMediaPlayer::sourceChanged, this, &QQuickMediaPlayer::onSourceChanged);
 }
 
 void QQuickMediaPlayer::qmlSetSource(const QUrl &source)
@@ -30,6 +31,32 @@ QUrl QQuickMediaPlayer::qmlSource() const
     return m_source;
 }
 
+void QQuickMediaPlayer::qmlSetNextSource(const QUrl &source)
+{
+    if (m_nextSource == source)
+        return;
+    m_nextSource = source;
+    const QQmlContext *context = qmlContext(this);
+    setNextSource(context && !source.isEmpty() ? context->resolvedUrl(source) : source);
+    emit qmlNextSourceChanged(source);
+}
+
+QUrl QQuickMediaPlayer::qmlNextSource() const
+{
+    return m_nextSource;
+}
+
+void QQuickMediaPlayer::onSourceChanged()
+{
+    // The player has switched to the next source, which is reset then
+    if (m_nextSource.isEmpty() || !nextSource().isEmpty())
+        return;
+
+    m_source = std::exchange(m_nextSource, QUrl());
+    emit qmlSourceChanged(m_source);
+    emit qmlNextSourceChanged(m_nextSource);
+}
+
 void QQuickMediaPlayer::setQmlPosition(int position)
 {
     setPosition(static_cast<qint64>(position));
@@ -33,6 +33,8 @@ class Q_MULTIMEDIAQUICK_EXPORT QQuickMediaPlayer : public QMediaPlayer
     Q_PROPERTY(int duration READ qmlDuration NOTIFY qmlDurationChanged FINAL)
     Q_PROPERTY(int position READ qmlPosition WRITE setQmlPosition NOTIFY qmlPositionChanged FINAL)
     Q_PROPERTY(bool autoPlay READ autoPlay WRITE setAutoPlay NOTIFY autoPlayChanged FINAL)
+    Q_PROPERTY(QUrl nextSource READ qmlNextSource WRITE qmlSetNextSource NOTIFY
+                       qmlNextSourceChanged REVISION(6, 11) FINAL)
 
     QML_NAMED_ELEMENT(MediaPlayer)
 
@@ -43,6 +45,10 @@ public:
 
     QUrl qmlSource() const;
 
+    void qmlSetNextSource(const QUrl &source);
+
+    QUrl qmlNextSource() const;
+
     void setQmlPosition(int position);
 
     int qmlPosition() const;
@@ -57,15 +63,18 @@ private:
     void onPositionChanged(qint64 position);
     void onDurationChanged(qint64 position);
     void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
+    void onSourceChanged();
 
 Q_SIGNALS:
     void qmlSourceChanged(const QUrl &source);
     void qmlPositionChanged(int position);
     void qmlDurationChanged(int duration);
     void autoPlayChanged(bool autoPlay);
+    Q_REVISION(6, 11) void qmlNextSourceChanged(const QUrl &source);
 
 private:
     QUrl m_source;
+    QUrl m_nextSource;
     bool m_autoPlay = false;
     bool m_wasMediaLoaded = false;
 };
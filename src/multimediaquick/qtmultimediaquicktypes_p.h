@@ -30,6 +30,7 @@
 #include <QtMultimedia/qmediametadata.h>
 #include <QtMultimedia/qmediarecorder.h>
 #include <QtMultimedia/qplaybackoptions.h>
+#include <QtMultimedia/qplaybackstatistics.h>
 #include <QtMultimedia/qscreencapture.h>
 #include <QtMultimedia/qwindowcapture.h>
 
@@ -226,6 +227,35 @@ namespace QPlaybackOptionsNamespaceForeign {
     QML_ADDED_IN_VERSION(6, 10)
 } // namespace QPlaybackOptionsNamespaceForeign
 
+class QPlaybackStatisticsDerived : public QPlaybackStatistics
+{
+    Q_PROPERTY(qint64 averageVideoDecodeTimeUs READ averageVideoDecodeTimeUs FINAL)
+    Q_PROPERTY(qint64 audioVideoSyncOffsetUs READ audioVideoSyncOffsetUs FINAL)
+
+    Q_GADGET
+    QML_FOREIGN(QPlaybackStatistics)
+    QML_VALUE_TYPE(playbackStatistics)
+    QML_EXTENDED(QPlaybackStatisticsDerived)
+    QML_ADDED_IN_VERSION(6, 11)
+
+public:
+    qint64 averageVideoDecodeTimeUs() const { return averageVideoDecodeTime().count(); }
+
+    qint64 audioVideoSyncOffsetUs() const { return audioVideoSyncOffset().count(); }
+
+    Q_INVOKABLE qint64 bufferedDurationUs(QPlaybackStatistics::StreamType stream) const
+    {
+        return bufferedDuration(stream).count();
+    }
+};
+
+namespace QPlaybackStatisticsNamespaceForeign {
+    Q_NAMESPACE
+    QML_NAMED_ELEMENT(PlaybackStatistics)
+    QML_FOREIGN_NAMESPACE(QPlaybackStatistics)
+    QML_ADDED_IN_VERSION(6, 11)
+} // namespace QPlaybackStatisticsNamespaceForeign
+
 
 
 } // namespace QtMultimediaPrivate
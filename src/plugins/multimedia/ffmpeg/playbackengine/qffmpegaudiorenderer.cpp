@@ -254,6 +254,8 @@ void AudioRenderer::updateOutputs(const Frame &frame)
         m_audioFrameConverter.reset();
     }
 
+    updateCodecContext(frame);
+
     if (m_bufferOutput) {
         if (m_bufferOutputChanged) {
             m_bufferOutputChanged = false;
@@ -300,6 +302,32 @@ void AudioRenderer::updateOutputs(const Frame &frame)
         initAudioFrameConverter(frame);
 }
 
+void AudioRenderer::updateCodecContext(const Frame &frame)
+{
+    const CodecContext *codecContext = frame.codecContext();
+    Q_ASSERT(codecContext);
+
+    if (m_codecContext && m_codecContext->context() == codecContext->context())
+        return;
+
+    const QAudioFormat frameFormat = audioFormatFromFrame(frame);
+
+    if (m_codecContext) {
+        qCDebug(qLcAudioRenderer) << "Codec context changed, format:" << m_frameFormat << "->"
+                                  << frameFormat;
+
+        // Keep the sink if the format matches, so that there's no gap in the sound
+        if (frameFormat != m_frameFormat)
+            freeOutput();
+
+        m_audioFrameConverter.reset();
+        m_bufferOutputResampler.reset();
+    }
+
+    m_codecContext = *codecContext;
+    m_frameFormat = frameFormat;
+}
+
 void AudioRenderer::updateSynchronization(const SynchronizationStamp &stamp, const Frame &frame)
 {
     if (!frame.isValid())
@@ -390,8 +418,14 @@ microseconds AudioRenderer::bufferLoadingTime(const SynchronizationStamp &syncSt
 
 void AudioRenderer::onAudioSinkStateChanged(QAudio::State state)
 {
-    if (state == QAudio::IdleState && !m_firstFrameToSink && !m_deviceChanged)
+    if (state == QAudio::IdleState && !m_firstFrameToSink && !m_deviceChanged) {
+        // The sink has played out all the data before the end of the stream
+        auto *collector = statistics();
+        if (collector && !m_drained && !isPaused())
+            PlaybackStatisticsCollector::add(collector->audioUnderruns);
+
         scheduleNextStep();
+    }
 }
 
 microseconds AudioRenderer::durationForBytes(qsizetype bytes) const
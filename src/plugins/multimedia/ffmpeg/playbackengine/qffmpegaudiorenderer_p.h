@@ -95,6 +95,8 @@ protected:
 
     void updateOutputs(const Frame &frame);
 
+    void updateCodecContext(const Frame &frame);
+
     void initAudioFrameConverter(const Frame &frame);
 
     void onDeviceChanged();
@@ -118,6 +120,10 @@ private:
     std::unique_ptr<QFFmpegResampler> m_bufferOutputResampler;
     QAudioFormat m_sinkFormat;
 
+    // the codec context of the last rendered frame; it changes when the next media is spliced
+    std::optional<CodecContext> m_codecContext;
+    QAudioFormat m_frameFormat;
+
     BufferedDataWithOffset m_bufferedData;
     QPointer<QIODevice> m_ioDevice;
 
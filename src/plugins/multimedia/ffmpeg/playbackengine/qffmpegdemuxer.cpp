@@ -103,6 +103,8 @@ void Demuxer::doNextStep()
             if (!std::exchange(m_buffered, true))
                 emit packetsBuffered();
 
+            emit endOfMediaReached(id(), m_maxPacketsEndPos, m_loopOffset.loopIndex);
+
             setAtEnd(true);
         } else {
             // start next loop
@@ -302,6 +304,14 @@ void Demuxer::updateStreamDataLimitFlag(StreamData &streamData)
             || (streamData.bufferedDuration == TrackDuration(0)
                 && packetsPosDiff >= MaxBufferedDurationUs)
             || streamData.bufferedSize >= MaxBufferedSize;
+
+    if (auto *collector = statistics()) {
+        const int trackType = streamData.trackType;
+        PlaybackStatisticsCollector::set(collector->bufferedBytes[trackType],
+                                         streamData.bufferedSize);
+        PlaybackStatisticsCollector::set(collector->bufferedDurationUs[trackType],
+                                         streamData.bufferedDuration.get());
+    }
 }
 
 } // namespace QFFmpeg
@@ -47,6 +47,9 @@ signals:
     void requestProcessVideoPacket(Packet);
     void requestProcessSubtitlePacket(Packet);
     void firstPacketFound(PlaybackEngineObjectID id, TrackPosition absSeekPos);
+    // all the loops are demuxed; the offset of the media that might follow them
+    void endOfMediaReached(PlaybackEngineObjectID id, TrackPosition nextLoopStartTimeUs,
+                           int nextLoopIndex);
     void packetsBuffered();
 
 protected:
@@ -184,8 +184,8 @@ QPlatformMediaPlayer::TrackType MediaDataHolder::trackTypeFromMediaType(int medi
 
 namespace {
 q23::expected<AVFormatContextUPtr, MediaDataHolder::ContextError>
-loadMedia(const QUrl &mediaUrl, QIODevice *stream, const QPlaybackOptions &playbackOptions,
-          const std::shared_ptr<ICancelToken> &cancelToken)
+loadMedia(const QUrl &mediaUrl, QIODevice *stream, MappedFileIO *mappedIO,
+          const QPlaybackOptions &playbackOptions, const std::shared_ptr<ICancelToken> &cancelToken)
 {
     using std::chrono::duration_cast;
     using std::chrono::microseconds;
@@ -195,7 +195,10 @@ loadMedia(const QUrl &mediaUrl, QIODevice *stream, const QPlaybackOptions &playb
 
     AVFormatContextUPtr context{ avformat_alloc_context() };
 
-    if (stream) {
+    if (mappedIO) {
+        qCDebug(qLcMediaDataHolder) << "Reading memory mapped media" << mediaUrl;
+        context->pb = mappedIO->avioContext();
+    } else if (stream) {
         if (!stream->isOpen()) {
             if (!stream->open(QIODevice::ReadOnly))
                 return q23::unexpected{
@@ -303,18 +306,21 @@ MediaDataHolder::Maybe MediaDataHolder::create(const QUrl &url, QIODevice *strea
                                                const QPlaybackOptions &options,
                                                const std::shared_ptr<ICancelToken> &cancelToken)
 {
-    q23::expected context = loadMedia(url, stream, options, cancelToken);
+    // QMediaPlayer opens qrc sources as QFile streams
+    std::unique_ptr<MappedFileIO> mappedIO = stream ? MappedFileIO::create(stream) : nullptr;
+    q23::expected context = loadMedia(url, stream, mappedIO.get(), options, cancelToken);
     if (context) {
         // MediaDataHolder is wrapped in a shared pointer to interop with signal/slot mechanism
         return std::make_shared<MediaDataHolder>(
-                MediaDataHolder{ std::move(context.value()), cancelToken });
+                MediaDataHolder{ std::move(context.value()), cancelToken, std::move(mappedIO) });
     }
     return q23::unexpected{ context.error() };
 }
 
 MediaDataHolder::MediaDataHolder(AVFormatContextUPtr context,
-                                 const std::shared_ptr<ICancelToken> &cancelToken)
-    : m_cancelToken{ cancelToken }
+                                 const std::shared_ptr<ICancelToken> &cancelToken,
+                                 std::unique_ptr<MappedFileIO> mappedIO)
+    : m_cancelToken{ cancelToken }, m_mappedIO{ std::move(mappedIO) }
 {
     Q_ASSERT(context);
 
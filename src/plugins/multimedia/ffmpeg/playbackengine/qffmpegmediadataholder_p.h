@@ -22,8 +22,10 @@
 #include <QtMultimedia/private/qmultimediautils_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegtime_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegioutils_p.h>
 
 #include <array>
+#include <atomic>
 #include <optional>
 
 QT_BEGIN_NAMESPACE
@@ -36,6 +38,17 @@ struct ICancelToken
     virtual bool isCancelled() const = 0;
 };
 
+class CancelToken : public ICancelToken
+{
+public:
+    bool isCancelled() const override { return m_cancelled.load(std::memory_order_acquire); }
+
+    void cancel() { m_cancelled.store(true, std::memory_order_release); }
+
+private:
+    std::atomic_bool m_cancelled = false;
+};
+
 using AVFormatContextUPtr = std::unique_ptr<AVFormatContext, AVDeleter<decltype(&avformat_close_input), &avformat_close_input>>;
 
 class MediaDataHolder
@@ -58,7 +71,8 @@ public:
     using StreamIndexes = std::array<int, QPlatformMediaPlayer::NTrackTypes>;
 
     MediaDataHolder() = default;
-    MediaDataHolder(AVFormatContextUPtr context, const std::shared_ptr<ICancelToken> &cancelToken);
+    MediaDataHolder(AVFormatContextUPtr context, const std::shared_ptr<ICancelToken> &cancelToken,
+                    std::unique_ptr<MappedFileIO> mappedIO = {});
 
     static QPlatformMediaPlayer::TrackType trackTypeFromMediaType(int mediaType);
 
@@ -90,6 +104,7 @@ private:
     std::shared_ptr<ICancelToken> m_cancelToken; // NOTE: Cancel token may be accessed by
                                                  // AVFormatContext during destruction and
                                                  // must outlive the context object
+    std::unique_ptr<MappedFileIO> m_mappedIO; // Custom IO of the context, must outlive it
     AVFormatContextUPtr m_context;
 
     bool m_isSeekable = false;
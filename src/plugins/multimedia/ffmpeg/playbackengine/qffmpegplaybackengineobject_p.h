@@ -21,8 +21,10 @@
 #include <QtMultimedia/qmediaplayer.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegplaybackenginedefs_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegplaybackutils_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegplaybackstatistics_p.h>
 
 #include <chrono>
+#include <memory>
 #include <optional>
 
 QT_BEGIN_NAMESPACE
@@ -72,6 +74,12 @@ public:
 
     quint64 objectID() const { return m_id.objectID; }
 
+    // Must be set before the object is moved to its thread
+    void setStatisticsCollector(std::shared_ptr<PlaybackStatisticsCollector> collector)
+    {
+        m_statistics = std::move(collector);
+    }
+
 signals:
     void atEnd(PlaybackEngineObjectID id);
 
@@ -116,6 +124,9 @@ protected:
 
     virtual void doNextStep() { }
 
+    // Might be nullptr
+    PlaybackStatisticsCollector *statistics() const { return m_statistics.get(); }
+
 private slots:
     void onTimeout();
 
@@ -132,6 +143,7 @@ private:
     QAtomicInteger<bool> m_atEnd = false;
     std::atomic_int m_invalidateCounter = 0;
     PlaybackEngineObjectID m_id;
+    std::shared_ptr<PlaybackStatisticsCollector> m_statistics;
 
     TimePointOpt m_nextTimePoint;
     TimePointOpt m_timePoint;
@@ -0,0 +1,76 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "playbackengine/qffmpegplaybackstatistics_p.h"
+
+#include <QtMultimedia/private/qplaybackstatistics_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+static QPlaybackStatistics::StreamType toStreamType(QPlatformMediaPlayer::TrackType trackType)
+{
+    switch (trackType) {
+    case QPlatformMediaPlayer::VideoStream:
+        return QPlaybackStatistics::StreamType::Video;
+    case QPlatformMediaPlayer::AudioStream:
+        return QPlaybackStatistics::StreamType::Audio;
+    case QPlatformMediaPlayer::SubtitleStream:
+        return QPlaybackStatistics::StreamType::Subtitle;
+    default:
+        Q_UNREACHABLE_RETURN(QPlaybackStatistics::StreamType::Video);
+    }
+}
+
+void PlaybackStatisticsCollector::fillStatistics(QPlaybackStatistics &statistics) const
+{
+    using std::chrono::microseconds;
+    constexpr auto order = std::memory_order_relaxed;
+
+    auto *d = QPlaybackStatisticsPrivate::get(statistics);
+
+    // Frames are counted as decoded before they are presented or dropped. Reading
+    // the later stages first, and with acquire, keeps presented + dropped <= decoded.
+    const qint64 presented = presentedVideoFrames.load(std::memory_order_acquire);
+    const qint64 dropped = droppedVideoFrames.load(std::memory_order_acquire);
+    const qint64 decoded = decodedVideoFrames.load(order);
+
+    // Frames that were decoded, but not presented or dropped before the restart,
+    // are counted as decoded since the restart, which keeps the invariant.
+    d->presentedVideoFrames = presented - m_baseline.presentedVideoFrames;
+    d->droppedVideoFrames = dropped - m_baseline.droppedVideoFrames;
+    d->decodedVideoFrames =
+            decoded - m_baseline.presentedVideoFrames - m_baseline.droppedVideoFrames;
+
+    if (const qint64 decodedSinceRestart = decoded - m_baseline.decodedVideoFrames;
+        decodedSinceRestart > 0)
+        d->averageVideoDecodeTime = microseconds(
+                (videoDecodeTimeUs.load(order) - m_baseline.videoDecodeTimeUs)
+                / decodedSinceRestart);
+    d->audioUnderruns = audioUnderruns.load(order) - m_baseline.audioUnderruns;
+    d->audioVideoSyncOffset = microseconds(audioVideoSyncOffsetUs.load(order));
+
+    for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i) {
+        const auto stream = qToUnderlying(
+                toStreamType(static_cast<QPlatformMediaPlayer::TrackType>(i)));
+        d->bufferedBytes[stream] = bufferedBytes[i].load(order);
+        d->bufferedDuration[stream] = microseconds(bufferedDurationUs[i].load(order));
+        d->renderQueueDepth[stream] = static_cast<int>(renderQueueDepth[i].load(order));
+    }
+}
+
+void PlaybackStatisticsCollector::restart()
+{
+    constexpr auto order = std::memory_order_relaxed;
+
+    m_baseline.presentedVideoFrames = presentedVideoFrames.load(std::memory_order_acquire);
+    m_baseline.droppedVideoFrames = droppedVideoFrames.load(std::memory_order_acquire);
+    m_baseline.decodedVideoFrames = decodedVideoFrames.load(order);
+    m_baseline.videoDecodeTimeUs = videoDecodeTimeUs.load(order);
+    m_baseline.audioUnderruns = audioUnderruns.load(order);
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
@@ -0,0 +1,90 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QFFMPEGPLAYBACKSTATISTICS_P_H
+#define QFFMPEGPLAYBACKSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/private/qplatformmediaplayer_p.h>
+
+#include <array>
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+class QPlaybackStatistics;
+
+namespace QFFmpeg {
+
+/*!
+    Playback counters shared between the playback engine objects. The objects
+    update them from their threads; the engine reads a snapshot in the main thread.
+ */
+struct PlaybackStatisticsCollector
+{
+    using Counter = std::atomic<qint64>;
+    using TrackCounters = std::array<Counter, QPlatformMediaPlayer::NTrackTypes>;
+
+    static void add(Counter &counter, qint64 value = 1)
+    {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    // For the counters of frames that have been counted by an earlier stage, so that a
+    // snapshot never shows a frame as processed by a later stage, but not an earlier one
+    static void addAfterEarlierStage(Counter &counter)
+    {
+        counter.fetch_add(1, std::memory_order_release);
+    }
+
+    static void set(Counter &counter, qint64 value)
+    {
+        counter.store(value, std::memory_order_relaxed);
+    }
+
+    void fillStatistics(QPlaybackStatistics &statistics) const;
+
+    // Makes the following snapshots count from the current values, e.g. when the next
+    // media starts. Must be called in the thread that fills the statistics.
+    void restart();
+
+    Counter decodedVideoFrames = 0;
+    Counter videoDecodeTimeUs = 0;
+    Counter presentedVideoFrames = 0;
+    Counter droppedVideoFrames = 0;
+    Counter audioUnderruns = 0;
+    Counter audioVideoSyncOffsetUs = 0;
+
+    // Indexed by QPlatformMediaPlayer::TrackType
+    TrackCounters bufferedBytes = {};
+    TrackCounters bufferedDurationUs = {};
+    TrackCounters renderQueueDepth = {};
+
+private:
+    // The counter values at the last restart
+    struct Baseline
+    {
+        qint64 decodedVideoFrames = 0;
+        qint64 videoDecodeTimeUs = 0;
+        qint64 presentedVideoFrames = 0;
+        qint64 droppedVideoFrames = 0;
+        qint64 audioUnderruns = 0;
+    };
+
+    Baseline m_baseline;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGPLAYBACKSTATISTICS_P_H
@@ -88,6 +88,12 @@ void Renderer::render(Frame frame)
         qCDebug(qLcRenderer) << "frame outdated! absEnd:" << frame.absoluteEnd().get() << "absPts"
                              << frame.absolutePts().get() << "seekPos:" << seekPosition().get();
 
+        const auto codecContext = frame.codecContext();
+        auto *collector = statistics();
+        if (collector && codecContext
+            && codecContext->context()->codec_type == AVMEDIA_TYPE_VIDEO)
+            PlaybackStatisticsCollector::addAfterEarlierStage(collector->droppedVideoFrames);
+
         emit frameProcessed(std::move(frame));
         return;
     }
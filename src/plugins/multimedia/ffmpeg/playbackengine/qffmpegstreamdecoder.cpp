@@ -4,6 +4,9 @@
 #include "playbackengine/qffmpegstreamdecoder_p.h"
 #include "playbackengine/qffmpegmediadataholder_p.h"
 #include <qloggingcategory.h>
+#include <qscopeguard.h>
+
+#include <chrono>
 
 QT_BEGIN_NAMESPACE
 
@@ -12,14 +15,15 @@ Q_STATIC_LOGGING_CATEGORY(qLcStreamDecoder, "qt.multimedia.ffmpeg.streamdecoder"
 namespace QFFmpeg {
 
 StreamDecoder::StreamDecoder(const PlaybackEngineObjectID &id, const CodecContext &codecContext,
-                             TrackPosition absSeekPos)
+                             TrackPosition absSeekPos, bool holdFrames)
     : PlaybackEngineObject(id),
       m_codecContext(codecContext),
       m_absSeekPos(absSeekPos),
-      m_trackType(MediaDataHolder::trackTypeFromMediaType(codecContext.context()->codec_type))
+      m_trackType(MediaDataHolder::trackTypeFromMediaType(codecContext.context()->codec_type)),
+      m_holdFrames(holdFrames)
 {
     qCDebug(qLcStreamDecoder) << "Create stream decoder, trackType" << m_trackType
-                              << "absSeekPos:" << absSeekPos.get();
+                              << "absSeekPos:" << absSeekPos.get() << "holdFrames:" << holdFrames;
     Q_ASSERT(m_trackType != QPlatformMediaPlayer::NTrackTypes);
 }
 
@@ -28,6 +32,20 @@ StreamDecoder::~StreamDecoder()
     avcodec_flush_buffers(m_codecContext.context());
 }
 
+void StreamDecoder::releaseFrames()
+{
+    invokePriorityMethod([this]() {
+        m_holdFrames = false;
+
+        while (!m_heldFrames.empty())
+            emit requestHandleFrame(m_heldFrames.dequeue());
+
+        setAtEnd(m_finalPacketDecoded);
+
+        scheduleNextStep();
+    });
+}
+
 void StreamDecoder::onFinalPacketReceived(PlaybackEngineObjectID sourceID)
 {
     if (checkSessionID(sourceID.sessionID))
@@ -70,7 +88,9 @@ void StreamDecoder::doNextStep()
 
     decodePacket(packet);
 
-    setAtEnd(!packet.isValid());
+    // the end is reported after the held frames
+    m_finalPacketDecoded = !packet.isValid();
+    setAtEnd(m_finalPacketDecoded && !m_holdFrames);
 
     if (packet.isValid())
         emit packetProcessed(std::move(packet));
@@ -105,6 +125,7 @@ void StreamDecoder::onFrameProcessed(Frame frame)
 
     --m_pendingFramesCount;
     Q_ASSERT(m_pendingFramesCount >= 0);
+    updateRenderQueueDepthStatistics();
 
     scheduleNextStep();
 }
@@ -124,11 +145,34 @@ void StreamDecoder::onFrameFound(Frame frame)
 
     Q_ASSERT(m_pendingFramesCount >= 0);
     ++m_pendingFramesCount;
-    emit requestHandleFrame(frame);
+    updateRenderQueueDepthStatistics();
+
+    // The held frames count as pending, so that only the first frames are decoded in advance
+    if (m_holdFrames)
+        m_heldFrames.enqueue(std::move(frame));
+    else
+        emit requestHandleFrame(frame);
+}
+
+void StreamDecoder::updateRenderQueueDepthStatistics()
+{
+    if (auto *collector = statistics())
+        PlaybackStatisticsCollector::set(collector->renderQueueDepth[m_trackType],
+                                         m_pendingFramesCount);
 }
 
 void StreamDecoder::decodeMedia(const Packet &packet)
 {
+    auto *collector = m_trackType == QPlatformMediaPlayer::VideoStream ? statistics() : nullptr;
+    const auto decodingStart = std::chrono::steady_clock::now();
+    auto statisticsGuard = qScopeGuard([&]() {
+        if (collector) {
+            const auto decodingTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - decodingStart);
+            PlaybackStatisticsCollector::add(collector->videoDecodeTimeUs, decodingTime.count());
+        }
+    });
+
     auto sendPacketResult = sendAVPacket(packet);
 
     if (sendPacketResult == AVERROR(EAGAIN)) {
@@ -184,9 +228,13 @@ void StreamDecoder::receiveAVFrames(bool flushPacket)
 
 
         // Avoid starvation on FFmpeg decoders with fixed size frame pool
-        if (m_trackType == QPlatformMediaPlayer::VideoStream)
+        if (m_trackType == QPlatformMediaPlayer::VideoStream) {
             avFrame = copyFromHwPool(std::move(avFrame));
 
+            if (auto *collector = statistics())
+                PlaybackStatisticsCollector::add(collector->decodedVideoFrames);
+        }
+
         onFrameFound({ m_offset, std::move(avFrame), m_codecContext, id() });
     }
 }
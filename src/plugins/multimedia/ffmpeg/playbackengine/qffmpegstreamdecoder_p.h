@@ -31,13 +31,16 @@ class StreamDecoder : public PlaybackEngineObject
 {
     Q_OBJECT
 public:
+    // If holdFrames is set, the decoded frames are kept until releaseFrames() is called
     StreamDecoder(const PlaybackEngineObjectID &id, const CodecContext &codecContext,
-                  TrackPosition absSeekPos);
+                  TrackPosition absSeekPos, bool holdFrames = false);
 
     ~StreamDecoder() override;
 
     QPlatformMediaPlayer::TrackType trackType() const;
 
+    void releaseFrames();
+
     // Maximum number of frames that we are allowed to keep in render queue
     static qint32 maxQueueSize(QPlatformMediaPlayer::TrackType type);
 
@@ -70,6 +73,8 @@ private:
 
     void receiveAVFrames(bool flushPacket = false);
 
+    void updateRenderQueueDepthStatistics();
+
 private:
     CodecContext m_codecContext;
     TrackPosition m_absSeekPos = TrackPosition(0);
@@ -80,6 +85,10 @@ private:
     LoopOffset m_offset;
 
     QQueue<Packet> m_packets;
+
+    bool m_holdFrames = false;
+    bool m_finalPacketDecoded = false;
+    QQueue<Frame> m_heldFrames;
 };
 
 } // namespace QFFmpeg
@@ -63,6 +63,9 @@ VideoRenderer::RenderingResult VideoRenderer::renderInternal(Frame frame)
     }
 #endif
 
+    // How late the frame is presented relatively to the audio-driven time controller
+    const std::chrono::microseconds syncOffset = frameDelay(frame);
+
     const auto pixelAspectRatio = codecContext->pixelAspectRatio(frame.avFrame());
     auto buffer = std::make_unique<QFFmpegVideoBuffer>(frame.takeAVFrame(), pixelAspectRatio);
     QVideoFrameFormat format(buffer->size(), buffer->pixelFormat());
@@ -77,6 +80,12 @@ VideoRenderer::RenderingResult VideoRenderer::renderInternal(Frame frame)
     videoFrame.setEndTime(frame.endTime().get());
     m_sink->setVideoFrame(videoFrame);
 
+    if (auto *collector = statistics()) {
+        PlaybackStatisticsCollector::addAfterEarlierStage(collector->presentedVideoFrames);
+        PlaybackStatisticsCollector::set(collector->audioVideoSyncOffsetUs,
+                                         syncOffset.count());
+    }
+
     return {};
 }
 
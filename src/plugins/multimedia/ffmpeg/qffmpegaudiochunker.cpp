@@ -0,0 +1,75 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qffmpegaudiochunker_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+void AudioChunker::setFormat(const QAudioFormat &format)
+{
+    if (m_format == format)
+        return;
+
+    if (m_format.isValid())
+        m_formatStartTime += m_format.durationForFrames(m_framesInFormat);
+    m_framesInFormat = 0;
+    m_format = format;
+
+    // The pending data cannot be mixed with data of the new format
+    reset();
+}
+
+void AudioChunker::setChunkFrames(qint32 frames)
+{
+    m_chunkFrames = qMax(frames, 0);
+}
+
+void AudioChunker::reset()
+{
+    m_filled = 0;
+}
+
+char *AudioChunker::pendingChunk(qsizetype bytes)
+{
+    QByteArray &chunk = m_ring[m_ringIndex];
+    if (!chunk.isDetached()) {
+        // Still referred to by a buffer that has been emitted before
+        Q_ASSERT(m_filled == 0);
+        chunk = QByteArray(bytes, Qt::Uninitialized);
+    } else if (chunk.size() != bytes) {
+        chunk.resize(bytes); // keeps the pending data
+    }
+    return chunk.data();
+}
+
+QByteArray AudioChunker::cutPendingChunk(qsizetype bytes)
+{
+    QByteArray &chunk = m_ring[m_ringIndex];
+    Q_ASSERT(m_filled > bytes);
+    QByteArray tail = chunk.sliced(bytes, m_filled - bytes);
+    chunk.resize(bytes);
+    m_filled = bytes;
+    return tail;
+}
+
+QAudioBuffer AudioChunker::takeChunk()
+{
+    const QByteArray &chunk = m_ring[m_ringIndex];
+    Q_ASSERT(chunk.size() == m_filled);
+
+    const qint64 startTime = m_formatStartTime + m_format.durationForFrames(m_framesInFormat);
+    m_framesInFormat += m_format.framesForBytes(m_filled);
+
+    // Shares the storage; it's reused once the buffer is released
+    QAudioBuffer buffer(chunk, m_format, startTime);
+
+    m_filled = 0;
+    m_ringIndex = (m_ringIndex + 1) % RingSize;
+    return buffer;
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
@@ -0,0 +1,103 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QFFMPEGAUDIOCHUNKER_P_H
+#define QFFMPEGAUDIOCHUNKER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qaudiobuffer.h>
+#include <QtMultimedia/qaudioformat.h>
+#include <QtCore/qbytearray.h>
+
+#include <array>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+/*!
+    Cuts a stream of captured PCM data into audio buffers of a fixed number of frames.
+
+    The data is copied once, straight into the storage of the emitted buffers. The storage
+    is kept in a small ring and reused as soon as the consumers have released the buffers
+    referring to it, so that steady capture doesn't allocate.
+
+    Start times are continuous across format and chunk size changes.
+ */
+class AudioChunker
+{
+public:
+    void setFormat(const QAudioFormat &format);
+    QAudioFormat format() const { return m_format; }
+
+    // Takes effect from the pending chunk on; it is cut at the new size if it's too big
+    void setChunkFrames(qint32 frames);
+    qint32 chunkFrames() const { return m_chunkFrames; }
+    qsizetype chunkBytes() const { return m_format.bytesForFrames(m_chunkFrames); }
+
+    // Drops the pending partial chunk
+    void reset();
+
+    // Invokes handler(QAudioBuffer) for every chunk completed by data
+    template <typename Handler>
+    void write(const char *data, qint64 len, Handler &&handler)
+    {
+        const qsizetype bytes = chunkBytes();
+        if (bytes <= 0)
+            return;
+
+        if (m_filled > bytes) {
+            // The chunk size has been reduced while the pending chunk was filled
+            const QByteArray tail = cutPendingChunk(bytes);
+            handler(takeChunk());
+            write(tail.constData(), tail.size(), handler);
+        }
+
+        while (len > 0) {
+            char *chunk = pendingChunk(bytes);
+            const qsizetype toCopy = qMin(len, bytes - m_filled);
+            std::memcpy(chunk + m_filled, data, toCopy);
+            m_filled += toCopy;
+            data += toCopy;
+            len -= toCopy;
+
+            if (m_filled == bytes)
+                handler(takeChunk());
+        }
+    }
+
+private:
+    char *pendingChunk(qsizetype bytes);
+    QByteArray cutPendingChunk(qsizetype bytes);
+    QAudioBuffer takeChunk();
+
+    // Enough for the consumers to hold on to a few buffers, e.g. the encoder queue
+    static constexpr size_t RingSize = 8;
+
+    QAudioFormat m_format;
+    qint32 m_chunkFrames = 0;
+
+    std::array<QByteArray, RingSize> m_ring;
+    size_t m_ringIndex = 0;
+    qsizetype m_filled = 0;
+
+    // The start time of the first frame in the current format, in microseconds
+    qint64 m_formatStartTime = 0;
+    qint64 m_framesInFormat = 0;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGAUDIOCHUNKER_P_H
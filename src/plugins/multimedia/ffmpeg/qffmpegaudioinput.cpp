@@ -1,6 +1,7 @@
 // Copyright (C) 2021 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 #include "qffmpegaudioinput_p.h"
+#include "qffmpegaudiochunker_p.h"
 
 #include <QtCore/qatomic.h>
 #include <QtCore/qdebug.h>
@@ -45,11 +46,25 @@ public:
             updateSource(locker);
         });
     }
+    void setFormat(const QAudioFormat &format)
+    {
+        Q_ASSERT(!thread()->isCurrentThread());
+        QMutexLocker locker(&m_mutex);
+        if (m_requestedFormat == format)
+            return;
+        m_requestedFormat = format;
+        QMetaObject::invokeMethod(this, [this] {
+            QMutexLocker locker(&m_mutex);
+            // avoid restarting the source if it already captures in the selected format
+            if (!m_audioSource || selectFormat() != m_format)
+                updateSource(locker);
+        });
+    }
     void setBufferSize(int bufferSize)
     {
-        m_bufferSize.storeRelease((bufferSize > 0 && m_format.isValid())
-                                          ? m_format.bytesForFrames(bufferSize)
-                                          : DefaultAudioInputBufferSize);
+        QMutexLocker locker(&m_mutex);
+        m_bufferFrames.storeRelease(qMax(bufferSize, 0));
+        updateBufferSize(locker);
     }
     void setRunning(bool r) {
         Q_ASSERT(!thread()->isCurrentThread());
@@ -75,6 +90,12 @@ public:
 
     int bufferSize() const { return m_bufferSize.loadAcquire(); }
 
+    QAudioFormat format() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_format;
+    }
+
 protected:
     qint64 readData(char *, qint64) override
     {
@@ -84,29 +105,17 @@ protected:
     {
         Q_ASSERT(m_audioSource);
 
-        int l = len;
-        while (len > 0) {
-            const auto bufferSize = m_bufferSize.loadAcquire();
-
-            while (m_pcm.size() > bufferSize) {
-                // bufferSize has been reduced. Send data until m_pcm
-                // can hold more data.
-                sendBuffer(m_pcm.first(bufferSize));
-                m_pcm.remove(0, bufferSize);
-            }
-
-            // Size of m_pcm is always <= bufferSize
-            int toAppend = qMin(len, bufferSize - m_pcm.size());
-            m_pcm.append(data, toAppend);
-            data += toAppend;
-            len -= toAppend;
-            if (m_pcm.size() == bufferSize) {
-                sendBuffer(m_pcm);
-                m_pcm.clear();
-            }
-        }
+        const int bufferFrames = m_bufferFrames.loadAcquire();
+        m_chunker.setChunkFrames(bufferFrames > 0
+                                         ? bufferFrames
+                                         : m_chunker.format().framesForBytes(
+                                                   DefaultAudioInputBufferSize));
+
+        m_chunker.write(data, len, [this](const QAudioBuffer &buffer) {
+            emit m_input->newAudioBuffer(buffer);
+        });
 
-        return l;
+        return len;
     }
 
 private Q_SLOTS:
@@ -132,9 +141,11 @@ private:
     void updateSource(const QMutexLocker<QMutex> &guard)
     {
         Q_ASSERT(guard.mutex() == &m_mutex);
-        m_format = m_device.preferredFormat();
+        m_format = selectFormat();
+        updateBufferSize(guard);
         if (std::exchange(m_audioSource, nullptr))
-            m_pcm.clear();
+            m_chunker.reset();
+        m_chunker.setFormat(m_format);
 
         m_audioSource = std::make_unique<QAudioSource>(m_device, m_format);
         updateVolume();
@@ -142,17 +153,26 @@ private:
             m_audioSource->start(this);
     }
 
-    void sendBuffer(const QByteArray &pcmData)
+    // The requested format if the device captures in it natively, the preferred one otherwise
+    QAudioFormat selectFormat() const
     {
-        QAudioFormat fmt = m_audioSource->format();
-        qint64 time = fmt.durationForBytes(m_processed);
-        QAudioBuffer buffer(pcmData, fmt, time);
-        emit m_input->newAudioBuffer(buffer);
-        m_processed += pcmData.size();
+        if (m_requestedFormat.isValid() && m_device.isFormatSupported(m_requestedFormat))
+            return m_requestedFormat;
+        return m_device.preferredFormat();
+    }
+
+    void updateBufferSize(const QMutexLocker<QMutex> &guard)
+    {
+        Q_ASSERT(guard.mutex() == &m_mutex);
+        const int bufferFrames = m_bufferFrames.loadAcquire();
+        m_bufferSize.storeRelease((bufferFrames > 0 && m_format.isValid())
+                                          ? m_format.bytesForFrames(bufferFrames)
+                                          : DefaultAudioInputBufferSize);
     }
 
-    QMutex m_mutex;
+    mutable QMutex m_mutex;
     QAudioDevice m_device;
+    QAudioFormat m_requestedFormat;
     float m_volume = 1.;
     bool m_muted = false;
     bool m_running = false;
@@ -160,9 +180,9 @@ private:
     QFFmpegAudioInput *m_input = nullptr;
     std::unique_ptr<QAudioSource> m_audioSource;
     QAudioFormat m_format;
+    QAtomicInt m_bufferFrames = 0;
     QAtomicInt m_bufferSize = DefaultAudioInputBufferSize;
-    qint64 m_processed = 0;
-    QByteArray m_pcm;
+    AudioChunker m_chunker;
 };
 
 } // namespace QFFmpeg
@@ -203,6 +223,16 @@ void QFFmpegAudioInput::setVolume(float volume)
     m_audioIO->setVolume(volume);
 }
 
+void QFFmpegAudioInput::setAudioFormat(const QAudioFormat &format)
+{
+    m_audioIO->setFormat(format);
+}
+
+QAudioFormat QFFmpegAudioInput::audioFormat() const
+{
+    return m_audioIO->format();
+}
+
 void QFFmpegAudioInput::setBufferSize(int bufferSize)
 {
     m_audioIO->setBufferSize(bufferSize);
@@ -14,6 +14,7 @@
 // We mean it.
 //
 
+#include <QtMultimedia/qaudioformat.h>
 #include <QtMultimedia/qaudioinput.h>
 #include <QtMultimedia/private/qplatformaudioinput_p.h>
 #include <QtMultimedia/private/qplatformaudiobufferinput_p.h>
@@ -39,6 +40,12 @@ public:
     void setMuted(bool /*muted*/) override;
     void setVolume(float /*volume*/) override;
 
+    // The format to capture in if the device supports it, the preferred format of the
+    // device otherwise. An invalid format selects the preferred format.
+    void setAudioFormat(const QAudioFormat &format);
+    QAudioFormat audioFormat() const;
+
+    // In frames of the captured format
     void setBufferSize(int bufferSize);
 
     int bufferSize() const;
@@ -0,0 +1,134 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QFFMPEGBOUNDEDQUEUE_P_H
+#define QFFMPEGBOUNDEDQUEUE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qtclasshelpermacros.h>
+#include <QtCore/qmath.h>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+/*!
+    Bounded lock-free queue for multiple producers and a single consumer,
+    based on Dmitry Vyukov's bounded MPMC queue.
+
+    Neither push() nor pop() ever block: push() returns false if the queue is full,
+    pop() returns an empty optional if the queue is empty. The capacity is rounded
+    up to the next power of two.
+ */
+template <typename T>
+class BoundedQueue
+{
+    struct Cell
+    {
+        std::atomic_size_t sequence;
+        std::optional<T> value;
+    };
+
+public:
+    explicit BoundedQueue(size_t capacity)
+        : m_capacity(qNextPowerOfTwo(quint64(qMax<size_t>(capacity, 2) - 1))),
+          m_mask(m_capacity - 1),
+          m_cells(std::make_unique<Cell[]>(m_capacity))
+    {
+        for (size_t i = 0; i < m_capacity; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    Q_DISABLE_COPY_MOVE(BoundedQueue)
+
+    // The value is not moved from if the queue is full
+    template <typename U>
+    bool push(U &&value)
+    {
+        Cell *cell = nullptr;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<qptrdiff>(sequence) - static_cast<qptrdiff>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value.emplace(std::forward<U>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> pop()
+    {
+        Cell *cell = nullptr;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<qptrdiff>(sequence) - static_cast<qptrdiff>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return std::nullopt;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> result = std::move(cell->value);
+        cell->value.reset();
+        cell->sequence.store(pos + m_capacity, std::memory_order_release);
+        return result;
+    }
+
+    // Might include elements that are being pushed at the moment, so pop()
+    // can fail for a short period of time even though size() is not zero.
+    size_t size() const
+    {
+        const size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+        const size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return m_capacity; }
+
+private:
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    // Keep producer and consumer positions on separate cache lines
+    alignas(64) std::atomic_size_t m_enqueuePos = 0;
+    alignas(64) std::atomic_size_t m_dequeuePos = 0;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGBOUNDEDQUEUE_P_H
@@ -262,6 +262,12 @@ std::optional<std::unordered_set<AVCodecID>> availableHWCodecs(const CodecStorag
 #endif
 }
 
+bool experimentalCodecsEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT_ENABLE_EXPERIMENTAL_CODECS");
+    return enabled;
+}
+
 const CodecsStorage &codecsStorage(CodecStorageType codecsType)
 {
     static const auto &storages = []() {
@@ -277,10 +283,7 @@ const CodecsStorage &codecsStorage(CodecStorageType codecsType)
             // be not stable, maybe we shouldn't.
             // Currently, it's possible to turn them on for testing purposes.
 
-            static const auto experimentalCodecsEnabled =
-                    qEnvironmentVariableIntValue("QT_ENABLE_EXPERIMENTAL_CODECS");
-
-            if (!experimentalCodecsEnabled && codec.isExperimental()) {
+            if (!experimentalCodecsEnabled() && codec.isExperimental()) {
                 qCDebug(qLcCodecStorage) << "Skip experimental codec" << codec.name();
                 continue;
             }
@@ -357,6 +360,38 @@ bool findAndOpenCodec(CodecStorageType codecsType, AVCodecID codecId,
     return std::any_of(codecsToScores.begin(), codecsToScores.end(), open);
 }
 
+bool hasAVCodec(CodecStorageType codecsType, AVCodecID codecId)
+{
+    static const auto &builtHwDeviceTypes = []() {
+        std::vector<AVHWDeviceType> result;
+        AVHWDeviceType type = AV_HWDEVICE_TYPE_NONE;
+        while ((type = av_hwdevice_iterate_types(type)) != AV_HWDEVICE_TYPE_NONE)
+            result.push_back(type);
+        return result;
+    }();
+
+    static const auto &platformHwCodecs = []() {
+        std::array<std::optional<std::unordered_set<AVCodecID>>, CodecStorageTypeCount> result;
+        result[Encoders] = availableHWCodecs(Encoders);
+        result[Decoders] = availableHWCodecs(Decoders);
+        return result;
+    }();
+
+    // The storage is not used, as building it checks the hw devices
+    for (const Codec codec : CodecEnumerator()) {
+        if (codec.id() != codecId)
+            continue;
+        if (codecsType == Encoders ? !codec.isEncoder() : !codec.isDecoder())
+            continue;
+        if (!experimentalCodecsEnabled() && codec.isExperimental())
+            continue;
+        if (isCodecValid(codec, builtHwDeviceTypes, platformHwCodecs[codecsType]))
+            return true;
+    }
+
+    return false;
+}
+
 std::optional<Codec> findAVCodec(CodecStorageType codecsType, AVCodecID codecId,
                                  const std::optional<PixelOrSampleFormat> &format)
 {
@@ -391,6 +426,16 @@ std::optional<Codec> findAVEncoder(AVCodecID codecId, const std::optional<PixelO
     return findAVCodec(Encoders, codecId, format);
 }
 
+bool hasAVDecoder(AVCodecID codecId)
+{
+    return hasAVCodec(Decoders, codecId);
+}
+
+bool hasAVEncoder(AVCodecID codecId)
+{
+    return hasAVCodec(Encoders, codecId);
+}
+
 bool findAndOpenAVDecoder(AVCodecID codecId,
                           const std::function<AVScore(const Codec &)> &scoresGetter,
                           const std::function<bool(const Codec &)> &codecOpener)
@@ -40,6 +40,12 @@ std::optional<Codec> findAVDecoder(AVCodecID codecId,
 std::optional<Codec> findAVEncoder(AVCodecID codecId,
                                    const std::optional<PixelOrSampleFormat> &format = {});
 
+// Unlike findAVDecoder and findAVEncoder, these don't check the hw devices, which loads
+// their drivers. Hardware codecs count if FFmpeg is built with support for their devices.
+bool hasAVDecoder(AVCodecID codecId);
+
+bool hasAVEncoder(AVCodecID codecId);
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
@@ -42,6 +42,8 @@ extern "C" {
     (LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(59, 8, 100)) // since FFmpeg n7.0
 #define QT_FFMPEG_SWR_CONST_CH_LAYOUT \
     (LIBSWRESAMPLE_VERSION_INT >= AV_VERSION_INT(4, 9, 100))
+#define QT_FFMPEG_HAS_AVFORMAT_INDEX_GET_ENTRY \
+    (LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)) // since FFmpeg n4.4
 #define QT_FFMPEG_AVIO_WRITE_CONST \
     (LIBAVFORMAT_VERSION_MAJOR >= 61)
 #define QT_CODEC_PARAMETERS_HAVE_FRAMERATE \
@@ -17,10 +17,14 @@ namespace {
 // In the example https://ffmpeg.org/doxygen/trunk/avio_read_callback_8c-example.html,
 // BufferSize = 4096 is suggested, however, it might be not optimal. To be investigated.
 constexpr size_t DefaultBufferSize = 4096;
+
+// Fragments are started at each video key frame, but audio-only streams
+// have no key frames to split on, so the fragment duration is limited as well.
+constexpr auto MaxFragmentDurationUs = "1000000";
 } // namespace
 
 EncodingFormatContext::EncodingFormatContext(QMediaFormat::FileFormat fileFormat)
-    : m_avFormatContext(avformat_alloc_context())
+    : m_avFormatContext(avformat_alloc_context()), m_fileFormat(fileFormat)
 {
     const AVOutputFormat *avFormat = QFFmpegMediaFormatInfo::outputFormatForFileFormat(fileFormat);
     m_avFormatContext->oformat = const_cast<AVOutputFormat *>(avFormat); // constness varies
@@ -33,6 +37,31 @@ EncodingFormatContext::~EncodingFormatContext()
     avformat_free_context(m_avFormatContext);
 }
 
+QMediaRecorder::MuxingMode EncodingFormatContext::setMuxingMode(QMediaRecorder::MuxingMode mode)
+{
+    if (mode == QMediaRecorder::DefaultMuxing)
+        return mode;
+
+    if (m_fileFormat != QMediaFormat::MPEG4 && m_fileFormat != QMediaFormat::QuickTime) {
+        qCDebug(qLcEncodingFormatContext)
+                << "Fragmented muxing is not supported for" << m_fileFormat;
+        return QMediaRecorder::DefaultMuxing;
+    }
+
+    // empty_moov writes the track headers up front, so that finalization only has to flush
+    // the last fragment, and the file stays playable if the recording is interrupted.
+    const char *movFlags = mode == QMediaRecorder::CmafMuxing
+            ? "cmaf+frag_keyframe+empty_moov+separate_moof+default_base_moof"
+            : "frag_keyframe+empty_moov+default_base_moof";
+
+    av_dict_set(m_muxerOptions, "movflags", movFlags, 0);
+    av_dict_set(m_muxerOptions, "frag_duration", MaxFragmentDurationUs, 0);
+
+    qCDebug(qLcEncodingFormatContext) << "Muxer options:" << m_muxerOptions;
+
+    return mode;
+}
+
 void EncodingFormatContext::openAVIO(const QString &filePath)
 {
     Q_ASSERT(!isAVIOOpen());
@@ -5,7 +5,9 @@
 #define QFFMPEGENCODINGFORMATCONTEXT_P_H
 
 #include <QtFFmpegMediaPluginImpl/private/qffmpegdefs_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
 #include "qmediaformat.h"
+#include "qmediarecorder.h"
 
 //
 //  W A R N I N G
@@ -43,6 +45,18 @@ public:
 
     const AVFormatContext *avFormatContext() const { return m_avFormatContext; }
 
+    /*!
+        Configures the muxer to write a fragmented layout if the file format
+        supports it. Returns the muxing mode that will be actually applied.
+        Must be called before the header is written.
+     */
+    QMediaRecorder::MuxingMode setMuxingMode(QMediaRecorder::MuxingMode mode);
+
+    /*!
+        Options to be passed to avformat_write_header.
+     */
+    AVDictionary **muxerOptions() { return m_muxerOptions; }
+
 private:
     Q_DISABLE_COPY_MOVE(EncodingFormatContext)
 
@@ -51,6 +65,8 @@ private:
 private:
     AVFormatContext *m_avFormatContext;
     std::unique_ptr<QFile> m_outputFile;
+    QMediaFormat::FileFormat m_fileFormat;
+    AVDictionaryHolder m_muxerOptions;
 };
 
 } // namespace QFFmpeg
@@ -3,12 +3,22 @@
 
 #include "qffmpegioutils_p.h"
 #include "qiodevice.h"
+#include "qfile.h"
 #include "qffmpegdefs_p.h"
 
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qtenvironmentvariables.h>
+
+#include <cstring>
+
 QT_BEGIN_NAMESPACE
 
 namespace QFFmpeg {
 
+Q_STATIC_LOGGING_CATEGORY(qLcFFmpegIOUtils, "qt.multimedia.ffmpeg.ioutils");
+
+static constexpr int MappedIOBufferSize = 32768;
+
 int readQIODevice(void *opaque, uint8_t *buf, int buf_size)
 {
     auto *dev = static_cast<QIODevice *>(opaque);
@@ -50,6 +60,106 @@ int64_t seekQIODevice(void *opaque, int64_t offset, int whence)
     return offset;
 }
 
+std::unique_ptr<MappedFileIO> MappedFileIO::create(QIODevice *device)
+{
+    // Subclasses of QFile might alter the data in readData
+    auto *file = qobject_cast<QFile *>(device);
+    if (!file || file->metaObject() != &QFile::staticMetaObject || file->fileName().isEmpty())
+        return {};
+
+    return create(file->fileName());
+}
+
+std::unique_ptr<MappedFileIO> MappedFileIO::create(const QString &fileName)
+{
+    if (qEnvironmentVariableIntValue("QT_FFMPEG_DISABLE_MEMORY_MAPPED_IO"))
+        return {};
+
+    // Pages of a mapped file that is truncated meanwhile raise SIGBUS on access
+    if (!fileName.startsWith(u':'))
+        return {};
+
+    auto file = std::make_unique<QFile>(fileName);
+    if (!file->open(QIODevice::ReadOnly))
+        return {};
+
+    const qint64 size = file->size();
+    if (size <= 0)
+        return {};
+
+    // Mapping of resources returns a pointer to the resource data unless it's compressed
+    uchar *data = file->map(0, size);
+    if (!data) {
+        qCDebug(qLcFFmpegIOUtils) << "Could not map" << fileName << file->errorString();
+        return {};
+    }
+
+    std::unique_ptr<MappedFileIO> result(new MappedFileIO(std::move(file), data, size));
+    if (!result->m_avioContext)
+        return {};
+
+    return result;
+}
+
+MappedFileIO::MappedFileIO(std::unique_ptr<QFile> file, uchar *data, qint64 size)
+    : m_file(std::move(file)), m_data(data), m_size(size)
+{
+    auto *buffer = static_cast<unsigned char *>(av_malloc(MappedIOBufferSize));
+    m_avioContext = avio_alloc_context(buffer, MappedIOBufferSize, false, this, &MappedFileIO::read,
+                                       nullptr, &MappedFileIO::seek);
+    if (!m_avioContext)
+        av_free(buffer);
+}
+
+MappedFileIO::~MappedFileIO()
+{
+    // AVFormatContext doesn't free custom IO contexts
+    if (m_avioContext) {
+        av_freep(&m_avioContext->buffer);
+        avio_context_free(&m_avioContext);
+    }
+
+    m_file->unmap(m_data);
+}
+
+int MappedFileIO::read(void *opaque, uint8_t *buf, int buf_size)
+{
+    auto *io = static_cast<MappedFileIO *>(opaque);
+    Q_ASSERT(io);
+
+    if (io->m_pos >= io->m_size)
+        return AVERROR_EOF;
+
+    const qint64 count = std::min<qint64>(buf_size, io->m_size - io->m_pos);
+    std::memcpy(buf, io->m_data + io->m_pos, count);
+    io->m_pos += count;
+    return static_cast<int>(count);
+}
+
+int64_t MappedFileIO::seek(void *opaque, int64_t offset, int whence)
+{
+    auto *io = static_cast<MappedFileIO *>(opaque);
+    Q_ASSERT(io);
+
+    if (whence & AVSEEK_SIZE)
+        return io->m_size;
+
+    whence &= ~AVSEEK_FORCE;
+
+    if (whence == SEEK_CUR)
+        offset += io->m_pos;
+    else if (whence == SEEK_END)
+        offset += io->m_size;
+    else if (whence != SEEK_SET)
+        return AVERROR(EINVAL);
+
+    if (offset < 0 || offset > io->m_size)
+        return AVERROR(EINVAL);
+
+    io->m_pos = offset;
+    return offset;
+}
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
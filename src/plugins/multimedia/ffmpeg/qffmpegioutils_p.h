@@ -17,11 +17,16 @@
 
 #include "qtmultimediaglobal.h"
 #include <QtFFmpegMediaPluginImpl/private/qffmpegdefs_p.h>
+#include <QtCore/qstring.h>
 
+#include <memory>
 #include <type_traits>
 
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
+class QFile;
+
 namespace QFFmpeg {
 
 int readQIODevice(void *opaque, uint8_t *buf, int buf_size);
@@ -33,6 +38,48 @@ int writeQIODevice(void *opaque, AvioWriteBufferType buf, int buf_size);
 
 int64_t seekQIODevice(void *opaque, int64_t offset, int whence);
 
+/*!
+    Serves AVIO reads of Qt resources straight from the resource data. Uncompressed
+    resources are mapped without any copying. FFmpeg still copies the data to its
+    buffer, but reads and seeks don't go through QIODevice and its buffering.
+
+    Local files are not mapped: FFmpeg's file protocol reads them as efficiently,
+    and copes with files that are truncated or grow while they are read.
+ */
+class MappedFileIO
+{
+public:
+    // Returns nullptr if the device is not a plain QFile of a resource, or cannot be mapped
+    static std::unique_ptr<MappedFileIO> create(QIODevice *device);
+
+    // Returns nullptr if the file is not a resource, or cannot be mapped
+    static std::unique_ptr<MappedFileIO> create(const QString &fileName);
+
+    ~MappedFileIO();
+
+    Q_DISABLE_COPY_MOVE(MappedFileIO)
+
+    AVIOContext *avioContext() const { return m_avioContext; }
+
+    const uchar *data() const { return m_data; }
+
+    qint64 size() const { return m_size; }
+
+    // AVIO callbacks, opaque is the MappedFileIO instance
+    static int read(void *opaque, uint8_t *buf, int buf_size);
+
+    static int64_t seek(void *opaque, int64_t offset, int whence);
+
+private:
+    MappedFileIO(std::unique_ptr<QFile> file, uchar *data, qint64 size);
+
+    std::unique_ptr<QFile> m_file;
+    uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    qint64 m_pos = 0;
+    AVIOContext *m_avioContext = nullptr;
+};
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
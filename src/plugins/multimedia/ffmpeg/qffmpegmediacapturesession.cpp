@@ -168,7 +168,10 @@ void QFFmpegMediaCaptureSession::updateAudioSink()
     if (!m_audioInput || !m_audioOutput)
         return;
 
-    auto format = m_audioInput->device.preferredFormat();
+    // The recorder may have switched the input to the format of its encoder
+    QAudioFormat format = m_audioInput->audioFormat();
+    if (!format.isValid())
+        format = m_audioInput->device.preferredFormat();
 
     if (!m_audioOutput->device.isFormatSupported(format))
         qWarning() << "Audio source format" << format << "is not compatible with the audio output";
@@ -185,13 +188,25 @@ void QFFmpegMediaCaptureSession::updateAudioSink()
     m_audioIODevice = m_audioSink->start();
     if (m_audioIODevice) {
         auto writeToDevice = [this](const QAudioBuffer &buffer) {
-            if (m_audioBufferSize < preferredAudioSinkBufferSize(*m_audioInput)) {
+            if (buffer.format() != m_audioSink->format()) {
+                // Drop buffers captured before the input switched formats
+                if (buffer.format() != m_audioInput->audioFormat())
+                    return;
+
+                qCDebug(qLcFFmpegMediaCaptureSession)
+                        << "Recreate audiosink due to format change:" << buffer.format();
+
+                updateAudioSink();
+            } else if (m_audioBufferSize < preferredAudioSinkBufferSize(*m_audioInput)) {
                 qCDebug(qLcFFmpegMediaCaptureSession)
                         << "Recreate audiosink due to small buffer size:" << m_audioBufferSize;
 
                 updateAudioSink();
             }
 
+            if (!m_audioIODevice)
+                return;
+
             const auto written =
                     m_audioIODevice->write(buffer.data<const char>(), buffer.byteCount());
 
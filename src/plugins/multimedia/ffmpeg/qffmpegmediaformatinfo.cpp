@@ -6,6 +6,8 @@
 #include "qaudioformat.h"
 #include "qimagewriter.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 static constexpr struct {
@@ -84,6 +86,14 @@ static constexpr struct
     { QMediaFormat::Wave, "audio/x-wav", nullptr }
 };
 
+// Keeps the order of FFmpeg's codec descriptors
+template <typename CodecType>
+static void sortByAVCodecId(QList<CodecType> &codecs)
+{
+    std::sort(codecs.begin(), codecs.end(),
+              [](CodecType a, CodecType b) { return codecId(a) < codecId(b); });
+}
+
 template <typename AVFormat>
 static QMediaFormat::FileFormat formatForAVFormat(AVFormat *format)
 {
@@ -116,142 +126,122 @@ static const AVOutputFormat *avFormatForFormat(QMediaFormat::FileFormat format)
     return nullptr;
 }
 
-QFFmpegMediaFormatInfo::QFFmpegMediaFormatInfo()
+// Muxers and demuxers of a file format mostly support the same codecs. FFmpeg doesn't
+// allow querying the codecs of demuxers, so the muxers are queried for decoding, too.
+static QPlatformMediaFormatInfo::CodecMap queryMuxers(QMediaFormat::FileFormat format,
+                                                      QMediaFormat::ConversionMode mode)
 {
-    using VideoCodec = QMediaFormat::VideoCodec;
-    using AudioCodec = QMediaFormat::AudioCodec;
+    auto hasCodec = [mode](AVCodecID id) {
+        return mode == QMediaFormat::Encode ? QFFmpeg::hasAVEncoder(id)
+                                            : QFFmpeg::hasAVDecoder(id);
+    };
 
-    QList<AudioCodec> audioEncoders; // All audio encoders that Qt support
-    QList<AudioCodec> extraAudioDecoders; // All audio decoders that do not support encoding
-    QList<VideoCodec> videoEncoders; // All video encoders that Qt support
-    QList<VideoCodec> extraVideoDecoders; // All video decoders that do not support encoding
-
-    // Sort all FFmpeg's codecs into the buckets
-    const AVCodecDescriptor *descriptor = nullptr;
-    while ((descriptor = avcodec_descriptor_next(descriptor))) {
-
-        const bool canEncode{ QFFmpeg::findAVEncoder(descriptor->id).has_value() };
-        const bool canDecode{ QFFmpeg::findAVDecoder(descriptor->id).has_value() };
-
-        const VideoCodec videoCodec = videoCodecForAVCodecId(descriptor->id);
-        const AudioCodec audioCodec = audioCodecForAVCodecId(descriptor->id);
-
-        if (descriptor->type == AVMEDIA_TYPE_VIDEO && videoCodec != VideoCodec::Unspecified) {
-            if (canEncode) {
-                if (!videoEncoders.contains(videoCodec))
-                    videoEncoders.append(videoCodec);
-            } else if (canDecode) {
-                if (!extraVideoDecoders.contains(videoCodec))
-                    extraVideoDecoders.append(videoCodec);
-            }
-        } else if (descriptor->type == AVMEDIA_TYPE_AUDIO && audioCodec != AudioCodec::Unspecified) {
-            if (canEncode) {
-                if (!audioEncoders.contains(audioCodec))
-                    audioEncoders.append(audioCodec);
-            } else if (canDecode) {
-                if (!extraAudioDecoders.contains(audioCodec))
-                    extraAudioDecoders.append(audioCodec);
-            }
-        }
-    }
+    // Only add the codec if it can be used with the container. A negative
+    // result means that the codec may work, but information is unavailable
+    auto canMux = [](const AVOutputFormat *outputFormat, AVCodecID id, AVCodecID defaultId) {
+        const int result = avformat_query_codec(outputFormat, id, FF_COMPLIANCE_NORMAL);
+        return result == 1 || (result < 0 && id == defaultId);
+    };
+
+    QPlatformMediaFormatInfo::CodecMap codecMap{ format, {}, {} };
 
-    // Update 'encoders' list with muxer/encoder combinations that Qt supports
     void *opaque = nullptr;
     const AVOutputFormat *outputFormat = nullptr;
     while ((outputFormat = av_muxer_iterate(&opaque))) {
-        QMediaFormat::FileFormat mediaFormat = formatForAVFormat(outputFormat);
-        if (mediaFormat == QMediaFormat::UnspecifiedFormat)
+        if (formatForAVFormat(outputFormat) != format)
             continue;
 
-        CodecMap encoder;
-        encoder.format = mediaFormat;
-
-        for (AudioCodec codec : audioEncoders) {
-            const AVCodecID id = codecId(codec);
-            // Only add the codec if it can be used with this container. A negative
-            // result means that the codec may work, but information is unavailable
-            const int result = avformat_query_codec(outputFormat, id, FF_COMPLIANCE_NORMAL);
-            if (result == 1 || (result < 0 && id == outputFormat->audio_codec)) {
-                // add codec for container
-                encoder.audio.append(codec);
-            }
+        for (const auto &c : s_audioCodecMap) {
+            if (!codecMap.audio.contains(c.codec)
+                && canMux(outputFormat, c.id, outputFormat->audio_codec) && hasCodec(c.id))
+                codecMap.audio.append(c.codec);
         }
 
-        for (VideoCodec codec : videoEncoders) {
-            const AVCodecID id = codecId(codec);
-            // Only add the codec if it can be used with this container. A negative
-            // result means that the codec may work, but information is unavailable
-            const int result = avformat_query_codec(outputFormat, id, FF_COMPLIANCE_NORMAL);
-            if (result == 1 || (result < 0 && id == outputFormat->video_codec)) {
-                // add codec for container
-                encoder.video.append(codec);
-            }
+        for (const auto &c : s_videoCodecMap) {
+            if (!codecMap.video.contains(c.codec)
+                && canMux(outputFormat, c.id, outputFormat->video_codec) && hasCodec(c.id))
+                codecMap.video.append(c.codec);
         }
+    }
 
-        // If no encoders support either audio or video, we skip this format.
-        if (encoder.audio.isEmpty() && encoder.video.isEmpty())
-            continue;
+    sortByAVCodecId(codecMap.audio);
+    sortByAVCodecId(codecMap.video);
+    return codecMap;
+}
 
-        // Handle special cases
-        switch (encoder.format) {
-        case QMediaFormat::WMV:
-            // add WMA
-            encoders.append({ QMediaFormat::WMA, encoder.audio, {} });
-            break;
-        case QMediaFormat::MPEG4:
-            // add Mpeg4Audio and QuickTime
-            encoders.append({ QMediaFormat::QuickTime, encoder.audio, encoder.video });
-            encoders.append({ QMediaFormat::Mpeg4Audio, encoder.audio, {} });
-            break;
-        case QMediaFormat::Wave:
-            // FFmpeg allows other encoded formats in WAV containers, but we do not want that
-            if (!encoder.audio.contains(AudioCodec::Wave))
-                continue;
-            encoder.audio = { AudioCodec::Wave };
-            break;
-        default:
-            break;
-        }
+static QPlatformMediaFormatInfo::CodecMap createCodecMap(QMediaFormat::FileFormat format,
+                                                         QMediaFormat::ConversionMode mode)
+{
+    using VideoCodec = QMediaFormat::VideoCodec;
+    using AudioCodec = QMediaFormat::AudioCodec;
+
+    QPlatformMediaFormatInfo::CodecMap codecMap;
 
-        encoders.append(encoder);
+    // Handle special cases
+    switch (format) {
+    case QMediaFormat::QuickTime:
+        // QuickTime is the same as MP4
+        codecMap = queryMuxers(QMediaFormat::MPEG4, mode);
+        break;
+    case QMediaFormat::Mpeg4Audio:
+        // Mpeg4Audio is the same as MP4 without the video codecs
+        codecMap = queryMuxers(QMediaFormat::MPEG4, mode);
+        codecMap.video.clear();
+        break;
+    case QMediaFormat::WMA:
+        // WMA is the same as WMV without the video codecs
+        codecMap = queryMuxers(QMediaFormat::WMV, mode);
+        codecMap.video.clear();
+        break;
+    case QMediaFormat::Wave:
+        // FFmpeg allows other encoded formats in WAV containers, but we do not want that
+        codecMap = queryMuxers(format, mode);
+        if (codecMap.audio.contains(AudioCodec::Wave))
+            codecMap.audio = { AudioCodec::Wave };
+        else
+            codecMap.audio.clear();
+        break;
+    default:
+        codecMap = queryMuxers(format, mode);
+        break;
     }
 
-    // FFmpeg doesn't allow querying supported codecs for demuxers.
-    // We take a simple approximation stating that we can decode what we
-    // can encode. That's a safe subset.
-    decoders = encoders;
+    codecMap.format = format;
+
+    if (mode == QMediaFormat::Decode) {
+        // FFmpeg can currently only decode WMA and WMV, not encode
+        if ((format == QMediaFormat::WMA || format == QMediaFormat::WMV)
+            && !codecMap.audio.contains(AudioCodec::WMA)
+            && QFFmpeg::hasAVDecoder(codecId(AudioCodec::WMA)))
+            codecMap.audio.append(AudioCodec::WMA);
+
+        if (format == QMediaFormat::WMV && !codecMap.video.contains(VideoCodec::WMV)
+            && QFFmpeg::hasAVDecoder(codecId(VideoCodec::WMV)))
+            codecMap.video.append(VideoCodec::WMV);
+
+        return codecMap;
+    }
 
 #ifdef Q_OS_WINDOWS
     // MediaFoundation HVEC encoder fails when processing frames
-    for (auto &encoder : encoders) {
-        auto h265index = encoder.video.indexOf(VideoCodec::H265);
-        if (h265index >= 0)
-            encoder.video.removeAt(h265index);
-    }
+    codecMap.video.removeAll(VideoCodec::H265);
 #endif
 
     // FFmpeg's Matroska muxer does not work with H264 video codec
-    for (auto &encoder : encoders) {
-        if (encoder.format == QMediaFormat::Matroska) {
-            encoder.video.removeAll(VideoCodec::H264);
+    if (format == QMediaFormat::Matroska) {
+        codecMap.video.removeAll(VideoCodec::H264);
 
-            // And on macOS, also not with H265
+        // And on macOS, also not with H265
 #ifdef Q_OS_MACOS
-            encoder.video.removeAll(VideoCodec::H265);
+        codecMap.video.removeAll(VideoCodec::H265);
 #endif
-        }
-    }
-
-    // FFmpeg can currently only decode WMA and WMV, not encode
-    if (extraAudioDecoders.contains(AudioCodec::WMA)) {
-        decoders[QMediaFormat::WMA].audio.append(AudioCodec::WMA);
-        decoders[QMediaFormat::WMV].audio.append(AudioCodec::WMA);
     }
 
-    if (extraVideoDecoders.contains(VideoCodec::WMV)) {
-        decoders[QMediaFormat::WMV].video.append(VideoCodec::WMV);
-    }
+    return codecMap;
+}
 
+QFFmpegMediaFormatInfo::QFFmpegMediaFormatInfo()
+{
     // Add image formats we support. We currently simply use Qt's built-in image write
     // to save images. That doesn't give us HDR support or support for larger bit depths,
     // but most cameras can currently not generate those anyway.
@@ -271,6 +261,33 @@ QFFmpegMediaFormatInfo::QFFmpegMediaFormatInfo()
 
 QFFmpegMediaFormatInfo::~QFFmpegMediaFormatInfo() = default;
 
+QList<QPlatformMediaFormatInfo::CodecMap>
+QFFmpegMediaFormatInfo::codecMaps(QMediaFormat::ConversionMode m,
+                                  QMediaFormat::FileFormat fileFormat) const
+{
+    QMutexLocker locker(&m_codecMapsMutex);
+
+    QList<CodecMap> result;
+    auto appendCodecMap = [&](QMediaFormat::FileFormat format) {
+        std::optional<CodecMap> &codecMap = m_codecMaps[m][format];
+        if (!codecMap)
+            codecMap = createCodecMap(format, m);
+
+        // If no codecs support either audio or video, the format is not supported.
+        if (!codecMap->audio.isEmpty() || !codecMap->video.isEmpty())
+            result.append(*codecMap);
+    };
+
+    if (fileFormat != QMediaFormat::UnspecifiedFormat) {
+        appendCodecMap(fileFormat);
+    } else {
+        for (int format = 0; format <= QMediaFormat::LastFileFormat; ++format)
+            appendCodecMap(QMediaFormat::FileFormat(format));
+    }
+
+    return result;
+}
+
 QMediaFormat::AudioCodec QFFmpegMediaFormatInfo::audioCodecForAVCodecId(AVCodecID id)
 {
     for (const auto &c : s_audioCodecMap) {
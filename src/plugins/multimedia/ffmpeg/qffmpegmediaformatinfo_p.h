@@ -18,9 +18,13 @@
 #include <QtMultimedia/private/qplatformmediaformatinfo_p.h>
 #include <qhash.h>
 #include <qlist.h>
+#include <qmutex.h>
 #include <qaudioformat.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
 
+#include <array>
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 class QFFmpegMediaFormatInfo : public QPlatformMediaFormatInfo
@@ -45,6 +49,17 @@ public:
     static QAudioFormat::ChannelConfig channelConfigForAVLayout(int64_t avChannelLayout);
 
     static QAudioFormat audioFormatFromCodecParameters(const AVCodecParameters &codecPar);
+
+protected:
+    QList<CodecMap> codecMaps(QMediaFormat::ConversionMode m,
+                              QMediaFormat::FileFormat fileFormat) const override;
+
+private:
+    // Built on the first query of the conversion mode and file format
+    using CodecMaps = std::array<std::optional<CodecMap>, QMediaFormat::LastFileFormat + 1>;
+
+    mutable QMutex m_codecMapsMutex;
+    mutable std::array<CodecMaps, 2> m_codecMaps;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,154 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include <QtFFmpegMediaPluginImpl/private/qffmpegmediaframeextractor_p.h>
+
+#include <QtFFmpegMediaPluginImpl/private/qffmpegvideoframereader_p.h>
+
+#include <QtMultimedia/private/qvideoframeconverter_p.h>
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore/qthreadpool.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QFFmpeg;
+
+QFFmpegMediaFrameExtractor::QFFmpegMediaFrameExtractor(QMediaFrameExtractor *parent)
+    : QPlatformMediaFrameExtractor(parent)
+{
+}
+
+QFFmpegMediaFrameExtractor::~QFFmpegMediaFrameExtractor()
+{
+    cancel();
+
+    for (QFuture<void> &extraction : m_extractions)
+        extraction.waitForFinished();
+}
+
+void QFFmpegMediaFrameExtractor::extractFrames(const QUrl &source, const QList<qint64> &positions,
+                                               const QSize &imageSize)
+{
+    cancel();
+
+    m_extractions.removeIf([](const QFuture<void> &extraction) {
+        return extraction.isFinished();
+    });
+
+    if (positions.empty()) {
+        finished();
+        return;
+    }
+
+    setActive(true);
+
+    m_cancelToken = std::make_shared<CancelToken>();
+
+    m_extractions.push_back(QtConcurrent::run(
+            [this, request = Request{ source, imageSize, m_cancelToken }, positions] {
+                runExtraction(request, positions);
+            }));
+}
+
+void QFFmpegMediaFrameExtractor::cancel()
+{
+    if (m_cancelToken) {
+        m_cancelToken->cancel();
+        m_cancelToken.reset();
+    }
+
+    setActive(false);
+}
+
+void QFFmpegMediaFrameExtractor::runExtraction(const Request &request,
+                                               const QList<qint64> &positions)
+{
+    VideoFrameReader::Maybe reader = VideoFrameReader::create(request.source, request.cancelToken);
+    if (!reader) {
+        reportError(request, reader.error().code, reader.error().description);
+        return;
+    }
+
+    const QList<QList<qint64>> chunks = splitIntoChunks(
+            *reader, positions, QThreadPool::globalInstance()->maxThreadCount());
+
+    // The first chunk reuses the reader opened for planning
+    QList<QFuture<void>> workers;
+    for (qsizetype i = 1; i < chunks.size(); ++i) {
+        workers.push_back(QtConcurrent::run([this, request, chunk = chunks[i]] {
+            VideoFrameReader::Maybe chunkReader =
+                    VideoFrameReader::create(request.source, request.cancelToken);
+            if (chunkReader)
+                extractChunk(request, *chunkReader, chunk);
+            else
+                reportError(request, chunkReader.error().code, chunkReader.error().description);
+        }));
+    }
+
+    extractChunk(request, *reader, chunks.front());
+
+    for (QFuture<void> &worker : workers)
+        worker.waitForFinished();
+
+    QMetaObject::invokeMethod(this, [this, cancelToken = request.cancelToken] {
+        if (cancelToken->isCancelled())
+            return;
+
+        m_cancelToken.reset();
+        finished();
+    });
+}
+
+void QFFmpegMediaFrameExtractor::extractChunk(const Request &request, VideoFrameReader &reader,
+                                              const QList<qint64> &positions)
+{
+    for (qint64 userPosition : positions) {
+        if (request.cancelToken->isCancelled())
+            return;
+
+        const TrackPosition position = toTrackPosition(UserTrackPosition(userPosition));
+        reportFrame(request, userPosition, reader.frameAt(position));
+    }
+}
+
+void QFFmpegMediaFrameExtractor::reportFrame(const Request &request, qint64 position,
+                                             const QVideoFrame &frame)
+{
+    if (request.imageSize.isValid()) {
+        // Convert on the worker; the GPU path would need a rhi per worker thread
+        QImage image = qImageFromVideoFrame(frame, /*forceCpu=*/true);
+        if (!image.isNull())
+            image = image.scaled(request.imageSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+        QMetaObject::invokeMethod(this, [this, cancelToken = request.cancelToken, position,
+                                         image = std::move(image)] {
+            if (!cancelToken->isCancelled())
+                imageExtracted(position, image);
+        });
+    } else {
+        QMetaObject::invokeMethod(this, [this, cancelToken = request.cancelToken, position, frame] {
+            if (!cancelToken->isCancelled())
+                frameExtracted(position, frame);
+        });
+    }
+}
+
+void QFFmpegMediaFrameExtractor::reportError(const Request &request,
+                                             QMediaFrameExtractor::Error error,
+                                             const QString &errorString)
+{
+    // Stops the other workers, and drops the frames they have already reported
+    request.cancelToken->cancel();
+
+    QMetaObject::invokeMethod(this, [this, cancelToken = request.cancelToken, error, errorString] {
+        if (m_cancelToken != cancelToken)
+            return;
+
+        m_cancelToken.reset();
+        this->error(error, errorString);
+    });
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qffmpegmediaframeextractor_p.cpp"
@@ -0,0 +1,64 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFFMPEGMEDIAFRAMEEXTRACTOR_P_H
+#define QFFMPEGMEDIAFRAMEEXTRACTOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/private/qplatformmediaframeextractor_p.h>
+#include <QtCore/qfuture.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+class CancelToken;
+class VideoFrameReader;
+} // namespace QFFmpeg
+
+class QFFmpegMediaFrameExtractor : public QPlatformMediaFrameExtractor
+{
+    Q_OBJECT
+
+public:
+    explicit QFFmpegMediaFrameExtractor(QMediaFrameExtractor *parent);
+    ~QFFmpegMediaFrameExtractor() override;
+
+    void extractFrames(const QUrl &source, const QList<qint64> &positions,
+                       const QSize &imageSize) override;
+    void cancel() override;
+
+private:
+    struct Request
+    {
+        QUrl source;
+        QSize imageSize;
+        std::shared_ptr<QFFmpeg::CancelToken> cancelToken;
+    };
+
+    // On worker threads
+    void runExtraction(const Request &request, const QList<qint64> &positions);
+    void extractChunk(const Request &request, QFFmpeg::VideoFrameReader &reader,
+                      const QList<qint64> &positions);
+    void reportFrame(const Request &request, qint64 position, const QVideoFrame &frame);
+    void reportError(const Request &request, QMediaFrameExtractor::Error error,
+                     const QString &errorString);
+
+    std::shared_ptr<QFFmpeg::CancelToken> m_cancelToken;
+    QList<QFuture<void>> m_extractions; // including the cancelled ones, which may still run
+};
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGMEDIAFRAMEEXTRACTOR_P_H
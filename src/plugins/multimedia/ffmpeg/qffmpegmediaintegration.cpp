@@ -9,6 +9,7 @@
 #include <QtFFmpegMediaPluginImpl/private/qffmpegimagecapture_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegmediacapturesession_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegmediaformatinfo_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegmediaframeextractor_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegmediaplayer_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegmediarecorder_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegresampler_p.h>
@@ -171,6 +172,11 @@ QFFmpegMediaIntegration::QFFmpegMediaIntegration()
     qCInfo(qLcFFmpeg) << "Using Qt multimedia with FFmpeg version" << av_version_info()
                       << avutil_license();
 
+    // Checking the HW device types loads the drivers, which may take a while.
+    // Don't do it on startup unless the result is going to be logged.
+    if (!qLcFFmpeg().isDebugEnabled())
+        return;
+
     qCDebug(qLcFFmpeg) << "Available HW decoding frameworks:";
     for (auto type : QFFmpeg::HWAccel::decodingDeviceTypes())
         qCDebug(qLcFFmpeg) << "    " << av_hwdevice_get_type_name(type);
@@ -186,6 +192,12 @@ QFFmpegMediaIntegration::createAudioDecoder(QAudioDecoder *decoder)
     return new QFFmpegAudioDecoder(decoder);
 }
 
+q23::expected<QPlatformMediaFrameExtractor *, QString>
+QFFmpegMediaIntegration::createMediaFrameExtractor(QMediaFrameExtractor *extractor)
+{
+    return new QFFmpegMediaFrameExtractor(extractor);
+}
+
 q23::expected<std::unique_ptr<QPlatformAudioResampler>, QString>
 QFFmpegMediaIntegration::createAudioResampler(const QAudioFormat &inputFormat,
                                               const QAudioFormat &outputFormat)
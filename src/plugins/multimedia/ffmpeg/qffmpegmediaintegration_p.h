@@ -29,6 +29,8 @@ public:
     QFFmpegMediaIntegration();
 
     q23::expected<QPlatformAudioDecoder *, QString> createAudioDecoder(QAudioDecoder *decoder) override;
+    q23::expected<QPlatformMediaFrameExtractor *, QString>
+    createMediaFrameExtractor(QMediaFrameExtractor *extractor) override;
     q23::expected<std::unique_ptr<QPlatformAudioResampler>, QString>
     createAudioResampler(const QAudioFormat &inputFormat,
                          const QAudioFormat &outputFormat) override;
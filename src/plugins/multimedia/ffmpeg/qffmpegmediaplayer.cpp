@@ -17,22 +17,6 @@
 
 QT_BEGIN_NAMESPACE
 
-namespace QFFmpeg {
-
-class CancelToken : public ICancelToken
-{
-public:
-
-    bool isCancelled() const override { return m_cancelled.load(std::memory_order_acquire); }
-
-    void cancel() { m_cancelled.store(true, std::memory_order_release); }
-
-private:
-    std::atomic_bool m_cancelled = false;
-};
-
-} // namespace QFFmpeg
-
 using namespace QFFmpeg;
 
 QFFmpegMediaPlayer::QFFmpegMediaPlayer(QMediaPlayer *player)
@@ -48,6 +32,7 @@ QFFmpegMediaPlayer::~QFFmpegMediaPlayer()
     if (m_cancelToken)
         m_cancelToken->cancel();
 
+    cancelNextMedia();
     m_loadMedia.waitForFinished();
 };
 
@@ -82,6 +67,12 @@ void QFFmpegMediaPlayer::endOfStream()
     QPointer currentPlaybackEngine(m_playbackEngine.get());
     positionChanged(duration());
 
+    // the next media hasn't been spliced by the playback engine
+    if (currentPlaybackEngine && !m_nextUrl.isEmpty()) {
+        playNextMedia();
+        return;
+    }
+
     // skip changing state and mediaStatus if playbackEngine has been recreated,
     // e.g. if new media has been loaded as a response to positionChanged signal
     if (currentPlaybackEngine)
@@ -103,6 +94,27 @@ void QFFmpegMediaPlayer::onLoopChanged()
     m_positionUpdateTimer.start();
 }
 
+void QFFmpegMediaPlayer::onNextMediaStarted(const QUrl &url)
+{
+    QPointer currentPlaybackEngine(m_playbackEngine.get());
+
+    m_url = url;
+    m_device = nullptr;
+    m_nextUrl.clear();
+
+    QPlatformMediaPlayer::nextMediaStarted(url);
+
+    // skip reporting if another media has been set as a response to the source change
+    if (!currentPlaybackEngine)
+        return;
+
+    mediaInfoChanged();
+
+    positionChanged(0);
+    m_positionUpdateTimer.stop();
+    m_positionUpdateTimer.start();
+}
+
 void QFFmpegMediaPlayer::onBuffered()
 {
     if (mediaStatus() == QMediaPlayer::BufferingMedia)
@@ -235,6 +247,20 @@ void QFFmpegMediaPlayer::setMediaAsync(QFFmpeg::MediaDataHolder::Maybe mediaData
         return;
     }
 
+    createPlaybackEngine();
+    m_playbackEngine->setMedia(std::move(*mediaDataHolder.value()));
+    initPlaybackEngine();
+
+    if (m_requestedStatus != QMediaPlayer::StoppedState) {
+        if (m_requestedStatus == QMediaPlayer::PlayingState)
+            play();
+        else if (m_requestedStatus == QMediaPlayer::PausedState)
+            pause();
+    }
+}
+
+void QFFmpegMediaPlayer::createPlaybackEngine()
+{
     m_playbackEngine = std::make_unique<PlaybackEngine>(playbackOptions());
 
     connect(m_playbackEngine.get(), &PlaybackEngine::endOfStream, this,
@@ -245,9 +271,12 @@ void QFFmpegMediaPlayer::setMediaAsync(QFFmpeg::MediaDataHolder::Maybe mediaData
             &QFFmpegMediaPlayer::onLoopChanged);
     connect(m_playbackEngine.get(), &PlaybackEngine::buffered, this,
             &QFFmpegMediaPlayer::onBuffered);
+    connect(m_playbackEngine.get(), &PlaybackEngine::nextMediaStarted, this,
+            &QFFmpegMediaPlayer::onNextMediaStarted);
+}
 
-    m_playbackEngine->setMedia(std::move(*mediaDataHolder.value()));
-
+void QFFmpegMediaPlayer::initPlaybackEngine()
+{
     m_playbackEngine->setAudioBufferOutput(m_audioBufferOutput);
     m_playbackEngine->setAudioSink(m_audioOutput);
     m_playbackEngine->setVideoSink(m_videoSink);
@@ -256,6 +285,18 @@ void QFFmpegMediaPlayer::setMediaAsync(QFFmpeg::MediaDataHolder::Maybe mediaData
     m_playbackEngine->setPlaybackRate(m_playbackRate);
     m_playbackEngine->setPitchCompensation(m_pitchCompensation);
 
+    if (m_nextMedia) {
+        m_playbackEngine->setNextMedia(std::move(*m_nextMedia));
+        m_nextMedia.reset();
+    }
+
+    mediaInfoChanged();
+
+    mediaStatusChanged(QMediaPlayer::LoadedMedia);
+}
+
+void QFFmpegMediaPlayer::mediaInfoChanged()
+{
     durationChanged(duration());
     tracksChanged();
     metaDataChanged();
@@ -265,14 +306,112 @@ void QFFmpegMediaPlayer::setMediaAsync(QFFmpeg::MediaDataHolder::Maybe mediaData
             !m_playbackEngine->streamInfo(QPlatformMediaPlayer::AudioStream).isEmpty());
     videoAvailableChanged(
             !m_playbackEngine->streamInfo(QPlatformMediaPlayer::VideoStream).isEmpty());
+}
 
-    mediaStatusChanged(QMediaPlayer::LoadedMedia);
+bool QFFmpegMediaPlayer::setNextMedia(const QUrl &media)
+{
+    cancelNextMedia();
 
-    if (m_requestedStatus != QMediaPlayer::StoppedState) {
-        if (m_requestedStatus == QMediaPlayer::PlayingState)
-            play();
-        else if (m_requestedStatus == QMediaPlayer::PausedState)
-            pause();
+    m_nextUrl = media;
+
+    if (m_playbackEngine)
+        m_playbackEngine->setNextMedia({});
+
+    if (!media.isEmpty())
+        loadNextMedia();
+
+    return true;
+}
+
+void QFFmpegMediaPlayer::loadNextMedia()
+{
+    m_nextCancelToken = std::make_shared<CancelToken>();
+
+    // Load the media and create the decoders in advance, so that the playback
+    // engine can continue with them without a gap
+    m_loadNextMedia = QtConcurrent::run([this, url = m_nextUrl, options = playbackOptions(),
+                                         cancelToken = m_nextCancelToken] {
+        // On worker thread
+        MediaDataHolder::Maybe mediaHolder =
+                MediaDataHolder::create(url, nullptr, options, cancelToken);
+
+        std::shared_ptr<NextMedia> nextMedia;
+        if (mediaHolder) {
+            nextMedia = std::make_shared<NextMedia>();
+            nextMedia->url = url;
+            nextMedia->codecContexts =
+                    PlaybackEngine::createCodecContexts(*mediaHolder.value(), options);
+            nextMedia->media = std::move(*mediaHolder.value());
+        }
+
+        QMetaObject::invokeMethod(this, [this, nextMedia, cancelToken] {
+            setNextMediaAsync(nextMedia, cancelToken);
+        });
+    });
+}
+
+void QFFmpegMediaPlayer::setNextMediaAsync(std::shared_ptr<NextMedia> nextMedia,
+                                           const std::shared_ptr<CancelToken> &cancelToken)
+{
+    if (cancelToken->isCancelled())
+        return;
+
+    // The media keeps the token for interrupting its IO, so it must not be cancelled anymore
+    m_nextCancelToken.reset();
+
+    // Errors are reported if the media is set as the current one
+    if (!nextMedia)
+        return;
+
+    if (m_playbackEngine)
+        m_playbackEngine->setNextMedia(std::move(*nextMedia));
+    else
+        m_nextMedia = std::move(nextMedia);
+}
+
+void QFFmpegMediaPlayer::cancelNextMedia()
+{
+    if (m_nextCancelToken)
+        m_nextCancelToken->cancel();
+
+    m_loadNextMedia.waitForFinished();
+    m_nextCancelToken.reset();
+    m_nextMedia.reset();
+}
+
+void QFFmpegMediaPlayer::playNextMedia()
+{
+    const QUrl url = std::exchange(m_nextUrl, QUrl());
+
+    if (std::optional<NextMedia> nextMedia = m_playbackEngine->takeNextMedia()) {
+        // The engine cannot splice the media, e.g. if it has other kinds of tracks.
+        // Switch to the loaded media with a new playback engine.
+        m_playbackEngine.reset();
+
+        createPlaybackEngine();
+        m_playbackEngine->setMedia(std::move(*nextMedia));
+
+        m_url = url;
+        m_device = nullptr;
+
+        QPointer currentPlaybackEngine(m_playbackEngine.get());
+        QPlatformMediaPlayer::nextMediaStarted(url);
+
+        // skip starting if another media has been set as a response to the source change
+        if (!currentPlaybackEngine)
+            return;
+
+        initPlaybackEngine();
+        positionChanged(0);
+        runPlayback();
+    } else {
+        // The media is still loading or has failed to load
+        cancelNextMedia();
+
+        setMedia(url, nullptr);
+        m_requestedStatus = QMediaPlayer::PlayingState;
+
+        QPlatformMediaPlayer::nextMediaStarted(url);
     }
 }
 
@@ -430,6 +569,11 @@ QFFmpegMediaPlayer::pitchCompensationAvailability() const
     return PitchCompensationAvailability::Available;
 }
 
+QPlaybackStatistics QFFmpegMediaPlayer::playbackStatistics() const
+{
+    return m_playbackEngine ? m_playbackEngine->statistics() : QPlaybackStatistics{};
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qffmpegmediaplayer_p.cpp"
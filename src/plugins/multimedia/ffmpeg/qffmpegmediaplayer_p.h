@@ -26,9 +26,8 @@
 QT_BEGIN_NAMESPACE
 
 namespace QFFmpeg {
-class CancelToken;
-
 class PlaybackEngine;
+struct NextMedia;
 } // namespace QFFmpeg
 
 class QPlatformAudioOutput;
@@ -54,6 +53,7 @@ public:
     QUrl media() const override;
     const QIODevice *mediaStream() const override;
     void setMedia(const QUrl &media, QIODevice *stream) override;
+    bool setNextMedia(const QUrl &media) override;
 
     void play() override;
     void pause() override;
@@ -78,11 +78,22 @@ public:
     void setPitchCompensation(bool enabled) override;
     bool pitchCompensation() const override;
 
+    QPlaybackStatistics playbackStatistics() const override;
+
 private:
     void runPlayback();
     void handleIncorrectMedia(QMediaPlayer::MediaStatus status);
     void setMediaAsync(QFFmpeg::MediaDataHolder::Maybe mediaDataHolder,
                        const std::shared_ptr<QFFmpeg::CancelToken> &cancelToken);
+    void createPlaybackEngine();
+    void initPlaybackEngine();
+    void mediaInfoChanged();
+
+    void loadNextMedia();
+    void setNextMediaAsync(std::shared_ptr<QFFmpeg::NextMedia> nextMedia,
+                           const std::shared_ptr<QFFmpeg::CancelToken> &cancelToken);
+    void cancelNextMedia();
+    void playNextMedia();
 
     void mediaStatusChanged(QMediaPlayer::MediaStatus);
 
@@ -95,6 +106,7 @@ private slots:
     }
     void onLoopChanged();
     void onBuffered();
+    void onNextMediaStarted(const QUrl &url);
 
 private:
     QTimer m_positionUpdateTimer;
@@ -115,6 +127,12 @@ private:
     std::shared_ptr<QFFmpeg::CancelToken> m_cancelToken; // For interrupting ongoing
                                                          // network connection attempt
 
+    // gapless playback
+    QUrl m_nextUrl;
+    QFuture<void> m_loadNextMedia;
+    std::shared_ptr<QFFmpeg::CancelToken> m_nextCancelToken;
+    std::shared_ptr<QFFmpeg::NextMedia> m_nextMedia; // loaded before the playback engine
+
     bool m_pitchCompensation = true;
 };
 
@@ -62,6 +62,7 @@ void QFFmpegMediaRecorder::record(QMediaEncoderSettings &settings)
 
     QString actualLocation;
     auto formatContext = std::make_unique<QFFmpeg::EncodingFormatContext>(settings.fileFormat());
+    settings.setMuxingMode(formatContext->setMuxingMode(settings.muxingMode()));
 
     if (outputDevice() && outputDevice()->isWritable()) {
         formatContext->openAVIO(outputDevice());
@@ -88,6 +89,10 @@ void QFFmpegMediaRecorder::record(QMediaEncoderSettings &settings)
 
     connect(m_recordingEngine.get(), &QFFmpeg::RecordingEngine::durationChanged, this,
             &QFFmpegMediaRecorder::newDuration);
+    connect(m_recordingEngine.get(), &QFFmpeg::RecordingEngine::skippedVideoFrameCountChanged,
+            this, [this](qint64 count) { skippedVideoFrameCountChanged(count); });
+    connect(m_recordingEngine.get(), &QFFmpeg::RecordingEngine::droppedAudioDurationChanged,
+            this, [this](qint64 duration) { droppedAudioDurationChanged(duration); });
     connect(m_recordingEngine.get(), &QFFmpeg::RecordingEngine::finalizationDone, this,
             &QFFmpegMediaRecorder::finalizationDone);
     connect(m_recordingEngine.get(), &QFFmpeg::RecordingEngine::sessionError, this,
@@ -105,6 +110,8 @@ void QFFmpegMediaRecorder::record(QMediaEncoderSettings &settings)
             handleStreamInitializationError);
 
     durationChanged(0);
+    skippedVideoFrameCountChanged(0);
+    droppedAudioDurationChanged(0);
     actualLocationChanged(QUrl::fromLocalFile(actualLocation));
 
     qCDebug(qLcMediaEncoder) << "Starting recording engine";
@@ -14,6 +14,8 @@
 #include "playbackengine/qffmpegvideorenderer_p.h"
 #include "playbackengine/qffmpegaudiorenderer_p.h"
 
+#include <QtMultimedia/private/qplaybackstatistics_p.h>
+
 #include <qloggingcategory.h>
 
 QT_BEGIN_NAMESPACE
@@ -35,6 +37,8 @@ PlaybackEngine::PlaybackEngine(const QPlaybackOptions &options)
     : m_demuxer({}, {}),
       m_streams(defaultObjectsArray<decltype(m_streams)>()),
       m_renderers(defaultObjectsArray<decltype(m_renderers)>()),
+      m_previousDemuxer({}, {}),
+      m_previousStreams(defaultObjectsArray<decltype(m_previousStreams)>()),
       m_options{ options }
 {
     qCDebug(qLcPlaybackEngine) << "Create PlaybackEngine";
@@ -48,6 +52,7 @@ PlaybackEngine::~PlaybackEngine() {
     qCDebug(qLcPlaybackEngine) << "Delete PlaybackEngine";
 
     finalizeOutputs();
+    resetPreviousObjects();
     forEachExistingObject([](auto &object) { object.reset(); });
     deleteFreeThreads();
 }
@@ -73,6 +78,10 @@ void PlaybackEngine::onRendererFinished(const PlaybackEngineObjectID &id)
     if (std::exchange(m_state, QMediaPlayer::StoppedState) == QMediaPlayer::StoppedState)
         return;
 
+    // the next media has ended without rendering any frames
+    if (m_splice)
+        commitSplice();
+
     finilizeTime(duration().asTimePoint());
 
     forceUpdate();
@@ -88,6 +97,15 @@ void PlaybackEngine::onRendererLoopChanged(const PlaybackEngineObjectID &id, Tra
     if (!hasRenderer(id))
         return;
 
+    for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i)
+        if (checkObjectID(m_renderers[i], id))
+            m_rendererLoopIndexes[i] = loopIndex;
+
+    if (m_splice && loopIndex >= m_splice->offset.loopIndex)
+        commitSplice();
+
+    releaseDrainedMedia();
+
     if (loopIndex > m_currentLoopOffset.loopIndex) {
         m_currentLoopOffset = { offset, loopIndex };
         emit loopChanged();
@@ -186,6 +204,8 @@ void PlaybackEngine::registerObject(PlaybackEngineObject &object)
 {
     connect(&object, &PlaybackEngineObject::error, this, &PlaybackEngine::errorOccured);
 
+    object.setStatisticsCollector(m_statistics);
+
     auto threadName = objectThreadName(object);
     auto &thread = m_threads[threadName];
     if (!thread) {
@@ -265,7 +285,16 @@ void PlaybackEngine::setLoops(int loops)
                                << "index:" << m_currentLoopOffset.loopIndex;
 
     if (m_demuxer)
-        m_demuxer->setLoops(loops);
+        m_demuxer->setLoops(demuxerLoops());
+}
+
+int PlaybackEngine::demuxerLoops() const
+{
+    if (m_loops < 0)
+        return m_loops;
+
+    // the loop indexes of a spliced media continue the ones of the previous media
+    return (m_splice ? m_splice->offset.loopIndex : m_firstLoopIndex) + m_loops;
 }
 
 void PlaybackEngine::triggerStepIfNeeded()
@@ -306,6 +335,7 @@ void PlaybackEngine::recreateObjects()
 {
     m_timeController.deactivate();
 
+    cancelSplice();
     forEachExistingObject([](auto &object) { object.reset(); });
 
     createObjectsIfNeeded();
@@ -316,6 +346,8 @@ void PlaybackEngine::createObjectsIfNeeded()
     if (m_state == QMediaPlayer::StoppedState || !m_media.avContext())
         return;
 
+    m_finalFramesSent = false;
+
     for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i)
         createStreamAndRenderer(static_cast<QPlatformMediaPlayer::TrackType>(i));
 
@@ -348,6 +380,8 @@ void PlaybackEngine::createStreamAndRenderer(QPlatformMediaPlayer::TrackType tra
         if (!renderer)
             return;
 
+        m_rendererLoopIndexes[trackType] = 0;
+
         connect(renderer.get(), &Renderer::synchronized, this,
                 &PlaybackEngine::onRendererSynchronized);
 
@@ -363,11 +397,33 @@ void PlaybackEngine::createStreamAndRenderer(QPlatformMediaPlayer::TrackType tra
 
     Q_ASSERT(trackType == stream->trackType());
 
-    connect(stream.get(), &StreamDecoder::requestHandleFrame, renderer.get(), &Renderer::render);
-    connect(stream.get(), &PlaybackEngineObject::atEnd, renderer.get(),
-            &Renderer::onFinalFrameReceived);
-    connect(renderer.get(), &Renderer::frameProcessed, stream.get(),
-            &StreamDecoder::onFrameProcessed);
+    connectStreamToRenderer(*stream, *renderer);
+}
+
+void PlaybackEngine::connectStreamToRenderer(StreamDecoder &stream, Renderer &renderer)
+{
+    connect(&stream, &StreamDecoder::requestHandleFrame, &renderer, &Renderer::render);
+    // the final frame is forwarded to the renderer by onStreamFinished
+    connect(&stream, &PlaybackEngineObject::atEnd, this, &PlaybackEngine::onStreamFinished);
+    connect(&renderer, &Renderer::frameProcessed, &stream, &StreamDecoder::onFrameProcessed);
+}
+
+void PlaybackEngine::connectDemuxerToStreams(
+        Demuxer &demuxer, std::array<StreamPtr, QPlatformMediaPlayer::NTrackTypes> &streams)
+{
+    for (auto &stream : streams) {
+        if (!stream)
+            continue;
+
+        connect(&demuxer, Demuxer::signalByTrackType(stream->trackType()), stream.get(),
+                &StreamDecoder::decode);
+        connect(&demuxer, &PlaybackEngineObject::atEnd, stream.get(),
+                &StreamDecoder::onFinalPacketReceived);
+        connect(stream.get(), &StreamDecoder::packetProcessed, &demuxer,
+                &Demuxer::onPacketProcessed);
+    }
+
+    connect(&demuxer, &Demuxer::endOfMediaReached, this, &PlaybackEngine::onDemuxerEndOfMedia);
 }
 
 std::optional<CodecContext> PlaybackEngine::codecContextForTrack(QPlatformMediaPlayer::TrackType trackType)
@@ -420,31 +476,236 @@ void PlaybackEngine::createDemuxer()
 
     m_demuxer = createPlaybackEngineObject<Demuxer>(m_media.avContext(), currentLoopPosUs,
                                                     m_seekPending, m_currentLoopOffset,
-                                                    streamIndexes, m_loops);
+                                                    streamIndexes, demuxerLoops());
 
     m_seekPending = false;
+    m_endOfMediaOffset.reset();
 
     connect(m_demuxer.get(), &Demuxer::packetsBuffered, this, &PlaybackEngine::buffered);
 
-    forEachExistingObject<StreamDecoder>([&](auto &stream) {
-        connect(m_demuxer.get(), Demuxer::signalByTrackType(stream->trackType()), stream.get(),
-                &StreamDecoder::decode);
-        connect(m_demuxer.get(), &PlaybackEngineObject::atEnd, stream.get(),
-                &StreamDecoder::onFinalPacketReceived);
-        connect(stream.get(), &StreamDecoder::packetProcessed, m_demuxer.get(),
-                &Demuxer::onPacketProcessed);
-    });
+    connectDemuxerToStreams(*m_demuxer, m_streams);
 
     connect(m_demuxer.get(), &Demuxer::firstPacketFound, this, &PlaybackEngine::onFirstPacketFound);
 }
 
+void PlaybackEngine::onDemuxerEndOfMedia(const PlaybackEngineObjectID &id,
+                                         TrackPosition nextLoopStartTimeUs, int nextLoopIndex)
+{
+    if (!checkObjectID(m_demuxer, id))
+        return;
+
+    m_endOfMediaOffset = LoopOffset{ nextLoopStartTimeUs, nextLoopIndex };
+    spliceNextMedia();
+}
+
+void PlaybackEngine::onStreamFinished(const PlaybackEngineObjectID &id)
+{
+    for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i) {
+        if (checkObjectID(m_previousStreams[i], id)) {
+            // The renderer has received all the frames of the previous media,
+            // so the frames of the next one may follow.
+            m_previousStreams[i].reset();
+            if (m_streams[i])
+                m_streams[i]->releaseFrames();
+
+            if (std::none_of(m_previousStreams.begin(), m_previousStreams.end(),
+                             [](const StreamPtr &stream) { return bool(stream); })) {
+                m_previousDemuxer.reset();
+                spliceNextMedia();
+            }
+            return;
+        }
+
+        if (checkObjectID(m_streams[i], id)) {
+            m_finalFramesSent = true;
+            if (Renderer *renderer = m_renderers[i].get())
+                QMetaObject::invokeMethod(renderer,
+                                          [renderer, id] { renderer->onFinalFrameReceived(id); });
+            return;
+        }
+    }
+}
+
+bool PlaybackEngine::canSpliceNextMedia()
+{
+    // The splice is possible if the current demuxer has read all the loops,
+    // and the renderers are still waiting for the frames.
+    if (!m_nextMedia || !m_endOfMediaOffset || m_splice || m_previousDemuxer
+        || m_finalFramesSent || !m_demuxer)
+        return false;
+
+    NextMedia &next = *m_nextMedia;
+
+    for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i) {
+        const auto trackType = static_cast<QPlatformMediaPlayer::TrackType>(i);
+        const int streamIndex = next.media.currentStreamIndex(trackType);
+        const bool hasStream = streamIndex >= 0;
+
+        // The next media is expected to be played with the same renderers
+        if (hasStream != (m_media.currentStreamIndex(trackType) >= 0))
+            return false;
+
+        if (bool(m_streams[i]) != (hasStream && m_renderers[i]))
+            return false;
+
+        if (m_streams[i] && !next.codecContexts[i]) {
+            auto maybeCodecContext = CodecContext::create(next.media.avContext()->streams[streamIndex],
+                                                          next.media.avContext(), m_options);
+            if (!maybeCodecContext)
+                return false;
+
+            next.codecContexts[i] = maybeCodecContext.value();
+        }
+    }
+
+    // the video renderer keeps the transformation of the media it has been created for
+    return !m_renderers[QPlatformMediaPlayer::VideoStream]
+            || next.media.transformation() == m_media.transformation();
+}
+
+void PlaybackEngine::spliceNextMedia()
+{
+    if (!canSpliceNextMedia())
+        return;
+
+    const LoopOffset offset = *m_endOfMediaOffset;
+    m_endOfMediaOffset.reset();
+
+    qCDebug(qLcPlaybackEngine) << "Splice next media:" << m_nextMedia->url
+                               << "loop offset:" << offset.loopStartTimeUs.get()
+                               << "index:" << offset.loopIndex;
+
+    m_splice = Splice{ std::move(*m_nextMedia), offset };
+    m_nextMedia.reset();
+
+    // The previous objects finish decoding the frames of the current media
+    m_previousDemuxer = std::move(m_demuxer);
+    m_previousStreams = std::move(m_streams);
+    m_streams = defaultObjectsArray<decltype(m_streams)>();
+    m_finalFramesSent = false;
+
+    NextMedia &next = m_splice->next;
+    StreamIndexes streamIndexes = { -1, -1, -1 };
+
+    for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i) {
+        if (!m_previousStreams[i])
+            continue;
+
+        const auto trackType = static_cast<QPlatformMediaPlayer::TrackType>(i);
+        auto &stream = m_streams[i] = createPlaybackEngineObject<StreamDecoder>(
+                *next.codecContexts[i], offset.loopStartTimeUs, /*holdFrames=*/true);
+        connectStreamToRenderer(*stream, *m_renderers[i]);
+        streamIndexes[i] = next.media.currentStreamIndex(trackType);
+    }
+
+    m_demuxer = createPlaybackEngineObject<Demuxer>(next.media.avContext(), TrackPosition(0),
+                                                    next.rewind, offset, streamIndexes,
+                                                    demuxerLoops());
+
+    connectDemuxerToStreams(*m_demuxer, m_streams);
+
+    updateObjectsPausedState();
+}
+
+void PlaybackEngine::commitSplice()
+{
+    Q_ASSERT(m_splice);
+
+    Splice splice = std::move(*m_splice);
+    m_splice.reset();
+
+    qCDebug(qLcPlaybackEngine) << "Next media started:" << splice.next.url;
+
+    // The renderers might still keep the frames of the previous media
+    retireMedia(std::exchange(m_media, std::move(splice.next.media)), splice.offset.loopIndex);
+
+    m_codecContexts = std::move(splice.next.codecContexts);
+    m_firstLoopIndex = splice.offset.loopIndex;
+    m_currentLoopOffset = splice.offset;
+
+    // The statistics are reported per source
+    m_statistics->restart();
+
+    updateVideoSinkSize();
+
+    // the demuxer might have read the new media already
+    spliceNextMedia();
+
+    emit nextMediaStarted(splice.next.url);
+}
+
+bool PlaybackEngine::cancelSplice()
+{
+    resetPreviousObjects();
+    m_endOfMediaOffset.reset();
+
+    if (!m_splice)
+        return false;
+
+    qCDebug(qLcPlaybackEngine) << "Cancel splicing next media:" << m_splice->next.url;
+
+    Q_ASSERT(!m_nextMedia);
+
+    m_nextMedia = std::move(m_splice->next);
+    m_nextMedia->rewind = true;
+    m_splice.reset();
+
+    return true;
+}
+
+void PlaybackEngine::resetPreviousObjects()
+{
+    m_previousDemuxer.reset();
+    for (auto &stream : m_previousStreams)
+        stream.reset();
+}
+
+void PlaybackEngine::retireMedia(MediaDataHolder media, int releaseLoopIndex)
+{
+    m_retiredMedia.push_back({ std::move(media), releaseLoopIndex });
+    releaseDrainedMedia();
+}
+
+void PlaybackEngine::releaseDrainedMedia()
+{
+    // Frames are rendered in order, so a renderer that has reached a loop doesn't keep the
+    // frames of earlier ones. Subtitle frames don't refer to the codec context.
+    std::optional<int> minLoopIndex;
+    for (auto trackType : { QPlatformMediaPlayer::VideoStream, QPlatformMediaPlayer::AudioStream }) {
+        if (!m_renderers[trackType])
+            continue;
+        const int loopIndex = m_rendererLoopIndexes[trackType];
+        minLoopIndex = minLoopIndex ? std::min(*minLoopIndex, loopIndex) : loopIndex;
+    }
+
+    if (!minLoopIndex)
+        return;
+
+    const auto end = std::remove_if(m_retiredMedia.begin(), m_retiredMedia.end(),
+                                    [&](const RetiredMedia &retired) {
+                                        return retired.releaseLoopIndex <= *minLoopIndex;
+                                    });
+    if (end != m_retiredMedia.end())
+        qCDebug(qLcPlaybackEngine) << "Release" << std::distance(end, m_retiredMedia.end())
+                                   << "drained media";
+    m_retiredMedia.erase(end, m_retiredMedia.end());
+}
+
 void PlaybackEngine::deleteFreeThreads() {
     m_threadsDirty = false;
     auto freeThreads = std::move(m_threads);
 
-    forEachExistingObject([&](auto &object) {
+    auto keepThread = [&](auto &object) {
         m_threads.insert(freeThreads.extract(objectThreadName(*object)));
-    });
+    };
+
+    forEachExistingObject(keepThread);
+
+    if (m_previousDemuxer)
+        keepThread(m_previousDemuxer);
+    for (auto &stream : m_previousStreams)
+        if (stream)
+            keepThread(stream);
 
     for (auto &[name, thr] : freeThreads)
         thr->quit();
@@ -463,6 +724,58 @@ void PlaybackEngine::setMedia(MediaDataHolder media)
     updateVideoSinkSize();
 }
 
+void PlaybackEngine::setMedia(NextMedia media)
+{
+    m_codecContexts = std::move(media.codecContexts);
+    m_seekPending = media.rewind;
+    setMedia(std::move(media.media));
+}
+
+void PlaybackEngine::setNextMedia(std::optional<NextMedia> media)
+{
+    if (m_splice) {
+        // The replaced media has been spliced already; restart the playback without it.
+        qCDebug(qLcPlaybackEngine) << "Cancel splicing replaced next media:"
+                                   << m_splice->next.url;
+
+        retireMedia(std::move(m_splice->next.media), m_currentLoopOffset.loopIndex + 1);
+        m_splice.reset();
+        forceUpdate();
+    }
+
+    // the media might still be in use by the objects of the cancelled splice
+    if (m_nextMedia && m_nextMedia->rewind)
+        retireMedia(std::move(m_nextMedia->media), m_currentLoopOffset.loopIndex + 1);
+
+    m_nextMedia = std::move(media);
+    spliceNextMedia();
+}
+
+std::optional<NextMedia> PlaybackEngine::takeNextMedia()
+{
+    return std::exchange(m_nextMedia, std::nullopt);
+}
+
+CodecContexts PlaybackEngine::createCodecContexts(MediaDataHolder &media,
+                                                  const QPlaybackOptions &options)
+{
+    CodecContexts result;
+    for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i) {
+        const int streamIndex =
+                media.currentStreamIndex(static_cast<QPlatformMediaPlayer::TrackType>(i));
+        if (streamIndex < 0)
+            continue;
+
+        // on failure, the engine creates the codec context again and reports the error
+        auto maybeCodecContext =
+                CodecContext::create(media.avContext()->streams[streamIndex], media.avContext(),
+                                     options);
+        if (maybeCodecContext)
+            result[i] = maybeCodecContext.value();
+    }
+    return result;
+}
+
 void PlaybackEngine::setVideoSink(QVideoSink *sink)
 {
     auto prev = std::exchange(m_videoSink, sink);
@@ -566,6 +879,13 @@ void PlaybackEngine::setActiveTrack(QPlatformMediaPlayer::TrackType trackType, i
 
     m_codecContexts[trackType] = {};
 
+    if (cancelSplice()) {
+        // the renderers might have received the frames of the next media
+        updateVideoSinkSize();
+        forceUpdate();
+        return;
+    }
+
     m_renderers[trackType].reset();
     m_streams = defaultObjectsArray<decltype(m_streams)>();
     m_demuxer.reset();
@@ -588,6 +908,7 @@ void PlaybackEngine::finilizeTime(TrackPosition pos)
     m_timeController.deactivate();
     m_timeController.sync(pos);
     m_currentLoopOffset = {};
+    m_firstLoopIndex = 0;
 }
 
 void PlaybackEngine::finalizeOutputs()
@@ -654,6 +975,18 @@ TrackPosition PlaybackEngine::boundPosition(TrackPosition position) const
     return duration() > TrackDuration(0) ? qMin(position, duration().asTimePoint()) : position;
 }
 
+QPlaybackStatistics PlaybackEngine::statistics() const
+{
+    QPlaybackStatistics result;
+    m_statistics->fillStatistics(result);
+
+    const auto &videoCodecContext = m_codecContexts[QPlatformMediaPlayer::VideoStream];
+    QPlaybackStatisticsPrivate::get(result)->hardwareDecoding =
+            videoCodecContext && videoCodecContext->hwAccel() != nullptr;
+
+    return result;
+}
+
 AudioRenderer *PlaybackEngine::getAudioRenderer()
 {
     return qobject_cast<AudioRenderer *>(m_renderers[QPlatformMediaPlayer::AudioStream].get());
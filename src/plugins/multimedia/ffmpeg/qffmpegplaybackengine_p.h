@@ -43,6 +43,17 @@
  * - PlaybackEngine knows the objects object and is able to create/delete them and
  *   call their public methods.
  *
+ * GAPLESS PLAYBACK
+ *
+ * - The next media can be loaded in advance, see setNextMedia. When the demuxer
+ *   has read the last loop of the current media, the engine creates the demuxer and
+ *   the stream decoders of the next media and connects them to the existing renderers.
+ *   The frames of the next media continue the timeline of the current one as a new loop,
+ *   so the renderers, their threads, and the audio sink are kept.
+ * - The new stream decoders hold their frames until the previous decoders have sent
+ *   the final ones, so the renderers receive the frames in order.
+ * - The next media becomes the current one when a renderer renders its first frame.
+ *
  */
 
 #include <QtFFmpegMediaPluginImpl/private/qffmpegplaybackenginedefs_p.h>
@@ -51,11 +62,16 @@
 #include <QtFFmpegMediaPluginImpl/private/qffmpegcodeccontext_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegplaybackutils_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegtime_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegplaybackstatistics_p.h>
 #include <QtMultimedia/qplaybackoptions.h>
+#include <QtMultimedia/qplaybackstatistics.h>
 
 #include <QtCore/qpointer.h>
+#include <QtCore/qurl.h>
 
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -69,6 +85,17 @@ class QPlaybackOptions;
 namespace QFFmpeg
 {
 
+using CodecContexts = std::array<std::optional<CodecContext>, QPlatformMediaPlayer::NTrackTypes>;
+
+// The media to be played without gaps after the current one; it is loaded in advance.
+struct NextMedia
+{
+    QUrl url;
+    MediaDataHolder media;
+    CodecContexts codecContexts;
+    bool rewind = false; // the media has been read partially, and needs seeking to 0
+};
+
 class PlaybackEngine : public QObject
 {
     Q_OBJECT
@@ -77,8 +104,19 @@ public:
 
     ~PlaybackEngine() override;
 
+    // Creates the codec contexts of the active tracks; might be invoked on a worker thread.
+    static CodecContexts createCodecContexts(MediaDataHolder &media,
+                                             const QPlaybackOptions &options);
+
     void setMedia(MediaDataHolder media);
 
+    void setMedia(NextMedia media);
+
+    // Sets the media to be played without gaps after the current one.
+    void setNextMedia(std::optional<NextMedia> media);
+
+    std::optional<NextMedia> takeNextMedia();
+
     void setVideoSink(QVideoSink *sink);
 
     void setAudioSink(QAudioOutput *output);
@@ -124,11 +162,14 @@ public:
 
     void setPitchCompensation(bool enabled);
 
+    QPlaybackStatistics statistics() const;
+
 signals:
     void endOfStream();
     void errorOccured(QMediaPlayer::Error, const QString &);
     void loopChanged();
     void buffered();
+    void nextMediaStarted(const QUrl &url);
 
 protected: // objects managing
     struct ObjectDeleter
@@ -159,6 +200,13 @@ private:
 
     void createDemuxer();
 
+    void connectStreamToRenderer(StreamDecoder &stream, Renderer &renderer);
+
+    void connectDemuxerToStreams(Demuxer &demuxer,
+                                 std::array<StreamPtr, QPlatformMediaPlayer::NTrackTypes> &streams);
+
+    int demuxerLoops() const;
+
     void registerObject(PlaybackEngineObject &object);
 
     template<typename C, typename Action>
@@ -187,6 +235,25 @@ private:
     void onRendererLoopChanged(const PlaybackEngineObjectID &id, TrackPosition offset,
                                int loopIndex);
 
+    void onDemuxerEndOfMedia(const PlaybackEngineObjectID &id, TrackPosition nextLoopStartTimeUs,
+                             int nextLoopIndex);
+
+    void onStreamFinished(const PlaybackEngineObjectID &id);
+
+    bool canSpliceNextMedia();
+
+    void spliceNextMedia();
+
+    void commitSplice();
+
+    bool cancelSplice();
+
+    void resetPreviousObjects();
+
+    // The media is released once the renderers have moved on to the loop
+    void retireMedia(MediaDataHolder media, int releaseLoopIndex);
+    void releaseDrainedMedia();
+
     void triggerStepIfNeeded();
 
     static QString objectThreadName(const PlaybackEngineObject &object);
@@ -233,12 +300,38 @@ private:
 
     bool m_seekPending = false;
 
-    std::array<std::optional<CodecContext>, QPlatformMediaPlayer::NTrackTypes> m_codecContexts;
+    CodecContexts m_codecContexts;
     int m_loops = QMediaPlayer::Once;
     LoopOffset m_currentLoopOffset;
+    int m_firstLoopIndex = 0; // the loop index the current media has started with
+
+    // gapless playback
+    struct Splice
+    {
+        NextMedia next;
+        LoopOffset offset;
+    };
+
+    std::optional<NextMedia> m_nextMedia;
+    std::optional<Splice> m_splice;
+    std::optional<LoopOffset> m_endOfMediaOffset;
+    bool m_finalFramesSent = false;
+    // the objects of the current media, which finish decoding after the splice
+    ObjectPtr<Demuxer> m_previousDemuxer;
+    std::array<StreamPtr, QPlatformMediaPlayer::NTrackTypes> m_previousStreams;
+    // the codec contexts of the frames in the renderers might refer to the replaced media
+    struct RetiredMedia
+    {
+        MediaDataHolder media;
+        int releaseLoopIndex = 0;
+    };
+    std::vector<RetiredMedia> m_retiredMedia;
+    std::array<int, QPlatformMediaPlayer::NTrackTypes> m_rendererLoopIndexes = {};
 
     bool m_pitchCompensation = true;
     QPlaybackOptions m_options;
+    std::shared_ptr<PlaybackStatisticsCollector> m_statistics =
+            std::make_shared<PlaybackStatisticsCollector>();
     PlaybackEngineObjectID m_currentID{ 1, 1 };
 };
 
@@ -10,10 +10,7 @@ using namespace QFFmpeg;
 
 void ConsumerThread::stopAndDelete()
 {
-    {
-        QMutexLocker locker(&m_loopDataMutex);
-        m_exit = true;
-    }
+    m_exit.store(true, std::memory_order_release);
     dataReady();
     wait();
     delete this;
@@ -21,7 +18,28 @@ void ConsumerThread::stopAndDelete()
 
 void ConsumerThread::dataReady()
 {
-    m_condition.wakeAll();
+    // Pairs with the fence in waitForData: either the consumer sees the published
+    // data when re-checking hasData(), or we see it sleeping and wake it up.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.exchange(false, std::memory_order_acq_rel))
+        m_wakeUp.release();
+}
+
+void ConsumerThread::waitForData()
+{
+    while (!hasData() && !m_exit.load(std::memory_order_acquire)) {
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (hasData() || m_exit.load(std::memory_order_relaxed)) {
+            // A producer might have already taken the flag and released the semaphore;
+            // in this case, the next acquire just returns immediately.
+            m_sleeping.store(false, std::memory_order_relaxed);
+            return;
+        }
+
+        m_wakeUp.acquire();
+    }
 }
 
 void ConsumerThread::run()
@@ -30,15 +48,10 @@ void ConsumerThread::run()
         return;
 
     while (true) {
+        waitForData();
 
-        {
-            QMutexLocker locker(&m_loopDataMutex);
-            while (!hasData() && !m_exit)
-                m_condition.wait(&m_loopDataMutex);
-
-            if (m_exit)
-                break;
-        }
+        if (m_exit.load(std::memory_order_acquire))
+            break;
 
         processOne();
     }
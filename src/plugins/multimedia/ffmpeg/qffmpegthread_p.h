@@ -17,9 +17,11 @@
 #include <QtMultimedia/private/qtmultimediaglobal_p.h>
 
 #include <qmutex.h>
-#include <qwaitcondition.h>
+#include <qsemaphore.h>
 #include <qthread.h>
 
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 class QAudioSink;
@@ -33,6 +35,10 @@ namespace QFFmpeg
     This thread processes work items until no more data is available.
     When no more data is available, it sleeps until it is notified about
     more available data.
+
+    Work items are expected to be passed via lock-free queues; the thread
+    doesn't hold any lock while checking hasData(), and dataReady() only
+    wakes the thread if it's sleeping.
  */
 class ConsumerThread : public QThread
 {
@@ -70,27 +76,32 @@ protected:
     /*!
         Wake thread from sleep and process data until
         hasData() returns false. The method is supposed to be invoked
-        right after the scope of QMutexLocker that lockLoopData returns.
+        right after new data has been published, e.g. pushed to a queue.
     */
     void dataReady();
 
     /*!
-        Must return true when data is available for processing
+        Must return true when data is available for processing.
+        Called from the consumer thread without any lock held.
      */
     virtual bool hasData() const = 0;
 
     /*!
         Locks the loop data mutex. It must be used to protect loop data
-        like a queue of video frames.
+        that is rarely changed, like the paused state; per-item data is
+        supposed to be passed via lock-free queues.
      */
     QMutexLocker<QMutex> lockLoopData() const;
 
 private:
     void run() final;
 
+    void waitForData();
+
     mutable QMutex m_loopDataMutex;
-    QWaitCondition m_condition;
-    bool m_exit = false;
+    QSemaphore m_wakeUp;
+    std::atomic_bool m_sleeping = false;
+    std::atomic_bool m_exit = false;
 };
 
 template <typename T>
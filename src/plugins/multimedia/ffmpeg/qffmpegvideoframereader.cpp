@@ -0,0 +1,228 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include <QtFFmpegMediaPluginImpl/private/qffmpegvideoframereader_p.h>
+
+#include <QtFFmpegMediaPluginImpl/private/qffmpegvideobuffer_p.h>
+
+#include <QtMultimedia/qplaybackoptions.h>
+#include <QtMultimedia/private/qvideoframe_p.h>
+#include <QtCore/qloggingcategory.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(qLcVideoFrameReader, "qt.multimedia.ffmpeg.videoframereader");
+
+namespace QFFmpeg {
+
+static QMediaFrameExtractor::Error toExtractorError(QMediaPlayer::Error error)
+{
+    switch (error) {
+    case QMediaPlayer::FormatError:
+        return QMediaFrameExtractor::FormatError;
+    case QMediaPlayer::AccessDeniedError:
+        return QMediaFrameExtractor::AccessDeniedError;
+    default:
+        return QMediaFrameExtractor::ResourceError;
+    }
+}
+
+VideoFrameReader::Maybe VideoFrameReader::create(const QUrl &source,
+                                                 const std::shared_ptr<ICancelToken> &cancelToken)
+{
+    const QPlaybackOptions options;
+    MediaDataHolder::Maybe media = MediaDataHolder::create(source, nullptr, options, cancelToken);
+    if (!media)
+        return q23::unexpected{ ExtractionError{ toExtractorError(media.error().code),
+                                                 media.error().description } };
+
+    const int streamIndex = (*media)->currentStreamIndex(QPlatformMediaPlayer::VideoStream);
+    if (streamIndex < 0)
+        return q23::unexpected{ ExtractionError{ QMediaFrameExtractor::FormatError,
+                                                 QStringLiteral("No video stream found") } };
+
+    AVFormatContext *formatContext = (*media)->avContext();
+    auto codecContext =
+            CodecContext::create(formatContext->streams[streamIndex], formatContext, options);
+    if (!codecContext)
+        return q23::unexpected{ ExtractionError{ QMediaFrameExtractor::FormatError,
+                                                 codecContext.error() } };
+
+    // Skip reading the packets of the other streams
+    for (unsigned i = 0; i < formatContext->nb_streams; ++i) {
+        if (int(i) != streamIndex)
+            formatContext->streams[i]->discard = AVDISCARD_ALL;
+    }
+
+    return VideoFrameReader(std::move(*media), std::move(*codecContext), cancelToken);
+}
+
+VideoFrameReader::VideoFrameReader(std::shared_ptr<MediaDataHolder> media,
+                                   CodecContext codecContext,
+                                   std::shared_ptr<ICancelToken> cancelToken)
+    : m_media(std::move(media)),
+      m_codecContext(std::move(codecContext)),
+      m_cancelToken(std::move(cancelToken)),
+      m_transformation(m_media->transformation()),
+      m_packet(av_packet_alloc())
+{
+}
+
+TrackPosition VideoFrameReader::position(const AVFrame &frame) const
+{
+    const qint64 pts = frame.pts != AV_NOPTS_VALUE ? frame.pts : frame.best_effort_timestamp;
+    return m_codecContext.toTrackPosition(AVStreamPosition(pts));
+}
+
+std::optional<TrackPosition> VideoFrameReader::keyFramePosition(TrackPosition position) const
+{
+#if QT_FFMPEG_HAS_AVFORMAT_INDEX_GET_ENTRY
+    AVStream *stream = m_codecContext.stream();
+    const int index = av_index_search_timestamp(stream, toStreamTimestamp(position),
+                                                AVSEEK_FLAG_BACKWARD);
+    if (index < 0)
+        return {};
+
+    if (const AVIndexEntry *entry = avformat_index_get_entry(stream, index))
+        return m_codecContext.toTrackPosition(AVStreamPosition(entry->timestamp));
+#else
+    Q_UNUSED(position);
+#endif
+    return {};
+}
+
+bool VideoFrameReader::canDecodeForward(TrackPosition decodedPosition,
+                                        TrackPosition position) const
+{
+    if (position < decodedPosition)
+        return false;
+
+    const std::optional<TrackPosition> keyFrame = keyFramePosition(position);
+    return keyFrame && *keyFrame <= decodedPosition;
+}
+
+QVideoFrame VideoFrameReader::frameAt(TrackPosition position)
+{
+    if (!m_current || !canDecodeForward(this->position(*m_current), position)) {
+        seek(position);
+        m_current.reset();
+        m_next.reset();
+    }
+
+    // If the seek lands after the position, the first decoded frame is the closest one
+    while (true) {
+        if (!m_next)
+            m_next = read();
+        if (!m_next || (m_current && this->position(*m_next) > position))
+            break;
+        m_current = std::move(m_next);
+    }
+
+    return m_current ? toVideoFrame(*m_current) : QVideoFrame{};
+}
+
+void VideoFrameReader::seek(TrackPosition position)
+{
+    ++m_seekCount;
+
+    const int err = av_seek_frame(m_media->avContext(), m_codecContext.streamIndex(),
+                                  toStreamTimestamp(position), AVSEEK_FLAG_BACKWARD);
+    if (err < 0)
+        qCWarning(qLcVideoFrameReader) << "Failed to seek to" << position.get()
+                                       << "us:" << err2str(err);
+
+    avcodec_flush_buffers(m_codecContext.context());
+}
+
+AVFrameUPtr VideoFrameReader::read()
+{
+    AVFrameUPtr frame = makeAVFrame();
+    while (!m_cancelToken->isCancelled()) {
+        const int ret = avcodec_receive_frame(m_codecContext.context(), frame.get());
+        if (ret >= 0) {
+            ++m_decodedFrameCount;
+            return frame;
+        }
+        if (ret != AVERROR(EAGAIN))
+            return {};
+
+        sendNextPacket();
+    }
+
+    return {};
+}
+
+QVideoFrame VideoFrameReader::toVideoFrame(const AVFrame &frame) const
+{
+    const TrackPosition startTime = position(frame);
+    const auto pixelAspectRatio = m_codecContext.pixelAspectRatio(const_cast<AVFrame *>(&frame));
+    auto buffer = std::make_unique<QFFmpegVideoBuffer>(AVFrameUPtr(av_frame_clone(&frame)),
+                                                       pixelAspectRatio);
+    QVideoFrameFormat format(buffer->size(), buffer->pixelFormat());
+    format.setColorSpace(buffer->colorSpace());
+    format.setColorTransfer(buffer->colorTransfer());
+    format.setColorRange(buffer->colorRange());
+    format.setMaxLuminance(buffer->maxNits());
+    format.setRotation(m_transformation.rotation);
+    format.setMirrored(m_transformation.mirroredHorizontallyAfterRotation);
+    QVideoFrame videoFrame = QVideoFramePrivate::createFrame(std::move(buffer), format);
+    videoFrame.setStartTime(startTime.get());
+    if (const auto duration = getAVFrameDuration(frame))
+        videoFrame.setEndTime(
+                (startTime + m_codecContext.toTrackDuration(AVStreamDuration(duration))).get());
+    return videoFrame;
+}
+
+qint64 VideoFrameReader::toStreamTimestamp(TrackPosition position) const
+{
+    const AVContextPosition contextPosition = toContextPosition(position, m_media->avContext());
+    return av_rescale_q(contextPosition.get(), AV_TIME_BASE_Q, m_codecContext.stream()->time_base);
+}
+
+// Sends the next packet of the video stream to the decoder, or starts draining
+// the decoder at the end of the media. Corrupted packets are skipped by the caller
+// receiving EAGAIN again.
+void VideoFrameReader::sendNextPacket()
+{
+    AVFormatContext *formatContext = m_media->avContext();
+    while (av_read_frame(formatContext, m_packet.get()) >= 0) {
+        const bool isVideoPacket = m_packet->stream_index == int(m_codecContext.streamIndex());
+        if (isVideoPacket)
+            avcodec_send_packet(m_codecContext.context(), m_packet.get());
+
+        av_packet_unref(m_packet.get());
+        if (isVideoPacket)
+            return;
+    }
+
+    avcodec_send_packet(m_codecContext.context(), nullptr);
+}
+
+QList<QList<qint64>> splitIntoChunks(const VideoFrameReader &reader,
+                                     const QList<qint64> &positions, int maxChunkCount)
+{
+    QList<QList<qint64>> groups;
+    std::optional<TrackPosition> groupKeyFrame;
+    for (qint64 position : positions) {
+        const std::optional<TrackPosition> keyFrame =
+                reader.keyFramePosition(toTrackPosition(UserTrackPosition(position)));
+        if (groups.empty() || !keyFrame || keyFrame != groupKeyFrame)
+            groups.emplace_back();
+
+        groups.back().push_back(position);
+        groupKeyFrame = keyFrame;
+    }
+
+    const qsizetype chunkCount = std::clamp<qsizetype>(maxChunkCount, 1, groups.size());
+    QList<QList<qint64>> chunks(chunkCount);
+    for (qsizetype i = 0; i < groups.size(); ++i)
+        chunks[i * chunkCount / groups.size()].append(groups[i]);
+
+    return chunks;
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
@@ -0,0 +1,103 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFFMPEGVIDEOFRAMEREADER_P_H
+#define QFFMPEGVIDEOFRAMEREADER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtFFmpegMediaPluginImpl/private/qffmpegcodeccontext_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegmediadataholder_p.h>
+
+#include <QtMultimedia/qmediaframeextractor.h>
+#include <QtMultimedia/qvideoframe.h>
+#include <QtCore/private/qexpected_p.h>
+
+#include <memory>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+struct ExtractionError
+{
+    QMediaFrameExtractor::Error code = QMediaFrameExtractor::NoError;
+    QString description;
+};
+
+// Decodes the frames of the video stream of a media, seeking only if the
+// requested positions cannot be reached by decoding forward within a GOP.
+// Each reader has its own format context, so that readers can run in parallel.
+class VideoFrameReader
+{
+public:
+    using Maybe = q23::expected<VideoFrameReader, ExtractionError>;
+
+    static Maybe create(const QUrl &source, const std::shared_ptr<ICancelToken> &cancelToken);
+
+    TrackPosition position(const AVFrame &frame) const;
+
+    // Returns the position of the key frame preceding the position, if the demuxer
+    // has indexed it
+    std::optional<TrackPosition> keyFramePosition(TrackPosition position) const;
+
+    // Whether decoding forward from the decoded position reaches the position
+    // without a key frame in between
+    bool canDecodeForward(TrackPosition decodedPosition, TrackPosition position) const;
+
+    // Returns the frame shown at the position, i.e. the last frame starting at or
+    // before it. Consecutive calls with increasing positions in one GOP continue
+    // decoding from the previous frame instead of seeking.
+    QVideoFrame frameAt(TrackPosition position);
+
+    void seek(TrackPosition position);
+
+    // Returns the next decoded frame, or null at the end of the stream
+    AVFrameUPtr read();
+
+    QVideoFrame toVideoFrame(const AVFrame &frame) const;
+
+    int seekCount() const { return m_seekCount; }
+    int decodedFrameCount() const { return m_decodedFrameCount; }
+
+private:
+    VideoFrameReader(std::shared_ptr<MediaDataHolder> media, CodecContext codecContext,
+                     std::shared_ptr<ICancelToken> cancelToken);
+
+    qint64 toStreamTimestamp(TrackPosition position) const;
+
+    void sendNextPacket();
+
+    std::shared_ptr<MediaDataHolder> m_media;
+    CodecContext m_codecContext;
+    std::shared_ptr<ICancelToken> m_cancelToken;
+    VideoTransformation m_transformation;
+    AVPacketUPtr m_packet;
+
+    AVFrameUPtr m_current; // the last decoded frame at or before the requested position
+    AVFrameUPtr m_next; // the first decoded frame after the current one
+
+    int m_seekCount = 0;
+    int m_decodedFrameCount = 0;
+};
+
+// Splits the sorted positions into contiguous chunks, one per worker. Positions
+// sharing a key frame are kept in the same chunk, so that their GOP is decoded once.
+QList<QList<qint64>> splitIntoChunks(const VideoFrameReader &reader,
+                                     const QList<qint64> &positions, int maxChunkCount);
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGVIDEOFRAMEREADER_P_H
@@ -2,16 +2,14 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qv4l2camera_p.h"
+#include "qv4l2capturethread_p.h"
 #include "qv4l2filedescriptor_p.h"
 #include "qv4l2memorytransfer_p.h"
 
 #include <private/qcameradevice_p.h>
 #include <private/qmultimediautils_p.h>
-#include <private/qmemoryvideobuffer_p.h>
-#include <private/qvideoframe_p.h>
 #include <private/qcore_unix_p.h>
 
-#include <qsocketnotifier.h>
 #include <qloggingcategory.h>
 
 QT_BEGIN_NAMESPACE
@@ -356,39 +354,20 @@ void QV4L2Camera::setColorTemperature(int temperature)
         colorTemperatureChanged(t);
 }
 
-void QV4L2Camera::readFrame()
+void QV4L2Camera::onCaptureError(quint64 captureId, int error)
 {
-    Q_ASSERT(m_memoryTransfer);
-
-    auto buffer = m_memoryTransfer->dequeueBuffer();
-    if (!buffer) {
-        qCWarning(qLcV4L2Camera) << "Cannot take buffer";
-
-        if (errno == ENODEV) {
-            // camera got removed while being active
-            stopCapturing();
-            closeV4L2Fd();
-        }
+    if (!m_captureThread || captureId != m_captureId)
+        return; // capturing has been stopped or restarted in the meantime
 
+    if (error == ENODEV) {
+        // camera got removed while being active
+        stopCapturing();
+        closeV4L2Fd();
         return;
     }
 
-    auto videoBuffer = std::make_unique<QMemoryVideoBuffer>(buffer->data, m_bytesPerLine);
-    QVideoFrame frame = QVideoFramePrivate::createFrame(std::move(videoBuffer), frameFormat());
-
-    auto &v4l2Buffer = buffer->v4l2Buffer;
-
-    if (m_firstFrameTime.tv_sec == -1)
-        m_firstFrameTime = v4l2Buffer.timestamp;
-    qint64 secs = v4l2Buffer.timestamp.tv_sec - m_firstFrameTime.tv_sec;
-    qint64 usecs = v4l2Buffer.timestamp.tv_usec - m_firstFrameTime.tv_usec;
-    frame.setStartTime(secs*1000000 + usecs);
-    frame.setEndTime(frame.startTime() + m_frameDuration);
-
-    emit newVideoFrame(frame);
-
-    if (!m_memoryTransfer->enqueueBuffer(v4l2Buffer.index))
-        qCWarning(qLcV4L2Camera) << "Cannot add buffer";
+    stopCapturing();
+    updateError(QCamera::CameraError, QLatin1String("Camera stopped delivering frames"));
 }
 
 void QV4L2Camera::setCameraBusy()
@@ -660,7 +639,8 @@ void QV4L2Camera::stopCapturing()
     if (!m_memoryTransfer || !m_v4l2FileDescriptor)
         return;
 
-    m_notifier = nullptr;
+    // the capture thread uses the memory transfer until it's stopped
+    m_captureThread = nullptr;
 
     if (!m_v4l2FileDescriptor->stopStream()) {
         // TODO: handle the case carefully to avoid possible memory corruption
@@ -688,11 +668,22 @@ void QV4L2Camera::startCapturing()
         return;
     }
 
-    m_notifier =
-            std::make_unique<QSocketNotifier>(m_v4l2FileDescriptor->get(), QSocketNotifier::Read);
-    connect(m_notifier.get(), &QSocketNotifier::activated, this, &QV4L2Camera::readFrame);
-
-    m_firstFrameTime = { -1, -1 };
+    // Frames are dequeued and delivered on a dedicated thread, so that the driver
+    // gets its buffers back in time even if the camera's thread is busy.
+    auto onFrame = [this](const QVideoFrame &frame) {
+        emit newVideoFrame(frame);
+    };
+    // the thread is joined before the camera is destroyed
+    auto onError = [this, captureId = ++m_captureId](int error) {
+        QMetaObject::invokeMethod(this, [this, captureId, error] {
+            onCaptureError(captureId, error);
+        }, Qt::QueuedConnection);
+    };
+
+    m_captureThread = std::make_unique<QV4L2CaptureThread>(
+            m_v4l2FileDescriptor, *m_memoryTransfer, frameFormat(), m_bytesPerLine,
+            m_frameDuration, std::move(onFrame), std::move(onError));
+    m_captureThread->start(QThread::HighestPriority);
 }
 
 QVideoFrameFormat QV4L2Camera::frameFormat() const
@@ -16,13 +16,12 @@
 //
 
 #include <QtMultimedia/private/qplatformcamera_p.h>
-#include <sys/time.h>
 
 QT_BEGIN_NAMESPACE
 
+class QV4L2CaptureThread;
 class QV4L2FileDescriptor;
 class QV4L2MemoryTransfer;
-class QSocketNotifier;
 
 struct V4L2CameraInfo
 {
@@ -94,10 +93,8 @@ public:
 
     QVideoFrameFormat frameFormat() const override;
 
-private Q_SLOTS:
-    void readFrame();
-
 private:
+    void onCaptureError(quint64 captureId, int error);
     void setCameraBusy();
     void initV4L2Controls();
     void closeV4L2Fd();
@@ -114,13 +111,14 @@ private:
     bool m_active = false;
     QCameraDevice m_cameraDevice;
 
-    std::unique_ptr<QSocketNotifier> m_notifier;
+    // destroyed before the memory transfer, see stopCapturing()
     std::unique_ptr<QV4L2MemoryTransfer> m_memoryTransfer;
+    std::unique_ptr<QV4L2CaptureThread> m_captureThread;
+    quint64 m_captureId = 0;
     std::shared_ptr<QV4L2FileDescriptor> m_v4l2FileDescriptor;
 
     V4L2CameraInfo m_v4l2Info;
 
-    timeval m_firstFrameTime = { -1, -1 };
     quint32 m_bytesPerLine = 0;
     quint32 m_imageSize = 0;
     QVideoFrameFormat::ColorSpace m_colorSpace = QVideoFrameFormat::ColorSpace_Undefined;
@@ -8,12 +8,16 @@
 #include <private/qcameradevice_p.h>
 #include <private/qcore_unix_p.h>
 
+#include <QtConcurrent/qtconcurrentrun.h>
+
 #include <qdir.h>
 #include <qfile.h>
 #include <qdebug.h>
 #include <qloggingcategory.h>
+#include <qscopeguard.h>
 
 #include <linux/videodev2.h>
+#include <sys/stat.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -30,150 +34,266 @@ static bool areCamerasEqual(QList<QCameraDevice> a, QList<QCameraDevice> b)
     return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend(), areCamerasDataEqual);
 }
 
-QV4L2CameraDevices::QV4L2CameraDevices(QPlatformMediaIntegration *integration)
-    : QPlatformVideoDevices(integration)
+QV4L2CameraDevices::QV4L2CameraDevices(QPlatformMediaIntegration *integration,
+                                       QString deviceDirectory, NodeProber prober)
+    : QPlatformVideoDevices(integration),
+      m_deviceDirectory(std::move(deviceDirectory)),
+      m_prober(prober ? std::move(prober)
+                      : [this](const QByteArray &file, ProbedNode &node,
+                               QHash<QByteArray, Capabilities> &capabilities) {
+                            return probeNode(file, node, capabilities);
+                        })
 {
-    m_deviceWatcher.addPath(QLatin1String("/dev"));
+    m_deviceWatcher.addPath(m_deviceDirectory);
     connect(&m_deviceWatcher, &QFileSystemWatcher::directoryChanged, this,
             &QV4L2CameraDevices::checkCameras);
-    doCheckCameras();
+    startScan();
+}
+
+QV4L2CameraDevices::~QV4L2CameraDevices()
+{
+    // the scan accesses the caches of this object
+    m_scanFuture.waitForFinished();
 }
 
 QList<QCameraDevice> QV4L2CameraDevices::findVideoInputs() const
 {
+    QMutexLocker locker(&m_mutex);
+
+    // Reporting no cameras before the first scan is done would make applications
+    // that query the cameras at startup miss them. The scan never waits for this thread.
+    while (!m_firstScanDone)
+        m_firstScanFinished.wait(&m_mutex);
+
     return m_cameras;
 }
 
 void QV4L2CameraDevices::checkCameras()
 {
-    if (doCheckCameras())
-        onVideoInputsChanged();
+    startScan();
 }
 
-bool QV4L2CameraDevices::doCheckCameras()
+void QV4L2CameraDevices::startScan()
 {
+    if (m_scanning) {
+        m_rescanRequested = true;
+        return;
+    }
+
+    m_scanning = true;
+    m_scanFuture = QtConcurrent::run([this] {
+        scan();
+    });
+    m_scanFuture.then(this, [this] {
+        m_scanning = false;
+        if (std::exchange(m_rescanRequested, false))
+            startScan();
+    });
+}
+
+void QV4L2CameraDevices::scan()
+{
+    QHash<QByteArray, ProbedNode> probedNodes;
+    QHash<QByteArray, Capabilities> capabilities;
     QList<QCameraDevice> newCameras;
 
-    QDir dir(QLatin1String("/dev"));
+    QDir dir(m_deviceDirectory);
     const auto devices = dir.entryList(QDir::System);
 
-    bool first = true;
-
-    for (auto device : devices) {
-        //        qCDebug(qLcV4L2Camera) << "device:" << device;
+    for (const auto &device : devices) {
         if (!device.startsWith(QLatin1String("video")))
             continue;
 
         QByteArray file = QFile::encodeName(dir.filePath(device));
-        const int fd = open(file.constData(), O_RDONLY);
-        if (fd < 0)
+
+        struct stat fileStat;
+        if (::stat(file.constData(), &fileStat) != 0)
             continue;
 
-        auto fileCloseGuard = qScopeGuard([fd]() { close(fd); });
+        const qint64 changeTime =
+                qint64(fileStat.st_ctim.tv_sec) * 1'000'000'000 + fileStat.st_ctim.tv_nsec;
+
+        ProbedNode node;
+        const auto cached = m_probedNodes.constFind(file);
+        if (cached != m_probedNodes.cend() && cached->device == fileStat.st_rdev
+            && cached->changeTime == changeTime) {
+            qCDebug(qLcV4L2CameraDevices) << "node" << file << "is unchanged";
+            node = *cached;
+
+            if (auto it = m_capabilities.constFind(node.capabilitiesKey);
+                it != m_capabilities.cend())
+                capabilities.insert(it.key(), *it);
+        } else {
+            node.device = fileStat.st_rdev;
+            node.changeTime = changeTime;
+
+            // nodes that cannot be queried are not cached, so that they are tried again
+            if (!m_prober(file, node, capabilities))
+                continue;
+        }
 
-        v4l2_fmtdesc formatDesc = {};
+        if (!node.camera.isNull())
+            newCameras.append(node.camera);
 
-        struct v4l2_capability cap;
-        if (xioctl(fd, VIDIOC_QUERYCAP, &cap) < 0)
-            continue;
+        probedNodes.insert(file, std::move(node));
+    }
 
-        if (cap.device_caps & V4L2_CAP_META_CAPTURE)
-            continue;
-        if (!(cap.capabilities & V4L2_CAP_VIDEO_CAPTURE))
-            continue;
-        if (!(cap.capabilities & V4L2_CAP_STREAMING))
-            continue;
+    // first camera is default
+    if (!newCameras.empty()) {
+        auto defaultCamera =
+                std::make_unique<QCameraDevicePrivate>(*QCameraDevicePrivate::handle(newCameras[0]));
+        defaultCamera->isDefault = true;
+        newCameras[0] = defaultCamera.release()->create();
+    }
 
-        auto camera = std::make_unique<QCameraDevicePrivate>();
+    // the capabilities of removed devices are dropped
+    m_probedNodes = std::move(probedNodes);
+    m_capabilities = std::move(capabilities);
+
+    bool changed = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        changed = !areCamerasEqual(m_cameras, newCameras);
+        m_cameras = std::move(newCameras);
+        m_firstScanDone = true;
+        m_firstScanFinished.wakeAll();
+    }
 
-        camera->id = file;
-        camera->description = QString::fromUtf8((const char *)cap.card);
-        qCDebug(qLcV4L2CameraDevices) << "found camera" << camera->id << camera->description;
+    // Notify on the thread of this object; queued calls are dropped if it's destroyed
+    if (changed)
+        QMetaObject::invokeMethod(this, [this] { onVideoInputsChanged(); },
+                                  Qt::QueuedConnection);
+}
 
-        formatDesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+QV4L2CameraDevices::Capabilities QV4L2CameraDevices::enumerateFormats(int fd)
+{
+    Capabilities formats;
 
-        while (!xioctl(fd, VIDIOC_ENUM_FMT, &formatDesc)) {
-            auto pixelFmt = formatForV4L2Format(formatDesc.pixelformat);
-            qCDebug(qLcV4L2CameraDevices) << "    " << pixelFmt;
+    v4l2_fmtdesc formatDesc = {};
+    formatDesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
 
-            if (pixelFmt == QVideoFrameFormat::Format_Invalid) {
-                ++formatDesc.index;
-                continue;
-            }
+    while (!xioctl(fd, VIDIOC_ENUM_FMT, &formatDesc)) {
+        auto pixelFmt = formatForV4L2Format(formatDesc.pixelformat);
+        qCDebug(qLcV4L2CameraDevices) << "    " << pixelFmt;
 
-            qCDebug(qLcV4L2CameraDevices) << "frame sizes:";
-            v4l2_frmsizeenum frameSize = {};
-            frameSize.pixel_format = formatDesc.pixelformat;
-
-            while (!xioctl(fd, VIDIOC_ENUM_FRAMESIZES, &frameSize)) {
-                QList<QSize> resolutions;
-                if (frameSize.type == V4L2_FRMSIZE_TYPE_DISCRETE) {
-                    resolutions.append(QSize(frameSize.discrete.width,
-                                             frameSize.discrete.height));
-                } else {
-                    resolutions.append(QSize(frameSize.stepwise.max_width,
-                                             frameSize.stepwise.max_height));
-                    resolutions.append(QSize(frameSize.stepwise.min_width,
-                                             frameSize.stepwise.min_height));
-                }
+        if (pixelFmt == QVideoFrameFormat::Format_Invalid) {
+            ++formatDesc.index;
+            continue;
+        }
+
+        qCDebug(qLcV4L2CameraDevices) << "frame sizes:";
+        v4l2_frmsizeenum frameSize = {};
+        frameSize.pixel_format = formatDesc.pixelformat;
+
+        while (!xioctl(fd, VIDIOC_ENUM_FRAMESIZES, &frameSize)) {
+            QList<QSize> resolutions;
+            if (frameSize.type == V4L2_FRMSIZE_TYPE_DISCRETE) {
+                resolutions.append(QSize(frameSize.discrete.width,
+                                         frameSize.discrete.height));
+            } else {
+                resolutions.append(QSize(frameSize.stepwise.max_width,
+                                         frameSize.stepwise.max_height));
+                resolutions.append(QSize(frameSize.stepwise.min_width,
+                                         frameSize.stepwise.min_height));
+            }
 
-                for (auto resolution : resolutions) {
-                    float min = 1e10;
-                    float max = 0;
-                    auto updateMaxMinFrameRate = [&max, &min](auto discreteFrameRate) {
-                        const float rate = float(discreteFrameRate.denominator)
-                                           / float(discreteFrameRate.numerator);
-                        if (rate > max)
-                            max = rate;
-                        if (rate < min)
-                            min = rate;
-                    };
-
-                    v4l2_frmivalenum frameInterval = {};
-                    frameInterval.pixel_format = formatDesc.pixelformat;
-                    frameInterval.width = resolution.width();
-                    frameInterval.height = resolution.height();
-
-                    while (!xioctl(fd, VIDIOC_ENUM_FRAMEINTERVALS, &frameInterval)) {
-                        if (frameInterval.type == V4L2_FRMIVAL_TYPE_DISCRETE) {
-                            updateMaxMinFrameRate(frameInterval.discrete);
-                        } else {
-                            updateMaxMinFrameRate(frameInterval.stepwise.max);
-                            updateMaxMinFrameRate(frameInterval.stepwise.min);
-                        }
-                        ++frameInterval.index;
+            for (auto resolution : resolutions) {
+                float min = 1e10;
+                float max = 0;
+                auto updateMaxMinFrameRate = [&max, &min](auto discreteFrameRate) {
+                    const float rate = float(discreteFrameRate.denominator)
+                                       / float(discreteFrameRate.numerator);
+                    if (rate > max)
+                        max = rate;
+                    if (rate < min)
+                        min = rate;
+                };
+
+                v4l2_frmivalenum frameInterval = {};
+                frameInterval.pixel_format = formatDesc.pixelformat;
+                frameInterval.width = resolution.width();
+                frameInterval.height = resolution.height();
+
+                while (!xioctl(fd, VIDIOC_ENUM_FRAMEINTERVALS, &frameInterval)) {
+                    if (frameInterval.type == V4L2_FRMIVAL_TYPE_DISCRETE) {
+                        updateMaxMinFrameRate(frameInterval.discrete);
+                    } else {
+                        updateMaxMinFrameRate(frameInterval.stepwise.max);
+                        updateMaxMinFrameRate(frameInterval.stepwise.min);
                     }
+                    ++frameInterval.index;
+                }
 
-                    qCDebug(qLcV4L2CameraDevices) << "    " << resolution << min << max;
+                qCDebug(qLcV4L2CameraDevices) << "    " << resolution << min << max;
 
-                    if (min <= max) {
-                        auto fmt = std::make_unique<QCameraFormatPrivate>();
-                        fmt->pixelFormat = pixelFmt;
-                        fmt->resolution = resolution;
-                        fmt->minFrameRate = min;
-                        fmt->maxFrameRate = max;
-                        camera->videoFormats.append(fmt.release()->create());
-                        camera->photoResolutions.append(resolution);
-                    }
+                if (min <= max) {
+                    auto fmt = std::make_unique<QCameraFormatPrivate>();
+                    fmt->pixelFormat = pixelFmt;
+                    fmt->resolution = resolution;
+                    fmt->minFrameRate = min;
+                    fmt->maxFrameRate = max;
+                    formats.videoFormats.append(fmt.release()->create());
+                    formats.photoResolutions.append(resolution);
                 }
-                ++frameSize.index;
             }
-            ++formatDesc.index;
+            ++frameSize.index;
         }
+        ++formatDesc.index;
+    }
 
-        if (camera->videoFormats.empty())
-            continue;
+    return formats;
+}
 
-        // first camera is default
-        camera->isDefault = std::exchange(first, false);
+bool QV4L2CameraDevices::probeNode(const QByteArray &file, ProbedNode &node,
+                                   QHash<QByteArray, Capabilities> &capabilities)
+{
+    const int fd = qt_safe_open(file.constData(), O_RDONLY);
+    if (fd < 0)
+        return false;
 
-        newCameras.append(camera.release()->create());
-    }
+    auto fileCloseGuard = qScopeGuard([fd]() { qt_safe_close(fd); });
 
-    if (areCamerasEqual(m_cameras, newCameras))
+    struct v4l2_capability cap;
+    if (xioctl(fd, VIDIOC_QUERYCAP, &cap) < 0)
         return false;
 
-    m_cameras = std::move(newCameras);
+    if (cap.device_caps & V4L2_CAP_META_CAPTURE)
+        return true;
+    if (!(cap.capabilities & V4L2_CAP_VIDEO_CAPTURE))
+        return true;
+    if (!(cap.capabilities & V4L2_CAP_STREAMING))
+        return true;
+
+    auto camera = std::make_unique<QCameraDevicePrivate>();
+
+    camera->id = file;
+    camera->description = QString::fromUtf8((const char *)cap.card);
+    qCDebug(qLcV4L2CameraDevices) << "found camera" << camera->id << camera->description;
+
+    // All nodes of a device have the same bus info, but may capture different streams with
+    // different formats, like the main and self paths of an ISP or the RGB and IR sensors of
+    // a camera. The device number tells the nodes apart.
+    node.capabilitiesKey = QByteArray((const char *)cap.driver) + '/'
+            + QByteArray((const char *)cap.card) + '/' + QByteArray((const char *)cap.bus_info)
+            + '/' + QByteArray::number(quint64(node.device));
+
+    // Reuse the formats found by the previous scan, if the node has only been touched
+    Capabilities formats;
+    if (auto it = m_capabilities.constFind(node.capabilitiesKey); it != m_capabilities.cend()) {
+        qCDebug(qLcV4L2CameraDevices) << "    using cached formats of" << node.capabilitiesKey;
+        formats = *it;
+    } else {
+        formats = enumerateFormats(fd);
+    }
+
+    capabilities.insert(node.capabilitiesKey, formats);
+
+    if (formats.videoFormats.empty())
+        return true;
+
+    camera->videoFormats = std::move(formats.videoFormats);
+    camera->photoResolutions = std::move(formats.photoResolutions);
+    node.camera = camera.release()->create();
     return true;
 }
 
@@ -19,26 +19,83 @@
 #include <QtMultimedia/private/qplatformmediaintegration_p.h>
 
 #include <qfilesystemwatcher.h>
+#include <qfuture.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+
+#include <functional>
+
+#include <sys/types.h>
 
 QT_BEGIN_NAMESPACE
 
+// Enumerates the cameras on the thread pool. Nodes in /dev are only probed again if they
+// changed, and the formats of a node are reused if it is probed again with the same device
+// number and capabilities.
 class QV4L2CameraDevices : public QPlatformVideoDevices
 {
     Q_OBJECT
 public:
-    QV4L2CameraDevices(QPlatformMediaIntegration *integration);
+    struct ProbedNode
+    {
+        dev_t device = 0;
+        qint64 changeTime = 0;
+        QCameraDevice camera; // null if the node is not a camera
+        QByteArray capabilitiesKey;
+    };
+
+    struct Capabilities
+    {
+        QList<QCameraFormat> videoFormats;
+        QList<QSize> photoResolutions;
+    };
+
+    // Fills in the node and adds its capabilities. Returns false if the node cannot be
+    // queried. Called on the thread pool, possibly before the constructor returns.
+    using NodeProber = std::function<bool(const QByteArray &file, ProbedNode &node,
+                                          QHash<QByteArray, Capabilities> &capabilities)>;
+
+    // Nodes are probed with V4L2 ioctls, unless another prober is given
+    QV4L2CameraDevices(QPlatformMediaIntegration *integration,
+                       QString deviceDirectory = QStringLiteral("/dev"),
+                       NodeProber prober = {});
+    ~QV4L2CameraDevices() override;
 
 public Q_SLOTS:
     void checkCameras();
 
 protected:
+    // Returns the last known cameras; only waits for the very first enumeration
     QList<QCameraDevice> findVideoInputs() const override;
 
 private:
-    bool doCheckCameras();
+    bool probeNode(const QByteArray &file, ProbedNode &node,
+                   QHash<QByteArray, Capabilities> &capabilities);
+
+    void startScan();
+    void scan();
+
+    static Capabilities enumerateFormats(int fd);
 
 private:
+    const QString m_deviceDirectory;
+    const NodeProber m_prober;
+
+    mutable QMutex m_mutex;
+    mutable QWaitCondition m_firstScanFinished;
     QList<QCameraDevice> m_cameras;
+    bool m_firstScanDone = false;
+
+    // Scans never overlap, so the caches are only accessed by one scan at a time.
+    // Nodes are keyed by path, capabilities by driver, card, bus info and device number.
+    QHash<QByteArray, ProbedNode> m_probedNodes;
+    QHash<QByteArray, Capabilities> m_capabilities;
+
+    QFuture<void> m_scanFuture;
+    bool m_scanning = false;
+    bool m_rescanRequested = false;
+
     QFileSystemWatcher m_deviceWatcher;
 };
 
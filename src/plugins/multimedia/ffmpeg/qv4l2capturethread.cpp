@@ -0,0 +1,225 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qv4l2capturethread_p.h"
+#include "qv4l2filedescriptor_p.h"
+#include "qv4l2memorytransfer_p.h"
+
+#include <private/qcore_unix_p.h>
+#include <private/qmemoryvideobuffer_p.h>
+#include <private/qvideoframe_p.h>
+
+#include <qloggingcategory.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(qLcV4L2CaptureThread, "qt.multimedia.ffmpeg.v4l2camera.capturethread");
+
+qint64 QV4L2FrameClock::monotonicTimeUs()
+{
+    timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return qint64(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+qint64 QV4L2FrameClock::frameTime(const v4l2_buffer &buffer, qint64 dequeueTimeUs)
+{
+    const qint64 driverTime = qint64(buffer.timestamp.tv_sec) * 1000000 + buffer.timestamp.tv_usec;
+
+    // Decided once per stream, so that all frames are on the same clock
+    if (!m_useDriverTimestamps) {
+        const bool isMonotonic = (buffer.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK)
+                == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC;
+        m_useDriverTimestamps = isMonotonic && driverTime != 0;
+        qCDebug(qLcV4L2CaptureThread) << "Using driver timestamps:" << *m_useDriverTimestamps;
+    }
+
+    // The dequeue time is on the same clock, so it can stand in for a missing stamp
+    if (*m_useDriverTimestamps && driverTime != 0)
+        return driverTime;
+    return dequeueTimeUs;
+}
+
+QV4L2CaptureThread::QV4L2CaptureThread(std::shared_ptr<QV4L2FileDescriptor> fileDescriptor,
+                                       QV4L2MemoryTransfer &memoryTransfer,
+                                       QVideoFrameFormat frameFormat, quint32 bytesPerLine,
+                                       qint64 frameDuration, FrameCallback frameCallback,
+                                       ErrorCallback errorCallback)
+    : m_fileDescriptor(std::move(fileDescriptor)),
+      m_memoryTransfer(memoryTransfer),
+      m_frameFormat(std::move(frameFormat)),
+      m_bytesPerLine(bytesPerLine),
+      m_frameDuration(frameDuration),
+      m_frameCallback(std::move(frameCallback)),
+      m_errorCallback(std::move(errorCallback)),
+      m_wakeUpFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+    Q_ASSERT(m_fileDescriptor);
+
+    if (m_wakeUpFd < 0)
+        qCWarning(qLcV4L2CaptureThread) << "Cannot create eventfd:" << qt_error_string(errno);
+
+    setObjectName(QStringLiteral("V4L2CaptureThread"));
+}
+
+QV4L2CaptureThread::~QV4L2CaptureThread()
+{
+    stop();
+
+    if (m_wakeUpFd >= 0)
+        qt_safe_close(m_wakeUpFd);
+}
+
+void QV4L2CaptureThread::stop()
+{
+    if (!isRunning())
+        return;
+
+    requestInterruption();
+
+    if (m_wakeUpFd >= 0) {
+        const quint64 value = 1;
+        if (qt_safe_write(m_wakeUpFd, &value, sizeof(value)) < 0)
+            qCWarning(qLcV4L2CaptureThread) << "Cannot wake up capture thread";
+    }
+
+    wait();
+}
+
+QV4L2CaptureThread::DeviceEvent QV4L2CaptureThread::deviceEvent(short pollEvents)
+{
+    if (pollEvents & (POLLHUP | POLLNVAL))
+        return DeviceEvent::Disconnected;
+    if (pollEvents & POLLIN)
+        return DeviceEvent::FrameReady;
+    // V4L2 reports POLLERR if no buffers are queued or the stream is not on
+    if (pollEvents & POLLERR)
+        return DeviceEvent::Error;
+    return DeviceEvent::None;
+}
+
+void QV4L2CaptureThread::run()
+{
+    pollfd fds[] = {
+        { m_fileDescriptor->get(), POLLIN, 0 },
+        { m_wakeUpFd, POLLIN, 0 },
+    };
+
+    // Without eventfd, check for the stop request periodically
+    const nfds_t fdCount = m_wakeUpFd >= 0 ? 2 : 1;
+    const int timeout = m_wakeUpFd >= 0 ? -1 : 100;
+
+    while (!isInterruptionRequested()) {
+        if (const int error = requeueBuffers()) {
+            m_errorCallback(error);
+            return;
+        }
+
+        int result = 0;
+        do {
+            result = ::poll(fds, fdCount, timeout);
+        } while (result < 0 && errno == EINTR);
+
+        if (result < 0) {
+            const int error = errno;
+            qCWarning(qLcV4L2CaptureThread) << "poll failed:" << qt_error_string(error);
+            m_errorCallback(error);
+            return;
+        }
+
+        if (fdCount > 1 && fds[1].revents)
+            break; // stop requested
+
+        switch (deviceEvent(fds[0].revents)) {
+        case DeviceEvent::None:
+            break;
+        case DeviceEvent::FrameReady:
+            if (const int error = readFrame()) {
+                m_errorCallback(error);
+                return;
+            }
+            break;
+        case DeviceEvent::Error:
+            // Buffers that failed to be queued are retried at the next iteration
+            if (m_deviceErrorCount++ == 0)
+                qCWarning(qLcV4L2CaptureThread) << "Camera device reported an error, retrying";
+            waitBeforeRetry();
+            break;
+        case DeviceEvent::Disconnected:
+            qCWarning(qLcV4L2CaptureThread) << "Camera device disconnected";
+            m_errorCallback(ENODEV);
+            return;
+        }
+    }
+}
+
+int QV4L2CaptureThread::requeueBuffers()
+{
+    while (!m_unqueuedBuffers.empty()) {
+        if (!m_memoryTransfer.enqueueBuffer(m_unqueuedBuffers.back()))
+            return errno == ENODEV ? ENODEV : 0;
+        m_unqueuedBuffers.pop_back();
+    }
+    return 0;
+}
+
+void QV4L2CaptureThread::waitBeforeRetry()
+{
+    const int timeoutMs = qMax(1, int(m_frameDuration / 1000));
+    if (m_wakeUpFd < 0) {
+        QThread::msleep(timeoutMs);
+        return;
+    }
+
+    // Interrupted by the stop request
+    pollfd wakeUp = { m_wakeUpFd, POLLIN, 0 };
+    ::poll(&wakeUp, 1, timeoutMs);
+}
+
+int QV4L2CaptureThread::readFrame()
+{
+    auto buffer = m_memoryTransfer.dequeueBuffer();
+    if (!buffer) {
+        qCWarning(qLcV4L2CaptureThread) << "Cannot take buffer";
+
+        // the camera got removed while being active
+        return errno == ENODEV ? ENODEV : 0;
+    }
+
+    auto &v4l2Buffer = buffer->v4l2Buffer;
+    m_deviceErrorCount = 0;
+
+    const qint64 timestamp =
+            m_frameClock.frameTime(v4l2Buffer, QV4L2FrameClock::monotonicTimeUs());
+    if (m_firstFrameTime < 0)
+        m_firstFrameTime = timestamp;
+
+    if (v4l2Buffer.flags & V4L2_BUF_FLAG_ERROR)
+        qCDebug(qLcV4L2CaptureThread) << "Buffer" << v4l2Buffer.index << "might be corrupted";
+
+    auto videoBuffer = std::make_unique<QMemoryVideoBuffer>(std::move(buffer->data),
+                                                            m_bytesPerLine);
+    QVideoFrame frame = QVideoFramePrivate::createFrame(std::move(videoBuffer), m_frameFormat);
+    frame.setStartTime(timestamp - m_firstFrameTime);
+    frame.setEndTime(frame.startTime() + m_frameDuration);
+
+    // Hand the buffer back to the driver before the frame is processed downstream
+    int error = 0;
+    if (!m_memoryTransfer.enqueueBuffer(v4l2Buffer.index)) {
+        qCWarning(qLcV4L2CaptureThread) << "Cannot add buffer";
+        if (errno == ENODEV)
+            error = ENODEV;
+        else
+            m_unqueuedBuffers.push_back(v4l2Buffer.index);
+    }
+
+    m_frameCallback(frame);
+
+    return error;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,118 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QV4L2CAPTURETHREAD_P_H
+#define QV4L2CAPTURETHREAD_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qvideoframe.h>
+#include <QtCore/qthread.h>
+
+#include <linux/videodev2.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QV4L2FileDescriptor;
+class QV4L2MemoryTransfer;
+
+/*!
+    Provides the capture times of the frames of a stream on a single clock.
+
+    The driver's buffer timestamps are used if they are on the monotonic clock, since
+    they don't depend on how late the buffers are dequeued. Otherwise, e.g. for drivers
+    that don't stamp buffers or use another clock, the dequeue time on the monotonic
+    clock is used for all frames of the stream.
+ */
+class QV4L2FrameClock
+{
+public:
+    // Returns the capture time in microseconds
+    qint64 frameTime(const v4l2_buffer &buffer, qint64 dequeueTimeUs);
+
+    static qint64 monotonicTimeUs();
+
+private:
+    std::optional<bool> m_useDriverTimestamps;
+};
+
+/*!
+    Dequeues the frames of a streaming V4L2 device on a dedicated thread and hands them
+    over to the frame callback right away, so that a busy camera thread cannot starve
+    the driver's buffer queue.
+
+    The thread only uses the memory transfer while running; it must be destroyed
+    before the memory transfer and before the stream is stopped.
+ */
+class QV4L2CaptureThread : public QThread
+{
+public:
+    // Called on the capture thread
+    using FrameCallback = std::function<void(const QVideoFrame &)>;
+    // Called on the capture thread with errno, right before the thread exits
+    using ErrorCallback = std::function<void(int)>;
+
+    QV4L2CaptureThread(std::shared_ptr<QV4L2FileDescriptor> fileDescriptor,
+                       QV4L2MemoryTransfer &memoryTransfer, QVideoFrameFormat frameFormat,
+                       quint32 bytesPerLine, qint64 frameDuration, FrameCallback frameCallback,
+                       ErrorCallback errorCallback);
+
+    ~QV4L2CaptureThread() override;
+
+    void stop();
+
+    enum class DeviceEvent {
+        None,
+        FrameReady,
+        Error, // recoverable, e.g. no buffers are queued
+        Disconnected,
+    };
+
+    static DeviceEvent deviceEvent(short pollEvents);
+
+protected:
+    void run() override;
+
+private:
+    // Return the error that stops capturing, or 0
+    int readFrame();
+    int requeueBuffers();
+
+    void waitBeforeRetry();
+
+    const std::shared_ptr<QV4L2FileDescriptor> m_fileDescriptor;
+    QV4L2MemoryTransfer &m_memoryTransfer;
+    const QVideoFrameFormat m_frameFormat;
+    const quint32 m_bytesPerLine;
+    const qint64 m_frameDuration;
+    const FrameCallback m_frameCallback;
+    const ErrorCallback m_errorCallback;
+
+    // eventfd to wake up the capture loop when stopping
+    int m_wakeUpFd = -1;
+
+    // Buffers that could not be handed back to the driver yet
+    std::vector<quint32> m_unqueuedBuffers;
+    int m_deviceErrorCount = 0;
+
+    QV4L2FrameClock m_frameClock;
+    qint64 m_firstFrameTime = -1;
+};
+
+QT_END_NAMESPACE
+
+#endif // QV4L2CAPTURETHREAD_P_H
@@ -15,6 +15,10 @@ Q_STATIC_LOGGING_CATEGORY(qLcV4L2MemoryTransfer, "qt.multimedia.ffmpeg.v4l2camer
 
 namespace {
 
+// One buffer is being filled by the driver, one is being dequeued, and the rest
+// absorbs scheduling jitter of the capture thread
+constexpr quint32 requestedBuffersCount = 4;
+
 v4l2_buffer makeV4l2Buffer(quint32 memoryType, quint32 index = 0)
 {
     v4l2_buffer buf = {};
@@ -29,7 +33,7 @@ class UserPtrMemoryTransfer : public QV4L2MemoryTransfer
 public:
     static QV4L2MemoryTransferUPtr create(QV4L2FileDescriptorPtr fileDescriptor, quint32 imageSize)
     {
-        quint32 buffersCount = 2;
+        quint32 buffersCount = requestedBuffersCount;
         if (!fileDescriptor->requestBuffers(V4L2_MEMORY_USERPTR, buffersCount)) {
             qCWarning(qLcV4L2MemoryTransfer) << "Cannot request V4L2_MEMORY_USERPTR buffers";
             return {};
@@ -108,7 +112,7 @@ public:
 
     static QV4L2MemoryTransferUPtr create(QV4L2FileDescriptorPtr fileDescriptor)
     {
-        quint32 buffersCount = 2;
+        quint32 buffersCount = requestedBuffersCount;
         if (!fileDescriptor->requestBuffers(V4L2_MEMORY_MMAP, buffersCount)) {
             qCWarning(qLcV4L2MemoryTransfer) << "Cannot request V4L2_MEMORY_MMAP buffers";
             return {};
@@ -0,0 +1,116 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qffmpegaudiobufferqueue_p.h"
+
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qelapsedtimer.h>
+
+#include <algorithm>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+using namespace std::chrono;
+
+AudioBufferQueue::AudioBufferQueue(microseconds maxDuration, AudioQueueOverflowPolicy policy,
+                                   microseconds maxWaitTime)
+    : m_maxDuration(maxDuration), m_policy(policy), m_maxWaitTime(std::min(maxWaitTime, maxDuration))
+{
+}
+
+AudioBufferQueue::PushResult AudioBufferQueue::push(const QAudioBuffer &buffer, bool canBlock)
+{
+    const microseconds bufferDuration(buffer.duration());
+
+    if (isFull() && !(canBlock && m_policy == AudioQueueOverflowPolicy::Block && waitForSpace())) {
+        drop(bufferDuration);
+        return m_policy == AudioQueueOverflowPolicy::Error ? PushResult::Overflow
+                                                           : PushResult::Dropped;
+    }
+
+    // Account the duration before pushing so that the consumer never observes
+    // a negative queue duration.
+    const Rep duration = m_duration.fetch_add(bufferDuration.count()) + bufferDuration.count();
+
+    Entry entry{ buffer, std::exchange(m_pendingGap, microseconds(0)) };
+    if (!m_queue.push(std::move(entry))) {
+        m_duration.fetch_sub(bufferDuration.count());
+        m_pendingGap = entry.gapBefore;
+        drop(bufferDuration);
+        return m_policy == AudioQueueOverflowPolicy::Error ? PushResult::Overflow
+                                                           : PushResult::Dropped;
+    }
+
+    // Only the producer updates the peak
+    if (duration > m_peakDuration.load(std::memory_order_relaxed))
+        m_peakDuration.store(duration, std::memory_order_relaxed);
+
+    return PushResult::Pushed;
+}
+
+std::optional<AudioBufferQueue::Entry> AudioBufferQueue::pop()
+{
+    std::optional<Entry> entry = m_queue.pop();
+    if (!entry)
+        return entry;
+
+    m_duration.fetch_sub(entry->buffer.duration());
+
+    if (m_producerWaiting) {
+        QMutexLocker locker(&m_spaceMutex);
+        m_spaceFreed.wakeAll();
+    }
+
+    return entry;
+}
+
+AudioQueueStatistics AudioBufferQueue::statistics() const
+{
+    AudioQueueStatistics result;
+    result.bufferCount = size();
+    result.duration = duration();
+    result.peakDuration = microseconds(m_peakDuration.load(std::memory_order_relaxed));
+    result.droppedBufferCount = m_droppedBufferCount.load(std::memory_order_relaxed);
+    result.droppedDuration = microseconds(m_droppedDuration.load(std::memory_order_relaxed));
+    result.blockedPushCount = m_blockedPushCount.load(std::memory_order_relaxed);
+    result.blockedTime = microseconds(m_blockedTime.load(std::memory_order_relaxed));
+    return result;
+}
+
+bool AudioBufferQueue::waitForSpace()
+{
+    // The producer gives the consumer at most the max wait time to catch up. Audio sources
+    // push from their capture thread, which must not miss the device's next period.
+    QElapsedTimer timer;
+    timer.start();
+    const QDeadlineTimer deadline(duration_cast<milliseconds>(m_maxWaitTime));
+
+    {
+        QMutexLocker locker(&m_spaceMutex);
+        // Setting the flag and checking the queue under the mutex guarantees
+        // that pop() cannot free space without waking us up.
+        m_producerWaiting = true;
+        while (isFull() && !deadline.hasExpired())
+            m_spaceFreed.wait(&m_spaceMutex, deadline);
+        m_producerWaiting = false;
+    }
+
+    m_blockedPushCount.fetch_add(1, std::memory_order_relaxed);
+    m_blockedTime.fetch_add(timer.nsecsElapsed() / 1000, std::memory_order_relaxed);
+
+    return !isFull();
+}
+
+void AudioBufferQueue::drop(microseconds bufferDuration)
+{
+    m_pendingGap += bufferDuration;
+    m_droppedBufferCount.fetch_add(1, std::memory_order_relaxed);
+    m_droppedDuration.fetch_add(bufferDuration.count(), std::memory_order_relaxed);
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
@@ -0,0 +1,135 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFFMPEGAUDIOBUFFERQUEUE_P_H
+#define QFFMPEGAUDIOBUFFERQUEUE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtFFmpegMediaPluginImpl/private/qffmpegboundedqueue_p.h>
+#include <QtMultimedia/qaudiobuffer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+enum class AudioQueueOverflowPolicy {
+    Block, // the producer waits for the encoder, up to the max wait time, then drops
+    DropAndMarkGap, // the buffer is dropped, and the encoder skips its duration
+    Error, // like DropAndMarkGap, and the recording reports an error
+};
+
+struct AudioQueueStatistics
+{
+    size_t bufferCount = 0;
+    std::chrono::microseconds duration{ 0 };
+    std::chrono::microseconds peakDuration{ 0 };
+    quint64 droppedBufferCount = 0;
+    std::chrono::microseconds droppedDuration{ 0 };
+    quint64 blockedPushCount = 0;
+    std::chrono::microseconds blockedTime{ 0 };
+};
+
+/*!
+    Queue of audio buffers between a single producer and the audio encoder thread,
+    bounded by the total duration of the queued buffers. If the encoder cannot keep
+    up, push() applies the overflow policy.
+
+    Dropped buffers aren't lost from the timeline: their duration is passed
+    to the consumer with the next queued buffer as a gap.
+ */
+class AudioBufferQueue
+{
+public:
+    struct Entry
+    {
+        QAudioBuffer buffer;
+        std::chrono::microseconds gapBefore{ 0 };
+    };
+
+    enum class PushResult { Pushed, Dropped, Overflow };
+
+    // A push blocks for the max wait time at most, and never longer than the max duration
+    AudioBufferQueue(std::chrono::microseconds maxDuration, AudioQueueOverflowPolicy policy,
+                     std::chrono::microseconds maxWaitTime = std::chrono::microseconds::max());
+
+    Q_DISABLE_COPY_MOVE(AudioBufferQueue)
+
+    // Called by the producer. Blocking is only allowed if the consumer is running;
+    // Overflow is returned instead of Dropped with AudioQueueOverflowPolicy::Error.
+    PushResult push(const QAudioBuffer &buffer, bool canBlock);
+
+    // Called by the consumer
+    std::optional<Entry> pop();
+
+    bool empty() const { return m_queue.empty(); }
+    size_t size() const { return m_queue.size(); }
+
+    std::chrono::microseconds duration() const
+    {
+        return std::chrono::microseconds(m_duration.load());
+    }
+
+    // Either the max duration is reached, or there are too many small buffers
+    bool isFull() const
+    {
+        return !m_queue.empty()
+                && (duration() >= m_maxDuration || m_queue.size() >= m_queue.capacity());
+    }
+
+    std::chrono::microseconds maxDuration() const { return m_maxDuration; }
+    AudioQueueOverflowPolicy overflowPolicy() const { return m_policy; }
+    std::chrono::microseconds maxWaitTime() const { return m_maxWaitTime; }
+
+    AudioQueueStatistics statistics() const;
+
+private:
+    bool waitForSpace();
+    void drop(std::chrono::microseconds bufferDuration);
+
+    using Rep = std::chrono::microseconds::rep;
+
+    const std::chrono::microseconds m_maxDuration;
+    const AudioQueueOverflowPolicy m_policy;
+    const std::chrono::microseconds m_maxWaitTime;
+
+    // Hard limit of the buffers count, large enough to hold the max duration
+    // of audio with typical buffer sizes. Reaching it is handled like reaching
+    // the max duration.
+    BoundedQueue<Entry> m_queue{ 1024 };
+
+    std::atomic<Rep> m_duration = 0;
+    std::chrono::microseconds m_pendingGap{ 0 }; // accessed by the producer only
+
+    std::atomic<Rep> m_peakDuration = 0;
+    std::atomic<quint64> m_droppedBufferCount = 0;
+    std::atomic<Rep> m_droppedDuration = 0;
+    std::atomic<quint64> m_blockedPushCount = 0;
+    std::atomic<Rep> m_blockedTime = 0;
+
+    // Used only while a producer is blocked
+    QMutex m_spaceMutex;
+    QWaitCondition m_spaceFreed;
+    std::atomic_bool m_producerWaiting = false;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGAUDIOBUFFERQUEUE_P_H
@@ -13,12 +13,81 @@
 
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 namespace QFFmpeg {
 
 Q_STATIC_LOGGING_CATEGORY(qLcFFmpegAudioEncoder, "qt.multimedia.ffmpeg.audioencoder");
 static constexpr bool audioEncoderExtendedTracing = false;
 
 namespace {
+
+// The bound of the audio queue is set by QMediaRecorder::maxAudioQueueDuration and
+// QMediaRecorder::audioOverflowPolicy. For testing, they can be overridden by
+// QT_FFMPEG_AUDIO_ENCODER_MAX_QUEUE_DURATION_MS and
+// QT_FFMPEG_AUDIO_ENCODER_QUEUE_OVERFLOW_POLICY=block|drop|error
+std::chrono::microseconds maxAudioQueueDuration(const QMediaEncoderSettings &settings)
+{
+    // Arbitrarily chosen to limit audio queue duration
+    constexpr std::chrono::milliseconds defaultDuration = std::chrono::seconds(5);
+
+    bool ok = false;
+    const int duration =
+            qEnvironmentVariableIntValue("QT_FFMPEG_AUDIO_ENCODER_MAX_QUEUE_DURATION_MS", &ok);
+    if (ok && duration > 0)
+        return std::chrono::milliseconds(duration);
+
+    return settings.maxAudioQueueDuration() > 0
+            ? std::chrono::milliseconds(settings.maxAudioQueueDuration())
+            : defaultDuration;
+}
+
+AudioQueueOverflowPolicy audioQueueOverflowPolicy(const QMediaEncoderSettings &settings)
+{
+    const QByteArray policy =
+            qgetenv("QT_FFMPEG_AUDIO_ENCODER_QUEUE_OVERFLOW_POLICY").trimmed().toLower();
+    if (policy == "block")
+        return AudioQueueOverflowPolicy::Block;
+    if (policy == "drop")
+        return AudioQueueOverflowPolicy::DropAndMarkGap;
+    if (policy == "error")
+        return AudioQueueOverflowPolicy::Error;
+
+    switch (settings.audioOverflowPolicy()) {
+    case QMediaRecorder::DropOnAudioOverflow:
+        return AudioQueueOverflowPolicy::DropAndMarkGap;
+    case QMediaRecorder::ErrorOnAudioOverflow:
+        return AudioQueueOverflowPolicy::Error;
+    default:
+        return AudioQueueOverflowPolicy::Block;
+    }
+}
+
+// Audio sources push from their capture thread. Blocking it for longer than about
+// a device period makes the device overrun, which loses audio anyway.
+// QT_FFMPEG_AUDIO_ENCODER_MAX_QUEUE_WAIT_MS overrides it for testing.
+std::chrono::microseconds maxAudioQueueWaitTime()
+{
+    constexpr std::chrono::milliseconds defaultWaitTime(10);
+
+    bool ok = false;
+    const int waitTime =
+            qEnvironmentVariableIntValue("QT_FFMPEG_AUDIO_ENCODER_MAX_QUEUE_WAIT_MS", &ok);
+    return ok && waitTime >= 0 ? std::chrono::milliseconds(waitTime) : defaultWaitTime;
+}
+
+// QT_FFMPEG_AUDIO_ENCODER_PIPELINE=0|1 overrides whether resampling and encoding
+// run on separate threads
+std::optional<bool> audioEncoderPipelineOverride()
+{
+    bool ok = false;
+    const int pipeline = qEnvironmentVariableIntValue("QT_FFMPEG_AUDIO_ENCODER_PIPELINE", &ok);
+    return ok ? std::optional<bool>(pipeline != 0) : std::nullopt;
+}
+
+// Enough to wake the muxer once per about 0.3 s of audio, at typical frame sizes
+constexpr size_t pipelinedPacketBatchSize = 16;
+
 void setupStreamParameters(AVStream *stream, const Codec &codec,
                            const AVAudioFormat &requestedAudioFormat)
 {
@@ -80,7 +149,11 @@ bool openCodecContext(AVCodecContext *codecContext, AVStream *stream,
 
 AudioEncoder::AudioEncoder(RecordingEngine &recordingEngine, const QAudioFormat &sourceFormat,
                            const QMediaEncoderSettings &settings)
-    : EncoderThread(recordingEngine), m_sourceFormat(sourceFormat), m_settings(settings)
+    : EncoderThread(recordingEngine),
+      m_audioBufferQueue(maxAudioQueueDuration(settings), audioQueueOverflowPolicy(settings),
+                         maxAudioQueueWaitTime()),
+      m_sourceFormat(sourceFormat),
+      m_settings(settings)
 {
     setObjectName(QLatin1String("AudioEncoder"));
     qCDebug(qLcFFmpegAudioEncoder) << "AudioEncoder" << settings.audioCodec();
@@ -104,30 +177,40 @@ void AudioEncoder::addBuffer(const QAudioBuffer &buffer)
         return;
     }
 
-    {
-        const std::chrono::microseconds bufferDuration(buffer.duration());
-        auto guard = lockLoopData();
+    resetEndOfSourceStream();
 
-        resetEndOfSourceStream();
+    if (m_paused) {
+        updateCanPushFrame();
+        return;
+    }
 
-        if (m_paused)
-            return;
+    // The source may be blocked only when the encoder thread consumes the queue
+    const auto result = m_audioBufferQueue.push(buffer, m_encodingStarted);
 
-        // TODO: apply logic with canPushFrame
+    if (result == AudioBufferQueue::PushResult::Pushed) {
+        m_overflowReported = false;
+        updateCanPushFrame();
+        dataReady();
+        return;
+    }
 
-        m_audioBufferQueue.push(buffer);
-        m_queueDuration += bufferDuration;
+    m_recordingEngine.newDroppedAudio(std::chrono::microseconds(buffer.duration()));
+
+    if (!m_overflowReported) {
+        // Warn once per overflow, not for every lost buffer
+        m_overflowReported = true;
+        qCWarning(qLcFFmpegAudioEncoder)
+                << "Audio buffer queue overflow, the encoder cannot keep up. Dropping audio,"
+                << "queue duration:" << m_audioBufferQueue.duration().count() << "us";
     }
 
-    dataReady();
-}
+    if (result == AudioBufferQueue::PushResult::Overflow && !m_overflowErrorEmitted) {
+        m_overflowErrorEmitted = true;
+        emit m_recordingEngine.sessionError(QMediaRecorder::ResourceError,
+                                            u"Audio encoder cannot keep up, audio data lost"_s);
+    }
 
-QAudioBuffer AudioEncoder::takeBuffer()
-{
-    auto locker = lockLoopData();
-    QAudioBuffer result = dequeueIfPossible(m_audioBufferQueue);
-    m_queueDuration -= std::chrono::microseconds(result.duration());
-    return result;
+    updateCanPushFrame();
 }
 
 bool AudioEncoder::init()
@@ -180,6 +263,17 @@ bool AudioEncoder::init()
 
     updateResampler(m_sourceFormat);
 
+    m_pipelined = audioEncoderPipelineOverride().value_or(m_pipelined);
+    m_frameEncoder.reset(
+            new AudioFrameEncoder(m_recordingEngine, m_stream, m_codecContext.get()));
+    if (m_pipelined) {
+        // Resampling pauses while the frame queue is full; resume it once there's space again
+        m_frameEncoder->setFrameTakenCallback([this] { dataReady(); });
+        m_frameEncoder->setPacketBatchSize(pipelinedPacketBatchSize);
+        m_frameEncoder->start();
+    }
+    qCDebug(qLcFFmpegAudioEncoder) << "encoding on a separate thread:" << m_pipelined;
+
     // TODO: try to address this dependency here.
     if (auto input = qobject_cast<QFFmpegAudioInput *>(source()))
         input->setBufferSize(m_codecContext->frame_size);
@@ -189,54 +283,43 @@ bool AudioEncoder::init()
 
 void AudioEncoder::cleanup()
 {
-    while (!m_audioBufferQueue.empty())
+    while (m_buffer.isValid() || !m_audioBufferQueue.empty())
         processOne();
 
     if (m_avFrameSamplesOffset) {
         // the size of the last frame can be less than m_codecContext->frame_size
-
-        retrievePackets();
         sendPendingFrameToAVCodec();
     }
 
-    while (avcodec_send_frame(m_codecContext.get(), nullptr) == AVERROR(EAGAIN))
-        retrievePackets();
-    retrievePackets();
+    if (m_pipelined)
+        m_frameEncoder.reset(); // encodes the queued frames, and flushes the codec
+    else
+        m_frameEncoder->finish();
 }
 
 bool AudioEncoder::hasData() const
 {
-    return !m_audioBufferQueue.empty();
+    // The frame encoder wakes us up when it takes a frame from its full queue
+    if (m_pipelined && m_frameEncoder->isFull())
+        return false;
+
+    return m_buffer.isValid() || !m_audioBufferQueue.empty();
 }
 
-void AudioEncoder::retrievePackets()
+// Takes the next buffer from the queue. Returns false if there is nothing to resample yet.
+bool AudioEncoder::takeBuffer()
 {
-    while (true) {
-        AVPacketUPtr packet(av_packet_alloc());
-        int ret = avcodec_receive_packet(m_codecContext.get(), packet.get());
-        switch (ret) {
-        case 0:
-            break;
-        case AVERROR(EAGAIN):
-        case AVERROR(EOF):
-            return;
-        default:
-            qCDebug(qLcFFmpegAudioEncoder) << "receive packet" << ret << QFFmpeg::AVError{ ret };
-            return;
-        }
+    std::optional<AudioBufferQueue::Entry> entry = m_audioBufferQueue.pop();
+    if (!entry)
+        return false; // the producer hasn't finished pushing the buffer yet
 
-        if constexpr (audioEncoderExtendedTracing)
-            qCDebug(qLcFFmpegAudioEncoder)
-                    << "writing audio packet" << packet->size << packet->pts << packet->dts;
-        packet->stream_index = m_stream->id;
-        m_recordingEngine.getMuxer()->addPacket(std::move(packet));
-    }
-}
+    updateCanPushFrame();
 
-void AudioEncoder::processOne()
-{
-    QAudioBuffer buffer = takeBuffer();
-    Q_ASSERT(buffer.isValid());
+    const bool hasGap = entry->gapBefore.count() > 0;
+    if (hasGap)
+        skipSamples(entry->gapBefore);
+
+    const QAudioBuffer &buffer = entry->buffer;
 
     if constexpr (audioEncoderExtendedTracing)
         qCDebug(qLcFFmpegAudioEncoder)
@@ -244,21 +327,35 @@ void AudioEncoder::processOne()
                 << buffer.frameCount() << m_codecContext->frame_size;
 
     if (buffer.format() != m_sourceFormat && !updateResampler(buffer.format()))
+        return false;
+
+    m_buffer = buffer;
+    m_bufferSamplesOffset = 0;
+
+    // Skipping the gap might have completed a frame; complete at most one per step
+    return !hasGap;
+}
+
+// Completes at most one frame per call, so that the encoder thread can pause as soon as
+// the frame queue of the pipeline is full.
+void AudioEncoder::processOne()
+{
+    if (!m_buffer.isValid() && !takeBuffer())
         return;
 
-    int samplesOffset = 0;
-    const int bufferSamplesCount = static_cast<int>(buffer.frameCount());
+    const int bufferSamplesCount = static_cast<int>(m_buffer.frameCount());
 
-    while (samplesOffset < bufferSamplesCount)
-        handleAudioData(buffer.constData<uint8_t>(), samplesOffset, bufferSamplesCount);
+    handleAudioData(m_buffer.constData<uint8_t>(), m_bufferSamplesOffset, bufferSamplesCount);
 
-    Q_ASSERT(samplesOffset == bufferSamplesCount);
+    Q_ASSERT(m_bufferSamplesOffset <= bufferSamplesCount);
+    if (m_bufferSamplesOffset == bufferSamplesCount)
+        m_buffer = {};
 }
 
 bool AudioEncoder::checkIfCanPushFrame() const
 {
     if (m_encodingStarted)
-        return m_audioBufferQueue.size() <= 1 || m_queueDuration < m_maxQueueDuration;
+        return !m_audioBufferQueue.isFull();
     if (!isFinished())
         return m_audioBufferQueue.empty();
 
@@ -386,9 +483,12 @@ void AudioEncoder::sendPendingFrameToAVCodec()
         qCDebug(qLcFFmpegAudioEncoder) << "sendPendingFrameToAVCodec" << m_avFrame->nb_samples
                                        << m_codecContext->frame_size << m_avFrame->pts;
 
-    int ret = avcodec_send_frame(m_codecContext.get(), m_avFrame.get());
-    if (ret < 0)
-        qCDebug(qLcFFmpegAudioEncoder) << "error sending frame" << ret << QFFmpeg::AVError(ret);
+    if (m_pipelined) {
+        // The queue has space, except when draining it in cleanup()
+        m_frameEncoder->addFrame(std::move(m_avFrame));
+    } else {
+        m_frameEncoder->encode(std::move(m_avFrame));
+    }
 
     m_avFrame = nullptr;
     m_avFrameSamplesOffset = 0;
@@ -405,11 +505,39 @@ void AudioEncoder::handleAudioData(const uchar *data, int &samplesOffset, int sa
     if (m_avFrameSamplesOffset < m_avFrame->nb_samples)
         return;
 
-    retrievePackets();
-
     sendPendingFrameToAVCodec();
 }
 
+void AudioEncoder::skipSamples(std::chrono::microseconds gap)
+{
+    // Dropped audio keeps its place in the timeline: the pending frame is completed
+    // with silence, and the rest of the gap is skipped by advancing the timestamps.
+    qint64 gapSamples = gap.count() * m_codecContext->sample_rate / 1'000'000;
+
+    qCDebug(qLcFFmpegAudioEncoder) << "Skipping" << gapSamples << "audio samples of dropped data";
+
+    if (m_avFrame) {
+#if QT_FFMPEG_HAS_AV_CHANNEL_LAYOUT
+        const int channelsCount = m_codecContext->ch_layout.nb_channels;
+#else
+        const int channelsCount = m_codecContext->channels;
+#endif
+        const int silenceSamples = static_cast<int>(
+                qMin<qint64>(gapSamples, m_avFrame->nb_samples - m_avFrameSamplesOffset));
+        av_samples_set_silence(m_avFrame->extended_data, m_avFrameSamplesOffset, silenceSamples,
+                               channelsCount, m_codecContext->sample_fmt);
+        m_avFrameSamplesOffset += silenceSamples;
+        gapSamples -= silenceSamples;
+
+        if (m_avFrameSamplesOffset < m_avFrame->nb_samples)
+            return;
+
+        sendPendingFrameToAVCodec();
+    }
+
+    m_samplesWritten += gapSamples;
+}
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
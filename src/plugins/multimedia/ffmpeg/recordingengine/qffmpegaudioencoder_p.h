@@ -16,9 +16,11 @@
 
 #include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegencoderthread_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegaudiobufferqueue_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegaudioframeencoder_p.h>
 #include <QtMultimedia/private/qplatformmediarecorder_p.h>
 #include <qaudiobuffer.h>
-#include <queue>
+#include <atomic>
 #include <chrono>
 
 QT_BEGIN_NAMESPACE
@@ -35,13 +37,21 @@ public:
 
     void addBuffer(const QAudioBuffer &buffer);
 
+    /*!
+        Encodes on a separate thread, in parallel with the resampling, and passes the
+        packets to the muxer in batches. Meant for sources that push faster than real
+        time, like QAudioBufferInput. Must be set before the encoder is started.
+     */
+    void setPipelined(bool pipelined) { m_pipelined = pipelined; }
+
+    AudioQueueStatistics queueStatistics() const { return m_audioBufferQueue.statistics(); }
+
 protected:
     bool checkIfCanPushFrame() const override;
 
 private:
-    QAudioBuffer takeBuffer();
-    void retrievePackets();
     bool updateResampler(const QAudioFormat &sourceFormat);
+    bool takeBuffer();
 
     bool init() override;
     void cleanup() override;
@@ -50,6 +60,8 @@ private:
 
     void handleAudioData(const uchar *data, int &samplesOffset, int samplesCount);
 
+    void skipSamples(std::chrono::microseconds gap);
+
     void ensurePendingFrame(int availableSamplesCount);
 
     void writeDataToPendingFrame(const uchar *data, int &samplesOffset, int samplesCount);
@@ -57,12 +69,9 @@ private:
     void sendPendingFrameToAVCodec();
 
 private:
-    std::queue<QAudioBuffer> m_audioBufferQueue;
-
-    // Arbitrarily chosen to limit audio queue duration
-    const std::chrono::microseconds m_maxQueueDuration = std::chrono::seconds(5);
-
-    std::chrono::microseconds m_queueDuration{ 0 };
+    AudioBufferQueue m_audioBufferQueue;
+    bool m_overflowReported = false; // accessed by the producer only
+    bool m_overflowErrorEmitted = false;
 
     AVStream *m_stream = nullptr;
     AVCodecContextUPtr m_codecContext;
@@ -75,6 +84,13 @@ private:
     AVFrameUPtr m_avFrame;
     int m_avFrameSamplesOffset = 0;
     std::vector<uint8_t *> m_avFramePlanesData;
+
+    // The buffer being resampled into frames, and the number of its processed samples
+    QAudioBuffer m_buffer;
+    int m_bufferSamplesOffset = 0;
+
+    bool m_pipelined = false;
+    ConsumerThreadUPtr<AudioFrameEncoder> m_frameEncoder;
 };
 
 
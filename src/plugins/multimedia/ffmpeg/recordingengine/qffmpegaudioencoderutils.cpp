@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qffmpegaudioencoderutils_p.h"
+#include "qffmpegavaudioformat_p.h"
+#include "qffmpegmediaformatinfo_p.h"
 #include "qalgorithms.h"
 
 QT_BEGIN_NAMESPACE
@@ -103,6 +105,37 @@ ChannelLayoutT adjustChannelLayout(QSpan<const ChannelLayoutT> supportedLayouts,
 #endif
 }
 
+QAudioFormat adjustSourceFormat(const Codec &codec, const QAudioFormat &sourceFormat)
+{
+    const AVAudioFormat requested(sourceFormat);
+    QAudioFormat result = sourceFormat;
+
+    if (auto formats = codec.sampleFormats(); !formats.empty()) {
+        const auto sampleFormat = QFFmpegMediaFormatInfo::sampleFormat(
+                adjustSampleFormat(formats, requested.sampleFormat));
+        if (sampleFormat != QAudioFormat::Unknown)
+            result.setSampleFormat(sampleFormat);
+    }
+
+    if (auto rates = codec.sampleRates(); !rates.empty())
+        result.setSampleRate(adjustSampleRate(rates, requested.sampleRate));
+
+    if (auto layouts = codec.channelLayouts(); !layouts.empty()) {
+#if QT_FFMPEG_HAS_AV_CHANNEL_LAYOUT
+        const ChannelLayoutT layout = adjustChannelLayout(layouts, requested.channelLayout);
+        const int64_t mask = layout.order == AV_CHANNEL_ORDER_NATIVE
+                ? int64_t(layout.u.mask)
+                : QFFmpegMediaFormatInfo::avChannelLayout(
+                          QAudioFormat::defaultChannelConfigForChannelCount(layout.nb_channels));
+#else
+        const int64_t mask = adjustChannelLayout(layouts, requested.channelLayoutMask);
+#endif
+        result.setChannelConfig(QFFmpegMediaFormatInfo::channelConfigForAVLayout(mask));
+    }
+
+    return result;
+}
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
@@ -16,6 +16,7 @@
 //
 
 #include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
+#include <QtMultimedia/qaudioformat.h>
 #include <QtCore/qspan.h>
 
 QT_BEGIN_NAMESPACE
@@ -29,6 +30,10 @@ int adjustSampleRate(QSpan<const int> supportedRates, int requested);
 ChannelLayoutT adjustChannelLayout(QSpan<const ChannelLayoutT> supportedLayouts,
                                    const ChannelLayoutT &requested);
 
+// The format closest to sourceFormat that codec encodes without resampling.
+// Planar sample formats of the codec map to their interleaved counterparts.
+QAudioFormat adjustSourceFormat(const Codec &codec, const QAudioFormat &sourceFormat);
+
 } // namespace QFFmpeg
 
 QT_END_NAMESPACE
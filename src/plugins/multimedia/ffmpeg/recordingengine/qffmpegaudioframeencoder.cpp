@@ -0,0 +1,137 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#include "qffmpegaudioframeencoder_p.h"
+#include "qffmpegmuxer_p.h"
+#include "qffmpegrecordingengine_p.h"
+#include <QtCore/qloggingcategory.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+Q_STATIC_LOGGING_CATEGORY(qLcFFmpegAudioEncoder, "qt.multimedia.ffmpeg.audioencoder");
+static constexpr bool audioEncoderExtendedTracing = false;
+
+AudioFrameEncoder::AudioFrameEncoder(RecordingEngine &recordingEngine, AVStream *stream,
+                                     AVCodecContext *codecContext)
+    : m_recordingEngine(recordingEngine), m_stream(stream), m_codecContext(codecContext)
+{
+    setObjectName(QLatin1String("AudioFrameEncoder"));
+}
+
+void AudioFrameEncoder::addFrame(AVFrameUPtr frame)
+{
+    if (!m_frameQueue.push(std::move(frame))) {
+        // Make sure the encoder thread is running before waiting for it
+        dataReady();
+
+        QMutexLocker locker(&m_spaceMutex);
+        // Registering the waiter before retrying guarantees that takeFrame()
+        // cannot free space without waking us up.
+        m_waitingProducers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!m_frameQueue.push(std::move(frame)))
+            m_spaceFreed.wait(&m_spaceMutex);
+        m_waitingProducers.fetch_sub(1);
+    }
+
+    dataReady();
+}
+
+void AudioFrameEncoder::encode(AVFrameUPtr frame)
+{
+    if constexpr (audioEncoderExtendedTracing)
+        qCDebug(qLcFFmpegAudioEncoder)
+                << "encode frame" << frame->nb_samples << m_codecContext->frame_size << frame->pts;
+
+    retrievePackets();
+
+    // The codec doesn't take the frame until its packets have been received
+    int ret = avcodec_send_frame(m_codecContext, frame.get());
+    while (ret == AVERROR(EAGAIN)) {
+        retrievePackets();
+        ret = avcodec_send_frame(m_codecContext, frame.get());
+    }
+    if (ret < 0)
+        qCDebug(qLcFFmpegAudioEncoder) << "error sending frame" << ret << QFFmpeg::AVError(ret);
+
+    // Don't hold packets back if no more frames are coming soon
+    if (m_packets.size() >= m_packetBatchSize || m_frameQueue.empty())
+        sendPackets();
+}
+
+void AudioFrameEncoder::finish()
+{
+    while (avcodec_send_frame(m_codecContext, nullptr) == AVERROR(EAGAIN))
+        retrievePackets();
+    retrievePackets();
+
+    sendPackets();
+}
+
+void AudioFrameEncoder::cleanup()
+{
+    while (!m_frameQueue.empty())
+        processOne();
+
+    finish();
+}
+
+std::optional<AVFrameUPtr> AudioFrameEncoder::takeFrame()
+{
+    std::optional<AVFrameUPtr> frame = m_frameQueue.pop();
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (frame && m_waitingProducers.load() > 0) {
+        QMutexLocker locker(&m_spaceMutex);
+        m_spaceFreed.wakeAll();
+    }
+
+    return frame;
+}
+
+void AudioFrameEncoder::processOne()
+{
+    std::optional<AVFrameUPtr> frame = takeFrame();
+    if (!frame)
+        return; // the producer hasn't finished pushing the frame yet
+
+    if (m_frameTaken)
+        m_frameTaken();
+
+    encode(std::move(*frame));
+}
+
+void AudioFrameEncoder::retrievePackets()
+{
+    while (true) {
+        AVPacketUPtr packet(av_packet_alloc());
+        int ret = avcodec_receive_packet(m_codecContext, packet.get());
+        switch (ret) {
+        case 0:
+            break;
+        case AVERROR(EAGAIN):
+        case AVERROR(EOF):
+            return;
+        default:
+            qCDebug(qLcFFmpegAudioEncoder) << "receive packet" << ret << QFFmpeg::AVError{ ret };
+            return;
+        }
+
+        if constexpr (audioEncoderExtendedTracing)
+            qCDebug(qLcFFmpegAudioEncoder)
+                    << "writing audio packet" << packet->size << packet->pts << packet->dts;
+        packet->stream_index = m_stream->id;
+        m_packets.push_back(std::move(packet));
+    }
+}
+
+void AudioFrameEncoder::sendPackets()
+{
+    if (!m_packets.empty())
+        m_recordingEngine.getMuxer()->addPackets(m_packets);
+}
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
@@ -0,0 +1,105 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#ifndef QFFMPEGAUDIOFRAMEENCODER_P_H
+#define QFFMPEGAUDIOFRAMEENCODER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtFFmpegMediaPluginImpl/private/qffmpegthread_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegboundedqueue_p.h>
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFFmpeg {
+
+class RecordingEngine;
+
+/*!
+    Sends the audio frames assembled by AudioEncoder to the codec, and the encoded
+    packets to the muxer.
+
+    It either encodes on the thread of AudioEncoder via encode(), or, if started, on its
+    own thread, which gets the frames via addFrame(). In the latter case, resampling and
+    encoding run in parallel, and the packets are passed to the muxer in batches.
+ */
+class AudioFrameEncoder : public ConsumerThread
+{
+public:
+    AudioFrameEncoder(RecordingEngine &recordingEngine, AVStream *stream,
+                      AVCodecContext *codecContext);
+
+    /*!
+        Sets the callback invoked on the encoder thread whenever a frame is taken from
+        the queue, so that a producer waiting for space can be woken up.
+     */
+    void setFrameTakenCallback(std::function<void()> callback)
+    {
+        m_frameTaken = std::move(callback);
+    }
+
+    // The number of packets collected before they are passed to the muxer
+    void setPacketBatchSize(size_t size) { m_packetBatchSize = qMax<size_t>(size, 1); }
+
+    // Called by the producer. Waits for the encoder thread to take a frame if the queue
+    // is full.
+    void addFrame(AVFrameUPtr frame);
+
+    bool isFull() const { return m_frameQueue.size() >= m_frameQueue.capacity(); }
+
+    // Encodes the frame on the calling thread
+    void encode(AVFrameUPtr frame);
+
+    // Flushes the codec and passes all remaining packets to the muxer
+    void finish();
+
+private:
+    bool init() override { return true; }
+    void cleanup() override;
+    bool hasData() const override { return !m_frameQueue.empty(); }
+    void processOne() override;
+
+    std::optional<AVFrameUPtr> takeFrame();
+
+    void retrievePackets();
+    void sendPackets();
+
+    RecordingEngine &m_recordingEngine;
+    AVStream *m_stream = nullptr;
+    AVCodecContext *m_codecContext = nullptr;
+
+    // About 0.7 s of audio with a typical codec frame size of 1024 samples at 48 kHz
+    BoundedQueue<AVFrameUPtr> m_frameQueue{ 32 };
+    std::function<void()> m_frameTaken;
+
+    // Used only while the producer is blocked on the full queue
+    QMutex m_spaceMutex;
+    QWaitCondition m_spaceFreed;
+    std::atomic_int m_waitingProducers = 0;
+
+    std::vector<AVPacketUPtr> m_packets;
+    size_t m_packetBatchSize = 1;
+};
+
+} // namespace QFFmpeg
+
+QT_END_NAMESPACE
+
+#endif // QFFMPEGAUDIOFRAMEENCODER_P_H
@@ -335,6 +335,83 @@ static void apply_mediacodec(const QMediaEncoderSettings &settings, AVCodecConte
 }
 #endif
 
+// libx265 takes its own options in a single, colon-separated list
+static void appendX265Param(AVDictionary **opts, const QByteArray &param)
+{
+    if (av_dict_get(*opts, "x265-params", nullptr, 0))
+        av_dict_set(opts, "x265-params", ":", AV_DICT_APPEND);
+    av_dict_set(opts, "x265-params", param.constData(), AV_DICT_APPEND);
+}
+
+static void applyThreadingOptions(const QMediaEncoderSettings &settings,
+                                  const QByteArray &codecName, AVCodecContext *codec,
+                                  AVDictionary **opts)
+{
+    if (settings.videoEncoderThreadCount() > 0)
+        av_dict_set_int(opts, "threads", settings.videoEncoderThreadCount(), 0);
+    else
+        av_dict_set(opts, "threads", "auto", 0); // we always want automatic threading
+
+    QMediaRecorder::EncoderThreading threading = settings.videoEncoderThreading();
+    if (threading == QMediaRecorder::AutomaticThreading && settings.videoEncoderLookahead() == 0)
+        threading = QMediaRecorder::SliceThreading; // every frame thread adds a frame of delay
+
+    // FFmpeg maps the thread type to its own threading, and to the sliced threads of libx264.
+    // libvpx and libaom always parallelize within frames.
+    switch (threading) {
+    case QMediaRecorder::FrameThreading:
+        codec->thread_type = FF_THREAD_FRAME;
+        break;
+    case QMediaRecorder::SliceThreading:
+        codec->thread_type = FF_THREAD_SLICE;
+        if (codecName == "libx265")
+            appendX265Param(opts, "frame-threads=1");
+        break;
+    case QMediaRecorder::AutomaticThreading:
+        break;
+    }
+}
+
+static void applyLookaheadOptions(const QMediaEncoderSettings &settings,
+                                  const QByteArray &codecName, AVCodecContext *codec,
+                                  AVDictionary **opts)
+{
+    const int lookahead = settings.videoEncoderLookahead();
+    if (lookahead < 0)
+        return;
+
+    // B-frames can only be encoded once the following frame is there
+    if (lookahead == 0)
+        codec->max_b_frames = 0;
+
+    if (codecName == "libx264") {
+        if (lookahead == 0)
+            av_dict_set(opts, "tune", "zerolatency", 0);
+        else
+            av_dict_set_int(opts, "rc-lookahead", lookahead, 0);
+    } else if (codecName == "libx265") {
+        if (lookahead == 0)
+            av_dict_set(opts, "tune", "zerolatency", 0);
+        else
+            appendX265Param(opts, "rc-lookahead=" + QByteArray::number(lookahead));
+    } else if (codecName == "libvpx" || codecName == "libvpx_vp9") {
+        av_dict_set_int(opts, "lag-in-frames", lookahead, 0);
+        if (lookahead == 0)
+            av_dict_set(opts, "deadline", "realtime", 0);
+    } else if (codecName == "libaom-av1") {
+        av_dict_set_int(opts, "lag-in-frames", lookahead, 0);
+        if (lookahead == 0)
+            av_dict_set(opts, "usage", "realtime", 0);
+    } else if (codecName.endsWith("_nvenc")) {
+        if (lookahead == 0) {
+            av_dict_set(opts, "zerolatency", "1", 0);
+            av_dict_set(opts, "delay", "0", 0);
+        } else {
+            av_dict_set_int(opts, "rc-lookahead", lookahead, 0);
+        }
+    }
+}
+
 namespace QFFmpeg {
 
 using ApplyOptions = void (*)(const QMediaEncoderSettings &settings, AVCodecContext *codec, AVDictionary **opts);
@@ -384,17 +461,19 @@ const struct {
 
 void applyVideoEncoderOptions(const QMediaEncoderSettings &settings, const QByteArray &codecName, AVCodecContext *codec, AVDictionary **opts)
 {
-    av_dict_set(opts, "threads", "auto", 0); // we always want automatic threading
+    applyThreadingOptions(settings, codecName, codec, opts);
 
     auto *table = videoCodecOptionTable;
     while (table->name) {
         if (codecName == table->name) {
             table->apply(settings, codec, opts);
-            return;
+            break;
         }
 
         ++table;
     }
+
+    applyLookaheadOptions(settings, codecName, codec, opts);
 }
 
 void applyAudioEncoderOptions(const QMediaEncoderSettings &settings, const QByteArray &codecName, AVCodecContext *codec, AVDictionary **opts)
@@ -33,6 +33,27 @@ void EncoderThread::setEndOfSourceStream()
     emit endOfSourceStream();
 }
 
+bool EncoderThread::computeCanPushFrame() const
+{
+    const bool autoStopActivated = m_endOfSourceStream && m_autoStop;
+    return !autoStopActivated && !m_paused && checkIfCanPushFrame();
+}
+
+void EncoderThread::updateCanPushFrame()
+{
+    // The producer and the encoder threads might race here; re-check the state
+    // after publishing the value so that the last writer leaves the actual one.
+    bool canPush = computeCanPushFrame();
+    while (m_canPushFrame.exchange(canPush, std::memory_order_acq_rel) != canPush) {
+        emit canPushFrameChanged();
+
+        const bool actualCanPush = computeCanPushFrame();
+        if (actualCanPush == canPush)
+            break;
+        canPush = actualCanPush;
+    }
+}
+
 void EncoderThread::startEncoding(bool noError)
 {
     Q_ASSERT(!m_encodingStarted);
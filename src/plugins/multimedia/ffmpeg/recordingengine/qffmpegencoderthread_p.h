@@ -44,7 +44,7 @@ public:
 
     void setEndOfSourceStream();
 
-    bool isEndOfSourceStream() const { return m_endOfSourceStream; }
+    bool isEndOfSourceStream() const { return m_endOfSourceStream.load(std::memory_order_relaxed); }
 
     void startEncoding(bool noError);
 
@@ -53,20 +53,22 @@ public:
 protected:
     bool init() override;
 
+    /*!
+        Recomputes canPushFrame and emits canPushFrameChanged if the value has changed.
+        It's invoked without a lock by both the producer and the encoder threads
+        after they have modified the queue.
+     */
     void updateCanPushFrame();
 
     virtual bool checkIfCanPushFrame() const = 0;
 
-    void resetEndOfSourceStream() { m_endOfSourceStream = false; }
+    void resetEndOfSourceStream() { m_endOfSourceStream.store(false, std::memory_order_relaxed); }
 
     auto lockLoopData()
     {
         return QScopeGuard([this, locker = ConsumerThread::lockLoopData()]() mutable {
-            const bool autoStopActivated = m_endOfSourceStream && m_autoStop;
-            const bool canPush = !autoStopActivated && !m_paused && checkIfCanPushFrame();
             locker.unlock();
-            if (m_canPushFrame.exchange(canPush, std::memory_order_relaxed) != canPush)
-                emit canPushFrameChanged();
+            updateCanPushFrame();
         });
     }
 
@@ -75,12 +77,15 @@ Q_SIGNALS:
     void endOfSourceStream();
     void initialized();
 
+private:
+    bool computeCanPushFrame() const;
+
 protected:
-    bool m_paused = false;
-    bool m_endOfSourceStream = false;
-    bool m_autoStop = false;
+    std::atomic_bool m_paused = false;
+    std::atomic_bool m_endOfSourceStream = false;
+    std::atomic_bool m_autoStop = false;
     bool m_initialized = false;
-    bool m_encodingStarted = false;
+    std::atomic_bool m_encodingStarted = false;
     std::atomic_bool m_canPushFrame = false;
     RecordingEngine &m_recordingEngine;
     QPointer<QObject> m_source;
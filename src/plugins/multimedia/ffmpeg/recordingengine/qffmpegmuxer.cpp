@@ -18,19 +18,51 @@ Muxer::Muxer(RecordingEngine *encoder) : m_encoder(encoder)
 
 void Muxer::addPacket(AVPacketUPtr packet)
 {
-    {
-        QMutexLocker locker = lockLoopData();
-        m_packetQueue.push(std::move(packet));
-    }
+    pushPacket(packet);
 
     //    qCDebug(qLcFFmpegEncoder) << "Muxer::addPacket" << packet->pts << packet->stream_index;
     dataReady();
 }
 
+void Muxer::addPackets(std::vector<AVPacketUPtr> &packets)
+{
+    for (AVPacketUPtr &packet : packets)
+        pushPacket(packet);
+    packets.clear();
+
+    dataReady();
+}
+
+void Muxer::pushPacket(AVPacketUPtr &packet)
+{
+    if (m_packetQueue.push(std::move(packet)))
+        return;
+
+    // The muxer is normally much faster than the encoders; if it doesn't keep up,
+    // let the encoder wait for it instead of dropping encoded data.
+    dataReady();
+
+    QMutexLocker locker(&m_spaceMutex);
+    // Registering the waiter before retrying guarantees that takePacket()
+    // cannot free space without waking us up.
+    m_waitingProducers.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!m_packetQueue.push(std::move(packet)))
+        m_spaceFreed.wait(&m_spaceMutex);
+    m_waitingProducers.fetch_sub(1);
+}
+
 AVPacketUPtr Muxer::takePacket()
 {
-    QMutexLocker locker = lockLoopData();
-    return dequeueIfPossible(m_packetQueue);
+    AVPacketUPtr packet = m_packetQueue.pop().value_or(AVPacketUPtr{});
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (packet && m_waitingProducers.load() > 0) {
+        QMutexLocker locker(&m_spaceMutex);
+        m_spaceFreed.wakeAll();
+    }
+
+    return packet;
 }
 
 bool Muxer::init()
@@ -55,6 +87,9 @@ bool QFFmpeg::Muxer::hasData() const
 void Muxer::processOne()
 {
     auto packet = takePacket();
+    if (!packet)
+        return; // the producer hasn't finished pushing the packet yet
+
     //   qCDebug(qLcFFmpegEncoder) << "writing packet to file" << packet->pts << packet->duration <<
     //   packet->stream_index;
 
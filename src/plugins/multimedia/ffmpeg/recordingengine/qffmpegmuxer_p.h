@@ -16,7 +16,13 @@
 
 #include <QtFFmpegMediaPluginImpl/private/qffmpegthread_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
-#include <queue>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegboundedqueue_p.h>
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <atomic>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -29,9 +35,14 @@ class Muxer : public ConsumerThread
 public:
     Muxer(RecordingEngine *encoder);
 
+    // Blocks the calling encoder thread while the packet queue is full
     void addPacket(AVPacketUPtr packet);
 
+    // Takes all packets, and wakes the muxer once for the whole batch
+    void addPackets(std::vector<AVPacketUPtr> &packets);
+
 private:
+    void pushPacket(AVPacketUPtr &packet);
     AVPacketUPtr takePacket();
 
     bool init() override;
@@ -40,7 +51,13 @@ private:
     void processOne() override;
 
 private:
-    std::queue<AVPacketUPtr> m_packetQueue;
+    // Packets are pushed by the audio and video encoder threads concurrently
+    BoundedQueue<AVPacketUPtr> m_packetQueue{ 1024 };
+
+    // Used only while a producer is blocked on the full queue
+    QMutex m_spaceMutex;
+    QWaitCondition m_spaceFreed;
+    std::atomic_int m_waitingProducers = 0;
 
     RecordingEngine *m_encoder;
 };
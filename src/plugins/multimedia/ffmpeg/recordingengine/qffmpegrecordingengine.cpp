@@ -3,6 +3,7 @@
 #include "qffmpegrecordingengine_p.h"
 #include "qffmpegencodinginitializer_p.h"
 #include "qffmpegaudioencoder_p.h"
+#include "qffmpegaudioencoderutils_p.h"
 #include "qffmpegaudioinput_p.h"
 #include "qffmpegrecordingengineutils_p.h"
 
@@ -13,6 +14,8 @@
 
 #include "qdebug.h"
 #include "qffmpegvideoencoder_p.h"
+#include "qffmpegcodecstorage_p.h"
+#include "qffmpegmediaformatinfo_p.h"
 #include "qffmpegmediametadata_p.h"
 #include "qffmpegmuxer_p.h"
 #include "qloggingcategory.h"
@@ -48,7 +51,7 @@ void RecordingEngine::addAudioInput(QFFmpegAudioInput *input)
         return;
     }
 
-    const QAudioFormat format = input->device.preferredFormat();
+    QAudioFormat format = input->device.preferredFormat();
 
     if (!format.isValid()) {
         emit streamInitializationError(
@@ -57,6 +60,17 @@ void RecordingEngine::addAudioInput(QFFmpegAudioInput *input)
         return;
     }
 
+    // Capture in the format of the encoder if the device supports it, so that the encoder
+    // takes the captured buffers without resampling.
+    const AVCodecID codecId = QFFmpegMediaFormatInfo::codecIdForAudioCodec(m_settings.audioCodec());
+    if (const auto codec = findAVEncoder(codecId)) {
+        const QAudioFormat encoderFormat = adjustSourceFormat(*codec, format);
+        if (input->device.isFormatSupported(encoderFormat))
+            format = encoderFormat;
+    }
+    input->setAudioFormat(format);
+    m_formattedAudioInputs.emplace_back(input);
+
     AudioEncoder *audioEncoder = createAudioEncoder(format);
     connectEncoderToSource(audioEncoder, input);
 }
@@ -71,6 +85,10 @@ void RecordingEngine::addAudioBufferInput(QPlatformAudioBufferInput *input,
 
     AudioEncoder *audioEncoder = createAudioEncoder(format);
 
+    // Buffer inputs are typically fed as fast as the encoder accepts the buffers,
+    // e.g. when transcoding files; keep resampling and encoding busy in parallel.
+    audioEncoder->setPipelined(true);
+
     // set the buffer before connecting to avoid potential races
     if (firstBuffer.isValid())
         audioEncoder->addBuffer(firstBuffer);
@@ -124,6 +142,9 @@ void RecordingEngine::addVideoSource(QPlatformVideoSource *source, const QVideoF
 
     auto videoEncoder = new VideoEncoder(*this, m_settings, frameFormat, hwPixelFormat);
     m_videoEncoders.emplace_back(videoEncoder);
+
+    videoEncoder->setDuplicateFrameElision(m_settings.skipDuplicateVideoFrames());
+
     if (m_autoStop)
         videoEncoder->setAutoStop(true);
 
@@ -218,6 +239,13 @@ void RecordingEngine::finalize()
     m_formatsInitializer.reset();
 
     forEachEncoder(&disconnectEncoderFromSource);
+
+    // The audio inputs are shared with the capture session, which monitors them
+    // in their own format; an invalid format selects the device's preferred one.
+    for (const QPointer<QFFmpegAudioInput> &input : std::exchange(m_formattedAudioInputs, {}))
+        if (input)
+            input->setAudioFormat({});
+
     if (m_state != State::Encoding)
         forEachEncoder(&EncoderThread::startEncoding, false);
 
@@ -245,12 +273,38 @@ void RecordingEngine::setMetaData(const QMediaMetaData &metaData)
     m_metaData = metaData;
 }
 
+void RecordingEngine::newSkippedVideoFrame()
+{
+    m_skippedVideoFrameCount.fetch_add(1, std::memory_order_relaxed);
+}
+
 void RecordingEngine::newTimeStamp(qint64 time)
 {
     QMutexLocker locker(&m_timeMutex);
     if (time > m_timeRecorded) {
         m_timeRecorded = time;
         emit durationChanged(time);
+        reportCounters();
+    }
+}
+
+void RecordingEngine::newDroppedAudio(std::chrono::microseconds duration)
+{
+    m_droppedAudioDuration.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+void RecordingEngine::reportCounters()
+{
+    const qint64 count = m_skippedVideoFrameCount.load(std::memory_order_relaxed);
+    if (count != m_reportedSkippedVideoFrameCount) {
+        m_reportedSkippedVideoFrameCount = count;
+        emit skippedVideoFrameCountChanged(count);
+    }
+
+    const qint64 duration = m_droppedAudioDuration.load(std::memory_order_relaxed) / 1000;
+    if (duration != m_reportedDroppedAudioDuration) {
+        m_reportedDroppedAudioDuration = duration;
+        emit droppedAudioDurationChanged(duration);
     }
 }
 
@@ -285,7 +339,7 @@ void RecordingEngine::handleEncoderInitialization()
 
     avFormatContext()->metadata = QFFmpegMetaData::toAVMetaData(m_metaData);
 
-    const int res = avformat_write_header(avFormatContext(), nullptr);
+    const int res = avformat_write_header(avFormatContext(), m_formatContext->muxerOptions());
     if (res < 0) {
         qWarning() << "could not write header, error:" << res << AVError(res);
         emit sessionError(QMediaRecorder::ResourceError,
@@ -302,9 +356,32 @@ void RecordingEngine::handleEncoderInitialization()
 
 void RecordingEngine::stopAndDeleteThreads()
 {
+    // The sources have been disconnected, so nothing is pushed to the audio queues anymore
+    for (const auto &audioEncoder : m_audioEncoders)
+        reportAudioQueueStatistics(audioEncoder->queueStatistics());
+
+    // The video encoders count the elided frames that they flush on cleanup
     m_audioEncoders.clear();
     m_videoEncoders.clear();
     m_muxer.reset();
+
+    QMutexLocker locker(&m_timeMutex);
+    reportCounters();
+}
+
+void RecordingEngine::reportAudioQueueStatistics(const AudioQueueStatistics &statistics)
+{
+    qCDebug(qLcFFmpegEncoder)
+            << "audio queue statistics: peak duration" << statistics.peakDuration.count()
+            << "us, dropped buffers" << statistics.droppedBufferCount << "("
+            << statistics.droppedDuration.count() << "us), blocked pushes"
+            << statistics.blockedPushCount << "(" << statistics.blockedTime.count() << "us)";
+
+    if (statistics.droppedBufferCount > 0)
+        qCWarning(qLcFFmpegEncoder).nospace()
+                << "The audio encoder could not keep up with the source; "
+                << statistics.droppedDuration.count() / 1000 << " ms of audio ("
+                << statistics.droppedBufferCount << " buffers) were skipped in the recording";
 }
 
 template <typename F, typename... Args>
@@ -19,6 +19,10 @@
 
 #include <QtMultimedia/private/qplatformmediarecorder_p.h>
 #include <qmediarecorder.h>
+#include <qpointer.h>
+
+#include <atomic>
+#include <chrono>
 
 QT_BEGIN_NAMESPACE
 
@@ -39,6 +43,7 @@ class AudioEncoder;
 class VideoEncoder;
 class VideoFrameEncoder;
 class EncodingInitializer;
+struct AudioQueueStatistics;
 
 class RecordingEngine : public QObject
 {
@@ -69,11 +74,17 @@ public:
 
     bool isEndOfSourceStreams() const;
 
+    // Called by the encoders; the totals are reported with the next time stamp
+    void newDroppedAudio(std::chrono::microseconds duration);
+    void newSkippedVideoFrame();
+
 public Q_SLOTS:
     void newTimeStamp(qint64 time);
 
 Q_SIGNALS:
     void durationChanged(qint64 duration);
+    void skippedVideoFrameCountChanged(qint64 count);
+    void droppedAudioDurationChanged(qint64 duration);
     void sessionError(QMediaRecorder::Error code, const QString &description);
     void streamInitializationError(QMediaRecorder::Error code, const QString &description);
     void finalizationDone();
@@ -124,6 +135,9 @@ private:
 
     void stopAndDeleteThreads();
 
+    static void reportAudioQueueStatistics(const AudioQueueStatistics &statistics);
+    void reportCounters(); // needs m_timeMutex
+
     template <typename F, typename... Args>
     void forEachEncoder(F &&f, Args &&...args);
 
@@ -139,9 +153,15 @@ private:
     std::vector<ConsumerThreadUPtr<AudioEncoder>> m_audioEncoders;
     std::vector<ConsumerThreadUPtr<VideoEncoder>> m_videoEncoders;
     std::unique_ptr<EncodingInitializer> m_formatsInitializer;
+    std::vector<QPointer<QFFmpegAudioInput>> m_formattedAudioInputs;
 
     QMutex m_timeMutex;
     qint64 m_timeRecorded = 0;
+    std::atomic<qint64> m_skippedVideoFrameCount = 0;
+    std::atomic<qint64> m_droppedAudioDuration = 0; // microseconds
+    // guarded by m_timeMutex
+    qint64 m_reportedSkippedVideoFrameCount = 0;
+    qint64 m_reportedDroppedAudioDuration = 0; // milliseconds
 
     bool m_autoStop = false;
     size_t m_initializedEncodersCount = 0;
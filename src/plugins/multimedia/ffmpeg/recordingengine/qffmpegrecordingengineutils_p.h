@@ -16,7 +16,6 @@
 //
 
 #include "qobject.h"
-#include <queue>
 
 QT_BEGIN_NAMESPACE
 
@@ -29,17 +28,6 @@ constexpr qint64 VideoFrameTimeBase = 1000000; // us in sec
 
 class EncoderThread;
 
-template <typename T>
-T dequeueIfPossible(std::queue<T> &queue)
-{
-    if (queue.empty())
-        return T{};
-
-    auto result = std::move(queue.front());
-    queue.pop();
-    return result;
-}
-
 void setEncoderInterface(QObject *source, QMediaInputEncoderInterface *);
 
 void setEncoderUpdateConnection(QObject *source, EncoderThread *encoder);
@@ -9,6 +9,9 @@
 #include "private/qvideoframe_p.h"
 #include "private/qmultimediautils_p.h"
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qhashfunctions.h>
+
+#include <cstring>
 
 QT_BEGIN_NAMESPACE
 
@@ -18,6 +21,49 @@ namespace QFFmpeg {
 
 Q_STATIC_LOGGING_CATEGORY(qLcFFmpegVideoEncoder, "qt.multimedia.ffmpeg.videoencoder");
 
+namespace {
+
+// Both frames must be mapped
+bool hasEqualData(const QVideoFrame &a, const QVideoFrame &b)
+{
+    if (a.pixelFormat() != b.pixelFormat() || a.size() != b.size()
+        || a.planeCount() != b.planeCount())
+        return false;
+
+    for (int plane = 0; plane < a.planeCount(); ++plane) {
+        if (a.mappedBytes(plane) != b.mappedBytes(plane)
+            || std::memcmp(a.bits(plane), b.bits(plane), a.mappedBytes(plane)) != 0)
+            return false;
+    }
+    return true;
+}
+
+// Hashes evenly spaced chunks of the planes. Frames with equal hashes are compared
+// in full, so the hash only needs to tell most changed frames apart cheaply.
+// The frame must be mapped.
+size_t sampledHash(const QVideoFrame &frame)
+{
+    constexpr qsizetype SampleCount = 64;
+    constexpr qsizetype SampleSize = 64;
+
+    size_t hash = qHashMulti(0, int(frame.pixelFormat()), frame.width(), frame.height());
+    for (int plane = 0; plane < frame.planeCount(); ++plane) {
+        const uchar *bits = frame.bits(plane);
+        const qsizetype size = frame.mappedBytes(plane);
+        if (size <= SampleCount * SampleSize) {
+            hash = qHashBits(bits, size, hash);
+            continue;
+        }
+
+        const qsizetype step = (size - SampleSize) / (SampleCount - 1);
+        for (qsizetype sample = 0; sample < SampleCount; ++sample)
+            hash = qHashBits(bits + sample * step, SampleSize, hash);
+    }
+    return hash;
+}
+
+} // namespace
+
 VideoEncoder::VideoEncoder(RecordingEngine &recordingEngine, const QMediaEncoderSettings &settings,
                            const QVideoFrameFormat &format, std::optional<AVPixelFormat> hwFormat)
     : EncoderThread(recordingEngine), m_settings(settings)
@@ -61,36 +107,37 @@ void VideoEncoder::addFrame(const QVideoFrame &frame)
         return;
     }
 
-    {
-        auto guard = lockLoopData();
+    resetEndOfSourceStream();
 
-        resetEndOfSourceStream();
-
-        if (m_paused) {
-            m_shouldAdjustTimeBaseForNextFrame = true;
-            return;
-        }
+    if (m_paused) {
+        m_shouldAdjustTimeBaseForNextFrame = true;
+        updateCanPushFrame();
+        return;
+    }
 
-        // Drop frames if encoder can not keep up with the video source data rate;
-        // canPushFrame might be used instead
-        const bool queueFull = m_videoFrameQueue.size() >= m_maxQueueSize;
+    // Drop frames if encoder can not keep up with the video source data rate;
+    // canPushFrame might be used instead
+    const bool queueFull = m_videoFrameQueue.size() >= m_maxQueueSize
+            || !m_videoFrameQueue.push(FrameInfo{ frame, m_shouldAdjustTimeBaseForNextFrame });
 
-        if (queueFull) {
-            qCDebug(qLcFFmpegVideoEncoder) << "RecordingEngine frame queue full. Frame lost.";
-            return;
-        }
-
-        m_videoFrameQueue.push({ frame, m_shouldAdjustTimeBaseForNextFrame });
-        m_shouldAdjustTimeBaseForNextFrame = false;
+    if (queueFull) {
+        qCDebug(qLcFFmpegVideoEncoder) << "RecordingEngine frame queue full. Frame lost.";
+        updateCanPushFrame();
+        return;
     }
 
+    m_shouldAdjustTimeBaseForNextFrame = false;
+
+    updateCanPushFrame();
     dataReady();
 }
 
 VideoEncoder::FrameInfo VideoEncoder::takeFrame()
 {
-    auto guard = lockLoopData();
-    return dequeueIfPossible(m_videoFrameQueue);
+    FrameInfo result = m_videoFrameQueue.pop().value_or(FrameInfo{});
+    if (result.frame.isValid())
+        updateCanPushFrame();
+    return result;
 }
 
 void VideoEncoder::retrievePackets()
@@ -122,6 +169,12 @@ void VideoEncoder::cleanup()
     while (!m_videoFrameQueue.empty())
         processOne();
 
+    flushElidedFrame();
+    m_lastFrame = {};
+
+    if (m_elideDuplicateFrames)
+        qCDebug(qLcFFmpegVideoEncoder) << "Elided duplicate frames:" << elidedFrameCount();
+
     while (m_frameEncoder->sendFrame(nullptr) == AVERROR(EAGAIN))
         retrievePackets();
     retrievePackets();
@@ -151,10 +204,92 @@ void VideoEncoder::processOne()
 
     FrameInfo frameInfo = takeFrame();
     QVideoFrame &frame = frameInfo.frame;
-    Q_ASSERT(frame.isValid());
+    if (!frame.isValid())
+        return; // the producer hasn't finished pushing the frame yet
 
     //    qCDebug(qLcFFmpegEncoder) << "new video buffer" << frame.startTime();
 
+    const auto [startTime, endTime] = frameTimeStamps(frame);
+
+    if (frameInfo.shouldAdjustTimeBase) {
+        m_baseTime += startTime - m_lastFrameTime;
+        qCDebug(qLcFFmpegVideoEncoder)
+                << ">>>> adjusting base time to" << m_baseTime << startTime << m_lastFrameTime;
+    }
+
+    const qint64 time = startTime - m_baseTime;
+    m_lastFrameTime = endTime;
+
+    if (m_elideDuplicateFrames && isDuplicateOfLastFrame(frame)) {
+        // Not sending the frame leaves a gap in pts, so the previous frame
+        // is displayed until the next changed one.
+        if (m_lastElidedFrame)
+            countElidedFrame(); // superseded by this one, so it won't be encoded on cleanup
+        m_lastElidedFrame.emplace(frame, time);
+        m_recordingEngine.newTimeStamp(time / 1000);
+        return;
+    }
+
+    const bool followsElidedFrames = m_lastElidedFrame.has_value();
+    if (followsElidedFrames) {
+        countElidedFrame();
+        m_lastElidedFrame.reset();
+    }
+    encodeFrame(frame, time, followsElidedFrames);
+}
+
+void VideoEncoder::countElidedFrame()
+{
+    m_elidedFrameCount.fetch_add(1, std::memory_order_relaxed);
+    m_recordingEngine.newSkippedVideoFrame();
+}
+
+bool VideoEncoder::isDuplicateOfLastFrame(const QVideoFrame &frame)
+{
+    // Frames that the source reports as changed since the previous one don't need hashing
+    const auto damage = QVideoFramePrivate::damage(frame);
+    const bool followsLastFrame =
+            damage && m_lastFrameSequence && damage->sequence == *m_lastFrameSequence + 1;
+    m_lastFrameSequence = damage ? std::optional(damage->sequence) : std::nullopt;
+    if (followsLastFrame && !damage->region.isEmpty()) {
+        m_lastFrameHash.reset();
+        m_lastFrame = {};
+        return false;
+    }
+
+    // Comparing GPU frames would require downloading them; skip them.
+    if (QVideoFramePrivate::hwBuffer(frame)) {
+        m_lastFrameHash.reset();
+        m_lastFrame = {};
+        return false;
+    }
+
+    QVideoFrame mappedFrame = frame;
+    if (!mappedFrame.map(QVideoFrame::ReadOnly)) {
+        m_lastFrameHash.reset();
+        m_lastFrame = {};
+        return false;
+    }
+
+    const size_t hash = sampledHash(mappedFrame);
+
+    // The hash only tells that the frames differ; confirm the match, so that
+    // a change between the samples doesn't drop a changed frame.
+    bool isDuplicate = false;
+    if (m_lastFrameHash == hash && m_lastFrame.map(QVideoFrame::ReadOnly)) {
+        isDuplicate = hasEqualData(mappedFrame, m_lastFrame);
+        m_lastFrame.unmap();
+    }
+
+    mappedFrame.unmap();
+
+    m_lastFrameHash = hash;
+    m_lastFrame = frame;
+    return isDuplicate;
+}
+
+void VideoEncoder::encodeFrame(QVideoFrame &frame, qint64 time, bool followsElidedFrames)
+{
     AVFrameUPtr avFrame;
 
     auto *videoBuffer = dynamic_cast<QFFmpegVideoBuffer *>(QVideoFramePrivate::hwBuffer(frame));
@@ -202,30 +337,28 @@ void VideoEncoder::processOne()
                                                new QVideoFrameHolder{ frame, img }, 0);
     }
 
-    const auto [startTime, endTime] = frameTimeStamps(frame);
-
-    if (frameInfo.shouldAdjustTimeBase) {
-        m_baseTime += startTime - m_lastFrameTime;
-        qCDebug(qLcFFmpegVideoEncoder)
-                << ">>>> adjusting base time to" << m_baseTime << startTime << m_lastFrameTime;
-    }
-
-    const qint64 time = startTime - m_baseTime;
-    m_lastFrameTime = endTime;
-
     setAVFrameTime(*avFrame, m_frameEncoder->getPts(time), m_frameEncoder->getTimeBase());
 
     m_recordingEngine.newTimeStamp(time / 1000);
 
     qCDebug(qLcFFmpegVideoEncoder)
             << ">>> sending frame" << avFrame->pts << time << m_lastFrameTime;
-    int ret = m_frameEncoder->sendFrame(std::move(avFrame));
+    int ret = m_frameEncoder->sendFrame(std::move(avFrame), followsElidedFrames);
     if (ret < 0) {
         qCDebug(qLcFFmpegVideoEncoder) << "error sending frame" << ret << AVError(ret);
         emit m_recordingEngine.sessionError(QMediaRecorder::ResourceError, err2str(ret));
     }
 }
 
+void VideoEncoder::flushElidedFrame()
+{
+    if (!m_lastElidedFrame)
+        return;
+
+    auto [frame, time] = *std::exchange(m_lastElidedFrame, std::nullopt);
+    encodeFrame(frame, time, true);
+}
+
 bool VideoEncoder::checkIfCanPushFrame() const
 {
     if (m_encodingStarted)
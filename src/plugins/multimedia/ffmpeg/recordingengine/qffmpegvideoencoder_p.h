@@ -17,8 +17,10 @@
 #include <QtFFmpegMediaPluginImpl/private/qffmpegencoderthread_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
 #include <QtFFmpegMediaPluginImpl/private/qffmpegvideoframeencoder_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegboundedqueue_p.h>
 #include <qvideoframe.h>
-#include <queue>
+#include <atomic>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -37,6 +39,16 @@ public:
 
     void addFrame(const QVideoFrame &frame);
 
+    /*!
+        Enables skipping of frames whose content is identical to the previously
+        encoded one. The previous frame's duration is then extended up to the
+        next changed frame. See QMediaRecorder::skipDuplicateVideoFrames.
+        Must be called before the encoder thread is started.
+     */
+    void setDuplicateFrameElision(bool enabled) { m_elideDuplicateFrames = enabled; }
+
+    quint64 elidedFrameCount() const { return m_elidedFrameCount.load(std::memory_order_relaxed); }
+
 protected:
     bool checkIfCanPushFrame() const override;
 
@@ -50,6 +62,11 @@ private:
     FrameInfo takeFrame();
     void retrievePackets();
 
+    bool isDuplicateOfLastFrame(const QVideoFrame &frame);
+    void countElidedFrame();
+    void encodeFrame(QVideoFrame &frame, qint64 time, bool followsElidedFrames = false);
+    void flushElidedFrame();
+
     bool init() override;
     void cleanup() override;
     bool hasData() const override;
@@ -60,13 +77,22 @@ private:
 private:
     QMediaEncoderSettings m_settings;
     VideoFrameEncoder::SourceParams m_sourceParams;
-    std::queue<FrameInfo> m_videoFrameQueue;
     const size_t m_maxQueueSize = 10; // Arbitrarily chosen to limit memory usage (332 MB @ 4K)
+    BoundedQueue<FrameInfo> m_videoFrameQueue{ m_maxQueueSize };
 
     VideoFrameEncoderUPtr m_frameEncoder;
     qint64 m_baseTime = 0;
-    bool m_shouldAdjustTimeBaseForNextFrame = true;
+    bool m_shouldAdjustTimeBaseForNextFrame = true; // accessed by the producer thread only
     qint64 m_lastFrameTime = 0;
+
+    bool m_elideDuplicateFrames = false;
+    std::optional<size_t> m_lastFrameHash;
+    QVideoFrame m_lastFrame; // to confirm hash matches
+    std::optional<quint64> m_lastFrameSequence; // see QVideoFramePrivate::Damage
+    // The most recent elided frame; it's encoded on cleanup so that
+    // a static tail of the recording keeps its duration.
+    std::optional<std::pair<QVideoFrame, qint64>> m_lastElidedFrame;
+    std::atomic<quint64> m_elidedFrameCount = 0;
 };
 
 } // namespace QFFmpeg
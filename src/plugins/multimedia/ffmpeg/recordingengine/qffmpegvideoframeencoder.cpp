@@ -460,7 +460,7 @@ private:
 };
 } // namespace
 
-int VideoFrameEncoder::sendFrame(AVFrameUPtr inputFrame)
+int VideoFrameEncoder::sendFrame(AVFrameUPtr inputFrame, bool followsGap)
 {
     if (!m_codecContext) {
         qWarning() << "codec context is not initialized!";
@@ -499,6 +499,9 @@ int VideoFrameEncoder::sendFrame(AVFrameUPtr inputFrame)
     getAVFrameTime(*resultFrame.value(), pts, timeBase);
     qCDebug(qLcVideoFrameEncoder) << "sending frame" << pts << "*" << timeBase;
 
+    if (followsGap)
+        m_ptsAfterGaps.insert(av_rescale_q(pts, timeBase, m_stream->time_base));
+
     return avcodec_send_frame(m_codecContext.get(), resultFrame.value().get());
 }
 
@@ -506,12 +509,24 @@ qint64 VideoFrameEncoder::estimateDuration(const AVPacket &packet, bool isFirstP
 {
     qint64 duration = 0; // In stream units, multiply by time_base to get seconds
 
+    const AVRational frameDuration = av_inv_q(m_codecContext->framerate);
+    const qint64 nominalDuration = av_rescale_q(1, frameDuration, m_stream->time_base);
+
+    // Packets whose frames have been dropped by the codec never show up here
+    const auto afterGapEnd = m_ptsAfterGaps.upper_bound(packet.pts);
+    const bool followsGap =
+            afterGapEnd != m_ptsAfterGaps.begin() && *std::prev(afterGapEnd) == packet.pts;
+    m_ptsAfterGaps.erase(m_ptsAfterGaps.begin(), afterGapEnd);
+
     if (isFirstPacket) {
         // First packet - Estimate duration from frame rate. Duration must
         // be set for single-frame videos, otherwise they won't open in
         // media player.
-        const AVRational frameDuration = av_inv_q(m_codecContext->framerate);
-        duration = av_rescale_q(1, frameDuration, m_stream->time_base);
+        duration = nominalDuration;
+    } else if (followsGap) {
+        // Duplicate frames have been elided before this one, so the distance
+        // to the previous packet is not the frame duration.
+        duration = std::min<qint64>(packet.pts - m_lastPacketTime, nominalDuration);
     } else {
         // Duration is calculated from actual packet times. TODO: Handle discontinuities
         duration = packet.pts - m_lastPacketTime;
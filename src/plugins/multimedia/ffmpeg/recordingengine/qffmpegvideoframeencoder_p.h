@@ -18,6 +18,8 @@
 #include <QtMultimedia/private/qplatformmediarecorder_p.h>
 #include <QtMultimedia/private/qmultimediautils_p.h>
 
+#include <set>
+
 
 QT_BEGIN_NAMESPACE
 
@@ -57,7 +59,8 @@ public:
 
     const AVRational &getTimeBase() const;
 
-    int sendFrame(AVFrameUPtr inputFrame);
+    // followsGap tells that preceding frames were elided, see estimateDuration
+    int sendFrame(AVFrameUPtr inputFrame, bool followsGap = false);
     AVPacketUPtr retrievePacket();
 
 private:
@@ -106,6 +109,7 @@ private:
     QSize m_targetSize;
 
     qint64 m_lastPacketTime = AV_NOPTS_VALUE;
+    std::set<qint64> m_ptsAfterGaps;
     AVCodecContextUPtr m_codecContext;
     SwsContextUPtr m_scaleContext;
     AVPixelFormat m_sourceFormat = AV_PIX_FMT_NONE;
@@ -17,6 +17,7 @@
 #include <uri_handler/qgstreamer_qiodevice_handler_p.h>
 #include <qgstreamerformatinfo_p.h>
 
+#include <QtMultimedia/private/qplaybackstatistics_p.h>
 #include <QtMultimedia/private/qthreadlocalrhi_p.h>
 #include <QtMultimedia/qaudiodevice.h>
 #include <QtCore/qdebug.h>
@@ -455,6 +456,10 @@ bool QGstreamerMediaPlayer::processBusMessage(const QGstreamerMessage &message)
             return processBusMessageApplication(message);
         return false;
 
+    case GST_MESSAGE_QOS:
+        processBusMessageQos(message);
+        return false;
+
     default:
         qCDebug(qLcMediaPlayer) << message;
 
@@ -464,6 +469,28 @@ bool QGstreamerMediaPlayer::processBusMessage(const QGstreamerMessage &message)
     return false;
 }
 
+void QGstreamerMediaPlayer::processBusMessageQos(const QGstreamerMessage &message)
+{
+    GstFormat format;
+    guint64 processed;
+    guint64 dropped;
+    gst_message_parse_qos_stats(message.message(), &format, &processed, &dropped);
+
+    // only video sinks report their statistics in buffers (i.e. frames), audio sinks use samples
+    if (format != GST_FORMAT_BUFFERS)
+        return;
+
+    gint64 jitter;
+    gdouble proportion;
+    gint quality;
+    gst_message_parse_qos_values(message.message(), &jitter, &proportion, &quality);
+
+    // the counters are only reset on state changes, so we keep the largest values seen
+    m_qosProcessedFrames = std::max<qint64>(m_qosProcessedFrames, processed);
+    m_qosDroppedFrames = std::max<qint64>(m_qosDroppedFrames, dropped);
+    m_qosJitter = std::chrono::round<std::chrono::microseconds>(std::chrono::nanoseconds(jitter));
+}
+
 bool QGstreamerMediaPlayer::processBusMessageApplication(const QGstreamerMessage &message)
 {
     using namespace std::chrono;
@@ -849,6 +876,9 @@ void QGstreamerMediaPlayer::setMedia(const QUrl &content, QIODevice *stream)
         cleanupCustomPipeline();
 
     m_resourceErrorState = ResourceErrorState::NoError;
+    m_qosProcessedFrames = 0;
+    m_qosDroppedFrames = 0;
+    m_qosJitter = {};
     m_url = content;
     m_stream = stream;
     QUrl streamURL;
@@ -1011,6 +1041,17 @@ void QGstreamerMediaPlayer::setVideoSink(QVideoSink *sink)
     m_gstVideoSink->connectPluggableVideoSink(pluggableSink);
 }
 
+QPlaybackStatistics QGstreamerMediaPlayer::playbackStatistics() const
+{
+    QPlaybackStatistics statistics;
+    auto *d = QPlaybackStatisticsPrivate::get(statistics);
+    d->decodedVideoFrames = m_qosProcessedFrames + m_qosDroppedFrames;
+    d->presentedVideoFrames = m_qosProcessedFrames;
+    d->droppedVideoFrames = m_qosDroppedFrames;
+    d->audioVideoSyncOffset = m_qosJitter;
+    return statistics;
+}
+
 int QGstreamerMediaPlayer::trackCount(QPlatformMediaPlayer::TrackType type)
 {
     QSpan<const QMediaMetaData> tracks = m_trackMetaData[type];
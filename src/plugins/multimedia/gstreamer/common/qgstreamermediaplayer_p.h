@@ -89,6 +89,8 @@ public:
     PitchCompensationAvailability pitchCompensationAvailability() const override;
     bool pitchCompensation() const override;
 
+    QPlaybackStatistics playbackStatistics() const override;
+
 private:
     QGstreamerMediaPlayer(QGstreamerVideoOutput *videoOutput, QMediaPlayer *parent);
 
@@ -111,6 +113,11 @@ private:
 
     ResourceErrorState m_resourceErrorState = ResourceErrorState::NoError;
     float m_bufferProgress = 0.f;
+
+    // QoS counters of the video sink, reset when the media changes
+    qint64 m_qosProcessedFrames = 0;
+    qint64 m_qosDroppedFrames = 0;
+    std::chrono::microseconds m_qosJitter{};
     std::chrono::milliseconds m_duration{};
 
     QGstreamerAudioOutput *gstAudioOutput = nullptr;
@@ -119,6 +126,7 @@ private:
     // // Message handler
     bool processBusMessage(const QGstreamerMessage &message) override;
     bool processBusMessageApplication(const QGstreamerMessage &message);
+    void processBusMessageQos(const QGstreamerMessage &message);
 
     // decoder connections
     void disconnectDecoderHandlers();
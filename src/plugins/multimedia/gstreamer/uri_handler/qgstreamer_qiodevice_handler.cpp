@@ -8,11 +8,14 @@
 #include <QtCore/qiodevice.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/qspan.h>
 #include <QtCore/qurl.h>
 #include <QtCore/quuid.h>
+#include <QtCore/qwaitcondition.h>
 
 #include <gst/base/gstbasesrc.h>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -67,9 +70,6 @@ QByteArray QIODeviceRegistry::registerQIODevice(QIODevice *device)
 {
     Q_ASSERT(device);
 
-    if (device->isSequential())
-        qWarning() << "GStreamer: sequential QIODevices are not fully supported";
-
     QMutexLocker lock(&m_registryMutex);
 
     auto it = m_reverseLookupTable.find(device);
@@ -154,6 +154,179 @@ bool QIODeviceRegistry::Record::isValid() const
 
 Q_GLOBAL_STATIC(QIODeviceRegistry, gQIODeviceRegistry);
 
+// QIODeviceStreamReader
+
+// Sequential devices can't be read on demand from the streaming thread: they may need the event
+// loop of their thread to receive data, and they aren't thread-safe. The reader reads them in
+// their thread whenever they signal readyRead, into a bounded queue that the streaming thread
+// consumes in push mode.
+class QIODeviceStreamReader : public QObject
+{
+public:
+    // The reader stops reading from the device when the queue is full
+    static constexpr qint64 maxQueueSize = 2 * 1024 * 1024;
+    // After an underrun, the streaming thread waits until the queue is refilled to this size
+    static constexpr qint64 bufferingSize = 256 * 1024;
+    static constexpr qint64 maxChunkSize = 64 * 1024;
+
+    enum class Status : uint8_t { Ok, EndOfStream, Flushing };
+
+    QIODeviceStreamReader(QIODevice *device, GstElement *element);
+
+    // streaming thread
+    Status read(uchar *data, qint64 maxSize, qint64 &bytesRead);
+    void setFlushing(bool flushing);
+
+private:
+    // device thread
+    void readFromDevice();
+    void setEndOfStream();
+
+    void postBufferingMessage(int percent);
+
+    QPointer<QIODevice> m_device;
+    GstElement *m_element;
+
+    QMutex m_mutex;
+    QWaitCondition m_queueChanged;
+    std::deque<QByteArray> m_queue;
+    qint64 m_queueSize = 0;
+    qsizetype m_headOffset = 0; // consumed bytes of the first chunk
+    bool m_endOfStream = false;
+    bool m_flushing = false;
+    bool m_waitingForSpace = false;
+};
+
+QIODeviceStreamReader::QIODeviceStreamReader(QIODevice *device, GstElement *element)
+    : m_device(device), m_element(element)
+{
+    moveToThread(device->thread());
+
+    connect(device, &QIODevice::readyRead, this, &QIODeviceStreamReader::readFromDevice);
+    connect(device, &QIODevice::readChannelFinished, this,
+            &QIODeviceStreamReader::readFromDevice);
+    connect(device, &QIODevice::aboutToClose, this, &QIODeviceStreamReader::setEndOfStream);
+    connect(device, &QObject::destroyed, this, &QIODeviceStreamReader::setEndOfStream);
+
+    // Devices may already have data, and some never emit readyRead
+    QMetaObject::invokeMethod(this, &QIODeviceStreamReader::readFromDevice, Qt::QueuedConnection);
+}
+
+void QIODeviceStreamReader::readFromDevice()
+{
+    while (true) {
+        if (!m_device || !m_device->isOpen())
+            return setEndOfStream();
+
+        qint64 freeSpace = 0;
+        {
+            QMutexLocker lock(&m_mutex);
+            freeSpace = maxQueueSize - m_queueSize;
+            m_waitingForSpace = freeSpace <= 0;
+            if (m_waitingForSpace || m_endOfStream)
+                return;
+        }
+
+        QByteArray chunk(qMin(freeSpace, maxChunkSize), Qt::Uninitialized);
+        const qint64 bytesRead = m_device->read(chunk.data(), chunk.size());
+
+        // A sequential device returns -1 when no more data will ever be available
+        if (bytesRead < 0)
+            return setEndOfStream();
+        if (bytesRead == 0)
+            return; // wait for readyRead
+
+        chunk.truncate(bytesRead);
+
+        QMutexLocker lock(&m_mutex);
+        m_queueSize += bytesRead;
+        m_queue.push_back(std::move(chunk));
+        m_queueChanged.wakeAll();
+    }
+}
+
+void QIODeviceStreamReader::setEndOfStream()
+{
+    QMutexLocker lock(&m_mutex);
+    m_endOfStream = true;
+    m_queueChanged.wakeAll();
+}
+
+QIODeviceStreamReader::Status QIODeviceStreamReader::read(uchar *data, qint64 maxSize,
+                                                          qint64 &bytesRead)
+{
+    bytesRead = 0;
+
+    QMutexLocker lock(&m_mutex);
+
+    if (m_queue.empty() && !m_endOfStream && !m_flushing) {
+        // Underrun: let the application know, and wait until the queue is refilled
+        int reportedPercent = -1;
+        while (!m_flushing && !m_endOfStream && m_queueSize < bufferingSize) {
+            const int percent = int(m_queueSize * 100 / bufferingSize);
+            if (percent != reportedPercent) {
+                reportedPercent = percent;
+                lock.unlock();
+                postBufferingMessage(percent);
+                lock.relock();
+                continue;
+            }
+            m_queueChanged.wait(&m_mutex);
+        }
+
+        if (reportedPercent != -1) {
+            lock.unlock();
+            postBufferingMessage(100);
+            lock.relock();
+        }
+    }
+
+    if (m_flushing)
+        return Status::Flushing;
+
+    while (bytesRead < maxSize && !m_queue.empty()) {
+        const QByteArray &chunk = m_queue.front();
+        const qint64 size = qMin(maxSize - bytesRead, qint64(chunk.size() - m_headOffset));
+        memcpy(data + bytesRead, chunk.constData() + m_headOffset, size);
+        bytesRead += size;
+        m_headOffset += size;
+
+        if (m_headOffset == chunk.size()) {
+            m_queue.pop_front();
+            m_headOffset = 0;
+        }
+    }
+
+    m_queueSize -= bytesRead;
+
+    if (bytesRead == 0) {
+        Q_ASSERT(m_endOfStream);
+        return Status::EndOfStream;
+    }
+
+    if (m_waitingForSpace) {
+        m_waitingForSpace = false;
+        QMetaObject::invokeMethod(this, &QIODeviceStreamReader::readFromDevice,
+                                  Qt::QueuedConnection);
+    }
+
+    return Status::Ok;
+}
+
+void QIODeviceStreamReader::setFlushing(bool flushing)
+{
+    QMutexLocker lock(&m_mutex);
+    m_flushing = flushing;
+    m_queueChanged.wakeAll();
+}
+
+void QIODeviceStreamReader::postBufferingMessage(int percent)
+{
+    GstMessage *message = gst_message_new_buffering(GST_OBJECT(m_element), percent);
+    gst_message_set_buffering_stats(message, GST_BUFFERING_STREAM, -1, -1, -1);
+    gst_element_post_message(m_element, message);
+}
+
 // qt helpers
 
 // glib / gstreamer object
@@ -173,6 +346,9 @@ struct QGstQIODeviceSrc
     bool isSeekable();
     std::optional<guint64> size();
     GstFlowReturn fill(guint64 offset, guint length, GstBuffer *buf);
+    GstFlowReturn fillFromStream(QIODeviceStreamReader *reader, guint64 offset, guint length,
+                                 GstBuffer *buf);
+    void setFlushing(bool flushing);
     void getURI(GValue *value) const;
     bool setURI(const char *location, GError **err = nullptr);
 
@@ -182,6 +358,7 @@ struct QGstQIODeviceSrc
 
     GstBaseSrc baseSrc;
     QIODeviceRegistry::SharedRecord record;
+    QIODeviceStreamReader *streamReader = nullptr; // sequential devices only, in push mode
 };
 
 void QGstQIODeviceSrc::getProperty(guint propId, GValue *value, const GParamSpec *pspec) const
@@ -211,30 +388,60 @@ void QGstQIODeviceSrc::setProperty(guint propId, const GValue *value, const GPar
 bool QGstQIODeviceSrc::start()
 {
     std::lock_guard guard{ *this };
-    return record && record->isValid();
+    if (!record)
+        return false;
+
+    return record->runWhileLocked([&](QIODevice *device) {
+        if (!device)
+            return false;
+
+        // Random access devices are read in pull mode, directly from the streaming thread
+        if (device->isSequential()) {
+            Q_ASSERT(!streamReader);
+            streamReader = new QIODeviceStreamReader(device, GST_ELEMENT(&baseSrc));
+        }
+        return true;
+    });
 }
 
 bool QGstQIODeviceSrc::stop()
 {
+    std::lock_guard guard{ *this };
+    if (streamReader) {
+        // the streaming thread has stopped, the reader can be deleted in the device thread
+        streamReader->deleteLater();
+        streamReader = nullptr;
+    }
     return true;
 }
 
 bool QGstQIODeviceSrc::isSeekable()
 {
     std::lock_guard guard{ *this };
+    if (!record)
+        return false;
+
     return record->runWhileLocked([&](QIODevice *device) {
-        return !device->isSequential();
+        return device && !device->isSequential();
     });
 }
 
+void QGstQIODeviceSrc::setFlushing(bool flushing)
+{
+    std::lock_guard guard{ *this };
+    if (streamReader)
+        streamReader->setFlushing(flushing);
+}
+
 std::optional<guint64> QGstQIODeviceSrc::size()
 {
     std::lock_guard guard{ *this };
     if (!record)
         return std::nullopt;
 
-    qint64 size = record->runWhileLocked([&](QIODevice *device) {
-        return device->size();
+    // The size of sequential devices is only the number of bytes available
+    qint64 size = record->runWhileLocked([&](QIODevice *device) -> qint64 {
+        return device && !device->isSequential() ? device->size() : -1;
     });
 
     if (size == -1)
@@ -248,6 +455,12 @@ GstFlowReturn QGstQIODeviceSrc::fill(guint64 offset, guint length, GstBuffer *bu
     if (!record)
         return GST_FLOW_ERROR;
 
+    if (QIODeviceStreamReader *reader = streamReader) {
+        // don't hold the object lock while waiting for data, unlock() needs it
+        guard.unlock();
+        return fillFromStream(reader, offset, length, buf);
+    }
+
     GstMapInfo info;
     if (!gst_buffer_map(buf, &info, GST_MAP_WRITE)) {
         guard.unlock();
@@ -301,6 +514,40 @@ GstFlowReturn QGstQIODeviceSrc::fill(guint64 offset, guint length, GstBuffer *bu
     return GST_FLOW_OK;
 }
 
+GstFlowReturn QGstQIODeviceSrc::fillFromStream(QIODeviceStreamReader *reader, guint64 offset,
+                                               guint length, GstBuffer *buf)
+{
+    GstMapInfo info;
+    if (!gst_buffer_map(buf, &info, GST_MAP_WRITE)) {
+        GST_ELEMENT_ERROR(&baseSrc, RESOURCE, WRITE, (nullptr), ("Can't map buffer for writing"));
+        return GST_FLOW_ERROR;
+    }
+
+    qint64 totalRead = 0;
+    const auto status = reader->read(info.data, length, totalRead);
+    gst_buffer_unmap(buf, &info);
+
+    switch (status) {
+    case QIODeviceStreamReader::Status::Flushing:
+        gst_buffer_resize(buf, 0, 0);
+        return GST_FLOW_FLUSHING;
+    case QIODeviceStreamReader::Status::EndOfStream:
+        gst_buffer_resize(buf, 0, 0);
+        return GST_FLOW_EOS;
+    case QIODeviceStreamReader::Status::Ok:
+        break;
+    }
+
+    if (totalRead != length)
+        gst_buffer_resize(buf, 0, totalRead);
+
+    // in push mode, the buffers follow each other
+    GST_BUFFER_OFFSET(buf) = offset;
+    GST_BUFFER_OFFSET_END(buf) = offset + totalRead;
+
+    return GST_FLOW_OK;
+}
+
 void QGstQIODeviceSrc::getURI(GValue *value) const
 {
     std::lock_guard guard{ *this };
@@ -446,6 +693,16 @@ void gst_qiodevice_src_class_init(QGstQIODeviceSrcClass *klass)
         QGstQIODeviceSrc *src = asQGstQIODeviceSrc(basesrc);
         return src->fill(offset, length, buf);
     };
+    gstbasesrcClass->unlock = [](GstBaseSrc *basesrc) -> gboolean {
+        QGstQIODeviceSrc *src = asQGstQIODeviceSrc(basesrc);
+        src->setFlushing(true);
+        return true;
+    };
+    gstbasesrcClass->unlock_stop = [](GstBaseSrc *basesrc) -> gboolean {
+        QGstQIODeviceSrc *src = asQGstQIODeviceSrc(basesrc);
+        src->setFlushing(false);
+        return true;
+    };
 }
 
 void qGstInitQIODeviceURIHandler(gpointer g_handlerInterface, gpointer)
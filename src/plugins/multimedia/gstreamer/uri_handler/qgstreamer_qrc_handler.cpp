@@ -5,6 +5,7 @@
 
 #include <QtCore/qfile.h>
 #include <QtCore/qglobal.h>
+#include <QtCore/qresource.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qurl.h>
 
@@ -50,6 +51,7 @@ struct QGstQrcSrc
     bool stop();
 
     std::optional<guint64> size();
+    GstFlowReturn create(guint64 offset, guint length, GstBuffer **buf);
     GstFlowReturn fill(guint64 offset, guint length, GstBuffer *buf);
     void getURI(GValue *value) const;
     bool setURI(const char *location, GError **err = nullptr);
@@ -60,6 +62,10 @@ struct QGstQrcSrc
 
     GstBaseSrc baseSrc;
     QFile file;
+
+    // Uncompressed resources are mapped, and served without copying
+    const uchar *mappedData = nullptr;
+    qint64 mappedSize = 0;
 };
 
 void QGstQrcSrc::getProperty(guint propId, GValue *value, const GParamSpec *pspec) const
@@ -106,6 +112,15 @@ bool QGstQrcSrc::start()
 
     gst_base_src_set_dynamic_size(&baseSrc, false);
 
+    // QFile::map() returns the resource data itself, which stays valid as long as the resource
+    // is registered, also after the file is closed. Compressed resources can't be mapped.
+    if (QResource(file.fileName()).compressionAlgorithm() == QResource::NoCompression) {
+        mappedSize = file.size();
+        mappedData = file.map(0, mappedSize);
+        if (!mappedData)
+            mappedSize = 0;
+    }
+
     Q_ASSERT(file.isOpen());
     return true;
 }
@@ -113,6 +128,8 @@ bool QGstQrcSrc::start()
 bool QGstQrcSrc::stop()
 {
     std::lock_guard guard{ *this };
+    mappedData = nullptr;
+    mappedSize = 0;
     file.close();
     return true;
 }
@@ -125,6 +142,38 @@ std::optional<guint64> QGstQrcSrc::size()
     return file.size();
 }
 
+GstFlowReturn QGstQrcSrc::create(guint64 offset, guint length, GstBuffer **buf)
+{
+    std::unique_lock guard{ *this };
+
+    if (!mappedData || offset == guint64(-1)) {
+        // compressed resource: read a copy via fill()
+        guard.unlock();
+        return GST_BASE_SRC_CLASS(parent_class)->create(&baseSrc, offset, length, buf);
+    }
+
+    if (offset >= guint64(mappedSize))
+        return GST_FLOW_EOS;
+
+    const gsize size = gsize(qMin(guint64(length), guint64(mappedSize) - offset));
+
+    if (*buf) {
+        // downstream provided the buffer to fill
+        gsize copied = gst_buffer_fill(*buf, 0, mappedData + offset, size);
+        gst_buffer_set_size(*buf, copied);
+    } else {
+        // The resource data is immutable and outlives the buffer, no need to release it
+        *buf = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY,
+                                           const_cast<uchar *>(mappedData), mappedSize, offset,
+                                           size, nullptr, nullptr);
+    }
+
+    GST_BUFFER_OFFSET(*buf) = offset;
+    GST_BUFFER_OFFSET_END(*buf) = offset + size;
+
+    return GST_FLOW_OK;
+}
+
 GstFlowReturn QGstQrcSrc::fill(guint64 offset, guint length, GstBuffer *buf)
 {
     std::unique_lock guard{ *this };
@@ -307,6 +356,11 @@ void gst_qrc_src_class_init(QGstQrcSrcClass *klass)
         *size = optionalSize.value();
         return true;
     };
+    gstbasesrcClass->create = [](GstBaseSrc *basesrc, guint64 offset, guint length,
+                                 GstBuffer **buf) -> GstFlowReturn {
+        QGstQrcSrc *src = asQGstQrcSrc(basesrc);
+        return src->create(offset, length, buf);
+    };
     gstbasesrcClass->fill = [](GstBaseSrc *basesrc, guint64 offset, guint length,
                                GstBuffer *buf) -> GstFlowReturn {
         QGstQrcSrc *src = asQGstQrcSrc(basesrc);
@@ -317,6 +371,8 @@ void gst_qrc_src_class_init(QGstQrcSrcClass *klass)
 void gst_qrc_src_init(QGstQrcSrc *self)
 {
     new (reinterpret_cast<void *>(&self->file)) QFile;
+    self->mappedData = nullptr;
+    self->mappedSize = 0;
 
     static constexpr guint defaultBlockSize = 16384;
     gst_base_src_set_blocksize(&self->baseSrc, defaultBlockSize);
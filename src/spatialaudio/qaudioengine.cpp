@@ -6,6 +6,7 @@
 #include <QtCore/qiodevice.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qelapsedtimer.h>
+#include <QtCore/qvarlengtharray.h>
 
 #include <QtMultimedia/qaudiodecoder.h>
 #include <QtMultimedia/qmediadevices.h>
@@ -22,6 +23,11 @@
 #include <QtSpatialAudio/qaudiolistener.h>
 
 #include <resonance_audio.h>
+#include <dsp/distance_attenuation.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -138,48 +144,16 @@ qint64 QAudioOutputStream::readData(char *data, qint64 len)
     if (len < nChannels*int(sizeof(float))*QAudioEnginePrivate::bufferSize)
         return 0;
 
+    const bool ambisonicOutput = ambisonicDecoder && d->outputMode == QAudioEngine::Surround;
+    d->updateSourceRendering(ambisonicOutput);
+
     short *fd = (short *)data;
     qint64 frames = len / nChannels / sizeof(short);
-    bool ok = true;
     while (frames >= qint64(QAudioEnginePrivate::bufferSize)) {
-        // Fill input buffers
-        for (auto *source : std::as_const(d->sources)) {
-            auto *sp = QSpatialSoundPrivate::get(source);
-            if (!sp)
-                continue;
-            float buf[QAudioEnginePrivate::bufferSize];
-            sp->getBuffer(buf, QAudioEnginePrivate::bufferSize, 1);
-            d->resonanceAudio->api->SetInterleavedBuffer(sp->sourceId, buf, 1, QAudioEnginePrivate::bufferSize);
-        }
-        for (auto *source : std::as_const(d->stereoSources)) {
-            auto *sp = QAmbientSoundPrivate::get(source);
-            if (!sp)
-                continue;
-            float buf[2*QAudioEnginePrivate::bufferSize];
-            sp->getBuffer(buf, QAudioEnginePrivate::bufferSize, 2);
-            d->resonanceAudio->api->SetInterleavedBuffer(sp->sourceId, buf, 2, QAudioEnginePrivate::bufferSize);
-        }
-
-        if (ambisonicDecoder && d->outputMode == QAudioEngine::Surround) {
-            const float *channels[QAmbisonicDecoder::maxAmbisonicChannels];
-            const float *reverbBuffers[2];
-            int nSamples = d->resonanceAudio->getAmbisonicOutput(channels, reverbBuffers, ambisonicDecoder->nInputChannels());
-            Q_ASSERT(ambisonicDecoder->nOutputChannels() <= 8);
-            ambisonicDecoder->processBufferWithReverb(channels, reverbBuffers, fd, nSamples);
-        } else {
-            ok = d->resonanceAudio->api->FillInterleavedOutputBuffer(2, QAudioEnginePrivate::bufferSize, fd);
-            if (!ok) {
-                // If we get here, it means that resonanceAudio did not actually fill the buffer.
-                // Sometimes this is expected, for example if resonanceAudio does not have any sources.
-                // In this case we just fill the buffer with silence.
-                if (d->sources.isEmpty() && d->stereoSources.isEmpty()) {
-                    memset(fd, 0, nChannels * QAudioEnginePrivate::bufferSize * sizeof(short));
-                } else {
-                    // If we get here, it means that something unexpected happened, so bail.
-                    qWarning() << "    Reading failed!";
-                    break;
-                }
-            }
+        if (!d->renderBuffer(fd, nChannels, ambisonicOutput ? ambisonicDecoder.get() : nullptr)) {
+            // If we get here, it means that something unexpected happened, so bail.
+            qWarning() << "    Reading failed!";
+            break;
         }
         fd += nChannels*QAudioEnginePrivate::bufferSize;
         frames -= QAudioEnginePrivate::bufferSize;
@@ -189,6 +163,52 @@ qint64 QAudioOutputStream::readData(char *data, qint64 len)
     return bytesProcessed;
 }
 
+namespace {
+
+using Rendering = QSpatialSoundPrivate::Rendering;
+
+Rendering renderingForQuality(QAudioEngine::RenderingQuality quality)
+{
+    switch (quality) {
+    case QAudioEngine::RenderingQuality::Medium:
+        return Rendering::BinauralMedium;
+    case QAudioEngine::RenderingQuality::Low:
+        return Rendering::BinauralLow;
+    case QAudioEngine::RenderingQuality::StereoPanning:
+        return Rendering::StereoPanning;
+    default:
+        return Rendering::BinauralHigh;
+    }
+}
+
+Rendering automaticRendering(const QSpatialSoundPrivate &sound, const QVector3D &listener)
+{
+    const vraudio::WorldPosition listenerPosition(listener.x(), listener.y(), listener.z());
+    const vraudio::WorldPosition soundPosition(sound.pos.x(), sound.pos.y(), sound.pos.z());
+
+    float attenuation = 1.f;
+    switch (sound.distanceModel) {
+    case QSpatialSound::DistanceModel::Logarithmic:
+        attenuation = vraudio::ComputeLogarithmicDistanceAttenuation(
+                listenerPosition, soundPosition, sound.size, sound.distanceCutoff);
+        break;
+    case QSpatialSound::DistanceModel::Linear:
+        attenuation = vraudio::ComputeLinearDistanceAttenuation(
+                listenerPosition, soundPosition, sound.size, sound.distanceCutoff);
+        break;
+    case QSpatialSound::DistanceModel::ManualAttenuation:
+        attenuation = sound.manualAttenuation;
+        break;
+    }
+
+    const float distance = (sound.pos - listener).length();
+    const float gain = sound.volume * sound.wallDampening * attenuation;
+
+    return QSpatialSoundPrivate::automaticRendering(distance, gain, sound.rendering);
+}
+
+} // namespace
+
 QAudioEnginePrivate::QAudioEnginePrivate(QAudioEngine *q) : q(q)
 {
     audioThread.setObjectName(u"QAudioThread");
@@ -264,19 +284,24 @@ void QAudioEnginePrivate::setOutputMode(QAudioEngine::OutputMode mode)
 void QAudioEnginePrivate::addSpatialSound(QSpatialSound *sound)
 {
     QMutexLocker l(&mutex);
-    QAmbientSoundPrivate *sd = QAmbientSoundPrivate::get(sound);
-
-    sd->sourceId = resonanceAudio->api->CreateSoundObjectSource(vraudio::kBinauralHighQuality);
+    QSpatialSoundPrivate *sd = QSpatialSoundPrivate::get(sound);
+
+    // Automatic rendering starts with the best quality, and is adjusted by the audio thread
+    QMutexLocker soundLocker(&sd->mutex);
+    sd->rendering = renderingForQuality(effectiveRenderingQuality(sd));
+    sd->sourceGain = 1.f;
+    sd->createSource(sd->rendering);
+    sd->positionDirty = true;
     sources.append(sound);
 }
 
 void QAudioEnginePrivate::removeSpatialSound(QSpatialSound *sound)
 {
     QMutexLocker l(&mutex);
-    QAmbientSoundPrivate *sd = QAmbientSoundPrivate::get(sound);
+    QSpatialSoundPrivate *sd = QSpatialSoundPrivate::get(sound);
 
-    resonanceAudio->api->DestroySource(sd->sourceId);
-    sd->sourceId = vraudio::ResonanceAudioApi::kInvalidSourceId;
+    QMutexLocker soundLocker(&sd->mutex);
+    sd->destroySources();
     sources.removeOne(sound);
 }
 
@@ -303,12 +328,18 @@ void QAudioEnginePrivate::addRoom(QAudioRoom *room)
 {
     QMutexLocker l(&mutex);
     rooms.append(room);
+    roomIndexDirty = true;
+    roomsDirty = true;
 }
 
 void QAudioEnginePrivate::removeRoom(QAudioRoom *room)
 {
     QMutexLocker l(&mutex);
     rooms.removeOne(room);
+    if (currentRoom == room)
+        currentRoom = nullptr;
+    roomIndexDirty = true;
+    roomsDirty = true;
 }
 
 // This method is called from the audio thread
@@ -317,68 +348,108 @@ void QAudioEnginePrivate::updateRooms()
     if (!roomEffectsEnabled)
         return;
 
-    bool needUpdate = listenerPositionDirty;
-    listenerPositionDirty = false;
-
-    bool roomDirty = false;
-    for (const auto &room : std::as_const(rooms)) {
-        auto *rd = QAudioRoomPrivate::get(room);
-        if (rd->dirty) {
-            roomDirty = true;
-            rd->update();
-            needUpdate = true;
+    // Collect what changed since the last update, and only recompute what depends on it
+    bool geometryChanged = std::exchange(roomIndexDirty, false);
+    QVarLengthArray<int, 8> changedRooms;
+    if (roomsDirty.fetchAndStoreRelaxed(false)) {
+        for (int i = 0; i < rooms.size(); ++i) {
+            auto *rd = QAudioRoomPrivate::get(rooms.at(i));
+            if (rd->geometryDirty) {
+                rd->geometryDirty = false;
+                geometryChanged = true;
+            }
+            if (rd->dirty) {
+                rd->update();
+                changedRooms.append(i);
+            }
         }
     }
 
-    if (!needUpdate)
-        return;
+    if (geometryChanged) {
+        QList<QAudioRoomGeometry> geometries;
+        geometries.reserve(rooms.size());
+        for (auto *r : std::as_const(rooms))
+            geometries.append(QAudioRoomPrivate::get(r)->geometry());
+        roomIndex.build(std::move(geometries));
+    }
 
-    QVector3D listenerPos = listenerPosition();
-    float roomVolume = float(qInf());
-    QAudioRoom *room = nullptr;
-    // Find the smallest room that contains the listener and apply its room effects
-    for (auto *r : std::as_const(rooms)) {
-        QVector3D dim2 = r->dimensions()/2.;
-        float vol = dim2.x()*dim2.y()*dim2.z();
-        if (vol > roomVolume)
-            continue;
-        QVector3D dist = r->position() - listenerPos;
-        // transform into room coordinates
-        dist = r->rotation().rotatedVector(dist);
-        if (qAbs(dist.x()) <= dim2.x() &&
-            qAbs(dist.y()) <= dim2.y() &&
-            qAbs(dist.z()) <= dim2.z()) {
-            room = r;
-            roomVolume = vol;
-        }
+    const bool listenerMoved = std::exchange(listenerPositionDirty, false);
+    if (listenerMoved || geometryChanged)
+        currentRoomIndex = roomIndex.roomAt(listenerPosition() * distanceScale);
+    QAudioRoom *room = currentRoomIndex >= 0 ? rooms.at(currentRoomIndex) : nullptr;
+
+    // The acoustics depend on the room of the listener and the rooms connected to it
+    bool acousticsChanged = room != currentRoom || geometryChanged;
+    const auto connections = roomIndex.connections(currentRoomIndex);
+    for (int i : changedRooms) {
+        acousticsChanged = acousticsChanged || i == currentRoomIndex
+                || std::any_of(connections.begin(), connections.end(),
+                               [i](const auto &connection) { return connection.room == i; });
     }
-    if (room != currentRoom)
-        roomDirty = true;
-    const bool previousRoom = currentRoom;
+
+    const bool wasInRoom = currentRoom;
     currentRoom = room;
+    if (acousticsChanged)
+        applyRoomAcoustics(wasInRoom);
 
-    if (!roomDirty)
+    // Outside of all rooms, there are no walls between the sources and the listener
+    if (!currentRoom && !acousticsChanged)
         return;
 
-    // apply room to engine
+    // Sources only need an update if they moved, or if the walls between them and the
+    // listener changed
+    for (auto *s : std::as_const(sources)) {
+        auto *sp = QSpatialSoundPrivate::get(s);
+        if (!sp)
+            continue;
+        const bool sourceMoved = sp->positionDirty.fetchAndStoreRelaxed(false);
+        if (sourceMoved || geometryChanged)
+            sp->roomIndex = roomIndex.roomAt(sp->pos);
+        if (sourceMoved || acousticsChanged || (listenerMoved && sp->outsideListenerRoom))
+            sp->updateRoomEffects();
+    }
+}
+
+// Applies the reflections and reverb of the listener's room, including what comes in
+// through its openings
+void QAudioEnginePrivate::applyRoomAcoustics(bool wasInRoom)
+{
     if (!currentRoom) {
         resonanceAudio->api->EnableRoomEffects(false);
         return;
     }
-    if (!previousRoom)
+    if (!wasInRoom)
         resonanceAudio->api->EnableRoomEffects(true);
 
-    QAudioRoomPrivate *rp = QAudioRoomPrivate::get(room);
-    resonanceAudio->api->SetReflectionProperties(rp->reflections);
-    resonanceAudio->api->SetReverbProperties(rp->reverb);
+    QAudioRoomPrivate *rp = QAudioRoomPrivate::get(currentRoom);
+    const QAudioRoomGeometry &geometry = roomIndex.room(currentRoomIndex);
+    const float surfaceArea = geometry.surfaceArea();
 
-    // update room effects for all sound sources
-    for (auto *s : std::as_const(sources)) {
-        auto *sp = QSpatialSoundPrivate::get(s);
-        if (!sp)
+    vraudio::ReflectionProperties reflections = rp->reflections;
+    vraudio::ReverbProperties reverb = rp->reverb;
+
+    for (const auto &connection : roomIndex.connections(currentRoomIndex)) {
+        // The open part of a wall doesn't reflect
+        const float wallFraction =
+                std::min(connection.openingArea / geometry.wallArea(connection.wall), 1.f);
+        reflections.coefficients[connection.wall] *= 1.f - wallFraction;
+
+        // The reverb of a connected room is mixed in according to the share of the opening
+        // in the surface of the room, and reverb escapes through openings to the outside
+        const float weight = std::min(connection.openingArea / surfaceArea, 1.f);
+        if (connection.room < 0) {
+            reverb.gain -= weight * rp->reverb.gain;
             continue;
-        sp->updateRoomEffects();
+        }
+        const auto &other = QAudioRoomPrivate::get(rooms.at(connection.room))->reverb;
+        for (size_t i = 0; i < std::size(reverb.rt60_values); ++i)
+            reverb.rt60_values[i] += weight * (other.rt60_values[i] - rp->reverb.rt60_values[i]);
+        reverb.gain += weight * (other.gain - rp->reverb.gain);
     }
+    reverb.gain = std::max(reverb.gain, 0.f);
+
+    resonanceAudio->api->SetReflectionProperties(reflections);
+    resonanceAudio->api->SetReverbProperties(reverb);
 }
 
 QVector3D QAudioEnginePrivate::listenerPosition() const
@@ -386,6 +457,91 @@ QVector3D QAudioEnginePrivate::listenerPosition() const
     return listener ? listener->position() : QVector3D();
 }
 
+QAudioEngine::RenderingQuality
+QAudioEnginePrivate::effectiveRenderingQuality(const QSpatialSoundPrivate *sound) const
+{
+    if (sound->renderingQuality != QAudioEngine::RenderingQuality::Automatic)
+        return sound->renderingQuality;
+    return renderingQuality;
+}
+
+// This method is called from the audio thread
+void QAudioEnginePrivate::updateSourceRendering(bool ambisonicOutput)
+{
+    const QVector3D listener = listenerPosition() * distanceScale;
+
+    for (auto *source : std::as_const(sources)) {
+        auto *sp = QSpatialSoundPrivate::get(source);
+        if (!sp)
+            continue;
+
+        const QAudioEngine::RenderingQuality quality = effectiveRenderingQuality(sp);
+        Rendering rendering = quality == QAudioEngine::RenderingQuality::Automatic
+                ? automaticRendering(*sp, listener)
+                : renderingForQuality(quality);
+
+        // Stereo panned sounds bypass the ambisonic sound field, which is all that is decoded
+        // to surround speakers
+        if (rendering == Rendering::StereoPanning && ambisonicOutput)
+            rendering = Rendering::BinauralLow;
+
+        sp->setRendering(rendering);
+    }
+}
+
+// Renders one buffer of bufferSize frames. Called from the audio thread.
+bool QAudioEnginePrivate::renderBuffer(short *output, int nChannels,
+                                       QAmbisonicDecoder *ambisonicDecoder)
+{
+    bool hasInput = false;
+
+    // Fill input buffers
+    for (auto *source : std::as_const(sources)) {
+        auto *sp = QSpatialSoundPrivate::get(source);
+        if (!sp)
+            continue;
+        // Stopped sounds would only render silence
+        if (!sp->m_playing && !sp->isFading())
+            continue;
+        float buf[QAudioEnginePrivate::bufferSize];
+        sp->getBuffer(buf, QAudioEnginePrivate::bufferSize, 1);
+        hasInput |= sp->renderBuffer(buf, QAudioEnginePrivate::bufferSize);
+    }
+    for (auto *source : std::as_const(stereoSources)) {
+        auto *sp = QAmbientSoundPrivate::get(source);
+        if (!sp)
+            continue;
+        float buf[2*QAudioEnginePrivate::bufferSize];
+        sp->getBuffer(buf, QAudioEnginePrivate::bufferSize, 2);
+        resonanceAudio->api->SetInterleavedBuffer(sp->sourceId, buf, 2, QAudioEnginePrivate::bufferSize);
+        hasInput = true;
+    }
+
+    if (ambisonicDecoder) {
+        const float *channels[QAmbisonicDecoder::maxAmbisonicChannels];
+        const float *reverbBuffers[2] = {};
+        int nSamples = resonanceAudio->getAmbisonicOutput(channels, reverbBuffers, ambisonicDecoder->nInputChannels());
+        Q_ASSERT(ambisonicDecoder->nOutputChannels() <= 8);
+        if (nSamples < 0) {
+            // Nothing was rendered into the sound field
+            memset(output, 0, nChannels * QAudioEnginePrivate::bufferSize * sizeof(short));
+            return true;
+        }
+        ambisonicDecoder->processBufferWithReverb(channels, reverbBuffers, output, nSamples);
+        return true;
+    }
+
+    if (!resonanceAudio->api->FillInterleavedOutputBuffer(2, QAudioEnginePrivate::bufferSize, output)) {
+        // If we get here, it means that resonanceAudio did not actually fill the buffer.
+        // This is expected if no source has been rendered, in which case we just fill the buffer
+        // with silence.
+        if (hasInput)
+            return false;
+        memset(output, 0, nChannels * QAudioEnginePrivate::bufferSize * sizeof(short));
+    }
+    return true;
+}
+
 /*!
     \class QAudioEngine
     \inmodule QtSpatialAudio
@@ -615,6 +771,54 @@ float QAudioEngine::distanceScale() const
     return d->distanceScale*100.f;
 }
 
+/*!
+    \enum QAudioEngine::RenderingQuality
+    \since 6.11
+
+    Defines how spatial sounds are rendered. Lower qualities use considerably less CPU time,
+    which matters for scenes with many sounds.
+
+    \value Automatic Choose the quality of each sound by its distance to the listener and its
+        volume at the listener: sounds close by are rendered with high quality, and sounds
+        further away with lower qualities. Sounds that are inaudible at the listener are not
+        rendered at all.
+    \value High Use binaural rendering based on third order ambisonics.
+    \value Medium Use binaural rendering based on second order ambisonics.
+    \value Low Use binaural rendering based on first order ambisonics.
+    \value StereoPanning Pan sounds between the left and right channels, without binaural
+        rendering. When rendering to surround speakers, Low is used instead.
+
+    Changes in the quality of a sound are cross-faded, so they don't cause audible clicks.
+
+    \sa QSpatialSound::renderingQuality
+*/
+
+/*!
+    \property QAudioEngine::renderingQuality
+    \since 6.11
+
+    Defines the rendering quality of the spatial sounds that don't define their own
+    rendering quality. The default is QAudioEngine::RenderingQuality::High.
+
+    \sa QSpatialSound::renderingQuality
+*/
+void QAudioEngine::setRenderingQuality(RenderingQuality quality)
+{
+    {
+        QMutexLocker locker(&d->mutex);
+        if (d->renderingQuality == quality)
+            return;
+        d->renderingQuality = quality;
+    }
+    emit renderingQualityChanged();
+}
+
+QAudioEngine::RenderingQuality QAudioEngine::renderingQuality() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->renderingQuality;
+}
+
 /*!
     \fn void QAudioEngine::pause()
 
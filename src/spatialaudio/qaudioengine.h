@@ -20,6 +20,8 @@ class Q_SPATIALAUDIO_EXPORT QAudioEngine : public QObject
     Q_PROPERTY(float masterVolume READ masterVolume WRITE setMasterVolume NOTIFY masterVolumeChanged)
     Q_PROPERTY(bool paused READ paused WRITE setPaused NOTIFY pausedChanged)
     Q_PROPERTY(float distanceScale READ distanceScale WRITE setDistanceScale NOTIFY distanceScaleChanged)
+    Q_PROPERTY(RenderingQuality renderingQuality READ renderingQuality WRITE setRenderingQuality
+               NOTIFY renderingQualityChanged)
 public:
     QAudioEngine() : QAudioEngine(nullptr) {};
     explicit QAudioEngine(QObject *parent) : QAudioEngine(44100, parent) {}
@@ -33,6 +35,15 @@ public:
     };
     Q_ENUM(OutputMode)
 
+    enum class RenderingQuality {
+        Automatic,
+        High,
+        Medium,
+        Low,
+        StereoPanning
+    };
+    Q_ENUM(RenderingQuality)
+
     void setOutputMode(OutputMode mode);
     OutputMode outputMode() const;
 
@@ -56,12 +67,16 @@ public:
     void setDistanceScale(float scale);
     float distanceScale() const;
 
+    void setRenderingQuality(RenderingQuality quality);
+    RenderingQuality renderingQuality() const;
+
 Q_SIGNALS:
     void outputModeChanged();
     void outputDeviceChanged();
     void masterVolumeChanged();
     void pausedChanged();
     void distanceScaleChanged();
+    void renderingQualityChanged();
 
 public Q_SLOTS:
     void start();
@@ -17,6 +17,7 @@
 
 #include <QtSpatialAudio/qaudioengine.h>
 #include <QtSpatialAudio/private/qtspatialaudioglobal_p.h>
+#include <QtSpatialAudio/private/qaudioroomindex_p.h>
 #include <QtMultimedia/qaudiodevice.h>
 #include <QtCore/qthread.h>
 #include <QtCore/qtclasshelpermacros.h>
@@ -34,8 +35,10 @@ class QAudioOutputStream;
 class QAudioRoom;
 class QAudioListener;
 class QAudioEngine;
+class QAmbisonicDecoder;
+class QSpatialSoundPrivate;
 
-class QAudioEnginePrivate
+class Q_SPATIALAUDIO_EXPORT QAudioEnginePrivate
 {
 public:
     static QAudioEnginePrivate *get(QAudioEngine *engine) { return engine ? engine->d : nullptr; }
@@ -50,6 +53,7 @@ public:
     int sampleRate = 44100;
     float masterVolume = 1.;
     QAudioEngine::OutputMode outputMode = QAudioEngine::Surround;
+    QAudioEngine::RenderingQuality renderingQuality = QAudioEngine::RenderingQuality::High;
     bool roomEffectsEnabled = true;
 
     void start();
@@ -77,6 +81,13 @@ public:
     mutable bool listenerPositionDirty = true;
     QAudioRoom *currentRoom = nullptr;
 
+    // Room state of the audio thread. The index is rebuilt when rooms are added, removed,
+    // moved or resized; rooms are identified by their index in rooms.
+    QAudioRoomIndex roomIndex;
+    int currentRoomIndex = -1;
+    bool roomIndexDirty = true;
+    QAtomicInteger<bool> roomsDirty = true; // any room changed
+
     void addSpatialSound(QSpatialSound *sound);
     void removeSpatialSound(QSpatialSound *sound);
     void addStereoSound(QAmbientSound *sound);
@@ -85,6 +96,13 @@ public:
     void addRoom(QAudioRoom *room);
     void removeRoom(QAudioRoom *room);
     void updateRooms();
+    void applyRoomAcoustics(bool wasInRoom);
+
+    QAudioEngine::RenderingQuality effectiveRenderingQuality(const QSpatialSoundPrivate *) const;
+
+    // Audio thread, with the mutex locked
+    void updateSourceRendering(bool ambisonicOutput);
+    bool renderBuffer(short *output, int nChannels, QAmbisonicDecoder *ambisonicDecoder);
 
     QVector3D listenerPosition() const;
     QAudioEngine *q;
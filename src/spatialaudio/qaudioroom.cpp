@@ -5,6 +5,8 @@
 
 #include <QtCore/qspan.h>
 
+#include <algorithm>
+
 #include "platforms/common/room_effects_utils.h"
 
 QT_BEGIN_NAMESPACE
@@ -103,6 +105,29 @@ void QAudioRoomPrivate::update()
     dirty = false;
 }
 
+void QAudioRoomPrivate::markDirty()
+{
+    dirty = true;
+    if (auto *ep = QAudioEnginePrivate::get(engine))
+        ep->roomsDirty = true;
+}
+
+void QAudioRoomPrivate::markGeometryDirty()
+{
+    geometryDirty = true;
+    markDirty();
+}
+
+QAudioRoomGeometry QAudioRoomPrivate::geometry() const
+{
+    QAudioRoomGeometry geometry;
+    geometry.position = toVector(roomProperties.position);
+    geometry.dimensions = toVector(roomProperties.dimensions);
+    geometry.rotation = toQuaternion(roomProperties.rotation);
+    std::copy(std::begin(m_wallOpening), std::end(m_wallOpening), geometry.wallOpening);
+    return geometry;
+}
+
 
 /*!
     \class QAudioRoom
@@ -122,6 +147,11 @@ void QAudioRoomPrivate::update()
 
     If multiple rooms cover the same position, the engine will use the room with the smallest
     volume.
+
+    Rooms can be connected through openings in their walls, like doors or windows, see
+    setWallOpening(). Sound from sources in a connected room passes through the opening and
+    contributes to the reverb of the listener's room, and the reverb of the connected room
+    can be heard through the opening.
  */
 
 /*!
@@ -208,7 +238,7 @@ void QAudioRoom::setPosition(QVector3D pos)
     if (toVector(d->roomProperties.position) == pos)
         return;
     toFloats(pos, d->roomProperties.position);
-    d->dirty = true;
+    d->markGeometryDirty();
     emit positionChanged();
 }
 
@@ -237,7 +267,7 @@ void QAudioRoom::setDimensions(QVector3D dim)
     if (toVector(d->roomProperties.dimensions) == dim)
         return;
     toFloats(dim, d->roomProperties.dimensions);
-    d->dirty = true;
+    d->markGeometryDirty();
     emit dimensionsChanged();
 }
 
@@ -263,7 +293,7 @@ void QAudioRoom::setRotation(const QQuaternion &q)
     if (toQuaternion(d->roomProperties.rotation) == q)
         return;
     toFloats(q, d->roomProperties.rotation);
-    d->dirty = true;
+    d->markGeometryDirty();
     emit rotationChanged();
 }
 
@@ -277,7 +307,7 @@ QQuaternion QAudioRoom::rotation() const
 /*!
     \fn void QAudioRoom::wallsChanged()
 
-    Signals when the wall material changes.
+    Signals when the wall material or the opening of a wall changes.
 */
 /*!
     Sets \a wall to \a material.
@@ -297,7 +327,7 @@ void QAudioRoom::setWallMaterial(Wall wall, Material material)
     if (d->roomProperties.material_names[int(wall)] == int(material))
         return;
     d->roomProperties.material_names[int(wall)] = vraudio::MaterialName(int(material));
-    d->dirty = true;
+    d->markDirty();
     emit wallsChanged();
 }
 
@@ -312,6 +342,48 @@ QAudioRoom::Material QAudioRoom::wallMaterial(Wall wall) const
     return Material(d->roomProperties.material_names[int(wall)]);
 }
 
+/*!
+    \since 6.11
+
+    Sets the fraction of \a wall that is open to \a fraction, for example for a door or
+    a window. The value is clamped to the range from 0 (a closed wall, the default) to 1.
+
+    The engine connects the room to the rooms found directly behind the opening. Sound from
+    sources in a connected room, or from outside if the wall doesn't lead to another room,
+    passes through the opening instead of being dampened and occluded by the wall. Sound
+    entering through the opening also gets the reverb of the room, and the reverb of
+    connected rooms is mixed into the reverb of the room according to the size of the
+    openings. The open part of the wall doesn't reflect sound.
+
+    An opening between two rooms only needs to be set on one of them.
+
+    \sa wallOpening(), wallMaterial()
+ */
+void QAudioRoom::setWallOpening(Wall wall, float fraction)
+{
+    Q_D(QAudioRoom);
+
+    fraction = qBound(0.f, fraction, 1.f);
+    if (d->m_wallOpening[int(wall)] == fraction)
+        return;
+    d->m_wallOpening[int(wall)] = fraction;
+    d->markGeometryDirty();
+    emit wallsChanged();
+}
+
+/*!
+    \since 6.11
+
+    Returns the fraction of \a wall that is open.
+
+    \sa setWallOpening()
+ */
+float QAudioRoom::wallOpening(Wall wall) const
+{
+    Q_D(const QAudioRoom);
+    return d->m_wallOpening[int(wall)];
+}
+
 /*!
     \property QAudioRoom::reflectionGain
 
@@ -331,7 +403,7 @@ void QAudioRoom::setReflectionGain(float factor)
     if (d->roomProperties.reflection_scalar == factor)
         return;
     d->roomProperties.reflection_scalar = factor;
-    d->dirty = true;
+    d->markDirty();
     emit reflectionGainChanged();
 }
 
@@ -360,7 +432,7 @@ void QAudioRoom::setReverbGain(float factor)
     if (d->roomProperties.reverb_gain == factor)
         return;
     d->roomProperties.reverb_gain = factor;
-    d->dirty = true;
+    d->markDirty();
     emit reverbGainChanged();
 }
 
@@ -389,7 +461,7 @@ void QAudioRoom::setReverbTime(float factor)
     if (d->roomProperties.reverb_time == factor)
         return;
     d->roomProperties.reverb_time = factor;
-    d->dirty = true;
+    d->markDirty();
     emit reverbTimeChanged();
 }
 
@@ -416,7 +488,7 @@ void QAudioRoom::setReverbBrightness(float factor)
     if (d->roomProperties.reverb_brightness == factor)
         return;
     d->roomProperties.reverb_brightness = factor;
-    d->dirty = true;
+    d->markDirty();
     emit reverbBrightnessChanged();
 }
 
@@ -77,6 +77,9 @@ public:
     void setWallMaterial(Wall wall, Material material);
     Material wallMaterial(Wall wall) const;
 
+    void setWallOpening(Wall wall, float fraction);
+    float wallOpening(Wall wall) const;
+
     void setReflectionGain(float factor);
     float reflectionGain() const;
 
@@ -16,6 +16,7 @@
 #include <QtSpatialAudio/qaudioroom.h>
 #include <QtSpatialAudio/private/qtspatialaudioglobal_p.h>
 #include <QtSpatialAudio/private/qaudioengine_p.h>
+#include <QtSpatialAudio/private/qaudioroomindex_p.h>
 #include <QtCore/private/qobject_p.h>
 
 #include <resonance_audio.h>
@@ -31,16 +32,22 @@ public:
     QAudioEngine *engine = nullptr;
     vraudio::RoomProperties roomProperties;
     bool dirty = true;
+    bool geometryDirty = true;
 
     vraudio::ReverbProperties reverb;
     vraudio::ReflectionProperties reflections;
 
     float m_wallOcclusion[6] = { -1.f, -1.f, -1.f, -1.f, -1.f, -1.f };
     float m_wallDampening[6] = { -1.f, -1.f, -1.f, -1.f, -1.f, -1.f };
+    float m_wallOpening[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
 
     float wallOcclusion(QAudioRoom::Wall wall) const;
     float wallDampening(QAudioRoom::Wall wall) const;
 
+    void markDirty();
+    void markGeometryDirty();
+    QAudioRoomGeometry geometry() const;
+
     void update();
 };
 
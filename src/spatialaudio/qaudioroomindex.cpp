@@ -0,0 +1,277 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-3.0-only
+
+#include "qaudioroomindex_p.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Cells are about the size of a typical room, which keeps both the number of rooms per cell
+// and the number of cells per room small.
+constexpr float minCellSize = 0.5f;
+constexpr qint64 maxCellsPerRoom = 64;
+
+// Each cell coordinate is packed into 21 bits of the cell key
+constexpr qint64 maxCellCoordinate = (qint64(1) << 20) - 1;
+
+qint64 cellCoordinate(float pos, float cellSize)
+{
+    const float cell = std::floor(pos / cellSize);
+    if (!(cell > -maxCellCoordinate)) // also catches NaN
+        return -maxCellCoordinate;
+    return std::min(qint64(cell), maxCellCoordinate);
+}
+
+quint64 packCellKey(qint64 x, qint64 y, qint64 z)
+{
+    constexpr quint64 mask = (quint64(1) << 21) - 1;
+    return (quint64(x) & mask) | (quint64(y) & mask) << 21 | (quint64(z) & mask) << 42;
+}
+
+// Walls are ordered as -x, +x, -y, +y, -z, +z
+int wallAxis(QAudioRoom::Wall wall)
+{
+    return int(wall) / 2;
+}
+
+float wallSign(QAudioRoom::Wall wall)
+{
+    return int(wall) % 2 ? 1.f : -1.f;
+}
+
+// The wall of room that is closest to pos
+QAudioRoom::Wall closestWall(const QAudioRoomGeometry &room, QVector3D pos)
+{
+    const QVector3D local = room.toRoomCoordinates(pos);
+    int axis = 0;
+    float maxRatio = -1.f;
+    for (int i = 0; i < 3; ++i) {
+        const float ratio = qAbs(local[i]) / std::max(room.dimensions[i], 1e-6f);
+        if (ratio > maxRatio) {
+            maxRatio = ratio;
+            axis = i;
+        }
+    }
+    return QAudioRoom::Wall(2 * axis + (local[axis] > 0 ? 1 : 0));
+}
+
+void addConnection(QList<QAudioRoomIndex::Connection> &connections, int room,
+                   QAudioRoom::Wall wall, float openingArea)
+{
+    for (auto &connection : connections) {
+        if (connection.room == room && connection.wall == wall) {
+            connection.openingArea += openingArea;
+            return;
+        }
+    }
+    connections.append({ room, wall, openingArea });
+}
+
+} // namespace
+
+float QAudioRoomGeometry::wallArea(QAudioRoom::Wall wall) const
+{
+    const int axis = wallAxis(wall);
+    return dimensions[(axis + 1) % 3] * dimensions[(axis + 2) % 3];
+}
+
+float QAudioRoomGeometry::surfaceArea() const
+{
+    return 2.f
+            * (dimensions.x() * dimensions.y() + dimensions.y() * dimensions.z()
+               + dimensions.z() * dimensions.x());
+}
+
+void QAudioRoomIndex::build(QList<QAudioRoomGeometry> rooms)
+{
+    m_rooms = std::move(rooms);
+    m_cells.clear();
+    m_largeRooms.clear();
+
+    // World space bounds of the rotated rooms
+    QList<std::pair<QVector3D, QVector3D>> bounds;
+    QList<float> extents;
+    bounds.reserve(m_rooms.size());
+    extents.reserve(m_rooms.size());
+    for (const auto &room : std::as_const(m_rooms)) {
+        const QVector3D dim2 = room.dimensions / 2.f;
+        QVector3D lower(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                        std::numeric_limits<float>::max());
+        QVector3D upper = -lower;
+        for (float x : { -1.f, 1.f }) {
+            for (float y : { -1.f, 1.f }) {
+                for (float z : { -1.f, 1.f }) {
+                    const QVector3D corner =
+                            room.toWorldCoordinates(QVector3D(x, y, z) * dim2);
+                    for (int i = 0; i < 3; ++i) {
+                        lower[i] = std::min(lower[i], corner[i]);
+                        upper[i] = std::max(upper[i], corner[i]);
+                    }
+                }
+            }
+        }
+        bounds.append({ lower, upper });
+        const QVector3D size = upper - lower;
+        extents.append(std::max({ size.x(), size.y(), size.z() }));
+    }
+
+    m_cellSize = minCellSize;
+    if (!extents.isEmpty()) {
+        auto median = extents.begin() + extents.size() / 2;
+        std::nth_element(extents.begin(), median, extents.end());
+        m_cellSize = std::max(*median, minCellSize);
+    }
+
+    for (int i = 0; i < m_rooms.size(); ++i) {
+        const auto &[lower, upper] = bounds.at(i);
+        qint64 from[3];
+        qint64 to[3];
+        qint64 cellCount = 1;
+        for (int axis = 0; axis < 3; ++axis) {
+            from[axis] = cellCoordinate(lower[axis], m_cellSize);
+            to[axis] = cellCoordinate(upper[axis], m_cellSize);
+            cellCount *= to[axis] - from[axis] + 1;
+        }
+        if (cellCount > maxCellsPerRoom) {
+            m_largeRooms.append(i);
+            continue;
+        }
+        for (qint64 x = from[0]; x <= to[0]; ++x) {
+            for (qint64 y = from[1]; y <= to[1]; ++y) {
+                for (qint64 z = from[2]; z <= to[2]; ++z)
+                    m_cells[packCellKey(x, y, z)].append(i);
+            }
+        }
+    }
+
+    addConnections();
+}
+
+int QAudioRoomIndex::roomAt(QVector3D pos, int excludedRoom) const
+{
+    int result = -1;
+    float resultVolume = std::numeric_limits<float>::infinity();
+
+    auto test = [&](int index) {
+        if (index == excludedRoom)
+            return;
+        const QAudioRoomGeometry &room = m_rooms.at(index);
+        const float volume = room.volume();
+        if (volume > resultVolume || (volume == resultVolume && index < result))
+            return;
+        if (!room.contains(pos))
+            return;
+        result = index;
+        resultVolume = volume;
+    };
+
+    const auto cell = m_cells.constFind(cellKey(pos));
+    if (cell != m_cells.cend()) {
+        for (int index : *cell)
+            test(index);
+    }
+    for (int index : m_largeRooms)
+        test(index);
+
+    return result;
+}
+
+QSpan<const QAudioRoomIndex::Connection> QAudioRoomIndex::connections(int room) const
+{
+    if (room < 0 || room >= m_connections.size())
+        return {};
+    return m_connections.at(room);
+}
+
+// The fraction of wall of room that opens into otherRoom, or to the outside for -1
+float QAudioRoomIndex::openingFraction(int room, QAudioRoom::Wall wall, int otherRoom) const
+{
+    float openingArea = 0.f;
+    for (const Connection &connection : connections(room)) {
+        if (connection.wall == wall && connection.room == otherRoom)
+            openingArea += connection.openingArea;
+    }
+    if (openingArea <= 0.f)
+        return 0.f;
+    return std::min(openingArea / m_rooms.at(room).wallArea(wall), 1.f);
+}
+
+quint64 QAudioRoomIndex::cellKey(QVector3D pos) const
+{
+    return packCellKey(cellCoordinate(pos.x(), m_cellSize), cellCoordinate(pos.y(), m_cellSize),
+                       cellCoordinate(pos.z(), m_cellSize));
+}
+
+// Finds what lies behind the open walls of every room. An opening only needs to be set on
+// one side: a room that doesn't declare any opening towards its neighbour gets the
+// connection of the neighbour mirrored onto its closest wall.
+void QAudioRoomIndex::addConnections()
+{
+    // Every wall is probed at a 3x3 grid of points, a bit further out than a typical wall
+    // is thick.
+    constexpr float probeDistance = 0.3f;
+    constexpr float probeOffsets[] = { -2.f / 3.f, 0.f, 2.f / 3.f };
+    constexpr float probeShare = 1.f / 9.f;
+
+    struct Mirrored
+    {
+        int room;
+        int otherRoom;
+        QAudioRoom::Wall wall;
+        float openingArea;
+    };
+    QList<Mirrored> mirrored;
+
+    m_connections = QList<QList<Connection>>(m_rooms.size());
+
+    for (int i = 0; i < m_rooms.size(); ++i) {
+        const QAudioRoomGeometry &room = m_rooms.at(i);
+        const QVector3D dim2 = room.dimensions / 2.f;
+
+        for (int w = 0; w < 6; ++w) {
+            const auto wall = QAudioRoom::Wall(w);
+            const float opening = room.wallOpening[w];
+            if (opening <= 0.f)
+                continue;
+
+            const int axis = wallAxis(wall);
+            const int u = (axis + 1) % 3;
+            const int v = (axis + 2) % 3;
+            const float probeArea = opening * room.wallArea(wall) * probeShare;
+
+            for (float du : probeOffsets) {
+                for (float dv : probeOffsets) {
+                    QVector3D probe;
+                    probe[axis] = wallSign(wall) * (dim2[axis] + probeDistance);
+                    probe[u] = du * dim2[u];
+                    probe[v] = dv * dim2[v];
+                    probe = room.toWorldCoordinates(probe);
+
+                    const int other = roomAt(probe, i);
+                    addConnection(m_connections[i], other, wall, probeArea);
+                    if (other >= 0) {
+                        mirrored.append({ other, i, closestWall(m_rooms.at(other), probe),
+                                          probeArea });
+                    }
+                }
+            }
+        }
+    }
+
+    const QList<QList<Connection>> declared = m_connections;
+    for (const Mirrored &m : std::as_const(mirrored)) {
+        const QList<Connection> &own = declared.at(m.room);
+        const bool hasOwnOpening = std::any_of(own.begin(), own.end(), [&](const Connection &c) {
+            return c.room == m.otherRoom;
+        });
+        if (!hasOwnOpening)
+            addConnection(m_connections[m.room], m.otherRoom, m.wall, m.openingArea);
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,100 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-3.0-only
+
+#ifndef QAUDIOROOMINDEX_P_H
+#define QAUDIOROOMINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSpatialAudio/qaudioroom.h>
+#include <QtSpatialAudio/private/qtspatialaudioglobal_p.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qspan.h>
+#include <QtGui/qquaternion.h>
+#include <QtGui/qvector3d.h>
+
+QT_BEGIN_NAMESPACE
+
+// The box of a room, in meters
+struct QAudioRoomGeometry
+{
+    QVector3D position;
+    QVector3D dimensions;
+    QQuaternion rotation;
+    // Open fraction of each wall, indexed by QAudioRoom::Wall
+    float wallOpening[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+
+    QVector3D toRoomCoordinates(QVector3D pos) const
+    {
+        return rotation.rotatedVector(pos - position);
+    }
+    QVector3D toWorldCoordinates(QVector3D pos) const
+    {
+        return position + rotation.conjugated().rotatedVector(pos);
+    }
+
+    bool contains(QVector3D pos) const
+    {
+        const QVector3D dist = toRoomCoordinates(pos);
+        const QVector3D dim2 = dimensions / 2.f;
+        return qAbs(dist.x()) <= dim2.x() && qAbs(dist.y()) <= dim2.y()
+                && qAbs(dist.z()) <= dim2.z();
+    }
+
+    float volume() const { return dimensions.x() * dimensions.y() * dimensions.z(); }
+    float wallArea(QAudioRoom::Wall wall) const;
+    float surfaceArea() const;
+};
+
+// Uniform grid over the rooms of an engine, to find the room at a position without testing
+// every room. Rooms are identified by their index in the list passed to build().
+class Q_SPATIALAUDIO_EXPORT QAudioRoomIndex
+{
+public:
+    // Part of a wall of a room that opens into another room, or to the outside
+    struct Connection
+    {
+        int room = -1; // -1 if the wall opens to the outside
+        QAudioRoom::Wall wall = QAudioRoom::LeftWall;
+        float openingArea = 0.f; // in square meters
+    };
+
+    void build(QList<QAudioRoomGeometry> rooms);
+
+    qsizetype size() const { return m_rooms.size(); }
+    const QAudioRoomGeometry &room(int index) const { return m_rooms.at(index); }
+
+    // The smallest room containing pos, or -1. If several rooms of the same size contain pos,
+    // the last one wins.
+    int roomAt(QVector3D pos, int excludedRoom = -1) const;
+
+    QSpan<const Connection> connections(int room) const;
+    float openingFraction(int room, QAudioRoom::Wall wall, int otherRoom) const;
+
+private:
+    quint64 cellKey(QVector3D pos) const;
+    void addConnections();
+
+    QList<QAudioRoomGeometry> m_rooms;
+    QList<QList<Connection>> m_connections;
+
+    float m_cellSize = 1.f;
+    QHash<quint64, QList<int>> m_cells;
+    // Rooms that would cover too many cells, like the outline of a whole building.
+    // They are tested on every lookup.
+    QList<int> m_largeRooms;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -10,6 +10,8 @@
 #include <qdebug.h>
 #include <qaudiodecoder.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -62,7 +64,11 @@ void QSpatialSound::setPosition(QVector3D pos)
 
     pos *= ep->distanceScale;
     d->pos = pos;
-    ep->resonanceAudio->api->SetSourcePosition(d->sourceId, pos.x(), pos.y(), pos.z());
+    d->positionDirty = true;
+    {
+        QMutexLocker locker(&d->mutex);
+        ep->resonanceAudio->api->SetSourcePosition(d->sourceId, pos.x(), pos.y(), pos.z());
+    }
     emit positionChanged();
 }
 
@@ -84,8 +90,10 @@ void QSpatialSound::setRotation(const QQuaternion &q)
 
     d->rotation = q;
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
+    if (ep) {
+        QMutexLocker locker(&d->mutex);
         ep->resonanceAudio->api->SetSourceRotation(d->sourceId, q.x(), q.y(), q.z(), q.scalar());
+    }
     emit rotationChanged();
 }
 
@@ -110,8 +118,10 @@ void QSpatialSound::setVolume(float volume)
         return;
     d->volume = volume;
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
+    if (ep) {
+        QMutexLocker locker(&d->mutex);
         ep->resonanceAudio->api->SetSourceVolume(d->sourceId, d->volume*d->wallDampening);
+    }
     emit volumeChanged();
 }
 
@@ -149,7 +159,10 @@ void QSpatialSound::setDistanceModel(DistanceModel model)
         return;
     d->distanceModel = model;
 
-    d->updateDistanceModel();
+    {
+        QMutexLocker locker(&d->mutex);
+        d->updateDistanceModel();
+    }
     emit distanceModelChanged();
 }
 
@@ -174,28 +187,38 @@ void QSpatialSoundPrivate::updateDistanceModel()
     ep->resonanceAudio->api->SetSourceDistanceModel(sourceId, dm, size, distanceCutoff);
 }
 
+// Called from the audio thread, whenever the sound, the listener or the walls between them
+// moved
 void QSpatialSoundPrivate::updateRoomEffects()
 {
     if (!engine || sourceId < 0)
         return;
     auto *ep = QAudioEnginePrivate::get(engine);
-    if (!ep->currentRoom)
+    auto *api = ep->resonanceAudio->api.get();
+
+    const int listenerRoom = ep->currentRoomIndex;
+    if (!ep->currentRoom || listenerRoom < 0) {
+        // No walls between the sound and the listener
+        outsideListenerRoom = false;
+        roomEffectsGain = 1.f;
+        wallDampening = 1.f;
+        wallOcclusion = 0.f;
+        api->SetSourceRoomEffectsGain(sourceId, roomEffectsGain);
+        api->SetSoundObjectOcclusionIntensity(sourceId, occlusionIntensity);
+        api->SetSourceVolume(sourceId, volume);
         return;
+    }
     auto *rp = QAudioRoomPrivate::get(ep->currentRoom);
-    if (!rp)
-        return;
+    const QAudioRoomGeometry &room = ep->roomIndex.room(listenerRoom);
 
-    QVector3D roomDim2 = ep->currentRoom->dimensions()/2.;
-    QVector3D roomPos = ep->currentRoom->position();
-    QQuaternion roomRot = ep->currentRoom->rotation();
-    QVector3D dist = pos - roomPos;
+    const QVector3D roomDim2 = room.dimensions / 2.f;
     // transform into room coordinates
-    dist = roomRot.rotatedVector(dist);
-    if (qAbs(dist.x()) <= roomDim2.x() &&
-        qAbs(dist.y()) <= roomDim2.y() &&
-        qAbs(dist.z()) <= roomDim2.z()) {
+    const QVector3D dist = room.toRoomCoordinates(pos);
+    outsideListenerRoom = !room.contains(pos);
+    if (!outsideListenerRoom) {
         // Source is inside room, apply
-        ep->resonanceAudio->api->SetSourceRoomEffectsGain(sourceId, 1);
+        roomEffectsGain = 1.f;
+        api->SetSourceRoomEffectsGain(sourceId, roomEffectsGain);
         wallDampening = 1.;
         wallOcclusion = 0.;
     } else {
@@ -204,8 +227,8 @@ void QSpatialSoundPrivate::updateRoomEffects()
         //
         // We basically cast a ray from the listener through the walls. If walls have different characteristics
         // and we get close to a corner, we try to use some averaging to avoid abrupt changes
-        auto relativeListenerPos = ep->listenerPosition() - roomPos;
-        relativeListenerPos = roomRot.rotatedVector(relativeListenerPos);
+        const QVector3D relativeListenerPos =
+                room.toRoomCoordinates(ep->listenerPosition() * ep->distanceScale);
 
         auto direction = dist.normalized();
         enum {
@@ -216,8 +239,8 @@ void QSpatialSoundPrivate::updateRoomEffects()
         const float transitionDistance = size + 0.4;
         QAudioRoom::Wall walls[3];
         walls[X] = direction.x() > 0 ? QAudioRoom::RightWall : QAudioRoom::LeftWall;
-        walls[Y] = direction.y() > 0 ? QAudioRoom::FrontWall : QAudioRoom::BackWall;
-        walls[Z] = direction.z() > 0 ? QAudioRoom::Ceiling : QAudioRoom::Floor;
+        walls[Y] = direction.y() > 0 ? QAudioRoom::Ceiling : QAudioRoom::Floor;
+        walls[Z] = direction.z() > 0 ? QAudioRoom::BackWall : QAudioRoom::FrontWall;
         float factors[3] = { 0., 0., 0. };
         bool foundWall = false;
         if (direction.x() != 0) {
@@ -268,16 +291,187 @@ void QSpatialSoundPrivate::updateRoomEffects()
         }
         wallDampening = 0;
         wallOcclusion = 0;
+        roomEffectsGain = 0.f;
         for (int i = 0; i < 3; ++i) {
-            wallDampening += factors[i]*rp->wallDampening(walls[i]);
-            wallOcclusion += factors[i]*rp->wallOcclusion(walls[i]);
+            // Sound passes through the part of the wall that opens towards the room of the
+            // source (or to the outside), and gets the reverb of the listener's room
+            const float opening = ep->roomIndex.openingFraction(listenerRoom, walls[i], roomIndex);
+            const float dampening = rp->wallDampening(walls[i]);
+            wallDampening += factors[i]*(dampening + opening*(1.f - dampening));
+            wallOcclusion += factors[i]*(1.f - opening)*rp->wallOcclusion(walls[i]);
+            roomEffectsGain += factors[i]*opening;
         }
 
 //        qDebug() << "intersection with wall" << walls[0] << walls[1] << walls[2] << factors[0] << factors[1] << factors[2] << wallDampening << wallOcclusion;
-        ep->resonanceAudio->api->SetSourceRoomEffectsGain(sourceId, 0);
+        api->SetSourceRoomEffectsGain(sourceId, roomEffectsGain);
     }
-    ep->resonanceAudio->api->SetSoundObjectOcclusionIntensity(sourceId, occlusionIntensity + wallOcclusion);
-    ep->resonanceAudio->api->SetSourceVolume(sourceId, volume*wallDampening);
+    api->SetSoundObjectOcclusionIntensity(sourceId, occlusionIntensity + wallOcclusion);
+    api->SetSourceVolume(sourceId, volume*wallDampening);
+}
+
+// Pushes all parameters of the sound to its current source
+void QSpatialSoundPrivate::applySourceParameters()
+{
+    if (!engine || sourceId < 0)
+        return;
+    auto *api = QAudioEnginePrivate::get(engine)->resonanceAudio->api.get();
+
+    api->SetSourcePosition(sourceId, pos.x(), pos.y(), pos.z());
+    api->SetSourceRotation(sourceId, rotation.x(), rotation.y(), rotation.z(), rotation.scalar());
+    api->SetSourceVolume(sourceId, volume*wallDampening);
+    api->SetSoundObjectDirectivity(sourceId, directivity, directivityOrder);
+    api->SetSoundObjectNearFieldEffectGain(sourceId, nearFieldGain*9.f);
+    api->SetSoundObjectOcclusionIntensity(sourceId, occlusionIntensity + wallOcclusion);
+    api->SetSourceRoomEffectsGain(sourceId, roomEffectsGain);
+    if (distanceModel == QSpatialSound::DistanceModel::ManualAttenuation)
+        api->SetSourceDistanceAttenuation(sourceId, manualAttenuation);
+    updateDistanceModel();
+}
+
+static vraudio::RenderingMode toRenderingMode(QSpatialSoundPrivate::Rendering rendering)
+{
+    using Rendering = QSpatialSoundPrivate::Rendering;
+
+    switch (rendering) {
+    case Rendering::StereoPanning:
+        return vraudio::kStereoPanning;
+    case Rendering::BinauralLow:
+        return vraudio::kBinauralLowQuality;
+    case Rendering::BinauralMedium:
+        return vraudio::kBinauralMediumQuality;
+    default:
+        return vraudio::kBinauralHighQuality;
+    }
+}
+
+QSpatialSoundPrivate::Rendering QSpatialSoundPrivate::automaticRendering(float distance,
+                                                                        float gain)
+{
+    if (gain < inaudibleGain)
+        return Rendering::Culled;
+
+    Rendering rendering = distance < highQualityDistance ? Rendering::BinauralHigh
+            : distance < mediumQualityDistance           ? Rendering::BinauralMedium
+            : distance < lowQualityDistance              ? Rendering::BinauralLow
+                                                         : Rendering::StereoPanning;
+
+    if (gain < quietGain && rendering != Rendering::StereoPanning)
+        rendering = Rendering(int(rendering) - 1);
+    return rendering;
+}
+
+// Keeps the current rendering while the distance and the gain are within the hysteresis
+QSpatialSoundPrivate::Rendering
+QSpatialSoundPrivate::automaticRendering(float distance, float gain, Rendering current)
+{
+    const Rendering lower = automaticRendering(distance * hysteresis, gain / hysteresis);
+    const Rendering higher = automaticRendering(distance / hysteresis, gain * hysteresis);
+    if (lower <= current && current <= higher)
+        return current;
+
+    return automaticRendering(distance, gain);
+}
+
+// Creates the source of the sound. Called with the engine mutex and the mutex locked.
+void QSpatialSoundPrivate::createSource(Rendering rendering)
+{
+    Q_ASSERT(rendering != Rendering::Culled);
+    auto *ep = QAudioEnginePrivate::get(engine);
+    sourceId = ep->resonanceAudio->api->CreateSoundObjectSource(toRenderingMode(rendering));
+    sourceRendering = rendering;
+    applySourceParameters();
+}
+
+void QSpatialSoundPrivate::destroySources()
+{
+    auto *ep = QAudioEnginePrivate::get(engine);
+    if (sourceId >= 0)
+        ep->resonanceAudio->api->DestroySource(sourceId);
+    if (fadingSourceId >= 0)
+        ep->resonanceAudio->api->DestroySource(fadingSourceId);
+    sourceId = vraudio::ResonanceAudioApi::kInvalidSourceId;
+    fadingSourceId = vraudio::ResonanceAudioApi::kInvalidSourceId;
+}
+
+// Called from the audio thread, with the engine mutex locked
+void QSpatialSoundPrivate::setRendering(Rendering newRendering)
+{
+    if (newRendering == rendering)
+        return;
+
+    if (newRendering != Rendering::Culled && newRendering != sourceRendering) {
+        // Wait until the previous change has been faded out
+        if (fadingSourceId >= 0)
+            return;
+
+        QMutexLocker locker(&mutex);
+        if (m_playing && sourceGain > 0.f) {
+            // cross-fade from the current source to the new one
+            fadingSourceId = sourceId;
+            fadingSourceGain = sourceGain;
+        } else {
+            QAudioEnginePrivate::get(engine)->resonanceAudio->api->DestroySource(sourceId);
+        }
+        createSource(newRendering);
+        sourceGain = 0.f;
+    }
+
+    rendering = newRendering;
+
+    // A stopped sound renders silence, there is nothing to fade
+    if (!m_playing && fadingSourceId < 0)
+        sourceGain = rendering == Rendering::Culled ? 0.f : 1.f;
+}
+
+bool QSpatialSoundPrivate::isFading() const
+{
+    const float targetGain = rendering == Rendering::Culled ? 0.f : 1.f;
+    return fadingSourceId >= 0 || sourceGain != targetGain;
+}
+
+static void applyGainRamp(float *buf, int frames, float from, float to)
+{
+    const float step = (to - from) / frames;
+    for (int i = 0; i < frames; ++i)
+        buf[i] *= from + step * (i + 1);
+}
+
+// Passes the next buffer of the sound to its sources, fading them as needed. Returns false if
+// the sound is culled. Called from the audio thread, with the engine mutex locked.
+bool QSpatialSoundPrivate::renderBuffer(float *buf, int frames)
+{
+    Q_ASSERT(frames <= QAudioEnginePrivate::bufferSize);
+    auto *api = QAudioEnginePrivate::get(engine)->resonanceAudio->api.get();
+    const float step = float(frames) / fadeFrames;
+    bool rendered = false;
+
+    if (fadingSourceId >= 0) {
+        if (fadingSourceGain > 0.f) {
+            const float gain = qMax(fadingSourceGain - step, 0.f);
+            float faded[QAudioEnginePrivate::bufferSize];
+            std::copy_n(buf, frames, faded);
+            applyGainRamp(faded, frames, fadingSourceGain, gain);
+            api->SetInterleavedBuffer(fadingSourceId, faded, 1, frames);
+            fadingSourceGain = gain;
+            rendered = true;
+        } else {
+            // The source has rendered its last, silent, buffer
+            api->DestroySource(fadingSourceId);
+            fadingSourceId = vraudio::ResonanceAudioApi::kInvalidSourceId;
+        }
+    }
+
+    const float targetGain = rendering == Rendering::Culled ? 0.f : 1.f;
+    const float gain = targetGain > sourceGain ? qMin(sourceGain + step, targetGain)
+                                               : qMax(sourceGain - step, targetGain);
+    if (sourceGain == 0.f && gain == 0.f)
+        return rendered;
+
+    if (sourceGain != 1.f || gain != 1.f)
+        applyGainRamp(buf, frames, sourceGain, gain);
+    api->SetInterleavedBuffer(sourceId, buf, 1, frames);
+    sourceGain = gain;
+    return true;
 }
 
 QSpatialSound::DistanceModel QSpatialSound::distanceModel() const
@@ -302,7 +496,10 @@ void QSpatialSound::setSize(float size)
         return;
     d->size = size;
 
-    d->updateDistanceModel();
+    {
+        QMutexLocker locker(&d->mutex);
+        d->updateDistanceModel();
+    }
     emit sizeChanged();
 }
 
@@ -329,7 +526,10 @@ void QSpatialSound::setDistanceCutoff(float cutoff)
         return;
     d->distanceCutoff = cutoff;
 
-    d->updateDistanceModel();
+    {
+        QMutexLocker locker(&d->mutex);
+        d->updateDistanceModel();
+    }
     emit distanceCutoffChanged();
 }
 
@@ -353,8 +553,10 @@ void QSpatialSound::setManualAttenuation(float attenuation)
         return;
     d->manualAttenuation = attenuation;
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
+    if (ep) {
+        QMutexLocker locker(&d->mutex);
         ep->resonanceAudio->api->SetSourceDistanceAttenuation(d->sourceId, d->manualAttenuation);
+    }
     emit manualAttenuationChanged();
 }
 
@@ -388,8 +590,10 @@ void QSpatialSound::setOcclusionIntensity(float occlusion)
         return;
     d->occlusionIntensity = occlusion;
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
+    if (ep) {
+        QMutexLocker locker(&d->mutex);
         ep->resonanceAudio->api->SetSoundObjectOcclusionIntensity(d->sourceId, d->occlusionIntensity + d->wallOcclusion);
+    }
     emit occlusionIntensityChanged();
 }
 
@@ -419,8 +623,10 @@ void QSpatialSound::setDirectivity(float alpha)
     d->directivity = alpha;
 
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
+    if (ep) {
+        QMutexLocker locker(&d->mutex);
         ep->resonanceAudio->api->SetSoundObjectDirectivity(d->sourceId, d->directivity, d->directivityOrder);
+    }
 
     emit directivityChanged();
 }
@@ -449,8 +655,10 @@ void QSpatialSound::setDirectivityOrder(float order)
     d->directivityOrder = order;
 
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
+    if (ep) {
+        QMutexLocker locker(&d->mutex);
         ep->resonanceAudio->api->SetSoundObjectDirectivity(d->sourceId, d->directivity, d->directivityOrder);
+    }
 
     emit directivityChanged();
 }
@@ -479,8 +687,10 @@ void QSpatialSound::setNearFieldGain(float gain)
     d->nearFieldGain = gain;
 
     auto *ep = QAudioEnginePrivate::get(d->engine);
-    if (ep)
+    if (ep) {
+        QMutexLocker locker(&d->mutex);
         ep->resonanceAudio->api->SetSoundObjectNearFieldEffectGain(d->sourceId, d->nearFieldGain*9.f);
+    }
 
     emit nearFieldGainChanged();
 
@@ -493,6 +703,44 @@ float QSpatialSound::nearFieldGain() const
     return d->nearFieldGain;
 }
 
+/*!
+    \property QSpatialSound::renderingQuality
+    \since 6.11
+
+    Defines the quality with which the sound is rendered. The default,
+    QAudioEngine::RenderingQuality::Automatic, uses the rendering quality of the engine.
+
+    Use a lower quality for sounds that don't need precise localization, such as ambient
+    sounds in a scene with many sounds.
+
+    \sa QAudioEngine::renderingQuality
+ */
+void QSpatialSound::setRenderingQuality(QAudioEngine::RenderingQuality quality)
+{
+    Q_D(QSpatialSound);
+
+    if (d->renderingQuality == quality)
+        return;
+
+    // The audio thread reads the quality with the engine mutex locked
+    auto *ep = QAudioEnginePrivate::get(d->engine);
+    if (ep) {
+        QMutexLocker locker(&ep->mutex);
+        d->renderingQuality = quality;
+    } else {
+        d->renderingQuality = quality;
+    }
+
+    emit renderingQualityChanged();
+}
+
+QAudioEngine::RenderingQuality QSpatialSound::renderingQuality() const
+{
+    Q_D(const QSpatialSound);
+
+    return d->renderingQuality;
+}
+
 /*!
     \property QSpatialSound::source
 
@@ -622,15 +870,8 @@ void QSpatialSound::setEngine(QAudioEngine *engine)
 
     // Add self to new engine if necessary
     ep = QAudioEnginePrivate::get(d->engine);
-    if (ep) {
+    if (ep)
         ep->addSpatialSound(this);
-        ep->resonanceAudio->api->SetSourcePosition(d->sourceId, d->pos.x(), d->pos.y(), d->pos.z());
-        ep->resonanceAudio->api->SetSourceRotation(d->sourceId, d->rotation.x(), d->rotation.y(), d->rotation.z(), d->rotation.scalar());
-        ep->resonanceAudio->api->SetSourceVolume(d->sourceId, d->volume);
-        ep->resonanceAudio->api->SetSoundObjectDirectivity(d->sourceId, d->directivity, d->directivityOrder);
-        ep->resonanceAudio->api->SetSoundObjectNearFieldEffectGain(d->sourceId, d->nearFieldGain);
-        d->updateDistanceModel();
-    }
 }
 
 /*!
@@ -4,6 +4,7 @@
 #define QSPATIALSOUND_H
 
 #include <QtSpatialAudio/qtspatialaudioglobal.h>
+#include <QtSpatialAudio/qaudioengine.h>
 #include <QtCore/QObject>
 #include <QtGui/qvector3d.h>
 #include <QtGui/qquaternion.h>
@@ -31,6 +32,8 @@ class Q_SPATIALAUDIO_EXPORT QSpatialSound : public QObject
     Q_PROPERTY(float nearFieldGain READ nearFieldGain WRITE setNearFieldGain NOTIFY nearFieldGainChanged)
     Q_PROPERTY(int loops READ loops WRITE setLoops NOTIFY loopsChanged)
     Q_PROPERTY(bool autoPlay READ autoPlay WRITE setAutoPlay NOTIFY autoPlayChanged)
+    Q_PROPERTY(QAudioEngine::RenderingQuality renderingQuality READ renderingQuality
+               WRITE setRenderingQuality NOTIFY renderingQualityChanged)
 
 public:
     explicit QSpatialSound(QAudioEngine *engine);
@@ -92,6 +95,9 @@ public:
     void setNearFieldGain(float gain);
     float nearFieldGain() const;
 
+    void setRenderingQuality(QAudioEngine::RenderingQuality quality);
+    QAudioEngine::RenderingQuality renderingQuality() const;
+
     QAudioEngine *engine() const;
 
 Q_SIGNALS:
@@ -109,6 +115,7 @@ Q_SIGNALS:
     void directivityChanged();
     void directivityOrderChanged();
     void nearFieldGainChanged();
+    void renderingQualityChanged();
 
 public Q_SLOTS:
     void play();
@@ -30,7 +30,7 @@ QT_BEGIN_NAMESPACE
 class QAudioDecoder;
 class QAudioEnginePrivate;
 
-class QSpatialSoundPrivate : public QAmbientSoundPrivate
+class Q_SPATIALAUDIO_EXPORT QSpatialSoundPrivate : public QAmbientSoundPrivate
 {
     Q_DECLARE_PUBLIC(QSpatialSound)
 
@@ -54,7 +54,59 @@ public:
     float nearFieldGain = 0.f;
     float wallDampening = 1.f;
     float wallOcclusion = 0.f;
+    float roomEffectsGain = 1.f;
 
+    // Room state of the audio thread
+    QAtomicInteger<bool> positionDirty = true;
+    int roomIndex = -1; // room containing the sound, in the room index of the engine
+    bool outsideListenerRoom = false;
+    QAudioEngine::RenderingQuality renderingQuality = QAudioEngine::RenderingQuality::Automatic;
+
+    // How the sound is rendered by the audio thread. Ordered by cost.
+    enum class Rendering : quint8 {
+        Culled,
+        StereoPanning,
+        BinauralLow,
+        BinauralMedium,
+        BinauralHigh,
+    };
+
+    // Distances (in meters) up to which sounds are rendered with a given quality, if the
+    // quality is chosen automatically
+    static constexpr float highQualityDistance = 3.f;
+    static constexpr float mediumQualityDistance = 10.f;
+    static constexpr float lowQualityDistance = 25.f;
+
+    // Sounds quieter than this at the listener are rendered one quality level lower
+    static constexpr float quietGain = 0.03f; // -30 dB
+    // Sounds quieter than this at the listener are not rendered at all
+    static constexpr float inaudibleGain = 0.001f; // -60 dB
+
+    // Distances and gains have to change by this factor before a sound switches back, so
+    // that sounds at a threshold don't keep switching
+    static constexpr float hysteresis = 1.1f;
+
+    static Rendering automaticRendering(float distance, float gain);
+    static Rendering automaticRendering(float distance, float gain, Rendering current);
+
+    // Changes of the rendering are faded over this number of frames
+    static constexpr int fadeFrames = 4 * QAudioEnginePrivate::bufferSize;
+
+    // Audio thread state. The source is replaced when the rendering changes, which happens
+    // with the mutex locked, so that the setters always update the current source.
+    Rendering rendering = Rendering::BinauralHigh;
+    Rendering sourceRendering = Rendering::BinauralHigh; // rendering of sourceId
+    float sourceGain = 1.f; // fade gain of sourceId
+    int fadingSourceId = -1; // previous source, being faded out
+    float fadingSourceGain = 0.f;
+
+    void createSource(Rendering rendering);
+    void destroySources();
+    void setRendering(Rendering rendering);
+    bool isFading() const;
+    bool renderBuffer(float *buf, int frames);
+
+    void applySourceParameters();
     void updateDistanceModel();
     void updateRoomEffects();
 };
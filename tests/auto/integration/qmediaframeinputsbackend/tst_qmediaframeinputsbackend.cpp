@@ -354,6 +354,60 @@ void tst_QMediaFrameInputsBackend::mediaRecorderWritesVideo_withSingleFrame()
     QCOMPARE_EQ(info->m_duration, 1s);
 }
 
+void tst_QMediaFrameInputsBackend::mediaRecorderWritesDuplicateFrames_byDefault()
+{
+    QSKIP_IF_NOT_FFMPEG();
+
+    constexpr int framesNumber = 20;
+    constexpr milliseconds frameDuration = 50ms;
+
+    CaptureSessionFixture f{ StreamType::Video };
+    f.m_videoGenerator.setPattern(ImagePattern::ColoredSquares);
+    f.m_videoGenerator.setFrameCount(framesNumber);
+    f.m_videoGenerator.setSize({ 128, 64 });
+    f.m_videoGenerator.setPeriod(frameDuration);
+    QVERIFY(!f.m_recorder.skipDuplicateVideoFrames());
+    f.start(RunMode::Pull, AutoStop::EmitEmpty);
+
+    QVERIFY(f.waitForRecorderStopped(60s));
+    QVERIFY2(f.m_recorder.error() == QMediaRecorder::NoError, f.m_recorder.errorString().toLatin1());
+
+    auto info = MediaInfo::create(f.m_recorder.actualLocation());
+
+    QCOMPARE_EQ(info->m_frameCount, framesNumber);
+    QCOMPARE_EQ(f.m_recorder.skippedVideoFrameCount(), 0);
+}
+
+void tst_QMediaFrameInputsBackend::mediaRecorderElidesDuplicateFrames_andKeepsDuration()
+{
+    QSKIP_IF_NOT_FFMPEG();
+
+    constexpr int framesNumber = 20;
+    constexpr milliseconds frameDuration = 50ms;
+
+    CaptureSessionFixture f{ StreamType::Video };
+    f.m_videoGenerator.setPattern(ImagePattern::ColoredSquares);
+    f.m_videoGenerator.setFrameCount(framesNumber);
+    f.m_videoGenerator.setSize({ 128, 64 });
+    f.m_videoGenerator.setPeriod(frameDuration);
+    f.m_recorder.setSkipDuplicateVideoFrames(true);
+    QSignalSpy skippedCountSpy(&f.m_recorder, &QMediaRecorder::skippedVideoFrameCountChanged);
+    f.start(RunMode::Pull, AutoStop::EmitEmpty);
+
+    QVERIFY(f.waitForRecorderStopped(60s));
+    QVERIFY2(f.m_recorder.error() == QMediaRecorder::NoError, f.m_recorder.errorString().toLatin1());
+
+    auto info = MediaInfo::create(f.m_recorder.actualLocation());
+
+    // Only the first and the last frames are encoded; the first one is stretched
+    QCOMPARE_EQ(info->m_frameCount, 2);
+    QCOMPARE_EQ(f.m_recorder.skippedVideoFrameCount(), framesNumber - 2);
+    QVERIFY(!skippedCountSpy.isEmpty());
+    QCOMPARE_EQ(skippedCountSpy.last().front().value<qint64>(), framesNumber - 2);
+    QCOMPARE_LT(info->m_duration, frameDuration * framesNumber * 1.001);
+    QCOMPARE_GE(info->m_duration, frameDuration * framesNumber * 0.999);
+}
+
 void tst_QMediaFrameInputsBackend::readyToSend_isEmitted_whenRecordingStarts_data()
 {
     QTest::addColumn<StreamType>("streamType");
@@ -23,6 +23,9 @@ private slots:
 
     void mediaRecorderWritesVideo_withSingleFrame();
 
+    void mediaRecorderWritesDuplicateFrames_byDefault();
+    void mediaRecorderElidesDuplicateFrames_andKeepsDuration();
+
     void sinkReceivesFrameWithTransformParams_whenPresentationTransformPresent_data();
     void sinkReceivesFrameWithTransformParams_whenPresentationTransformPresent();
 
@@ -2,17 +2,21 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QtTest/qtest.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qtemporaryfile.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qrandom.h>
 #include "qmediaplayer.h"
+#include "qplaybackstatistics.h"
 #include "mediaplayerstate.h"
 #include "fake.h"
 #include "fixture.h"
 #include "server.h"
 #include <qmediametadata.h>
 #include <qaudiobuffer.h>
+#include <qaudiobufferoutput.h>
 #include <qaudiodevice.h>
 #include <qvideosink.h>
 #include <qvideoframe.h>
@@ -145,6 +149,7 @@ private slots:
     void play_setsPlaybackStateAndMediaStatus_whenValidFileIsLoaded();
     void play_startsPlaybackAndChangesPosition_whenValidFileIsLoaded();
     void play_doesNotEnterMediaLoadingState_whenResumingPlayingAfterStop();
+    void playbackStatistics_countsDecodedAndPresentedFrames_whenPlayingVideo();
     void playAndSetSource_emitsExpectedSignalsAndStopsPlayback_whenSetSourceWasCalledWithEmptyUrl();
     void play_createsFramesWithExpectedContentAndIncreasingFrameTime_whenPlayingRtspMediaStream();
     void play_waitsForLastFrameEnd_whenPlayingVideoWithLongFrames();
@@ -213,6 +218,7 @@ private slots:
     void infiniteLoops();
     void seekOnLoops();
     void changeLoopsOnTheFly();
+    void nextSource_isPlayedWithoutStopping_whenSourceEnds();
     void seekAfterLoopReset();
 
     void cleanSinkAndNoMoreFramesAfterStop();
@@ -1412,6 +1418,31 @@ void tst_QMediaPlayerBackend::play_startsPlaybackAndChangesPosition_whenValidFil
     QTRY_VERIFY(m_fixture->positionChanged.last()[0].value<qint64>() > 100);
 }
 
+void tst_QMediaPlayerBackend::playbackStatistics_countsDecodedAndPresentedFrames_whenPlayingVideo()
+{
+    QSKIP_IF_NOT_FFMPEG("This test is only for FFmpeg backend");
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    m_fixture->player.setSource(*m_localVideoFile3ColorsWithSound);
+    m_fixture->player.play();
+
+    QTRY_VERIFY(m_fixture->framesCount > 5);
+
+    // Every snapshot is consistent, although the counters change while playing
+    for (int i = 0; i < 20; ++i) {
+        const QPlaybackStatistics statistics = m_fixture->player.playbackStatistics();
+        QCOMPARE_GT(statistics.decodedVideoFrames(), 0);
+        QCOMPARE_GT(statistics.presentedVideoFrames(), 0);
+        QCOMPARE_LE(statistics.presentedVideoFrames() + statistics.droppedVideoFrames(),
+                    statistics.decodedVideoFrames());
+        QCOMPARE_GT(statistics.averageVideoDecodeTime(), 0us);
+        QTest::qWait(10);
+    }
+
+    m_fixture->player.setSource({});
+    QCOMPARE_EQ(m_fixture->player.playbackStatistics().decodedVideoFrames(), 0);
+}
+
 void tst_QMediaPlayerBackend::play_doesNotEnterMediaLoadingState_whenResumingPlayingAfterStop()
 {
     CHECK_SELECTED_URL(m_localWavFile);
@@ -3707,6 +3738,125 @@ void tst_QMediaPlayerBackend::changeLoopsOnTheFly()
     QCOMPARE_GT(iterations[1].posCount, 2);
 }
 
+void tst_QMediaPlayerBackend::nextSource_isPlayedWithoutStopping_whenSourceEnds()
+{
+    CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
+
+    const QUrl url = *m_localVideoFile3ColorsWithSound;
+    QSignalSpy nextSourceChanged(&m_fixture->player, &QMediaPlayer::nextSourceChanged);
+
+    // The frames and buffers are delivered on the rendering threads
+    struct Rendered
+    {
+        qint64 renderTimeMs = 0;
+        qint64 startTimeUs = 0;
+        qint64 endTimeUs = 0;
+    };
+    QMutex renderedMutex;
+    QList<Rendered> videoFrames;
+    QList<Rendered> audioBuffers;
+    QElapsedTimer renderClock;
+    renderClock.start();
+    QObject receiver; // disconnects before the lists are destroyed
+
+    connect(&m_fixture->surface, &QVideoSink::videoFrameChanged, &receiver,
+            [&](const QVideoFrame &frame) {
+                if (!frame.isValid())
+                    return;
+                QMutexLocker locker(&renderedMutex);
+                videoFrames.append({ renderClock.elapsed(), frame.startTime(), frame.endTime() });
+            }, Qt::DirectConnection);
+
+    QAudioBufferOutput audioBufferOutput;
+    connect(&audioBufferOutput, &QAudioBufferOutput::audioBufferReceived, &receiver,
+            [&](const QAudioBuffer &buffer) {
+                if (!buffer.isValid())
+                    return;
+                QMutexLocker locker(&renderedMutex);
+                audioBuffers.append({ renderClock.elapsed(), buffer.startTime(),
+                                      buffer.startTime() + buffer.duration() });
+            }, Qt::DirectConnection);
+    m_fixture->player.setAudioBufferOutput(&audioBufferOutput);
+    auto resetAudioBufferOutput =
+            qScopeGuard([&] { m_fixture->player.setAudioBufferOutput(nullptr); });
+
+    m_fixture->player.setSource(url);
+    m_fixture->player.setNextSource(url);
+    QCOMPARE(nextSourceChanged.size(), 1);
+
+    m_fixture->sourceChanged.clear();
+    m_fixture->player.play();
+    m_fixture->surface.waitForFrame();
+
+    QTRY_COMPARE_WITH_TIMEOUT(nextSourceChanged.size(), 2, 5s);
+    QVERIFY(m_fixture->player.nextSource().isEmpty());
+    QCOMPARE(m_fixture->sourceChanged, SignalList({ { url } }));
+
+    const qint64 durationMs = m_fixture->player.duration();
+
+    // The audio sink keeps playing across the splice
+    if (isFFMPEGPlatform()) {
+        QTRY_COMPARE_GT(m_fixture->player.position(), durationMs / 2);
+        const QPlaybackStatistics statistics = m_fixture->player.playbackStatistics();
+        QCOMPARE_EQ(statistics.audioUnderruns(), 0);
+
+        // The statistics count the frames of the next source only
+        QMutexLocker locker(&renderedMutex);
+        QCOMPARE_GT(statistics.presentedVideoFrames(), 0);
+        QCOMPARE_LT(statistics.presentedVideoFrames(), videoFrames.size());
+        QCOMPARE_LE(statistics.presentedVideoFrames() + statistics.droppedVideoFrames(),
+                    statistics.decodedVideoFrames());
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_fixture->player.playbackState(), QMediaPlayer::StoppedState, 5s);
+    QCOMPARE(m_fixture->player.mediaStatus(), QMediaPlayer::EndOfMedia);
+    QCOMPARE(m_fixture->errorOccurred.size(), 0);
+
+    // The position runs through both sources
+    const std::vector<LoopIteration> iterations = loopIterations(m_fixture->positionChanged);
+    QCOMPARE_EQ(iterations.size(), 2u);
+    QCOMPARE_GE(iterations[0].endPos, durationMs - 100);
+    QCOMPARE_LE(iterations[1].startPos, 100);
+    QCOMPARE_EQ(iterations[1].endPos, durationMs);
+
+    // The FFmpeg backend switches to the preloaded next source without stopping
+    if (!isFFMPEGPlatform())
+        return;
+
+    QCOMPARE(m_fixture->playbackStateChanged,
+             SignalList({ { QMediaPlayer::PlayingState }, { QMediaPlayer::StoppedState } }));
+
+    QMutexLocker locker(&renderedMutex);
+
+    // Returns the index of the first item of the next source; the timestamps restart with it
+    auto spliceIndex = [](const QList<Rendered> &rendered) {
+        for (qsizetype i = 1; i < rendered.size(); ++i)
+            if (rendered[i].startTimeUs < rendered[i - 1].startTimeUs)
+                return i;
+        return qsizetype(-1);
+    };
+
+    // Both sources are rendered completely, and the next one follows the current one
+    // within the usual frame interval
+    const qsizetype videoSplice = spliceIndex(videoFrames);
+    QCOMPARE_GT(videoSplice, 0);
+    QCOMPARE_GE(videoFrames[videoSplice - 1].endTimeUs, (durationMs - 100) * 1000);
+    QCOMPARE_LE(videoFrames[videoSplice].startTimeUs, 100'000);
+    QCOMPARE_LT(videoFrames[videoSplice].renderTimeMs - videoFrames[videoSplice - 1].renderTimeMs,
+                200);
+
+    // The audio of both sources is contiguous, without missing or duplicated samples
+    const qsizetype audioSplice = spliceIndex(audioBuffers);
+    QCOMPARE_GT(audioSplice, 0);
+    QCOMPARE_GE(audioBuffers[audioSplice - 1].endTimeUs, (durationMs - 100) * 1000);
+    QCOMPARE_LE(audioBuffers[audioSplice].startTimeUs, 100'000);
+    for (qsizetype i = 1; i < audioBuffers.size(); ++i) {
+        if (i == audioSplice)
+            continue;
+        QCOMPARE_LE(qAbs(audioBuffers[i].startTimeUs - audioBuffers[i - 1].endTimeUs), 1000);
+    }
+}
+
 void tst_QMediaPlayerBackend::seekAfterLoopReset()
 {
     CHECK_SELECTED_URL(m_localVideoFile3ColorsWithSound);
@@ -21,6 +21,9 @@
 
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/qmimetype.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qcommandlineparser.h>
+#include <QtGui/qguiapplication.h>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -75,6 +78,29 @@ std::set<QMediaFormat::VideoCodec> unsupportedVideoCodecs(QMediaFormat::FileForm
     return unsupportedCodecs;
 }
 
+constexpr auto recordFragmentedOption = "record-fragmented-until-killed";
+constexpr auto muxingModeOption = "muxing-mode";
+
+// Runs in a child process started by
+// record_writesPlayableFile_whenProcessIsKilledDuringFragmentedRecording
+int recordFragmentedUntilKilled(const QString &outputPath, QMediaRecorder::MuxingMode muxingMode)
+{
+    CaptureSessionFixture f{ StreamType::Video };
+
+    QMediaFormat format{ QMediaFormat::MPEG4 };
+    format.setVideoCodec(QMediaFormat::VideoCodec::H264);
+    f.m_recorder.setMediaFormat(format);
+    f.m_recorder.setMuxingMode(muxingMode);
+    f.m_recorder.setOutputLocation(QUrl::fromLocalFile(outputPath));
+
+    f.m_videoGenerator.setFrameRate(25);
+    f.m_videoGenerator.setSize({ 320, 240 });
+    f.start(RunMode::Pull, AutoStop::No);
+
+    // Records until the parent process kills us
+    return f.waitForRecorderStopped(300s) ? 1 : 0;
+}
+
 } // namespace
 
 using namespace Qt::StringLiterals;
@@ -122,6 +148,9 @@ private slots:
 
     void record_reflectsAudioEncoderSetting();
 
+    void record_writesPlayableFile_whenProcessIsKilledDuringFragmentedRecording_data();
+    void record_writesPlayableFile_whenProcessIsKilledDuringFragmentedRecording();
+
 private:
     QTemporaryDir m_tempDir;
 };
@@ -752,6 +781,76 @@ void tst_QMediaRecorderBackend::record_reflectsAudioEncoderSetting()
     QCOMPARE_EQ(info->m_audioBuffer.format().channelCount(), 1);
 }
 
-QTEST_MAIN(tst_QMediaRecorderBackend)
+void tst_QMediaRecorderBackend::
+        record_writesPlayableFile_whenProcessIsKilledDuringFragmentedRecording_data()
+{
+    QTest::addColumn<QMediaRecorder::MuxingMode>("muxingMode");
+
+    QTest::addRow("fragmented") << QMediaRecorder::FragmentedMuxing;
+    QTest::addRow("cmaf") << QMediaRecorder::CmafMuxing;
+}
+
+void tst_QMediaRecorderBackend::
+        record_writesPlayableFile_whenProcessIsKilledDuringFragmentedRecording()
+{
+    QSKIP_IF_NOT_FFMPEG();
+#if !QT_CONFIG(process)
+    QSKIP("The test requires QProcess");
+#else
+    QFETCH(const QMediaRecorder::MuxingMode, muxingMode);
+
+    // Arrange: run the recording in a child process, which is an instance of this test
+    const QString outputPath = m_tempDir.filePath(u"killed_%1.mp4"_s.arg(int(muxingMode)));
+
+    QProcess child;
+    child.start(QCoreApplication::applicationFilePath(),
+                { u"--%1"_s.arg(QLatin1StringView(recordFragmentedOption)), outputPath,
+                  u"--%1"_s.arg(QLatin1StringView(muxingModeOption)),
+                  QString::number(int(muxingMode)) });
+    QVERIFY(child.waitForStarted());
+
+    // Act: let a few fragments be written, then terminate the recording abruptly
+    QTRY_VERIFY_WITH_TIMEOUT(QFileInfo(outputPath).size() > 256 * 1024, 60s);
+    child.kill();
+    QVERIFY(child.waitForFinished());
+
+    // Assert
+    const auto info = MediaInfo::create(QUrl::fromLocalFile(outputPath));
+    QVERIFY(info);
+    QVERIFY(info->m_hasVideo);
+    QCOMPARE_GT(info->m_frameCount, 0);
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    QCommandLineParser cmd;
+    const QCommandLineOption recordFragmented{
+        QStringList{ QString::fromLatin1(recordFragmentedOption) },
+        u"Records fragmented video to the given file until the process is killed"_s,
+        u"outputPath"_s
+    };
+    const QCommandLineOption muxingMode{ QStringList{ QString::fromLatin1(muxingModeOption) },
+                                         u"Muxing mode of the fragmented recording"_s,
+                                         u"mode"_s };
+    cmd.addOption(recordFragmented);
+    cmd.addOption(muxingMode);
+    cmd.parse({ argv, argv + argc });
+
+    if (cmd.isSet(recordFragmented)) {
+        QGuiApplication app{ argc, argv };
+        return recordFragmentedUntilKilled(
+                cmd.value(recordFragmented),
+                QMediaRecorder::MuxingMode(cmd.value(muxingMode).toInt()));
+    }
+
+    // If no special arguments are set, enter the regular QTest main routine
+    TESTLIB_SELFCOVERAGE_START("tst_QMediaRecorderBackend")
+    QT_PREPEND_NAMESPACE(QTest::Internal::callInitMain)<tst_QMediaRecorderBackend>();
+    QGuiApplication app(argc, argv);
+    app.setAttribute(Qt::AA_Use96Dpi, true);
+    tst_QMediaRecorderBackend tc;
+    QTEST_SET_MAIN_SOURCE_PATH return QTest::qExec(&tc, argc, argv);
+}
 
 #include "tst_qmediarecorderbackend.moc"
@@ -0,0 +1,277 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtMultimedia/qaudiodevice.h>
+#include <QtMultimedia/private/qplatformaudiodevices_p.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Replaces PULSE_SERVER for the current scope
+auto usePulseServer(const QByteArray &server)
+{
+    const QByteArray previous = qgetenv("PULSE_SERVER");
+    qputenv("PULSE_SERVER", server);
+    return qScopeGuard([previous] { qputenv("PULSE_SERVER", previous); });
+}
+
+// A server socket that accepts connections, but never replies
+class StalledServer
+{
+public:
+    explicit StalledServer(const QString &path)
+    {
+        const QByteArray encodedPath = QFile::encodeName(path);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (size_t(encodedPath.size()) >= sizeof(address.sun_path))
+            return;
+        qstrcpy(address.sun_path, encodedPath.constData());
+
+        m_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (m_fd < 0)
+            return;
+        if (::bind(m_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+            || ::listen(m_fd, 8) != 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    ~StalledServer()
+    {
+        if (m_fd >= 0)
+            ::close(m_fd);
+    }
+
+    bool isListening() const { return m_fd >= 0; }
+
+private:
+    int m_fd = -1;
+};
+
+// Generous bound of the startup timeout of the backend, which is 500ms
+constexpr auto maxStartupBlocking = 2s;
+
+} // namespace
+
+// Runs the PulseAudio backend against a private pulseaudio daemon with null sinks, so that
+// the results don't depend on the audio setup of the machine.
+class tst_QPulseAudioBackend : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void create_doesNotWaitForServer();
+    void create_doesNotWaitForServer_whenServerIsStalled();
+    void audioOutputs_returnsWithinStartupTimeout_whenServerIsStalled();
+    void audioOutputs_returnsEmptyList_whenServerIsAbsent();
+    void audioOutputs_containsServerSinks_whenQueriedRightAfterCreation();
+    void audioInputs_containsSinkMonitors();
+
+private:
+    std::unique_ptr<QPlatformAudioDevices> createBackend();
+    bool startDaemon();
+
+    QTemporaryDir m_runtimeDir;
+    QProcess m_daemon;
+    bool m_daemonRunning = false;
+};
+
+void tst_QPulseAudioBackend::initTestCase()
+{
+    QVERIFY(m_runtimeDir.isValid());
+    qputenv("QT_AUDIO_BACKEND", "pulseaudio");
+
+    m_daemonRunning = startDaemon();
+}
+
+bool tst_QPulseAudioBackend::startDaemon()
+{
+    const QString pulseaudio = QStandardPaths::findExecutable(u"pulseaudio"_s);
+    if (pulseaudio.isEmpty()) {
+        qWarning("pulseaudio is not installed");
+        return false;
+    }
+
+    const QString socket = m_runtimeDir.filePath(u"native"_s);
+
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(u"XDG_RUNTIME_DIR"_s, m_runtimeDir.path());
+    env.insert(u"HOME"_s, m_runtimeDir.path());
+    m_daemon.setProcessEnvironment(env);
+    m_daemon.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    m_daemon.start(pulseaudio,
+                   {
+                           u"-n"_s,
+                           u"--daemonize=no"_s,
+                           u"--exit-idle-time=-1"_s,
+                           u"--use-pid-file=no"_s,
+                           u"-L"_s,
+                           u"module-native-protocol-unix auth-anonymous=1 socket="_s + socket,
+                           u"-L"_s,
+                           u"module-null-sink sink_name=tst_sink_1"_s,
+                           u"-L"_s,
+                           u"module-null-sink sink_name=tst_sink_2"_s,
+                   });
+    if (!m_daemon.waitForStarted()) {
+        qWarning("Cannot start pulseaudio");
+        return false;
+    }
+
+    // the daemon accepts connections once the socket exists
+    if (!QTest::qWaitFor([&] { return QFile::exists(socket); }, 10s)) {
+        qWarning("pulseaudio did not come up");
+        return false;
+    }
+
+    qputenv("PULSE_SERVER", "unix:" + socket.toLocal8Bit());
+    return true;
+}
+
+void tst_QPulseAudioBackend::cleanupTestCase()
+{
+    if (m_daemon.state() != QProcess::NotRunning) {
+        m_daemon.terminate();
+        if (!m_daemon.waitForFinished())
+            m_daemon.kill();
+    }
+}
+
+std::unique_ptr<QPlatformAudioDevices> tst_QPulseAudioBackend::createBackend()
+{
+    auto backend = QPlatformAudioDevices::create();
+    if (backend->backendName() != QLatin1String("PulseAudio"))
+        return {};
+    return backend;
+}
+
+void tst_QPulseAudioBackend::create_doesNotWaitForServer()
+{
+    if (!m_daemonRunning)
+        QSKIP("pulseaudio is not running");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto backend = createBackend();
+    if (!backend)
+        QSKIP("The PulseAudio backend is not available");
+
+    // Connecting and enumerating takes a few round trips to the server, which is not
+    // supposed to happen on the calling thread anymore
+    QCOMPARE_LT(timer.durationElapsed(), 500ms);
+}
+
+void tst_QPulseAudioBackend::create_doesNotWaitForServer_whenServerIsStalled()
+{
+    const QString socket = m_runtimeDir.filePath(u"stalled_create"_s);
+    StalledServer server(socket);
+    QVERIFY(server.isListening());
+    auto restoreServer = usePulseServer("unix:" + socket.toLocal8Bit());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto backend = createBackend();
+    if (!backend)
+        QSKIP("The PulseAudio backend is not available");
+
+    QCOMPARE_LT(timer.durationElapsed(), 500ms);
+}
+
+void tst_QPulseAudioBackend::audioOutputs_returnsWithinStartupTimeout_whenServerIsStalled()
+{
+    const QString socket = m_runtimeDir.filePath(u"stalled_query"_s);
+    StalledServer server(socket);
+    QVERIFY(server.isListening());
+    auto restoreServer = usePulseServer("unix:" + socket.toLocal8Bit());
+
+    auto backend = createBackend();
+    if (!backend)
+        QSKIP("The PulseAudio backend is not available");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVERIFY(backend->audioOutputs().isEmpty());
+
+    // The first query waits for the enumeration, but not longer than the startup timeout
+    QCOMPARE_LT(timer.durationElapsed(), maxStartupBlocking);
+}
+
+void tst_QPulseAudioBackend::audioOutputs_returnsEmptyList_whenServerIsAbsent()
+{
+    auto restoreServer =
+            usePulseServer("unix:" + m_runtimeDir.filePath(u"absent"_s).toLocal8Bit());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto backend = createBackend();
+    if (!backend)
+        QSKIP("The PulseAudio backend is not available");
+
+    // A failed connection ends the wait for the enumeration right away
+    QVERIFY(backend->audioOutputs().isEmpty());
+    QCOMPARE_LT(timer.durationElapsed(), maxStartupBlocking);
+}
+
+void tst_QPulseAudioBackend::audioOutputs_containsServerSinks_whenQueriedRightAfterCreation()
+{
+    if (!m_daemonRunning)
+        QSKIP("pulseaudio is not running");
+
+    auto backend = createBackend();
+    if (!backend)
+        QSKIP("The PulseAudio backend is not available");
+
+    const QList<QAudioDevice> outputs = backend->audioOutputs();
+
+    QStringList ids;
+    for (const QAudioDevice &device : outputs)
+        ids << QString::fromUtf8(device.id());
+
+    QVERIFY2(ids.contains(u"tst_sink_1"_s), qPrintable(ids.join(u", ")));
+    QVERIFY2(ids.contains(u"tst_sink_2"_s), qPrintable(ids.join(u", ")));
+}
+
+void tst_QPulseAudioBackend::audioInputs_containsSinkMonitors()
+{
+    if (!m_daemonRunning)
+        QSKIP("pulseaudio is not running");
+
+    auto backend = createBackend();
+    if (!backend)
+        QSKIP("The PulseAudio backend is not available");
+
+    const QList<QAudioDevice> inputs = backend->audioInputs();
+
+    QStringList ids;
+    for (const QAudioDevice &device : inputs)
+        ids << QString::fromUtf8(device.id());
+
+    QVERIFY2(ids.contains(u"tst_sink_1.monitor"_s), qPrintable(ids.join(u", ")));
+}
+
+QTEST_GUILESS_MAIN(tst_QPulseAudioBackend)
+
+#include "tst_qpulseaudiobackend.moc"
@@ -4,6 +4,8 @@
 #include <QtTest/qsignalspy.h>
 #include <QtTest/qtest.h>
 #include <QtTest/qtesteventloop.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtMultimedia/qaudio.h>
 #include <QtMultimedia/qaudiodevice.h>
 #include <QtMultimedia/qmediadevices.h>
@@ -45,6 +47,9 @@ private slots:
     void testSupportedMimeTypes();
     void testCorruptFile();
 
+    void preload_loadsSoundForLaterSoundEffects();
+    void setSourcePinned_keepsSoundLoaded_whenFileIsRemoved();
+
     void setAudioDevice_emitsSignalsInExpectedOrder_data();
     void setAudioDevice_emitsSignalsInExpectedOrder();
 
@@ -54,6 +59,8 @@ private slots:
     void testQSoundEffectVoiceWithVolume();
     void testQSoundEffectVoiceMuted();
     void testQSoundEffectVoiceLooping();
+    void testQSoundEffectVoiceInt16();
+    void testQSoundEffectVoicePackedInt24();
 
 private:
     QSoundEffect* sound;
@@ -67,6 +74,33 @@ private:
                         floats.size() * sizeof(float));
         return std::make_shared<QSample>(data, format);
     }
+
+    // Stores the floats with the given encoding; the values must be representable by it
+    SharedSamplePtr createTestSample(QSpan<const float> floats, const QAudioFormat &format,
+                                     QSample::Encoding encoding)
+    {
+        QByteArray data;
+        for (float value : floats) {
+            switch (encoding) {
+            case QSample::Encoding::Float:
+                data.append(reinterpret_cast<const char *>(&value), sizeof(float));
+                break;
+            case QSample::Encoding::Int16: {
+                const qint16 int16Value = qint16(value * 32768.f);
+                data.append(reinterpret_cast<const char *>(&int16Value), sizeof(qint16));
+                break;
+            }
+            case QSample::Encoding::PackedInt24: {
+                const qint32 int24Value = qint32(value * 8388608.f);
+                data.append(char(int24Value & 0xff));
+                data.append(char((int24Value >> 8) & 0xff));
+                data.append(char((int24Value >> 16) & 0xff));
+                break;
+            }
+            }
+        }
+        return std::make_shared<QSample>(data, format, encoding);
+    }
 };
 
 void tst_QSoundEffect::init()
@@ -442,6 +476,51 @@ void tst_QSoundEffect::testCorruptFile()
     }
 }
 
+void tst_QSoundEffect::preload_loadsSoundForLaterSoundEffects()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(u"preloaded.wav"_s);
+    QVERIFY(QFile::copy(url.toLocalFile(), fileName));
+    const QUrl preloadedUrl = QUrl::fromLocalFile(fileName);
+
+    QSoundEffect::preload(preloadedUrl);
+    QVERIFY(!QSoundEffect::isSourcePinned(preloadedUrl));
+
+    QSoundEffect effect;
+    effect.setSource(preloadedUrl);
+    QTRY_COMPARE(effect.status(), QSoundEffect::Ready);
+}
+
+void tst_QSoundEffect::setSourcePinned_keepsSoundLoaded_whenFileIsRemoved()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(u"pinned.wav"_s);
+    QVERIFY(QFile::copy(url.toLocalFile(), fileName));
+    const QUrl pinnedUrl = QUrl::fromLocalFile(fileName);
+
+    QVERIFY(!QSoundEffect::isSourcePinned(pinnedUrl));
+    QSoundEffect::setSourcePinned(pinnedUrl, true);
+    QVERIFY(QSoundEffect::isSourcePinned(pinnedUrl));
+
+    {
+        QSoundEffect effect;
+        effect.setSource(pinnedUrl);
+        QTRY_COMPARE(effect.status(), QSoundEffect::Ready);
+    }
+
+    // No sound effect uses the sound anymore, but it's still loaded
+    QVERIFY(QFile::remove(fileName));
+
+    QSoundEffect effect;
+    effect.setSource(pinnedUrl);
+    QTRY_COMPARE(effect.status(), QSoundEffect::Ready);
+
+    QSoundEffect::setSourcePinned(pinnedUrl, false);
+    QVERIFY(!QSoundEffect::isSourcePinned(pinnedUrl));
+}
+
 void tst_QSoundEffect::setAudioDevice_emitsSignalsInExpectedOrder_data()
 {
     QTest::addColumn<bool>("while_playing");
@@ -668,6 +747,57 @@ void tst_QSoundEffect::testQSoundEffectVoiceLooping()
     QCOMPARE(buffer[3], 0.5f);
 }
 
+void tst_QSoundEffect::testQSoundEffectVoiceInt16()
+{
+    std::array<float, 4> sampleData = { 1.0f - 1.0f / 32768.f, -1.0f, 0.5f, -0.25f };
+    QAudioFormat sampleFormat;
+    sampleFormat.setSampleFormat(QAudioFormat::Float);
+    sampleFormat.setChannelCount(2);
+    sampleFormat.setSampleRate(44100);
+    auto sample = createTestSample(sampleData, sampleFormat, QSample::Encoding::Int16);
+
+    QCOMPARE(sample->data().size(), 4 * qsizetype(sizeof(qint16)));
+    QCOMPARE(sample->frameCount(), 2);
+
+    QAudioFormat engineFormat = sampleFormat;
+
+    QSoundEffectVoice voice(VoiceId{ 0 }, sample, 1.0f, false, 1, engineFormat);
+
+    std::array<float, 4> buffer = { 0.0f, 0.0f, 0.0f, 0.0f };
+    qsizetype played = voice.playVoice(buffer);
+
+    QCOMPARE(played, 2);
+    for (size_t i = 0; i < buffer.size(); ++i)
+        QCOMPARE(buffer[i], sampleData[i]);
+}
+
+void tst_QSoundEffect::testQSoundEffectVoicePackedInt24()
+{
+    std::array<float, 2> sampleData = { 0.5f, -1.0f };
+    QAudioFormat sampleFormat;
+    sampleFormat.setSampleFormat(QAudioFormat::Float);
+    sampleFormat.setChannelCount(1);
+    sampleFormat.setSampleRate(44100);
+    auto sample = createTestSample(sampleData, sampleFormat, QSample::Encoding::PackedInt24);
+
+    QCOMPARE(sample->data().size(), 2 * 3);
+    QCOMPARE(sample->frameCount(), 2);
+
+    QAudioFormat engineFormat = sampleFormat;
+    engineFormat.setChannelCount(2);
+
+    QSoundEffectVoice voice(VoiceId{ 0 }, sample, 0.5f, false, 1, engineFormat);
+
+    std::array<float, 4> buffer = { 0.0f, 0.0f, 0.0f, 0.0f };
+    qsizetype played = voice.playVoice(buffer);
+
+    QCOMPARE(played, 2);
+    QCOMPARE(buffer[0], 0.25f);
+    QCOMPARE(buffer[1], 0.25f);
+    QCOMPARE(buffer[2], -0.5f);
+    QCOMPARE(buffer[3], -0.5f);
+}
+
 QTEST_MAIN(tst_QSoundEffect)
 
 #include "tst_qsoundeffect.moc"
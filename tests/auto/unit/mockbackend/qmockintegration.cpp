@@ -5,6 +5,7 @@
 #include "qmockintegration.h"
 #include "qmockmediaplayer.h"
 #include "qmockaudiodecoder.h"
+#include "qmockmediaframeextractor.h"
 #include "qmockaudiodevices.h"
 #include "qmockvideodevices.h"
 #include "qmockcamera.h"
@@ -75,6 +76,18 @@ q23::expected<QPlatformAudioDecoder *, QString> QMockIntegration::createAudioDec
         return q23::unexpected{ QStringLiteral("No audio decoder") };
 }
 
+q23::expected<QPlatformMediaFrameExtractor *, QString>
+QMockIntegration::createMediaFrameExtractor(QMediaFrameExtractor *extractor)
+{
+    if (m_flags & NoMediaFrameExtractorInterface) {
+        m_lastMediaFrameExtractor = nullptr;
+        return q23::unexpected{ QStringLiteral("No media frame extractor") };
+    }
+
+    m_lastMediaFrameExtractor = new QMockMediaFrameExtractor(extractor);
+    return m_lastMediaFrameExtractor;
+}
+
 q23::expected<QPlatformMediaPlayer *, QString> QMockIntegration::createPlayer(QMediaPlayer *parent)
 {
     if (m_flags & NoPlayerInterface)
@@ -22,6 +22,7 @@ QT_BEGIN_NAMESPACE
 
 class QMockMediaPlayer;
 class QMockAudioDecoder;
+class QMockMediaFrameExtractor;
 class QMockCamera;
 class QMockMediaCaptureSession;
 class QMockVideoSink;
@@ -44,6 +45,8 @@ public:
     using QPlatformMediaIntegration::resetInstance;
 
     q23::expected<QPlatformAudioDecoder *, QString> createAudioDecoder(QAudioDecoder *decoder) override;
+    q23::expected<QPlatformMediaFrameExtractor *, QString>
+    createMediaFrameExtractor(QMediaFrameExtractor *extractor) override;
     q23::expected<QPlatformMediaPlayer *, QString> createPlayer(QMediaPlayer *) override;
     q23::expected<QPlatformCamera *, QString> createCamera(QCamera *) override;
     q23::expected<QPlatformMediaRecorder *, QString> createRecorder(QMediaRecorder *) override;
@@ -58,7 +61,12 @@ public:
 
     void addNewCamera();
 
-    enum Flag { NoPlayerInterface = 0x1, NoAudioDecoderInterface = 0x2, NoCaptureInterface = 0x4 };
+    enum Flag {
+        NoPlayerInterface = 0x1,
+        NoAudioDecoderInterface = 0x2,
+        NoCaptureInterface = 0x4,
+        NoMediaFrameExtractorInterface = 0x8
+    };
     Q_DECLARE_FLAGS(Flags, Flag);
 
     void setFlags(Flags f) { m_flags = f; }
@@ -66,6 +74,10 @@ public:
 
     QMockMediaPlayer *lastPlayer() const { return m_lastPlayer; }
     QMockAudioDecoder *lastAudioDecoder() const { return m_lastAudioDecoderControl; }
+    QMockMediaFrameExtractor *lastMediaFrameExtractor() const
+    {
+        return m_lastMediaFrameExtractor;
+    }
     QMockCamera *lastCamera() const { return m_lastCamera; }
     // QMockMediaEncoder *lastEncoder const { return m_lastEncoder; }
     QMockMediaCaptureSession *lastCaptureService() const { return m_lastCaptureService; }
@@ -88,6 +100,7 @@ private:
     Flags m_flags = {};
     QMockMediaPlayer *m_lastPlayer = nullptr;
     QMockAudioDecoder *m_lastAudioDecoderControl = nullptr;
+    QMockMediaFrameExtractor *m_lastMediaFrameExtractor = nullptr;
     QMockCamera *m_lastCamera = nullptr;
     // QMockMediaEncoder *m_lastEncoder = nullptr;
     QMockMediaCaptureSession *m_lastCaptureService = nullptr;
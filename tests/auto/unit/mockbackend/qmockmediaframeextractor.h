@@ -0,0 +1,59 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QMOCKMEDIAFRAMEEXTRACTOR_H
+#define QMOCKMEDIAFRAMEEXTRACTOR_H
+
+#include <private/qplatformmediaframeextractor_p.h>
+
+#include <QtGui/qimage.h>
+#include <QtMultimedia/qvideoframe.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMockMediaFrameExtractor : public QPlatformMediaFrameExtractor
+{
+    Q_OBJECT
+
+public:
+    explicit QMockMediaFrameExtractor(QMediaFrameExtractor *parent)
+        : QPlatformMediaFrameExtractor(parent)
+    {
+    }
+
+    void extractFrames(const QUrl &source, const QList<qint64> &positions,
+                       const QSize &imageSize) override
+    {
+        m_source = source;
+        m_positions = positions;
+        m_imageSize = imageSize;
+        setActive(true);
+    }
+
+    void cancel() override { setActive(false); }
+
+    // Reports a frame, or an image, for each requested position, and finishes
+    void completeExtraction()
+    {
+        for (qint64 position : std::as_const(m_positions)) {
+            if (m_imageSize.isValid()) {
+                QImage image(m_imageSize, QImage::Format_ARGB32);
+                image.fill(Qt::red);
+                imageExtracted(position, image);
+            } else {
+                QVideoFrame frame(QVideoFrameFormat({ 16, 16 }, QVideoFrameFormat::Format_RGBA8888));
+                frame.setStartTime(position * 1000);
+                frameExtracted(position, frame);
+            }
+        }
+        finished();
+    }
+
+    QUrl m_source;
+    QList<qint64> m_positions;
+    QSize m_imageSize;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMOCKMEDIAFRAMEEXTRACTOR_H
@@ -92,6 +92,18 @@ public:
     bool streamPlaybackSupported() const override { return m_supportsStreamPlayback; }
     void setStreamPlaybackSupported(bool b) { m_supportsStreamPlayback = b; }
 
+    bool setNextMedia(const QUrl &media) override
+    {
+        _nextMedia = media;
+        return m_supportsGaplessPlayback;
+    }
+    void setGaplessPlaybackSupported(bool b) { m_supportsGaplessPlayback = b; }
+    void startNextMedia()
+    {
+        _media = std::exchange(_nextMedia, QUrl());
+        nextMediaStarted(_media);
+    }
+
     void play() override { if (_isValid && !_media.isEmpty()) setState(QMediaPlayer::PlayingState); }
     void pause() override { if (_isValid && !_media.isEmpty()) setState(QMediaPlayer::PausedState); }
     void stop() override { if (_state != QMediaPlayer::StoppedState) setState(QMediaPlayer::StoppedState); }
@@ -163,10 +175,12 @@ public:
     std::pair<qint64, qint64> _seekRange;
     qreal _playbackRate;
     QUrl _media;
+    QUrl _nextMedia;
     QIODevice *_stream;
     bool _isValid;
     QString _errorString;
     bool m_supportsStreamPlayback = false;
+    bool m_supportsGaplessPlayback = false;
     QPlatformAudioOutput *m_audioOutput = nullptr;
 };
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qrandom.h>
 #include <QtTest/qtest.h>
 
 #include <QtMultimedia/private/qaudiohelpers_p.h>
@@ -9,6 +10,8 @@
 #include <QtMultimedia/private/qaudio_alignment_support_p.h>
 #include <QtMultimedia/private/qaudio_qspan_support_p.h>
 
+#include <cstring>
+
 // NOLINTBEGIN(readability-convert-member-functions-to-static)
 
 class tst_QAudioHelpers : public QObject
@@ -16,8 +19,12 @@ class tst_QAudioHelpers : public QObject
     Q_OBJECT
 
 private slots:
+    void cleanup();
+
     void applyVolume();
     void applyVolume_data();
+    void applyVolume_givesSameResultWithAndWithoutSimd();
+    void applyVolume_givesSameResultWithAndWithoutSimd_data();
 
     void alignmentSupport();
 
@@ -28,6 +35,10 @@ private slots:
     void wordConverter_data();
 
     void wordConverter_checkLoopUnroll();
+    void wordConverter_givesSameResultWithAndWithoutSimd();
+    void wordConverter_givesSameResultWithAndWithoutSimd_data();
+    void wordConverter_dithering_changesSamplesByAtMostOneLsb();
+    void wordConverter_dithering_isIgnored_whenNoPrecisionIsLost();
 
     void findBestNativeSampleFormat();
 
@@ -109,6 +120,71 @@ float fromBytes(QByteArrayView value, QAudioFormat::SampleFormat sampleFormat)
                  .toUtf8() \
                  .data())
 
+using NativeSampleFormat = QAudioHelperInternal::NativeSampleFormat;
+
+namespace {
+
+qsizetype bytesPerSample(NativeSampleFormat format)
+{
+    return qsizetype(QAudioHelperInternal::bytesPerSample(format));
+}
+
+QAudioFormat makeAudioFormat(NativeSampleFormat format)
+{
+    QAudioFormat audioFormat;
+    switch (format) {
+    case NativeSampleFormat::int16_t:
+        audioFormat.setSampleFormat(QAudioFormat::Int16);
+        break;
+    case NativeSampleFormat::int32_t:
+        audioFormat.setSampleFormat(QAudioFormat::Int32);
+        break;
+    case NativeSampleFormat::float32_t:
+        audioFormat.setSampleFormat(QAudioFormat::Float);
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+    return audioFormat;
+}
+
+// Random samples, including values outside of the nominal range
+QByteArray makeRandomSamples(NativeSampleFormat format, qsizetype sampleCount)
+{
+    QRandomGenerator random(42);
+    QByteArray result(sampleCount * bytesPerSample(format), Qt::Uninitialized);
+
+    if (format == NativeSampleFormat::float32_t) {
+        for (qsizetype i = 0; i < sampleCount; ++i) {
+            const float value = float(random.bounded(2.4) - 1.2);
+            std::memcpy(result.data() + i * sizeof(float), &value, sizeof(float));
+        }
+    } else {
+        for (char &byte : result)
+            byte = char(random.bounded(256));
+    }
+    return result;
+}
+
+QByteArray convert(const QByteArray &source, NativeSampleFormat sourceFormat,
+                   NativeSampleFormat destinationFormat,
+                   QAudioHelperInternal::Dithering dithering = {})
+{
+    const qsizetype sampleCount = source.size() / bytesPerSample(sourceFormat);
+    QByteArray destination(sampleCount * bytesPerSample(destinationFormat), Qt::Uninitialized);
+    QAudioHelperInternal::convertSampleFormat(as_bytes(QSpan{ source }), sourceFormat,
+                                              as_writable_bytes(QSpan{ destination }),
+                                              destinationFormat, dithering);
+    return destination;
+}
+
+} // namespace
+
+void tst_QAudioHelpers::cleanup()
+{
+    QAudioHelperInternal::setSimdEnabled(true);
+}
+
 void tst_QAudioHelpers::applyVolume()
 {
     QFETCH(QAudioFormat::SampleFormat, sampleFormat);
@@ -169,6 +245,40 @@ void tst_QAudioHelpers::applyVolume_data()
     makeEntriesFor("uint8", SampleFormat::UInt8);
 }
 
+void tst_QAudioHelpers::applyVolume_givesSameResultWithAndWithoutSimd_data()
+{
+    QTest::addColumn<NativeSampleFormat>("format");
+    QTest::addColumn<int>("sampleCount");
+
+    for (NativeSampleFormat format : { NativeSampleFormat::int16_t, NativeSampleFormat::int32_t,
+                                       NativeSampleFormat::float32_t }) {
+        // cover the remainder after the vector loops
+        for (int sampleCount : { 1, 7, 8, 9, 31, 1024 }) {
+            QTest::addRow("%s, %d samples", QDebug::toBytes(format).constData(), sampleCount)
+                    << format << sampleCount;
+        }
+    }
+}
+
+void tst_QAudioHelpers::applyVolume_givesSameResultWithAndWithoutSimd()
+{
+    QFETCH(NativeSampleFormat, format);
+    QFETCH(int, sampleCount);
+
+    const QAudioFormat audioFormat = makeAudioFormat(format);
+    const QByteArray source = makeRandomSamples(format, sampleCount);
+
+    auto applyVolume = [&](bool simd) {
+        QAudioHelperInternal::setSimdEnabled(simd);
+        QByteArray destination(source.size(), Qt::Uninitialized);
+        QAudioHelperInternal::applyVolume(0.37f, audioFormat, as_bytes(QSpan{ source }),
+                                          as_writable_bytes(QSpan{ destination }));
+        return destination;
+    };
+
+    QCOMPARE_EQ(applyVolume(true), applyVolume(false));
+}
+
 void tst_QAudioHelpers::alignmentSupport()
 {
     using namespace QtMultimediaPrivate;
@@ -222,8 +332,6 @@ void tst_QAudioHelpers::span_take()
     QVERIFY(take(emptySpan, 3).empty());
 }
 
-using NativeSampleFormat = QAudioHelperInternal::NativeSampleFormat;
-
 void tst_QAudioHelpers::wordConverter()
 {
     QFETCH(QByteArray, argument);
@@ -350,6 +458,89 @@ void tst_QAudioHelpers::wordConverter_checkLoopUnroll()
     QCOMPARE_EQ(destination, int16Result);
 }
 
+void tst_QAudioHelpers::wordConverter_givesSameResultWithAndWithoutSimd_data()
+{
+    QTest::addColumn<NativeSampleFormat>("sourceFormat");
+    QTest::addColumn<NativeSampleFormat>("destinationFormat");
+    QTest::addColumn<int>("sampleCount");
+
+    const std::pair<NativeSampleFormat, NativeSampleFormat> conversions[] = {
+        { NativeSampleFormat::float32_t, NativeSampleFormat::int16_t },
+        { NativeSampleFormat::int16_t, NativeSampleFormat::float32_t },
+        { NativeSampleFormat::float32_t, NativeSampleFormat::int32_t },
+        { NativeSampleFormat::int32_t, NativeSampleFormat::float32_t },
+        { NativeSampleFormat::float32_t, NativeSampleFormat::int24_t_3b },
+        { NativeSampleFormat::int24_t_3b, NativeSampleFormat::float32_t },
+    };
+
+    for (auto [sourceFormat, destinationFormat] : conversions) {
+        // cover the remainder after the vector loops
+        for (int sampleCount : { 1, 4, 5, 8, 9, 17, 1024 }) {
+            QTest::addRow("%s to %s, %d samples", QDebug::toBytes(sourceFormat).constData(),
+                          QDebug::toBytes(destinationFormat).constData(), sampleCount)
+                    << sourceFormat << destinationFormat << sampleCount;
+        }
+    }
+}
+
+void tst_QAudioHelpers::wordConverter_givesSameResultWithAndWithoutSimd()
+{
+    QFETCH(NativeSampleFormat, sourceFormat);
+    QFETCH(NativeSampleFormat, destinationFormat);
+    QFETCH(int, sampleCount);
+
+    const QByteArray source = makeRandomSamples(sourceFormat, sampleCount);
+
+    QAudioHelperInternal::setSimdEnabled(false);
+    const QByteArray scalarResult = convert(source, sourceFormat, destinationFormat);
+
+    QAudioHelperInternal::setSimdEnabled(true);
+    const QByteArray simdResult = convert(source, sourceFormat, destinationFormat);
+
+    QCOMPARE_EQ(simdResult, scalarResult);
+}
+
+void tst_QAudioHelpers::wordConverter_dithering_changesSamplesByAtMostOneLsb()
+{
+    constexpr int sampleCount = 4096;
+    const QByteArray source = makeRandomSamples(NativeSampleFormat::float32_t, sampleCount);
+
+    const QByteArray plain =
+            convert(source, NativeSampleFormat::float32_t, NativeSampleFormat::int16_t);
+    const QByteArray dithered =
+            convert(source, NativeSampleFormat::float32_t, NativeSampleFormat::int16_t,
+                    QAudioHelperInternal::Dithering::Triangular);
+
+    QSpan<const int16_t> plainSamples{ reinterpret_cast<const int16_t *>(plain.constData()),
+                                       sampleCount };
+    QSpan<const int16_t> ditheredSamples{ reinterpret_cast<const int16_t *>(dithered.constData()),
+                                          sampleCount };
+
+    int changedSamples = 0;
+    for (int i = 0; i < sampleCount; ++i) {
+        const int difference = ditheredSamples[i] - plainSamples[i];
+        QCOMPARE_LE(std::abs(difference), 1);
+        if (difference != 0)
+            ++changedSamples;
+    }
+
+    // The noise has a triangular distribution over +-1 LSB, so about a third of the samples
+    // within the nominal range is rounded differently
+    QCOMPARE_GT(changedSamples, sampleCount / 8);
+}
+
+void tst_QAudioHelpers::wordConverter_dithering_isIgnored_whenNoPrecisionIsLost()
+{
+    const QByteArray source = makeRandomSamples(NativeSampleFormat::int16_t, 1024);
+
+    QCOMPARE_EQ(convert(source, NativeSampleFormat::int16_t, NativeSampleFormat::float32_t,
+                        QAudioHelperInternal::Dithering::Triangular),
+                convert(source, NativeSampleFormat::int16_t, NativeSampleFormat::float32_t));
+    QCOMPARE_EQ(convert(source, NativeSampleFormat::int16_t, NativeSampleFormat::int32_t,
+                        QAudioHelperInternal::Dithering::Triangular),
+                convert(source, NativeSampleFormat::int16_t, NativeSampleFormat::int32_t));
+}
+
 void tst_QAudioHelpers::findBestNativeSampleFormat()
 {
     using namespace QAudioHelperInternal;
@@ -0,0 +1,170 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtTest/qsignalspy.h>
+
+#include <QtGui/qimage.h>
+#include <QtMultimedia/qmediaframeextractor.h>
+#include <QtMultimedia/qvideoframe.h>
+
+#include "qmockintegration.h"
+#include "qmockmediaframeextractor.h"
+
+QT_USE_NAMESPACE
+
+Q_ENABLE_MOCK_MULTIMEDIA_PLUGIN
+
+class tst_QMediaFrameExtractor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+
+    void constructor_setsDefaults();
+    void extractFrames_passesSortedUniquePositions_toBackend();
+    void extractFrames_passesImageSize_toBackend();
+    void completedExtraction_reportsFrames_andFinishes();
+    void completedExtraction_reportsImages_whenImageSizeIsValid();
+    void setSource_cancelsRunningExtraction();
+    void backendError_isReported();
+    void unsupportedBackend_reportsNotSupportedError();
+};
+
+void tst_QMediaFrameExtractor::cleanup()
+{
+    QMockIntegration::instance()->setFlags({});
+}
+
+void tst_QMediaFrameExtractor::constructor_setsDefaults()
+{
+    QMediaFrameExtractor extractor;
+
+    QVERIFY(extractor.isSupported());
+    QVERIFY(extractor.source().isEmpty());
+    QVERIFY(!extractor.imageSize().isValid());
+    QVERIFY(!extractor.isActive());
+    QCOMPARE(extractor.error(), QMediaFrameExtractor::NoError);
+    QVERIFY(extractor.errorString().isEmpty());
+}
+
+void tst_QMediaFrameExtractor::extractFrames_passesSortedUniquePositions_toBackend()
+{
+    QMediaFrameExtractor extractor;
+    QSignalSpy activeSpy(&extractor, &QMediaFrameExtractor::activeChanged);
+
+    extractor.setSource(QUrl::fromLocalFile(QStringLiteral("video.mp4")));
+    extractor.extractFrames({ 3000, 1000, -5, 3000, 2000 });
+
+    QMockMediaFrameExtractor *backend = QMockIntegration::instance()->lastMediaFrameExtractor();
+    QVERIFY(backend);
+    QCOMPARE(backend->m_source, QUrl::fromLocalFile(QStringLiteral("video.mp4")));
+    QCOMPARE(backend->m_positions, QList<qint64>({ 0, 1000, 2000, 3000 }));
+    QVERIFY(extractor.isActive());
+    QCOMPARE(activeSpy.size(), 1);
+}
+
+void tst_QMediaFrameExtractor::extractFrames_passesImageSize_toBackend()
+{
+    QMediaFrameExtractor extractor;
+    QSignalSpy imageSizeSpy(&extractor, &QMediaFrameExtractor::imageSizeChanged);
+
+    extractor.setImageSize({ 160, 90 });
+    extractor.setImageSize({ 160, 90 });
+    QCOMPARE(imageSizeSpy.size(), 1);
+
+    extractor.extractFrames({ 0 });
+
+    QMockMediaFrameExtractor *backend = QMockIntegration::instance()->lastMediaFrameExtractor();
+    QCOMPARE(backend->m_imageSize, QSize(160, 90));
+}
+
+void tst_QMediaFrameExtractor::completedExtraction_reportsFrames_andFinishes()
+{
+    QMediaFrameExtractor extractor;
+    QSignalSpy frameSpy(&extractor, &QMediaFrameExtractor::frameExtracted);
+    QSignalSpy imageSpy(&extractor, &QMediaFrameExtractor::imageExtracted);
+    QSignalSpy finishedSpy(&extractor, &QMediaFrameExtractor::finished);
+
+    extractor.setSource(QUrl::fromLocalFile(QStringLiteral("video.mp4")));
+    extractor.extractFrames({ 1000, 0 });
+    QMockIntegration::instance()->lastMediaFrameExtractor()->completeExtraction();
+
+    QCOMPARE(frameSpy.size(), 2);
+    QCOMPARE(frameSpy[0][0].value<qint64>(), 0);
+    QCOMPARE(frameSpy[1][0].value<qint64>(), 1000);
+    QVERIFY(frameSpy[1][1].value<QVideoFrame>().isValid());
+    QCOMPARE(imageSpy.size(), 0);
+    QCOMPARE(finishedSpy.size(), 1);
+    QVERIFY(!extractor.isActive());
+}
+
+void tst_QMediaFrameExtractor::completedExtraction_reportsImages_whenImageSizeIsValid()
+{
+    QMediaFrameExtractor extractor;
+    QSignalSpy frameSpy(&extractor, &QMediaFrameExtractor::frameExtracted);
+    QSignalSpy imageSpy(&extractor, &QMediaFrameExtractor::imageExtracted);
+
+    extractor.setImageSize({ 32, 18 });
+    extractor.extractFrames({ 500 });
+    QMockIntegration::instance()->lastMediaFrameExtractor()->completeExtraction();
+
+    QCOMPARE(frameSpy.size(), 0);
+    QCOMPARE(imageSpy.size(), 1);
+    QCOMPARE(imageSpy[0][0].value<qint64>(), 500);
+    QCOMPARE(imageSpy[0][1].value<QImage>().size(), QSize(32, 18));
+}
+
+void tst_QMediaFrameExtractor::setSource_cancelsRunningExtraction()
+{
+    QMediaFrameExtractor extractor;
+    QSignalSpy sourceSpy(&extractor, &QMediaFrameExtractor::sourceChanged);
+
+    extractor.setSource(QUrl::fromLocalFile(QStringLiteral("a.mp4")));
+    extractor.extractFrames({ 0 });
+    QVERIFY(extractor.isActive());
+
+    extractor.setSource(QUrl::fromLocalFile(QStringLiteral("b.mp4")));
+
+    QVERIFY(!extractor.isActive());
+    QCOMPARE(sourceSpy.size(), 2);
+}
+
+void tst_QMediaFrameExtractor::backendError_isReported()
+{
+    QMediaFrameExtractor extractor;
+    QSignalSpy errorSpy(&extractor, &QMediaFrameExtractor::errorOccurred);
+
+    extractor.extractFrames({ 0 });
+    QMockIntegration::instance()->lastMediaFrameExtractor()->error(
+            QMediaFrameExtractor::FormatError, QStringLiteral("No video stream"));
+
+    QCOMPARE(errorSpy.size(), 1);
+    QCOMPARE(extractor.error(), QMediaFrameExtractor::FormatError);
+    QCOMPARE(extractor.errorString(), QStringLiteral("No video stream"));
+    QVERIFY(!extractor.isActive());
+
+    // a new extraction clears the error
+    extractor.extractFrames({ 0 });
+    QCOMPARE(extractor.error(), QMediaFrameExtractor::NoError);
+}
+
+void tst_QMediaFrameExtractor::unsupportedBackend_reportsNotSupportedError()
+{
+    QMockIntegration::instance()->setFlags(QMockIntegration::NoMediaFrameExtractorInterface);
+    QMediaFrameExtractor extractor;
+    QSignalSpy finishedSpy(&extractor, &QMediaFrameExtractor::finished);
+
+    QVERIFY(!extractor.isSupported());
+    QCOMPARE(extractor.error(), QMediaFrameExtractor::NotSupportedError);
+    QVERIFY(!extractor.errorString().isEmpty());
+
+    extractor.extractFrames({ 0 });
+    QVERIFY(!extractor.isActive());
+    QCOMPARE(finishedSpy.size(), 0);
+}
+
+QTEST_MAIN(tst_QMediaFrameExtractor)
+
+#include "tst_qmediaframeextractor.moc"
@@ -18,6 +18,7 @@
 #include "qvideosink.h"
 #include "qaudiooutput.h"
 #include <QtMultimedia/qplaybackoptions.h>
+#include <QtMultimedia/qplaybackstatistics.h>
 
 using namespace std::chrono_literals;
 
@@ -105,6 +106,10 @@ private slots:
     void setPlaybackOptions_setsPlaybackOptions();
     void setPlaybackOptions_doesNotEmitChangeSignal_whenOptionsDidNotChange();
     void resetPlaybackOptions_resetsPlaybackOptionsToDefault();
+    void playbackStatistics_returnsZeroValues_whenBackendDoesNotProvideThem();
+    void setNextSource_setsNextSource_andPassesItToBackend();
+    void nextSource_isPlayed_whenMediaEnds_andBackendDoesNotSupportGaplessPlayback();
+    void nextSource_becomesSource_whenBackendStartsNextMedia();
 
 private:
     void setupCommonTestData();
@@ -885,6 +890,21 @@ void tst_QMediaPlayer::playbackOptions_returnsDefaultAfterConstruction()
     QCOMPARE_EQ(player->playbackOptions(), QPlaybackOptions{});
 }
 
+void tst_QMediaPlayer::playbackStatistics_returnsZeroValues_whenBackendDoesNotProvideThem()
+{
+    const QPlaybackStatistics statistics = player->playbackStatistics();
+
+    QCOMPARE_EQ(statistics.decodedVideoFrames(), 0);
+    QCOMPARE_EQ(statistics.presentedVideoFrames(), 0);
+    QCOMPARE_EQ(statistics.droppedVideoFrames(), 0);
+    QCOMPARE_EQ(statistics.averageVideoDecodeTime(), 0us);
+    QCOMPARE_EQ(statistics.audioUnderruns(), 0);
+    QCOMPARE_EQ(statistics.audioVideoSyncOffset(), 0us);
+    QVERIFY(!statistics.hardwareDecoding());
+    QCOMPARE_EQ(statistics.bufferedBytes(QPlaybackStatistics::StreamType::Video), 0);
+    QCOMPARE_EQ(statistics.renderQueueDepth(QPlaybackStatistics::StreamType::Audio), 0);
+}
+
 void tst_QMediaPlayer::setPlaybackOptions_setsPlaybackOptions()
 {
     QSignalSpy spy{ player, &QMediaPlayer::playbackOptionsChanged };
@@ -919,5 +939,66 @@ void tst_QMediaPlayer::resetPlaybackOptions_resetsPlaybackOptionsToDefault()
     QCOMPARE_EQ(player->playbackOptions(), QPlaybackOptions{});
 }
 
+void tst_QMediaPlayer::setNextSource_setsNextSource_andPassesItToBackend()
+{
+    QSignalSpy spy{ player, &QMediaPlayer::nextSourceChanged };
+    const QUrl nextSource(QStringLiteral("file:///next.mp3"));
+
+    player->setSource(QUrl(QStringLiteral("file:///current.mp3")));
+    player->setNextSource(nextSource);
+
+    QCOMPARE_EQ(player->nextSource(), nextSource);
+    QCOMPARE_EQ(mockPlayer->_nextMedia, nextSource);
+    QCOMPARE_EQ(spy.size(), 1);
+    QCOMPARE_EQ(spy.front().front().toUrl(), nextSource);
+
+    player->setNextSource(nextSource);
+    QCOMPARE_EQ(spy.size(), 1);
+}
+
+void tst_QMediaPlayer::nextSource_isPlayed_whenMediaEnds_andBackendDoesNotSupportGaplessPlayback()
+{
+    const QUrl nextSource(QStringLiteral("file:///next.mp3"));
+
+    mockPlayer->setIsValid(true);
+    player->setSource(QUrl(QStringLiteral("file:///current.mp3")));
+    player->setNextSource(nextSource);
+    player->play();
+
+    QSignalSpy sourceSpy{ player, &QMediaPlayer::sourceChanged };
+    QSignalSpy nextSourceSpy{ player, &QMediaPlayer::nextSourceChanged };
+
+    mockPlayer->setState(QMediaPlayer::StoppedState, QMediaPlayer::EndOfMedia);
+
+    QTRY_COMPARE_EQ(player->source(), nextSource);
+    QVERIFY(player->nextSource().isEmpty());
+    QCOMPARE_EQ(mockPlayer->media(), nextSource);
+    QCOMPARE_EQ(player->playbackState(), QMediaPlayer::PlayingState);
+    QCOMPARE_EQ(sourceSpy.size(), 1);
+    QCOMPARE_EQ(nextSourceSpy.size(), 1);
+}
+
+void tst_QMediaPlayer::nextSource_becomesSource_whenBackendStartsNextMedia()
+{
+    const QUrl nextSource(QStringLiteral("file:///next.mp3"));
+
+    mockPlayer->setGaplessPlaybackSupported(true);
+    mockPlayer->setIsValid(true);
+    player->setSource(QUrl(QStringLiteral("file:///current.mp3")));
+    player->setNextSource(nextSource);
+    player->play();
+
+    QSignalSpy sourceSpy{ player, &QMediaPlayer::sourceChanged };
+    QSignalSpy nextSourceSpy{ player, &QMediaPlayer::nextSourceChanged };
+
+    mockPlayer->startNextMedia();
+
+    QCOMPARE_EQ(player->source(), nextSource);
+    QVERIFY(player->nextSource().isEmpty());
+    QCOMPARE_EQ(sourceSpy.size(), 1);
+    QCOMPARE_EQ(nextSourceSpy.size(), 1);
+    QCOMPARE_EQ(player->playbackState(), QMediaPlayer::PlayingState);
+}
+
 QTEST_GUILESS_MAIN(tst_QMediaPlayer)
 #include "tst_qmediaplayer.moc"
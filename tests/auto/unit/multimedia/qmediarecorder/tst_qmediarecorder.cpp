@@ -59,6 +59,11 @@ private slots:
 
     void testVideoSettingsQuality();
     void testVideoSettingsEncodingMode();
+    void testMuxingMode();
+    void testVideoEncoderThreading();
+    void testVideoEncoderLookahead();
+    void testSkipDuplicateVideoFrames();
+    void testAudioQueueSettings();
 
     void testApplicationInative();
 
@@ -685,6 +690,120 @@ void tst_QMediaRecorder::testVideoSettingsEncodingMode()
     QCOMPARE(recorder.encodingMode(), QMediaRecorder::AverageBitRateEncoding);
 }
 
+void tst_QMediaRecorder::testMuxingMode()
+{
+    QMediaRecorder recorder;
+    QSignalSpy spy(&recorder, &QMediaRecorder::muxingModeChanged);
+
+    QCOMPARE(recorder.muxingMode(), QMediaRecorder::DefaultMuxing);
+
+    recorder.setMuxingMode(QMediaRecorder::FragmentedMuxing);
+    QCOMPARE(recorder.muxingMode(), QMediaRecorder::FragmentedMuxing);
+    QCOMPARE(spy.size(), 1);
+
+    recorder.setMuxingMode(QMediaRecorder::FragmentedMuxing);
+    QCOMPARE(spy.size(), 1);
+
+    recorder.setMuxingMode(QMediaRecorder::CmafMuxing);
+    QCOMPARE(recorder.muxingMode(), QMediaRecorder::CmafMuxing);
+    QCOMPARE(spy.size(), 2);
+}
+
+void tst_QMediaRecorder::testVideoEncoderThreading()
+{
+    QMediaRecorder recorder;
+    QSignalSpy threadingSpy(&recorder, &QMediaRecorder::videoEncoderThreadingChanged);
+    QSignalSpy threadCountSpy(&recorder, &QMediaRecorder::videoEncoderThreadCountChanged);
+
+    QCOMPARE(recorder.videoEncoderThreading(), QMediaRecorder::AutomaticThreading);
+    QCOMPARE(recorder.videoEncoderThreadCount(), 0);
+
+    recorder.setVideoEncoderThreading(QMediaRecorder::SliceThreading);
+    QCOMPARE(recorder.videoEncoderThreading(), QMediaRecorder::SliceThreading);
+    QCOMPARE(threadingSpy.size(), 1);
+
+    recorder.setVideoEncoderThreading(QMediaRecorder::SliceThreading);
+    QCOMPARE(threadingSpy.size(), 1);
+
+    recorder.setVideoEncoderThreadCount(8);
+    QCOMPARE(recorder.videoEncoderThreadCount(), 8);
+    QCOMPARE(threadCountSpy.size(), 1);
+
+    // Negative counts mean automatic
+    recorder.setVideoEncoderThreadCount(-3);
+    QCOMPARE(recorder.videoEncoderThreadCount(), 0);
+    QCOMPARE(threadCountSpy.size(), 2);
+}
+
+void tst_QMediaRecorder::testVideoEncoderLookahead()
+{
+    QMediaRecorder recorder;
+    QSignalSpy spy(&recorder, &QMediaRecorder::videoEncoderLookaheadChanged);
+
+    QCOMPARE(recorder.videoEncoderLookahead(), -1);
+
+    recorder.setVideoEncoderLookahead(0);
+    QCOMPARE(recorder.videoEncoderLookahead(), 0);
+    QCOMPARE(spy.size(), 1);
+
+    recorder.setVideoEncoderLookahead(0);
+    QCOMPARE(spy.size(), 1);
+
+    recorder.setVideoEncoderLookahead(-10);
+    QCOMPARE(recorder.videoEncoderLookahead(), -1);
+    QCOMPARE(spy.size(), 2);
+}
+
+void tst_QMediaRecorder::testSkipDuplicateVideoFrames()
+{
+    QMediaRecorder recorder;
+    QSignalSpy spy(&recorder, &QMediaRecorder::skipDuplicateVideoFramesChanged);
+
+    QVERIFY(!recorder.skipDuplicateVideoFrames());
+    QCOMPARE(recorder.skippedVideoFrameCount(), 0);
+
+    recorder.setSkipDuplicateVideoFrames(true);
+    QVERIFY(recorder.skipDuplicateVideoFrames());
+    QCOMPARE(spy.size(), 1);
+
+    recorder.setSkipDuplicateVideoFrames(true);
+    QCOMPARE(spy.size(), 1);
+
+    recorder.setSkipDuplicateVideoFrames(false);
+    QVERIFY(!recorder.skipDuplicateVideoFrames());
+    QCOMPARE(spy.size(), 2);
+}
+
+void tst_QMediaRecorder::testAudioQueueSettings()
+{
+    QMediaRecorder recorder;
+    QSignalSpy durationSpy(&recorder, &QMediaRecorder::maxAudioQueueDurationChanged);
+    QSignalSpy policySpy(&recorder, &QMediaRecorder::audioOverflowPolicyChanged);
+
+    QCOMPARE(recorder.maxAudioQueueDuration(), -1);
+    QCOMPARE(recorder.audioOverflowPolicy(), QMediaRecorder::BlockOnAudioOverflow);
+    QCOMPARE(recorder.droppedAudioDuration(), 0);
+
+    recorder.setMaxAudioQueueDuration(200);
+    QCOMPARE(recorder.maxAudioQueueDuration(), 200);
+    QCOMPARE(durationSpy.size(), 1);
+
+    recorder.setMaxAudioQueueDuration(200);
+    QCOMPARE(durationSpy.size(), 1);
+
+    // Non-positive durations select the default
+    recorder.setMaxAudioQueueDuration(0);
+    QCOMPARE(recorder.maxAudioQueueDuration(), -1);
+    QCOMPARE(durationSpy.size(), 2);
+
+    recorder.setAudioOverflowPolicy(QMediaRecorder::DropOnAudioOverflow);
+    QCOMPARE(recorder.audioOverflowPolicy(), QMediaRecorder::DropOnAudioOverflow);
+    QCOMPARE(policySpy.size(), 1);
+
+    recorder.setAudioOverflowPolicy(QMediaRecorder::DropOnAudioOverflow);
+    QCOMPARE(policySpy.size(), 1);
+}
+
 void tst_QMediaRecorder::testApplicationInative()
 {
     QMediaCaptureSession session;
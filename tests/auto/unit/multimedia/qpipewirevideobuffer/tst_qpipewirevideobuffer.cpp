@@ -0,0 +1,213 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qthread.h>
+
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/private/qpipewire_videobuffer_p.h>
+#include <QtMultimedia/private/qvideoframe_p.h>
+
+#include <array>
+#include <memory>
+
+QT_USE_NAMESPACE
+
+using namespace QtPipeWire;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int maxLentBuffers = 2;
+constexpr int bufferCount = 6;
+constexpr QSize frameSize(4, 2);
+constexpr int bytesPerLine = frameSize.width() * 4;
+constexpr int frameBytes = bytesPerLine * frameSize.height();
+
+} // namespace
+
+class tst_QPipeWireVideoBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void map_returnsStreamBufferMemory_whenMappedReadOnly();
+    void releasingFrame_returnsStreamBuffer();
+    void canLend_returnsFalse_whenMaxLentBuffersReached();
+    void canLend_leavesTwoBuffersToProducer();
+    void removeBuffer_copiesData_whenBufferIsLent();
+    void invalidate_copiesDataOfAllLentBuffers();
+    void invalidate_waitsForUnmap_withoutBlockingOtherFrames();
+    void map_returnsCopyAndReturnsStreamBuffer_whenMappedForWriting();
+
+private:
+    QVideoFrame lendFrame(int index);
+
+    std::shared_ptr<QPipeWireBufferPool> m_pool;
+    std::array<pw_buffer, bufferCount> m_buffers{};
+    std::array<std::array<uchar, frameBytes>, bufferCount> m_data{};
+};
+
+void tst_QPipeWireVideoBuffer::init()
+{
+    m_pool = std::make_shared<QPipeWireBufferPool>(maxLentBuffers);
+    for (size_t i = 0; i < m_buffers.size(); ++i) {
+        m_data[i].fill(uchar(i + 1));
+        m_pool->addBuffer(&m_buffers[i]);
+    }
+}
+
+QVideoFrame tst_QPipeWireVideoBuffer::lendFrame(int index)
+{
+    return QVideoFramePrivate::createFrame(
+            m_pool->lend(&m_buffers[index], m_data[index].data(), frameBytes, bytesPerLine),
+            QVideoFrameFormat(frameSize, QVideoFrameFormat::Format_BGRX8888));
+}
+
+void tst_QPipeWireVideoBuffer::map_returnsStreamBufferMemory_whenMappedReadOnly()
+{
+    QVideoFrame frame = lendFrame(0);
+
+    QVERIFY(frame.map(QVideoFrame::ReadOnly));
+    QCOMPARE_EQ(frame.bits(0), m_data[0].data());
+    QCOMPARE_EQ(frame.bytesPerLine(0), bytesPerLine);
+    QCOMPARE_EQ(frame.mappedBytes(0), frameBytes);
+    frame.unmap();
+}
+
+void tst_QPipeWireVideoBuffer::releasingFrame_returnsStreamBuffer()
+{
+    QVideoFrame frame = lendFrame(0);
+    QVERIFY(m_pool->takeReturnedBuffers().empty());
+
+    frame = {};
+
+    const std::vector<pw_buffer *> returned = m_pool->takeReturnedBuffers();
+    QCOMPARE_EQ(returned.size(), 1u);
+    QCOMPARE_EQ(returned.front(), &m_buffers[0]);
+    QVERIFY(m_pool->takeReturnedBuffers().empty());
+}
+
+void tst_QPipeWireVideoBuffer::canLend_returnsFalse_whenMaxLentBuffersReached()
+{
+    QVideoFrame frame0 = lendFrame(0);
+    QVERIFY(m_pool->canLend());
+    QVideoFrame frame1 = lendFrame(1);
+    QVERIFY(!m_pool->canLend());
+
+    // Returned buffers count as lent until they are queued to the stream
+    frame0 = {};
+    QVERIFY(!m_pool->canLend());
+
+    m_pool->takeReturnedBuffers();
+    QVERIFY(m_pool->canLend());
+}
+
+void tst_QPipeWireVideoBuffer::canLend_leavesTwoBuffersToProducer()
+{
+    for (int i = 0; i < bufferCount - 3; ++i)
+        m_pool->removeBuffer(&m_buffers[i]);
+
+    // 3 buffers left
+    QVideoFrame frame = lendFrame(bufferCount - 1);
+    QVERIFY(!m_pool->canLend());
+}
+
+void tst_QPipeWireVideoBuffer::removeBuffer_copiesData_whenBufferIsLent()
+{
+    QVideoFrame frame = lendFrame(0);
+
+    m_pool->removeBuffer(&m_buffers[0]);
+    m_data[0].fill(0);
+
+    QVERIFY(frame.map(QVideoFrame::ReadOnly));
+    QCOMPARE_NE(frame.bits(0), m_data[0].data());
+    QCOMPARE_EQ(frame.bits(0)[0], 1);
+    QCOMPARE_EQ(frame.bits(0)[frameBytes - 1], 1);
+    frame.unmap();
+
+    // The stream doesn't know the buffer anymore
+    frame = {};
+    QVERIFY(m_pool->takeReturnedBuffers().empty());
+}
+
+void tst_QPipeWireVideoBuffer::invalidate_copiesDataOfAllLentBuffers()
+{
+    QVideoFrame frame0 = lendFrame(0);
+    QVideoFrame frame1 = lendFrame(1);
+
+    m_pool->invalidate();
+    m_data[0].fill(0);
+    m_data[1].fill(0);
+
+    QVERIFY(frame0.map(QVideoFrame::ReadOnly));
+    QCOMPARE_EQ(frame0.bits(0)[0], 1);
+    frame0.unmap();
+
+    QVERIFY(frame1.map(QVideoFrame::ReadOnly));
+    QCOMPARE_EQ(frame1.bits(0)[0], 2);
+    frame1.unmap();
+
+    frame0 = {};
+    frame1 = {};
+    QVERIFY(m_pool->takeReturnedBuffers().empty());
+}
+
+void tst_QPipeWireVideoBuffer::invalidate_waitsForUnmap_withoutBlockingOtherFrames()
+{
+    QVideoFrame otherFrame = lendFrame(0);
+    QVideoFrame mappedFrame = lendFrame(1); // invalidate() copies the last lent buffer first
+
+    QVERIFY(mappedFrame.map(QVideoFrame::ReadOnly));
+    QCOMPARE_EQ(mappedFrame.bits(0), m_data[1].data());
+
+    std::unique_ptr<QThread> invalidateThread(QThread::create([this] { m_pool->invalidate(); }));
+    invalidateThread->start();
+
+    // The stream memory is still in use, so invalidate() can't copy it yet
+    QVERIFY(!invalidateThread->wait(100ms));
+
+    // Other frames can be mapped and released meanwhile; this used to deadlock
+    // on the pool mutex held by invalidate()
+    QVERIFY(otherFrame.map(QVideoFrame::ReadOnly));
+    QCOMPARE_EQ(otherFrame.bits(0)[0], 1);
+    otherFrame.unmap();
+    otherFrame = {};
+    QVERIFY(!invalidateThread->isFinished());
+
+    mappedFrame.unmap();
+    QVERIFY(invalidateThread->wait(5s));
+
+    m_data[1].fill(0);
+    QVERIFY(mappedFrame.map(QVideoFrame::ReadOnly));
+    QCOMPARE_NE(mappedFrame.bits(0), m_data[1].data());
+    QCOMPARE_EQ(mappedFrame.bits(0)[0], 2);
+    mappedFrame.unmap();
+
+    // Buffers of the invalidated stream are never queued back
+    mappedFrame = {};
+    QVERIFY(m_pool->takeReturnedBuffers().empty());
+}
+
+void tst_QPipeWireVideoBuffer::map_returnsCopyAndReturnsStreamBuffer_whenMappedForWriting()
+{
+    QVideoFrame frame = lendFrame(0);
+
+    QVERIFY(frame.map(QVideoFrame::ReadWrite));
+    QCOMPARE_NE(frame.bits(0), m_data[0].data());
+    QCOMPARE_EQ(frame.bits(0)[0], 1);
+    frame.bits(0)[0] = 42;
+    frame.unmap();
+
+    QCOMPARE_EQ(m_data[0][0], 1);
+
+    const std::vector<pw_buffer *> returned = m_pool->takeReturnedBuffers();
+    QCOMPARE_EQ(returned.size(), 1u);
+    QCOMPARE_EQ(returned.front(), &m_buffers[0]);
+}
+
+QTEST_GUILESS_MAIN(tst_QPipeWireVideoBuffer)
+
+#include "tst_qpipewirevideobuffer.moc"
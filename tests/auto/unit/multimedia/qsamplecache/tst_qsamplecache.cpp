@@ -25,6 +25,15 @@ private slots:
     void testIncompatibleFile_data() { generateTestData(); }
     void testIncompatibleFile();
 
+    void requestSample_retainsUnreferencedSample_whenRetentionBudgetAllows();
+    void requestSample_evictsLeastRecentlyUsedSample_whenRetentionBudgetIsExceeded();
+    void setRetentionBudget_evictsSamples_whenBudgetIsLowered();
+    void pin_keepsUnreferencedSample_whenRetentionBudgetIsZero();
+    void unpin_releasesSample_whenRetentionBudgetIsZero();
+    void statistics_countsHitsMissesAndEvictions();
+
+    void requestSample_keepsInt16Data_whenFileIsInt16();
+
 private:
     void generateTestData()
     {
@@ -49,6 +58,9 @@ private:
         loop.exec(QEventLoop::EventLoopExec);
         return future.result();
     }
+
+    const QUrl m_testUrl = QUrl::fromLocalFile(QFINDTESTDATA("testdata/test.wav"));
+    const QUrl m_testUrl2 = QUrl::fromLocalFile(QFINDTESTDATA("testdata/test2.wav"));
 };
 
 void tst_QSampleCache::testCachedSample()
@@ -109,6 +121,118 @@ void tst_QSampleCache::testIncompatibleFile()
     QVERIFY(!sample);
 }
 
+void tst_QSampleCache::requestSample_retainsUnreferencedSample_whenRetentionBudgetAllows()
+{
+    QSampleCache cache(nullptr, 1024 * 1024 * 1024);
+
+    SharedSamplePtr sample = requestSample(cache, m_testUrl);
+    QVERIFY(sample);
+    const QSample *samplePointer = sample.get();
+    const qsizetype sampleSize = sample->data().size();
+    sample = {};
+
+    QVERIFY(cache.isCached(m_testUrl));
+    QCOMPARE_EQ(cache.retainedBytes(), sampleSize);
+    QCOMPARE_EQ(requestSample(cache, m_testUrl).get(), samplePointer);
+}
+
+void tst_QSampleCache::requestSample_evictsLeastRecentlyUsedSample_whenRetentionBudgetIsExceeded()
+{
+    QSampleCache cache(nullptr, 1024 * 1024 * 1024);
+
+    const qsizetype size = requestSample(cache, m_testUrl)->data().size();
+    const qsizetype size2 = requestSample(cache, m_testUrl2)->data().size();
+    QCOMPARE_EQ(cache.retainedBytes(), size + size2);
+
+    // make test.wav the most recently used sample
+    QVERIFY(requestSample(cache, m_testUrl));
+
+    cache.setRetentionBudget(size + size2 - 1);
+
+    QVERIFY(cache.isCached(m_testUrl));
+    QVERIFY(!cache.isCached(m_testUrl2));
+    QCOMPARE_EQ(cache.retainedBytes(), size);
+}
+
+void tst_QSampleCache::setRetentionBudget_evictsSamples_whenBudgetIsLowered()
+{
+    QSampleCache cache(nullptr, 1024 * 1024 * 1024);
+
+    QVERIFY(requestSample(cache, m_testUrl));
+    QVERIFY(requestSample(cache, m_testUrl2));
+
+    cache.setRetentionBudget(0);
+
+    QVERIFY(!cache.isCached(m_testUrl));
+    QVERIFY(!cache.isCached(m_testUrl2));
+    QCOMPARE_EQ(cache.retainedBytes(), 0);
+}
+
+void tst_QSampleCache::pin_keepsUnreferencedSample_whenRetentionBudgetIsZero()
+{
+    QSampleCache cache;
+
+    cache.pin(m_testUrl);
+    QVERIFY(cache.isPinned(m_testUrl));
+    QVERIFY(requestSample(cache, m_testUrl));
+
+    QVERIFY(cache.isCached(m_testUrl));
+    QCOMPARE_EQ(cache.retainedBytes(), 0);
+}
+
+void tst_QSampleCache::unpin_releasesSample_whenRetentionBudgetIsZero()
+{
+    QSampleCache cache;
+
+    SharedSamplePtr sample = requestSample(cache, m_testUrl);
+    cache.pin(m_testUrl);
+    sample = {};
+    QVERIFY(cache.isCached(m_testUrl));
+
+    cache.unpin(m_testUrl);
+
+    QVERIFY(!cache.isPinned(m_testUrl));
+    QVERIFY(!cache.isCached(m_testUrl));
+}
+
+void tst_QSampleCache::statistics_countsHitsMissesAndEvictions()
+{
+    QSampleCache cache(nullptr, 1024 * 1024 * 1024);
+
+    QVERIFY(requestSample(cache, m_testUrl));
+    QVERIFY(requestSample(cache, m_testUrl));
+    QVERIFY(requestSample(cache, m_testUrl2));
+    cache.setRetentionBudget(0);
+
+    const QSampleCache::Statistics statistics = cache.statistics();
+    QCOMPARE_EQ(statistics.hits, 1u);
+    QCOMPARE_EQ(statistics.misses, 2u);
+    QCOMPARE_EQ(statistics.evictions, 2u);
+}
+
+void tst_QSampleCache::requestSample_keepsInt16Data_whenFileIsInt16()
+{
+    QSampleCache cache;
+
+    // test.wav: pcm_s16le, 44100 Hz, mono, 44094 frames
+    SharedSamplePtr sample = requestSample(cache, m_testUrl);
+    QVERIFY(sample);
+
+    QCOMPARE_EQ(sample->encoding(), QSample::Encoding::Int16);
+    QCOMPARE_EQ(sample->data().size(), 44094 * qsizetype(sizeof(qint16)));
+    QCOMPARE_EQ(sample->frameCount(), 44094);
+    QCOMPARE_EQ(sample->format().sampleFormat(), QAudioFormat::Float);
+    QCOMPARE_EQ(sample->dataFormat()->sampleFormat(), QAudioFormat::Int16);
+
+    const QByteArray floats = sample->toFloat();
+    QCOMPARE_EQ(floats.size(), 44094 * qsizetype(sizeof(float)));
+
+    const qint16 *int16Samples = reinterpret_cast<const qint16 *>(sample->data().constData());
+    const float *floatSamples = reinterpret_cast<const float *>(floats.constData());
+    for (qsizetype i = 0; i < sample->frameCount(); ++i)
+        QCOMPARE_EQ(floatSamples[i], int16Samples[i] / 32768.f);
+}
+
 QTEST_GUILESS_MAIN(tst_QSampleCache)
 
 #include "tst_qsamplecache.moc"
@@ -14,6 +14,9 @@
 #include <QtCore/qset.h>
 #include <QtMultimedia/private/qtmultimedia-config_p.h>
 #include "private/qvideoframeconverter_p.h"
+#include "private/qvideoframeconversionhelper_p.h"
+#include "private/qvideotransformation_p.h"
+#include <QtGui/qpainter.h>
 #include <private/mediabackendutils_p.h>
 
 // Adds an enum, and the stringized version
@@ -202,6 +205,11 @@ private slots:
     void qImageFromVideoFrame_goodJPEGWithExtraData();
     void qImageFromVideoFrame_badJPEG();
 
+    void qScaledImageFromVideoFrame_samplesFullConversion_data();
+    void qScaledImageFromVideoFrame_samplesFullConversion();
+    void qScaledImageFromVideoFrame_appliesTransformation();
+    void paint_convertsStraightToTargetSize_whenScaledDown();
+
     void isMapped();
     void isReadable();
     void isWritable();
@@ -1070,6 +1078,116 @@ void tst_QVideoFrame::qImageFromVideoFrame_doesNotCrash_whenCalledWithEvenAndOdd
     QCOMPARE_EQ(actual.isNull(), size.isEmpty());
 }
 
+void tst_QVideoFrame::qScaledImageFromVideoFrame_samplesFullConversion_data()
+{
+    QTest::addColumn<QVideoFrameFormat::PixelFormat>("pixelFormat");
+    QTest::addColumn<QSize>("targetSize");
+
+    for (int i = QVideoFrameFormat::Format_Invalid + 1; i < QVideoFrameFormat::NPixelFormats;
+         ++i) {
+        const auto pixelFormat = QVideoFrameFormat::PixelFormat(i);
+        if (!qScaledConverterForFormat(pixelFormat))
+            continue;
+
+        for (QSize targetSize : { QSize(32, 18), QSize(21, 13), QSize(64, 36) }) {
+            QTest::addRow("%s, %dx%d",
+                          qPrintable(QVideoFrameFormat::pixelFormatToString(pixelFormat)),
+                          targetSize.width(), targetSize.height())
+                    << pixelFormat << targetSize;
+        }
+    }
+}
+
+void tst_QVideoFrame::qScaledImageFromVideoFrame_samplesFullConversion()
+{
+    QFETCH(const QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(const QSize, targetSize);
+
+    const QSize frameSize(64, 36);
+    QVideoFrame frame(QVideoFrameFormat(frameSize, pixelFormat));
+    QVERIFY(frame.map(QVideoFrame::WriteOnly));
+    for (int plane = 0; plane < frame.planeCount(); ++plane) {
+        uchar *bits = frame.bits(plane);
+        for (int i = 0; i < frame.mappedBytes(plane); ++i)
+            bits[i] = uchar(i * 7 + plane * 64);
+    }
+
+    // The SIMD converters of the RGB formats don't premultiply, keep the pixels opaque
+    if (const uint32_t alphaMask = qAlphaMask(pixelFormat)) {
+        auto *pixels = reinterpret_cast<uint32_t *>(frame.bits(0));
+        for (int i = 0; i < frame.mappedBytes(0) / 4; ++i)
+            pixels[i] |= alphaMask;
+    }
+    frame.unmap();
+
+    const QImage expected = qImageFromVideoFrame(frame, VideoTransformation{}, true);
+    const QImage actual = qScaledImageFromVideoFrame(frame, VideoTransformation{}, targetSize);
+
+    QCOMPARE_EQ(actual.size(), targetSize);
+    QCOMPARE_EQ(actual.format(), expected.format());
+
+    // Nearest neighbour sampling of the pixel centers
+    for (int y = 0; y < targetSize.height(); ++y) {
+        const int sourceY = (2 * y + 1) * frameSize.height() / (2 * targetSize.height());
+        for (int x = 0; x < targetSize.width(); ++x) {
+            const int sourceX = (2 * x + 1) * frameSize.width() / (2 * targetSize.width());
+            QCOMPARE_EQ(actual.pixel(x, y), expected.pixel(sourceX, sourceY));
+        }
+    }
+}
+
+void tst_QVideoFrame::qScaledImageFromVideoFrame_appliesTransformation()
+{
+    QImage image(64, 32, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    for (int y = 0; y < image.height(); ++y)
+        for (int x = image.width() / 2; x < image.width(); ++x)
+            image.setPixelColor(x, y, Qt::blue);
+
+    const QVideoFrame frame(image);
+
+    VideoTransformation transformation;
+    transformation.rotate(QtVideo::Rotation::Clockwise90);
+
+    // The size is the one after the rotation
+    const QImage actual = qScaledImageFromVideoFrame(frame, transformation, { 8, 16 });
+    QCOMPARE_EQ(actual.size(), QSize(8, 16));
+    QCOMPARE_EQ(actual.pixelColor(4, 2), QColor(Qt::red));
+    QCOMPARE_EQ(actual.pixelColor(4, 13), QColor(Qt::blue));
+}
+
+void tst_QVideoFrame::paint_convertsStraightToTargetSize_whenScaledDown()
+{
+    QImage image(640, 360, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    for (int y = 0; y < image.height(); ++y)
+        for (int x = image.width() / 2; x < image.width(); ++x)
+            image.setPixelColor(x, y, Qt::blue);
+
+    QVideoFrame frame(image);
+
+    QImage target(160, 90, QImage::Format_RGB32);
+    target.fill(Qt::black);
+    {
+        QPainter painter(&target);
+        frame.paint(&painter, target.rect(), {});
+    }
+
+    QCOMPARE_EQ(target.pixelColor(10, 45), QColor(Qt::red));
+    QCOMPARE_EQ(target.pixelColor(150, 45), QColor(Qt::blue));
+
+    // The scaled image is cached in the frame
+    const QImage &paintImage = QVideoFramePrivate::handle(frame)->paintImage;
+    QCOMPARE_EQ(paintImage.size(), target.size());
+    const qint64 cacheKey = paintImage.cacheKey();
+
+    {
+        QPainter painter(&target);
+        frame.paint(&painter, target.rect(), {});
+    }
+    QCOMPARE_EQ(QVideoFramePrivate::handle(frame)->paintImage.cacheKey(), cacheKey);
+}
+
 void tst_QVideoFrame::qImageFromVideoFrame_emptyJPEG()
 {
     QByteArray byteArray;
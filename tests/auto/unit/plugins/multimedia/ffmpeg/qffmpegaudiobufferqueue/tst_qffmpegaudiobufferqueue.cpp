@@ -0,0 +1,238 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qthread.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegaudiobufferqueue_p.h>
+
+#include <atomic>
+#include <memory>
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 10 ms of mono 48 kHz audio by default
+QAudioBuffer makeBuffer(qint64 durationUs = 10'000)
+{
+    QAudioFormat format;
+    format.setSampleRate(48000);
+    format.setChannelCount(1);
+    format.setSampleFormat(QAudioFormat::Int16);
+    return QAudioBuffer(QByteArray(format.bytesForDuration(durationUs), 0), format);
+}
+
+// Consumes the queue like an encoder that processes one buffer per interval
+class ThrottledConsumer
+{
+public:
+    ThrottledConsumer(AudioBufferQueue &queue, std::chrono::milliseconds interval)
+    {
+        m_thread.reset(QThread::create([&queue, interval, this] {
+            while (!m_stop) {
+                if (auto entry = queue.pop()) {
+                    ++m_poppedCount;
+                    m_gaps += entry->gapBefore.count();
+                }
+                QThread::sleep(interval);
+            }
+        }));
+        m_thread->start();
+    }
+
+    ~ThrottledConsumer() { stop(); }
+
+    void stop()
+    {
+        m_stop = true;
+        m_thread->wait();
+    }
+
+    int poppedCount() const { return m_poppedCount; }
+    std::chrono::microseconds gaps() const { return std::chrono::microseconds(m_gaps); }
+
+private:
+    std::unique_ptr<QThread> m_thread;
+    std::atomic_bool m_stop = false;
+    std::atomic_int m_poppedCount = 0;
+    std::atomic<std::chrono::microseconds::rep> m_gaps = 0;
+};
+
+} // namespace
+
+class tst_qffmpegaudiobufferqueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void push_accountsDuration_andPeak()
+    {
+        AudioBufferQueue queue(50ms, AudioQueueOverflowPolicy::DropAndMarkGap);
+
+        QCOMPARE_EQ(queue.push(makeBuffer(), false), AudioBufferQueue::PushResult::Pushed);
+        QCOMPARE_EQ(queue.push(makeBuffer(), false), AudioBufferQueue::PushResult::Pushed);
+        QCOMPARE_EQ(queue.size(), 2u);
+        QCOMPARE_EQ(queue.duration(), 20ms);
+
+        QVERIFY(queue.pop());
+        QCOMPARE_EQ(queue.duration(), 10ms);
+
+        const AudioQueueStatistics statistics = queue.statistics();
+        QCOMPARE_EQ(statistics.bufferCount, 1u);
+        QCOMPARE_EQ(statistics.duration, 10ms);
+        QCOMPARE_EQ(statistics.peakDuration, 20ms);
+        QCOMPARE_EQ(statistics.droppedBufferCount, 0u);
+    }
+
+    void push_drops_andMarksGap_whenQueueIsFull()
+    {
+        AudioBufferQueue queue(30ms, AudioQueueOverflowPolicy::DropAndMarkGap);
+
+        for (int i = 0; i < 3; ++i)
+            QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Pushed);
+        QVERIFY(queue.isFull());
+
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Dropped);
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Dropped);
+        QCOMPARE_EQ(queue.duration(), 30ms);
+
+        for (int i = 0; i < 3; ++i)
+            QCOMPARE_EQ(queue.pop()->gapBefore, 0us);
+
+        // The next pushed buffer carries the duration of the dropped ones
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Pushed);
+        QCOMPARE_EQ(queue.pop()->gapBefore, 20ms);
+
+        const AudioQueueStatistics statistics = queue.statistics();
+        QCOMPARE_EQ(statistics.droppedBufferCount, 2u);
+        QCOMPARE_EQ(statistics.droppedDuration, 20ms);
+        QCOMPARE_EQ(statistics.blockedPushCount, 0u);
+    }
+
+    void push_reportsOverflow_whenPolicyIsError()
+    {
+        AudioBufferQueue queue(10ms, AudioQueueOverflowPolicy::Error);
+
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Pushed);
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Overflow);
+        QCOMPARE_EQ(queue.statistics().droppedBufferCount, 1u);
+    }
+
+    void push_doesNotBlock_whenBlockingIsNotAllowed()
+    {
+        AudioBufferQueue queue(10ms, AudioQueueOverflowPolicy::Block);
+
+        QCOMPARE_EQ(queue.push(makeBuffer(), false), AudioBufferQueue::PushResult::Pushed);
+        QCOMPARE_EQ(queue.push(makeBuffer(), false), AudioBufferQueue::PushResult::Dropped);
+        QCOMPARE_EQ(queue.statistics().blockedPushCount, 0u);
+    }
+
+    void push_blocks_whenBufferCountReachesCapacity()
+    {
+        AudioBufferQueue queue(10s, AudioQueueOverflowPolicy::Block);
+
+        // Small buffers fill up the queue long before the max duration is reached
+        int pushedCount = 0;
+        while (!queue.isFull()) {
+            QCOMPARE_EQ(queue.push(makeBuffer(1'000), true), AudioBufferQueue::PushResult::Pushed);
+            ++pushedCount;
+        }
+        QCOMPARE_LT(queue.duration(), 10s);
+
+        std::unique_ptr<QThread> consumer(QThread::create([&queue] {
+            QThread::sleep(20ms);
+            queue.pop();
+        }));
+        consumer->start();
+
+        QCOMPARE_EQ(queue.push(makeBuffer(1'000), true), AudioBufferQueue::PushResult::Pushed);
+        QVERIFY(consumer->wait());
+
+        const AudioQueueStatistics statistics = queue.statistics();
+        QCOMPARE_EQ(statistics.bufferCount, size_t(pushedCount));
+        QCOMPARE_EQ(statistics.blockedPushCount, 1u);
+        QCOMPARE_EQ(statistics.droppedBufferCount, 0u);
+    }
+
+    void push_dropsAfterTimeout_whenBlockedConsumerDoesNotCatchUp()
+    {
+        AudioBufferQueue queue(10ms, AudioQueueOverflowPolicy::Block);
+
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Pushed);
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Dropped);
+
+        const AudioQueueStatistics statistics = queue.statistics();
+        QCOMPARE_EQ(statistics.blockedPushCount, 1u);
+        QCOMPARE_GE(statistics.blockedTime, 9ms);
+        QCOMPARE_EQ(statistics.droppedBufferCount, 1u);
+    }
+
+    void push_dropsAfterMaxWaitTime_whenItIsShorterThanMaxDuration()
+    {
+        AudioBufferQueue queue(10ms, AudioQueueOverflowPolicy::Block, 0ms);
+        QCOMPARE_EQ(queue.maxWaitTime(), 0ms);
+
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Pushed);
+        QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Dropped);
+
+        const AudioQueueStatistics statistics = queue.statistics();
+        QCOMPARE_EQ(statistics.blockedPushCount, 1u);
+        QCOMPARE_LT(statistics.blockedTime, 9ms);
+        QCOMPARE_EQ(statistics.droppedBufferCount, 1u);
+    }
+
+    void blockPolicy_throttlesProducer_toThrottledConsumer()
+    {
+        AudioBufferQueue queue(40ms, AudioQueueOverflowPolicy::Block);
+        ThrottledConsumer consumer(queue, 5ms);
+
+        constexpr int buffersCount = 50;
+        for (int i = 0; i < buffersCount; ++i)
+            QCOMPARE_EQ(queue.push(makeBuffer(), true), AudioBufferQueue::PushResult::Pushed);
+
+        QTRY_COMPARE_EQ(consumer.poppedCount(), buffersCount);
+        consumer.stop();
+
+        const AudioQueueStatistics statistics = queue.statistics();
+        QCOMPARE_LE(statistics.peakDuration, 50ms);
+        QCOMPARE_GT(statistics.blockedPushCount, 0u);
+        QCOMPARE_EQ(statistics.droppedBufferCount, 0u);
+        QCOMPARE_EQ(consumer.gaps(), 0us);
+    }
+
+    void dropPolicy_boundsQueue_andPreservesTimeline_withThrottledConsumer()
+    {
+        AudioBufferQueue queue(40ms, AudioQueueOverflowPolicy::DropAndMarkGap);
+        ThrottledConsumer consumer(queue, 5ms);
+
+        // Produce much faster than the consumer processes
+        constexpr int buffersCount = 100;
+        for (int i = 0; i < buffersCount; ++i) {
+            queue.push(makeBuffer(), true);
+            QCOMPARE_LE(queue.duration(), 50ms);
+        }
+        // Delivers the gap of the last dropped buffers, if any
+        QTRY_VERIFY(!queue.isFull());
+        queue.push(makeBuffer(), true);
+
+        QTRY_VERIFY(queue.empty());
+        consumer.stop();
+
+        const AudioQueueStatistics statistics = queue.statistics();
+        QCOMPARE_GT(statistics.droppedBufferCount, 0u);
+        QCOMPARE_LE(statistics.peakDuration, 50ms);
+
+        // Every produced buffer is either consumed or reported as a gap
+        QCOMPARE_EQ(consumer.gaps(), statistics.droppedDuration);
+        QCOMPARE_EQ(consumer.poppedCount() + int(statistics.droppedBufferCount),
+                    buffersCount + 1);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_qffmpegaudiobufferqueue)
+
+#include "tst_qffmpegaudiobufferqueue.moc"
@@ -0,0 +1,233 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qset.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegaudiochunker_p.h>
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+
+namespace {
+
+QAudioFormat makeFormat(int sampleRate, int channelCount)
+{
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channelCount);
+    format.setSampleFormat(QAudioFormat::Int32);
+    return format;
+}
+
+// Consecutive samples, so that any lost, repeated or reordered sample is detected
+QByteArray makeRamp(qint32 firstSample, qsizetype sampleCount)
+{
+    QByteArray data(sampleCount * qsizetype(sizeof(qint32)), Qt::Uninitialized);
+    auto *samples = reinterpret_cast<qint32 *>(data.data());
+    for (qsizetype i = 0; i < sampleCount; ++i)
+        samples[i] = firstSample + qint32(i);
+    return data;
+}
+
+struct Collector
+{
+    void operator()(const QAudioBuffer &buffer) { buffers.append(buffer); }
+
+    QList<QAudioBuffer> buffers;
+};
+
+// Writes data in pieces of random size, like a platform audio stream does
+void writeInPieces(AudioChunker &chunker, const QByteArray &data, Collector &collector,
+                   QRandomGenerator &random)
+{
+    qsizetype offset = 0;
+    while (offset < data.size()) {
+        const qsizetype piece = qMin(data.size() - offset, qsizetype(random.bounded(1, 3000)));
+        chunker.write(data.constData() + offset, piece, collector);
+        offset += piece;
+    }
+}
+
+// Checks that the buffers hold the samples from firstSample on without gaps, and that
+// their start times match the number of frames before them
+void verifyContinuity(const QList<QAudioBuffer> &buffers, qint32 firstSample = 0,
+                      qint64 startTime = 0)
+{
+    qint32 expectedSample = firstSample;
+    qint64 frames = 0;
+    QAudioFormat format;
+    for (const QAudioBuffer &buffer : buffers) {
+        if (buffer.format() != format) {
+            if (format.isValid())
+                startTime += format.durationForFrames(frames);
+            format = buffer.format();
+            frames = 0;
+        }
+
+        QCOMPARE_EQ(buffer.startTime(), startTime + format.durationForFrames(frames));
+
+        const qint32 *samples = buffer.constData<qint32>();
+        for (qsizetype i = 0; i < buffer.sampleCount(); ++i)
+            QCOMPARE_EQ(samples[i], expectedSample++);
+
+        frames += buffer.frameCount();
+    }
+}
+
+} // namespace
+
+class tst_qffmpegaudiochunker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void write_emitsChunksOfRequestedSize_withContinuousSamples_data()
+    {
+        QTest::addColumn<int>("sampleRate");
+        QTest::addColumn<int>("channelCount");
+        QTest::addColumn<int>("chunkFrames");
+
+        QTest::addRow("48 kHz stereo, 1024 frames") << 48000 << 2 << 1024;
+        QTest::addRow("96 kHz 6 channels, 1152 frames") << 96000 << 6 << 1152;
+        QTest::addRow("44.1 kHz mono, 960 frames") << 44100 << 1 << 960;
+    }
+    void write_emitsChunksOfRequestedSize_withContinuousSamples()
+    {
+        QFETCH(int, sampleRate);
+        QFETCH(int, channelCount);
+        QFETCH(int, chunkFrames);
+
+        const QAudioFormat format = makeFormat(sampleRate, channelCount);
+        AudioChunker chunker;
+        chunker.setFormat(format);
+        chunker.setChunkFrames(chunkFrames);
+
+        // 100 chunks and a partial one
+        const qsizetype frameCount = 100 * qsizetype(chunkFrames) + chunkFrames / 2;
+        QRandomGenerator random(42);
+        Collector collector;
+        writeInPieces(chunker, makeRamp(0, frameCount * channelCount), collector, random);
+
+        QCOMPARE_EQ(collector.buffers.size(), 100);
+        for (const QAudioBuffer &buffer : std::as_const(collector.buffers)) {
+            QCOMPARE_EQ(buffer.format(), format);
+            QCOMPARE_EQ(buffer.frameCount(), chunkFrames);
+        }
+        verifyContinuity(collector.buffers);
+    }
+
+    void write_keepsContinuity_whenChunkSizeChanges()
+    {
+        const QAudioFormat format = makeFormat(48000, 2);
+        AudioChunker chunker;
+        chunker.setFormat(format);
+        chunker.setChunkFrames(1024);
+
+        QRandomGenerator random(42);
+        Collector collector;
+        qint32 nextSample = 0;
+        auto writeFrames = [&](qsizetype frames) {
+            writeInPieces(chunker, makeRamp(nextSample, frames * 2), collector, random);
+            nextSample += qint32(frames * 2);
+        };
+
+        writeFrames(1024 * 3 + 700);
+
+        QCOMPARE_EQ(collector.buffers.size(), 3);
+
+        // Smaller than the pending partial chunk of 700 frames: it's cut at the new size,
+        // and the rest is carried over
+        chunker.setChunkFrames(256);
+        writeFrames(1380);
+        QCOMPARE_EQ(collector.buffers.size(), 3 + (700 + 1380) / 256);
+        for (qsizetype i = 3; i < collector.buffers.size(); ++i)
+            QCOMPARE_EQ(collector.buffers.at(i).frameCount(), 256);
+
+        // Larger: the pending chunk of 32 frames is filled up to the new size
+        chunker.setChunkFrames(2048);
+        writeFrames(2048 * 2);
+        QCOMPARE_EQ(collector.buffers.size(), 3 + 8 + 2);
+        QCOMPARE_EQ(collector.buffers.constLast().frameCount(), 2048);
+
+        verifyContinuity(collector.buffers);
+    }
+
+    void write_keepsTimeContinuous_whenFormatChanges()
+    {
+        AudioChunker chunker;
+        chunker.setFormat(makeFormat(48000, 2));
+        chunker.setChunkFrames(480);
+
+        Collector collector;
+        const QByteArray first = makeRamp(0, 480 * 2 * 10);
+        chunker.write(first.constData(), first.size(), collector);
+
+        chunker.setFormat(makeFormat(96000, 1));
+        chunker.setChunkFrames(960);
+        const QByteArray second = makeRamp(480 * 2 * 10, 960 * 10);
+        chunker.write(second.constData(), second.size(), collector);
+
+        QCOMPARE_EQ(collector.buffers.size(), 20);
+        QCOMPARE_EQ(collector.buffers.at(10).startTime(), 100'000);
+        verifyContinuity(collector.buffers);
+    }
+
+    void setFormat_dropsPendingPartialChunk()
+    {
+        AudioChunker chunker;
+        chunker.setFormat(makeFormat(48000, 1));
+        chunker.setChunkFrames(100);
+
+        Collector collector;
+        const QByteArray partial = makeRamp(0, 150);
+        chunker.write(partial.constData(), partial.size(), collector);
+        QCOMPARE_EQ(collector.buffers.size(), 1);
+
+        chunker.setFormat(makeFormat(44100, 1));
+        const QByteArray next = makeRamp(1000, 100);
+        chunker.write(next.constData(), next.size(), collector);
+
+        QCOMPARE_EQ(collector.buffers.size(), 2);
+        QCOMPARE_EQ(collector.buffers.at(1).constData<qint32>()[0], 1000);
+    }
+
+    void write_reusesStorage_ofReleasedBuffers()
+    {
+        AudioChunker chunker;
+        chunker.setFormat(makeFormat(48000, 2));
+        chunker.setChunkFrames(1024);
+
+        const QByteArray data = makeRamp(0, 1024 * 2);
+        QSet<const void *> storage;
+        for (int i = 0; i < 100; ++i) {
+            chunker.write(data.constData(), data.size(), [&](const QAudioBuffer &buffer) {
+                storage.insert(buffer.constData<char>());
+            });
+        }
+
+        // The emitted buffers were released right away, so the ring never grows
+        QCOMPARE_LE(storage.size(), 8);
+    }
+
+    void write_doesNotOverwrite_buffersHeldByConsumers()
+    {
+        AudioChunker chunker;
+        chunker.setFormat(makeFormat(48000, 2));
+        chunker.setChunkFrames(64);
+
+        // Hold on to far more buffers than the ring has slots
+        Collector collector;
+        const QByteArray data = makeRamp(0, 64 * 2 * 50);
+        chunker.write(data.constData(), data.size(), collector);
+
+        QCOMPARE_EQ(collector.buffers.size(), 50);
+        verifyContinuity(collector.buffers);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_qffmpegaudiochunker)
+
+#include "tst_qffmpegaudiochunker.moc"
@@ -0,0 +1,111 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qthread.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegboundedqueue_p.h>
+
+#include <memory>
+#include <vector>
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+
+class tst_qffmpegboundedqueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void capacity_isRoundedUpToPowerOfTwo()
+    {
+        QCOMPARE_EQ(BoundedQueue<int>(1).capacity(), 2u);
+        QCOMPARE_EQ(BoundedQueue<int>(8).capacity(), 8u);
+        QCOMPARE_EQ(BoundedQueue<int>(10).capacity(), 16u);
+    }
+
+    void pop_returnsNothing_whenQueueIsEmpty()
+    {
+        BoundedQueue<int> queue(4);
+        QVERIFY(queue.empty());
+        QVERIFY(!queue.pop());
+    }
+
+    void pop_returnsValuesInPushOrder()
+    {
+        BoundedQueue<int> queue(4);
+
+        // Wrap around the ring several times
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 4; ++i)
+                QVERIFY(queue.push(round * 4 + i));
+            QCOMPARE_EQ(queue.size(), 4u);
+
+            for (int i = 0; i < 4; ++i)
+                QCOMPARE_EQ(queue.pop(), round * 4 + i);
+            QVERIFY(queue.empty());
+        }
+    }
+
+    void push_fails_andKeepsValue_whenQueueIsFull()
+    {
+        BoundedQueue<std::unique_ptr<int>> queue(2);
+        QVERIFY(queue.push(std::make_unique<int>(1)));
+        QVERIFY(queue.push(std::make_unique<int>(2)));
+
+        auto value = std::make_unique<int>(3);
+        QVERIFY(!queue.push(std::move(value)));
+        QVERIFY(value);
+
+        QCOMPARE_EQ(*queue.pop().value(), 1);
+        QVERIFY(queue.push(std::move(value)));
+        QCOMPARE_EQ(*queue.pop().value(), 2);
+        QCOMPARE_EQ(*queue.pop().value(), 3);
+    }
+
+    void pop_receivesAllValues_whenPushedFromMultipleThreads()
+    {
+        constexpr int producerCount = 4;
+        constexpr int valuesPerProducer = 10000;
+
+        BoundedQueue<int> queue(64);
+
+        std::vector<std::unique_ptr<QThread>> producers;
+        for (int producer = 0; producer < producerCount; ++producer) {
+            producers.emplace_back(QThread::create([&queue, producer] {
+                for (int i = 0; i < valuesPerProducer; ++i) {
+                    while (!queue.push(producer * valuesPerProducer + i))
+                        QThread::yieldCurrentThread();
+                }
+            }));
+            producers.back()->start();
+        }
+
+        // Values of each producer must arrive in order
+        std::vector<int> lastValues(producerCount, -1);
+        for (int received = 0; received < producerCount * valuesPerProducer;) {
+            const std::optional<int> value = queue.pop();
+            if (!value) {
+                QThread::yieldCurrentThread();
+                continue;
+            }
+
+            const int producer = *value / valuesPerProducer;
+            QCOMPARE_LT(lastValues[producer], *value % valuesPerProducer);
+            lastValues[producer] = *value % valuesPerProducer;
+            ++received;
+        }
+
+        for (auto &producer : producers)
+            QVERIFY(producer->wait());
+
+        QVERIFY(queue.empty());
+        for (int lastValue : lastValues)
+            QCOMPARE_EQ(lastValue, valuesPerProducer - 1);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_qffmpegboundedqueue)
+
+#include "tst_qffmpegboundedqueue.moc"
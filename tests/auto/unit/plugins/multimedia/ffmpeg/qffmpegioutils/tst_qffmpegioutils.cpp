@@ -0,0 +1,128 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qresource.h>
+#include <QtCore/qtemporaryfile.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegioutils_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
+
+#include <array>
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+const QString resourceFileName = u":/tst_qffmpegioutils.cpp"_s;
+
+// Reads the whole AVIO context the way demuxers do, in small chunks
+QByteArray readAll(AVIOContext *context, int chunkSize = 4096)
+{
+    QByteArray result;
+    QByteArray chunk(chunkSize, Qt::Uninitialized);
+    while (true) {
+        const int read = avio_read(context, reinterpret_cast<unsigned char *>(chunk.data()),
+                                   chunkSize);
+        if (read <= 0)
+            break;
+        result.append(chunk.constData(), read);
+    }
+    return result;
+}
+
+} // namespace
+
+class tst_qffmpegioutils : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        QFile file(resourceFileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        m_fileData = file.readAll();
+        QVERIFY(!m_fileData.isEmpty());
+    }
+
+    void create_returnsNull_whenDeviceIsNotFile()
+    {
+        QBuffer buffer;
+        buffer.setData("data");
+        QVERIFY(!MappedFileIO::create(&buffer));
+    }
+
+    void create_returnsNull_whenFileDoesNotExist()
+    {
+        QVERIFY(!MappedFileIO::create(u":/nonexistent/file.mp4"_s));
+    }
+
+    void create_returnsNull_whenFileIsLocal()
+    {
+        // Local files are left to FFmpeg's file protocol
+        QTemporaryFile localFile;
+        QVERIFY(localFile.open());
+        QCOMPARE_EQ(localFile.write(m_fileData), m_fileData.size());
+        QVERIFY(localFile.flush());
+
+        QVERIFY(!MappedFileIO::create(localFile.fileName()));
+
+        QFile file(localFile.fileName());
+        QVERIFY(!MappedFileIO::create(&file));
+    }
+
+    void read_returnsFileContent()
+    {
+        auto io = MappedFileIO::create(resourceFileName);
+        QVERIFY(io);
+        QCOMPARE_EQ(io->size(), m_fileData.size());
+
+        QCOMPARE_EQ(readAll(io->avioContext()), m_fileData);
+    }
+
+    void seek_movesReadPosition_andReportsSize()
+    {
+        auto io = MappedFileIO::create(resourceFileName);
+        QVERIFY(io);
+
+        QCOMPARE_EQ(MappedFileIO::seek(io.get(), 0, AVSEEK_SIZE), m_fileData.size());
+        QCOMPARE_EQ(MappedFileIO::seek(io.get(), -10, SEEK_END), m_fileData.size() - 10);
+
+        std::array<uint8_t, 20> buffer{};
+        QCOMPARE_EQ(MappedFileIO::read(io.get(), buffer.data(), int(buffer.size())), 10);
+        QCOMPARE_EQ(QByteArrayView(buffer.data(), 10), QByteArrayView(m_fileData).last(10));
+        QCOMPARE_EQ(MappedFileIO::read(io.get(), buffer.data(), int(buffer.size())), AVERROR_EOF);
+
+        QCOMPARE_EQ(MappedFileIO::seek(io.get(), 100, SEEK_SET), 100);
+        QCOMPARE_EQ(MappedFileIO::seek(io.get(), -50, SEEK_CUR), 50);
+        QCOMPARE_LT(MappedFileIO::seek(io.get(), -100, SEEK_CUR), 0);
+        QCOMPARE_LT(MappedFileIO::seek(io.get(), m_fileData.size() + 1, SEEK_SET), 0);
+    }
+
+    void create_mapsResourceWithoutCopying()
+    {
+        const QResource resource(resourceFileName);
+        QVERIFY(resource.isValid());
+        QCOMPARE_EQ(resource.compressionAlgorithm(), QResource::NoCompression);
+
+        QFile file(resourceFileName);
+        auto io = MappedFileIO::create(&file);
+        QVERIFY(io);
+
+        QCOMPARE_EQ(io->data(), resource.data());
+        QCOMPARE_EQ(io->size(), resource.size());
+    }
+
+private:
+    QByteArray m_fileData;
+};
+
+QTEST_GUILESS_MAIN(tst_qffmpegioutils)
+
+#include "tst_qffmpegioutils.moc"
@@ -0,0 +1,321 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtendian.h>
+#include <QtMultimedia/qaudiobuffer.h>
+#include <QtMultimedia/qplaybackoptions.h>
+#include <QtMultimedia/private/qplatformaudiobufferinput_p.h>
+#include <QtMultimedia/private/qplatformmediarecorder_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegcodeccontext_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegcodecstorage_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegencodingformatcontext_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegmediadataholder_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegmediaformatinfo_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegrecordingengine_p.h>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Writes a few times faster than real time, which is much slower than the encoder
+// produces PCM, so that the back-pressure reaches the audio source
+class ThrottledBuffer : public QBuffer
+{
+public:
+    explicit ThrottledBuffer(qint64 bytesPerSecond) : m_bytesPerSecond(bytesPerSecond) { }
+
+protected:
+    qint64 writeData(const char *data, qint64 size) override
+    {
+        QThread::usleep(static_cast<unsigned long>(size * 1'000'000 / m_bytesPerSecond));
+        return QBuffer::writeData(data, size);
+    }
+
+private:
+    const qint64 m_bytesPerSecond;
+};
+
+QAudioFormat sourceFormat()
+{
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Int16);
+    format.setSampleRate(48000);
+    format.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+    return format;
+}
+
+// A constant non-zero signal, so that dropped audio shows up as missing or silent samples
+QAudioBuffer makeBuffer(const QAudioFormat &format, int frameCount)
+{
+    QByteArray data(format.bytesForFrames(frameCount), Qt::Uninitialized);
+    qint16 *samples = reinterpret_cast<qint16 *>(data.data());
+    std::fill_n(samples, frameCount * format.channelCount(), qint16(0x1234));
+    return QAudioBuffer(data, format);
+}
+
+// Returns the payload of the data chunk of a RIFF WAVE file
+QByteArray wavSamples(const QByteArray &wav)
+{
+    qsizetype offset = 12; // RIFF header
+    while (offset + 8 <= wav.size()) {
+        const QByteArray chunkId = wav.mid(offset, 4);
+        const quint32 chunkSize = qFromLittleEndian<quint32>(wav.constData() + offset + 4);
+        if (chunkId == "data")
+            return wav.mid(offset + 8, chunkSize);
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+    return {};
+}
+
+struct DecodedAudio
+{
+    qint64 sampleCount = 0; // per channel
+    qint64 duration = 0; // in microseconds, from the start of the first frame to the end of the last
+};
+
+std::optional<DecodedAudio> decodeAudio(const QByteArray &media)
+{
+    QBuffer input;
+    input.setData(media);
+
+    const QPlaybackOptions options;
+    MediaDataHolder::Maybe holder =
+            MediaDataHolder::create(QUrl(), &input, options, std::make_shared<CancelToken>());
+    if (!holder)
+        return {};
+
+    const int streamIndex = (*holder)->currentStreamIndex(QPlatformMediaPlayer::AudioStream);
+    if (streamIndex < 0)
+        return {};
+
+    AVFormatContext *formatContext = (*holder)->avContext();
+    auto codecContext =
+            CodecContext::create(formatContext->streams[streamIndex], formatContext, options);
+    if (!codecContext)
+        return {};
+
+    DecodedAudio result;
+    std::optional<TrackPosition> start;
+    TrackPosition end(0);
+    AVFrameUPtr frame = makeAVFrame();
+    const auto receiveFrames = [&] {
+        while (avcodec_receive_frame(codecContext->context(), frame.get()) >= 0) {
+            result.sampleCount += frame->nb_samples;
+            const TrackPosition position = codecContext->toTrackPosition(
+                    AVStreamPosition(frame->best_effort_timestamp));
+            if (!start)
+                start = position;
+            end = position
+                    + codecContext->toTrackDuration(AVStreamDuration(getAVFrameDuration(*frame)));
+        }
+    };
+
+    AVPacketUPtr packet(av_packet_alloc());
+    while (av_read_frame(formatContext, packet.get()) >= 0) {
+        if (packet->stream_index == streamIndex) {
+            avcodec_send_packet(codecContext->context(), packet.get());
+            receiveFrames();
+        }
+        av_packet_unref(packet.get());
+    }
+
+    // Drain the decoder
+    avcodec_send_packet(codecContext->context(), nullptr);
+    receiveFrames();
+
+    if (start)
+        result.duration = (end - *start).get();
+    return result;
+}
+
+} // namespace
+
+class tst_QFFmpegRecordingEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void record_keepsAllAudio_whenEncoderIsSlowerThanSource()
+    {
+        const QAudioFormat format = sourceFormat();
+
+        // The source isn't real time, so it has to wait longer than an audio device may
+        qputenv("QT_FFMPEG_AUDIO_ENCODER_MAX_QUEUE_WAIT_MS", "5000");
+        const auto unsetWaitTime =
+                qScopeGuard([] { qunsetenv("QT_FFMPEG_AUDIO_ENCODER_MAX_QUEUE_WAIT_MS"); });
+
+        // 2.5 ms per buffer, so that the muxer queue of 1024 packets holds about 2.5 s,
+        // and the source has to wait for the output most of the time
+        const QAudioBuffer buffer = makeBuffer(format, 120);
+        constexpr int bufferCount = 3200;
+
+        ThrottledBuffer output(4 * format.bytesForDuration(1'000'000));
+        QVERIFY(output.open(QIODevice::WriteOnly));
+
+        QMediaEncoderSettings settings = waveSettings();
+        // Keep the test short; the muxer queue holds the rest of the audio in flight
+        settings.setMaxAudioQueueDuration(500);
+
+        record(settings, output, buffer, bufferCount);
+        if (QTest::currentTestFailed())
+            return;
+
+        const QByteArray samples = wavSamples(output.data());
+        QCOMPARE_EQ(samples.size(), bufferCount * buffer.byteCount());
+
+        // Neither skipped nor replaced with silence
+        const QByteArray bufferData(buffer.constData<char>(), buffer.byteCount());
+        QVERIFY(samples == bufferData.repeated(bufferCount));
+        QCOMPARE_EQ(m_droppedAudioDuration, 0);
+    }
+
+    void record_reportsDroppedAudio_whenEncoderIsSlowerThanSourceAndPolicyIsDrop()
+    {
+        const QAudioFormat format = sourceFormat();
+        const QAudioBuffer buffer = makeBuffer(format, 120);
+        constexpr int bufferCount = 3200;
+
+        ThrottledBuffer output(4 * format.bytesForDuration(1'000'000));
+        QVERIFY(output.open(QIODevice::WriteOnly));
+
+        QMediaEncoderSettings settings = waveSettings();
+        settings.setMaxAudioQueueDuration(50);
+        settings.setAudioOverflowPolicy(QMediaRecorder::DropOnAudioOverflow);
+
+        record(settings, output, buffer, bufferCount);
+        if (QTest::currentTestFailed())
+            return;
+
+        QCOMPARE_GT(m_droppedAudioDuration, 0);
+        QCOMPARE_LE(m_droppedAudioDuration, bufferCount * buffer.duration() / 1000);
+    }
+
+    void record_producesSameAudio_whenPipelined_data()
+    {
+        QTest::addColumn<QMediaFormat::FileFormat>("fileFormat");
+        QTest::addColumn<QMediaFormat::AudioCodec>("audioCodec");
+
+        QTest::newRow("AAC") << QMediaFormat::Mpeg4Audio << QMediaFormat::AudioCodec::AAC;
+        QTest::newRow("Opus") << QMediaFormat::Ogg << QMediaFormat::AudioCodec::Opus;
+        QTest::newRow("FLAC") << QMediaFormat::FLAC << QMediaFormat::AudioCodec::FLAC;
+    }
+
+    void record_producesSameAudio_whenPipelined()
+    {
+        QFETCH(QMediaFormat::FileFormat, fileFormat);
+        QFETCH(QMediaFormat::AudioCodec, audioCodec);
+
+        if (!findAVEncoder(QFFmpegMediaFormatInfo::codecIdForAudioCodec(audioCodec)))
+            QSKIP("The codec is not supported for encoding");
+
+        QMediaFormat mediaFormat(fileFormat);
+        mediaFormat.setAudioCodec(audioCodec);
+        QMediaEncoderSettings settings;
+        settings.setMediaFormat(mediaFormat);
+
+        // About 4 s, in buffers that don't match the frame size of any of the encoders
+        const QAudioBuffer buffer = makeBuffer(sourceFormat(), 1000);
+        constexpr int bufferCount = 200;
+
+        const auto recordAndDecode = [&](const char *pipeline) -> std::optional<DecodedAudio> {
+            qputenv("QT_FFMPEG_AUDIO_ENCODER_PIPELINE", pipeline);
+            const auto unsetPipeline =
+                    qScopeGuard([] { qunsetenv("QT_FFMPEG_AUDIO_ENCODER_PIPELINE"); });
+
+            QBuffer output;
+            if (!output.open(QIODevice::WriteOnly))
+                return {};
+
+            record(settings, output, buffer, bufferCount);
+            if (QTest::currentTestFailed())
+                return {};
+            return decodeAudio(output.data());
+        };
+
+        const std::optional<DecodedAudio> singleThreaded = recordAndDecode("0");
+        QVERIFY(singleThreaded);
+        const std::optional<DecodedAudio> pipelined = recordAndDecode("1");
+        QVERIFY(pipelined);
+
+        QCOMPARE_GT(singleThreaded->sampleCount, 0);
+        QCOMPARE_EQ(pipelined->sampleCount, singleThreaded->sampleCount);
+        QCOMPARE_EQ(pipelined->duration, singleThreaded->duration);
+    }
+
+private:
+    static QMediaEncoderSettings waveSettings()
+    {
+        QMediaFormat mediaFormat(QMediaFormat::Wave);
+        mediaFormat.setAudioCodec(QMediaFormat::AudioCodec::Wave);
+
+        QMediaEncoderSettings settings;
+        settings.setMediaFormat(mediaFormat);
+        return settings;
+    }
+
+    // Records the buffer repeatedly, and waits for the recording to be finalized
+    void record(const QMediaEncoderSettings &settings, QIODevice &output,
+                const QAudioBuffer &buffer, int bufferCount)
+    {
+        m_droppedAudioDuration = 0;
+
+        auto formatContext = std::make_unique<EncodingFormatContext>(settings.fileFormat());
+        formatContext->openAVIO(&output);
+        QVERIFY(formatContext->isAVIOOpen());
+
+        // Deletes itself when finalized
+        auto engine = new RecordingEngine(settings, std::move(formatContext));
+
+        std::atomic<qint64> duration = 0;
+        bool finalized = false;
+        QStringList errors;
+        connect(engine, &RecordingEngine::durationChanged, engine,
+                [&](qint64 newDuration) { duration = newDuration; }, Qt::DirectConnection);
+        connect(engine, &RecordingEngine::droppedAudioDurationChanged, this,
+                [&](qint64 droppedDuration) { m_droppedAudioDuration = droppedDuration; });
+        connect(engine, &RecordingEngine::sessionError, this,
+                [&](QMediaRecorder::Error, const QString &description) {
+                    errors.push_back(description);
+                });
+        connect(engine, &RecordingEngine::finalizationDone, this, [&] { finalized = true; });
+
+        QPlatformAudioBufferInput input(buffer.format());
+        QVERIFY(engine->initialize({ &input }, {}));
+
+        // The source may be blocked only once the encoding has started
+        emit input.newAudioBuffer(buffer);
+        QTRY_VERIFY(duration > 0);
+
+        // Like an audio device, the source pushes without waiting for canPushFrame
+        std::unique_ptr<QThread> producer(QThread::create([&] {
+            for (int i = 1; i < bufferCount; ++i)
+                emit input.newAudioBuffer(buffer);
+        }));
+        producer->start();
+        QTRY_VERIFY_WITH_TIMEOUT(producer->isFinished(), 30s);
+
+        emit input.newAudioBuffer({});
+        engine->finalize();
+        QTRY_VERIFY_WITH_TIMEOUT(finalized, 30s);
+
+        QCOMPARE_EQ(errors, QStringList{});
+    }
+
+    qint64 m_droppedAudioDuration = 0; // as reported by the engine, in milliseconds
+};
+
+QTEST_GUILESS_MAIN(tst_QFFmpegRecordingEngine)
+
+#include "tst_qffmpegrecordingengine.moc"
@@ -0,0 +1,241 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qtemporaryfile.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegvideoframereader_p.h>
+
+#include <algorithm>
+#include <memory>
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+const QString resourceFileName = u":/15s.mkv"_s;
+
+} // namespace
+
+class tst_QFFmpegVideoFrameReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        // The demuxer cannot read from the resource file system
+        m_clipFile.reset(QTemporaryFile::createNativeFile(resourceFileName));
+        QVERIFY(m_clipFile);
+        m_clipUrl = QUrl::fromLocalFile(m_clipFile->fileName());
+
+        // Decode the whole clip sequentially as the reference
+        auto reader = createReader();
+        QVERIFY(reader);
+        while (AVFrameUPtr frame = reader->read())
+            m_framePositions.push_back(reader->position(*frame).get());
+
+        QCOMPARE_GT(m_framePositions.size(), 1);
+        QVERIFY(std::is_sorted(m_framePositions.begin(), m_framePositions.end()));
+        QCOMPARE_EQ(reader->seekCount(), 0);
+
+        for (qint64 position : m_framePositions) {
+            const std::optional<TrackPosition> keyFrame =
+                    reader->keyFramePosition(TrackPosition(position));
+            if (keyFrame && !m_keyFramePositions.contains(keyFrame->get()))
+                m_keyFramePositions.push_back(keyFrame->get());
+        }
+    }
+
+    void init()
+    {
+        if (m_keyFramePositions.size() < 2)
+            QSKIP("The demuxer does not index the key frames of the clip");
+    }
+
+    void canDecodeForward_returnsTrue_whenPositionIsAheadInSameGop()
+    {
+        auto reader = createReader();
+        QVERIFY(reader);
+
+        const qint64 keyFrame = m_keyFramePositions[0];
+        const qint64 frameInGop = framesInGop(keyFrame).back();
+        QCOMPARE_GT(frameInGop, keyFrame);
+
+        QVERIFY(reader->canDecodeForward(TrackPosition(keyFrame), TrackPosition(frameInGop)));
+        QVERIFY(reader->canDecodeForward(TrackPosition(frameInGop), TrackPosition(frameInGop)));
+    }
+
+    void canDecodeForward_returnsFalse_whenPositionIsBehind()
+    {
+        auto reader = createReader();
+        QVERIFY(reader);
+
+        const qint64 keyFrame = m_keyFramePositions[0];
+        const qint64 frameInGop = framesInGop(keyFrame).back();
+
+        QVERIFY(!reader->canDecodeForward(TrackPosition(frameInGop), TrackPosition(keyFrame)));
+    }
+
+    void canDecodeForward_returnsFalse_whenKeyFrameIsInBetween()
+    {
+        auto reader = createReader();
+        QVERIFY(reader);
+
+        const qint64 frameInFirstGop = framesInGop(m_keyFramePositions[0]).back();
+        const qint64 frameInSecondGop = framesInGop(m_keyFramePositions[1]).back();
+
+        QVERIFY(!reader->canDecodeForward(TrackPosition(frameInFirstGop),
+                                          TrackPosition(m_keyFramePositions[1])));
+        QVERIFY(!reader->canDecodeForward(TrackPosition(frameInFirstGop),
+                                          TrackPosition(frameInSecondGop)));
+    }
+
+    void frameAt_returnsFrameShownAtPosition_whenPositionsIncrease()
+    {
+        auto reader = createReader();
+        QVERIFY(reader);
+
+        // Both the exact frame starts and the positions between two frames
+        QList<qint64> positions;
+        for (qsizetype i = 0; i + 1 < m_framePositions.size(); i += 7) {
+            positions.push_back(m_framePositions[i]);
+            positions.push_back((m_framePositions[i] + m_framePositions[i + 1]) / 2);
+        }
+
+        for (qint64 position : positions) {
+            const QVideoFrame frame = reader->frameAt(TrackPosition(position));
+            QVERIFY(frame.isValid());
+            QCOMPARE_EQ(frame.startTime(), expectedFramePosition(position));
+        }
+
+        QCOMPARE_LE(reader->seekCount(), m_keyFramePositions.size());
+    }
+
+    void frameAt_returnsFrameShownAtPosition_whenPositionsDecrease()
+    {
+        auto reader = createReader();
+        QVERIFY(reader);
+
+        for (qsizetype i = m_framePositions.size() - 2; i >= 0; i -= 11) {
+            const qint64 position = (m_framePositions[i] + m_framePositions[i + 1]) / 2;
+            const QVideoFrame frame = reader->frameAt(TrackPosition(position));
+            QVERIFY(frame.isValid());
+            QCOMPARE_EQ(frame.startTime(), expectedFramePosition(position));
+        }
+    }
+
+    void frameAt_decodesGopOnce_whenPositionsShareKeyFrame()
+    {
+        const QList<qint64> gop = framesInGop(m_keyFramePositions[1]);
+        if (gop.size() < 3)
+            QSKIP("The GOPs of the clip are too short");
+
+        const QList<qint64> positions = { gop[1], gop[gop.size() / 2], gop.back() };
+
+        auto reader = createReader();
+        QVERIFY(reader);
+        for (qint64 position : positions)
+            QCOMPARE_EQ(reader->frameAt(TrackPosition(position)).startTime(), position);
+
+        QCOMPARE_EQ(reader->seekCount(), 1);
+
+        // Requesting only the last position decodes the same frames
+        auto lastPositionReader = createReader();
+        QVERIFY(lastPositionReader);
+        QCOMPARE_EQ(lastPositionReader->frameAt(TrackPosition(gop.back())).startTime(),
+                    gop.back());
+
+        QCOMPARE_EQ(lastPositionReader->seekCount(), 1);
+        QCOMPARE_EQ(reader->decodedFrameCount(), lastPositionReader->decodedFrameCount());
+    }
+
+    void splitIntoChunks_keepsGopsInOneChunk_data()
+    {
+        QTest::addColumn<int>("maxChunkCount");
+
+        QTest::newRow("single chunk") << 1;
+        QTest::newRow("fewer chunks than GOPs") << 2;
+        QTest::newRow("more chunks than GOPs") << 1000;
+    }
+
+    void splitIntoChunks_keepsGopsInOneChunk()
+    {
+        QFETCH(int, maxChunkCount);
+
+        auto reader = createReader();
+        QVERIFY(reader);
+
+        // User positions are in milliseconds
+        QList<qint64> positions;
+        for (qsizetype i = 0; i < m_framePositions.size(); i += 3) {
+            const qint64 position = (m_framePositions[i] + 999) / 1000;
+            if (positions.empty() || positions.back() != position)
+                positions.push_back(position);
+        }
+
+        const QList<QList<qint64>> chunks = splitIntoChunks(*reader, positions, maxChunkCount);
+
+        const auto keyFrameOf = [&](qint64 position) {
+            return reader->keyFramePosition(toTrackPosition(UserTrackPosition(position)));
+        };
+
+        qsizetype gopCount = 1;
+        for (qsizetype i = 1; i < positions.size(); ++i)
+            gopCount += keyFrameOf(positions[i]) != keyFrameOf(positions[i - 1]);
+
+        QCOMPARE_EQ(chunks.size(), std::min<qsizetype>(maxChunkCount, gopCount));
+
+        QList<qint64> chunkedPositions;
+        for (qsizetype i = 0; i < chunks.size(); ++i) {
+            QVERIFY(!chunks[i].empty());
+            if (i > 0)
+                QVERIFY(keyFrameOf(chunks[i].front()) != keyFrameOf(chunks[i - 1].back()));
+            chunkedPositions.append(chunks[i]);
+        }
+
+        QCOMPARE_EQ(chunkedPositions, positions);
+    }
+
+private:
+    VideoFrameReader::Maybe createReader() const
+    {
+        return VideoFrameReader::create(m_clipUrl, std::make_shared<CancelToken>());
+    }
+
+    // The last frame starting at or before the position
+    qint64 expectedFramePosition(qint64 position) const
+    {
+        const auto next =
+                std::upper_bound(m_framePositions.begin(), m_framePositions.end(), position);
+        return next == m_framePositions.begin() ? m_framePositions.front() : *std::prev(next);
+    }
+
+    QList<qint64> framesInGop(qint64 keyFramePosition) const
+    {
+        const auto keyFrameIt = std::find(m_keyFramePositions.begin(), m_keyFramePositions.end(),
+                                          keyFramePosition);
+        const auto nextKeyFrameIt = std::next(keyFrameIt);
+
+        QList<qint64> result;
+        for (qint64 position : m_framePositions) {
+            const bool isBeforeNextKeyFrame =
+                    nextKeyFrameIt == m_keyFramePositions.end() || position < *nextKeyFrameIt;
+            if (position >= keyFramePosition && isBeforeNextKeyFrame)
+                result.push_back(position);
+        }
+        return result;
+    }
+
+    std::unique_ptr<QTemporaryFile> m_clipFile;
+    QUrl m_clipUrl;
+    QList<qint64> m_framePositions; // in presentation order
+    QList<qint64> m_keyFramePositions;
+};
+
+QTEST_GUILESS_MAIN(tst_QFFmpegVideoFrameReader)
+
+#include "tst_qffmpegvideoframereader.moc"
@@ -0,0 +1,148 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qthread.h>
+#include <QtFFmpegMediaPluginImpl/private/qv4l2cameradevices_p.h>
+
+#include <private/qcameradevice_p.h>
+
+#include <sys/stat.h>
+
+QT_USE_NAMESPACE
+
+namespace {
+
+using ProbedNode = QV4L2CameraDevices::ProbedNode;
+using Capabilities = QV4L2CameraDevices::Capabilities;
+
+// Reports every node as a camera without opening it. Must outlive the camera devices,
+// which probe the nodes on the thread pool.
+class FakeNodeProber
+{
+public:
+    QV4L2CameraDevices::NodeProber prober()
+    {
+        return [this](const QByteArray &file, ProbedNode &node,
+                      QHash<QByteArray, Capabilities> &) {
+            {
+                QMutexLocker locker(&m_probedMutex);
+                m_probedFiles.append(file);
+            }
+
+            auto camera = std::make_unique<QCameraDevicePrivate>();
+            camera->id = file;
+            camera->description = QString::fromUtf8(file);
+            node.camera = camera.release()->create();
+            return true;
+        };
+    }
+
+    QList<QByteArray> probedFiles() const
+    {
+        QMutexLocker locker(&m_probedMutex);
+        return m_probedFiles;
+    }
+
+private:
+    mutable QMutex m_probedMutex;
+    QList<QByteArray> m_probedFiles;
+};
+
+// The scan only lists system files, so the fake nodes are FIFOs
+bool createNode(const QTemporaryDir &dir, const QString &name)
+{
+    return ::mkfifo(QFile::encodeName(dir.filePath(name)).constData(), 0600) == 0;
+}
+
+QByteArray nodePath(const QTemporaryDir &dir, const QString &name)
+{
+    return QFile::encodeName(dir.filePath(name));
+}
+
+} // namespace
+
+class tst_QV4L2CameraDevices : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_deviceDir.isValid());
+        QVERIFY(createNode(m_deviceDir, QStringLiteral("video0")));
+        QVERIFY(createNode(m_deviceDir, QStringLiteral("video1")));
+        QVERIFY(createNode(m_deviceDir, QStringLiteral("media0")));
+    }
+
+    void videoInputs_returnsCamerasOfFirstScan()
+    {
+        FakeNodeProber prober;
+        QV4L2CameraDevices devices(nullptr, m_deviceDir.path(), prober.prober());
+
+        const QList<QCameraDevice> cameras = devices.videoInputs();
+
+        QCOMPARE_EQ(cameras.size(), 2);
+        QVERIFY(cameras[0].isDefault());
+        QVERIFY(!cameras[1].isDefault());
+        QCOMPARE_EQ(prober.probedFiles().size(), 2);
+        QVERIFY(!prober.probedFiles().contains(nodePath(m_deviceDir, QStringLiteral("media0"))));
+    }
+
+    void checkCameras_probesOnlyChangedNodes()
+    {
+        FakeNodeProber prober;
+        QV4L2CameraDevices devices(nullptr, m_deviceDir.path(), prober.prober());
+        QCOMPARE_EQ(devices.videoInputs().size(), 2);
+        QCOMPARE_EQ(prober.probedFiles().size(), 2);
+
+        // File times have the granularity of the kernel tick
+        QThread::msleep(50);
+        const QByteArray changedNode = nodePath(m_deviceDir, QStringLiteral("video1"));
+        QCOMPARE_EQ(::chmod(changedNode.constData(), 0644), 0);
+
+        devices.checkCameras();
+
+        QTRY_COMPARE_EQ(prober.probedFiles().size(), 3);
+        QCOMPARE_EQ(prober.probedFiles().last(), changedNode);
+
+        // Further scans use the cache
+        devices.checkCameras();
+        QTest::qWait(100);
+        QCOMPARE_EQ(prober.probedFiles().size(), 3);
+        QCOMPARE_EQ(devices.videoInputs().size(), 2);
+    }
+
+    void videoInputsChanged_isEmittedOnObjectThread_whenCameraIsAdded()
+    {
+        FakeNodeProber prober;
+        QV4L2CameraDevices devices(nullptr, m_deviceDir.path(), prober.prober());
+        QCOMPARE_EQ(devices.videoInputs().size(), 2);
+
+        int changeCount = 0;
+        QThread *notifyingThread = nullptr;
+        connect(&devices, &QPlatformVideoDevices::videoInputsChanged, this, [&] {
+            ++changeCount;
+            notifyingThread = QThread::currentThread();
+        }, Qt::DirectConnection);
+
+        QVERIFY(createNode(m_deviceDir, QStringLiteral("video2")));
+        devices.checkCameras();
+
+        QTRY_COMPARE_GE(changeCount, 1);
+        QCOMPARE_EQ(notifyingThread, devices.thread());
+        QCOMPARE_EQ(devices.videoInputs().size(), 3);
+
+        QVERIFY(QFile::remove(m_deviceDir.filePath(QStringLiteral("video2"))));
+    }
+
+private:
+    QTemporaryDir m_deviceDir;
+};
+
+QTEST_GUILESS_MAIN(tst_QV4L2CameraDevices)
+
+#include "tst_qv4l2cameradevices.moc"
@@ -0,0 +1,225 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qmutex.h>
+#include <QtFFmpegMediaPluginImpl/private/qv4l2capturethread_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qv4l2filedescriptor_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qv4l2memorytransfer_p.h>
+
+#include <private/qcore_unix_p.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+QT_USE_NAMESPACE
+
+namespace {
+
+constexpr quint32 bytesPerLine = 4;
+constexpr qint64 frameDuration = 10'000;
+
+const QVideoFrameFormat frameFormat({ 4, 4 }, QVideoFrameFormat::Format_Y8);
+
+v4l2_buffer makeV4L2Buffer(quint32 flags, qint64 timestampUs)
+{
+    v4l2_buffer buffer = {};
+    buffer.flags = flags;
+    buffer.timestamp.tv_sec = timestampUs / 1'000'000;
+    buffer.timestamp.tv_usec = timestampUs % 1'000'000;
+    return buffer;
+}
+
+// Produces a frame whenever the device descriptor gets readable
+class FakeMemoryTransfer : public QV4L2MemoryTransfer
+{
+public:
+    using QV4L2MemoryTransfer::QV4L2MemoryTransfer;
+
+    std::optional<Buffer> dequeueBuffer() override
+    {
+        quint64 value = 0;
+        if (qt_safe_read(fileDescriptor().get(), &value, sizeof(value)) < 0)
+            return {};
+
+        QMutexLocker locker(&m_mutex);
+        Buffer buffer;
+        buffer.v4l2Buffer.index = m_nextIndex++ % buffersCount();
+        buffer.v4l2Buffer.flags = V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC;
+        buffer.data = QByteArray(bytesPerLine * frameFormat.frameHeight(), 0);
+        return buffer;
+    }
+
+    bool enqueueBuffer(quint32 index) override
+    {
+        QMutexLocker locker(&m_mutex);
+        m_enqueueAttempts.append(index);
+        if (m_failingEnqueueCount > 0) {
+            --m_failingEnqueueCount;
+            errno = EIO;
+            return false;
+        }
+        return true;
+    }
+
+    quint32 buffersCount() const override { return 2; }
+
+    void failNextEnqueues(int count)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_failingEnqueueCount = count;
+    }
+
+    QList<quint32> enqueueAttempts() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_enqueueAttempts;
+    }
+
+private:
+    mutable QMutex m_mutex;
+    quint32 m_nextIndex = 0;
+    int m_failingEnqueueCount = 0;
+    QList<quint32> m_enqueueAttempts;
+};
+
+struct CaptureThreadFixture
+{
+    explicit CaptureThreadFixture(int deviceFd)
+        : fileDescriptor(std::make_shared<QV4L2FileDescriptor>(deviceFd)),
+          memoryTransfer(fileDescriptor),
+          thread(
+                  fileDescriptor, memoryTransfer, frameFormat, bytesPerLine, frameDuration,
+                  [this](const QVideoFrame &) { ++frameCount; },
+                  [this](int error) {
+                      errors.append(error);
+                      errorCount = errors.size();
+                  })
+    {
+    }
+
+    std::shared_ptr<QV4L2FileDescriptor> fileDescriptor;
+    FakeMemoryTransfer memoryTransfer;
+    std::atomic_int frameCount = 0;
+    std::atomic_int errorCount = 0;
+    QList<int> errors; // written on the capture thread, read after errorCount
+    QV4L2CaptureThread thread;
+};
+
+void signalFrame(int deviceFd)
+{
+    const quint64 value = 1;
+    QCOMPARE_EQ(qt_safe_write(deviceFd, &value, sizeof(value)), qint64(sizeof(value)));
+}
+
+} // namespace
+
+class tst_QV4L2CaptureThread : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void deviceEvent_isRecoverable_onlyForPollErr()
+    {
+        using DeviceEvent = QV4L2CaptureThread::DeviceEvent;
+
+        QCOMPARE_EQ(QV4L2CaptureThread::deviceEvent(0), DeviceEvent::None);
+        QCOMPARE_EQ(QV4L2CaptureThread::deviceEvent(POLLIN), DeviceEvent::FrameReady);
+        QCOMPARE_EQ(QV4L2CaptureThread::deviceEvent(POLLERR), DeviceEvent::Error);
+        QCOMPARE_EQ(QV4L2CaptureThread::deviceEvent(POLLIN | POLLERR), DeviceEvent::FrameReady);
+        QCOMPARE_EQ(QV4L2CaptureThread::deviceEvent(POLLHUP), DeviceEvent::Disconnected);
+        QCOMPARE_EQ(QV4L2CaptureThread::deviceEvent(POLLNVAL), DeviceEvent::Disconnected);
+        QCOMPARE_EQ(QV4L2CaptureThread::deviceEvent(POLLERR | POLLHUP), DeviceEvent::Disconnected);
+    }
+
+    void frameTime_usesDriverTimestamps_whenMonotonic()
+    {
+        QV4L2FrameClock clock;
+
+        const auto first = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC, 1'000'000);
+        QCOMPARE_EQ(clock.frameTime(first, 5'000'000), 1'000'000);
+
+        const auto second = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC, 1'033'333);
+        QCOMPARE_EQ(clock.frameTime(second, 5'100'000), 1'033'333);
+    }
+
+    void frameTime_usesDequeueTime_whenDriverStampIsMissing()
+    {
+        QV4L2FrameClock clock;
+
+        const auto stamped = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC, 1'000'000);
+        QCOMPARE_EQ(clock.frameTime(stamped, 1'000'500), 1'000'000);
+
+        // Both are on the monotonic clock, so the stream stays continuous
+        const auto unstamped = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC, 0);
+        QCOMPARE_EQ(clock.frameTime(unstamped, 1'033'800), 1'033'800);
+    }
+
+    void frameTime_usesDequeueTimeForAllFrames_whenDriverClockIsNotMonotonic()
+    {
+        QV4L2FrameClock clock;
+
+        const auto copied = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_COPY, 42);
+        QCOMPARE_EQ(clock.frameTime(copied, 5'000'000), 5'000'000);
+
+        // Later frames don't switch clocks, even if they look usable
+        const auto monotonic = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC, 1'000'000);
+        QCOMPARE_EQ(clock.frameTime(monotonic, 5'033'000), 5'033'000);
+    }
+
+    void frameTime_usesDequeueTimeForAllFrames_whenFirstFrameIsUnstamped()
+    {
+        QV4L2FrameClock clock;
+
+        const auto unstamped = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC, 0);
+        QCOMPARE_EQ(clock.frameTime(unstamped, 5'000'000), 5'000'000);
+
+        const auto stamped = makeV4L2Buffer(V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC, 1'000'000);
+        QCOMPARE_EQ(clock.frameTime(stamped, 5'033'000), 5'033'000);
+    }
+
+    void captureThread_requeuesBuffer_whenEnqueueFails()
+    {
+        const int deviceFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        QCOMPARE_GE(deviceFd, 0);
+
+        CaptureThreadFixture fixture(deviceFd);
+        fixture.memoryTransfer.failNextEnqueues(1);
+        fixture.thread.start();
+
+        signalFrame(deviceFd);
+        QTRY_COMPARE_EQ(fixture.frameCount.load(), 1);
+
+        // The failed buffer is handed back to the driver before capturing goes on
+        QTRY_COMPARE_EQ(fixture.memoryTransfer.enqueueAttempts(), QList<quint32>({ 0, 0 }));
+
+        signalFrame(deviceFd);
+        QTRY_COMPARE_EQ(fixture.frameCount.load(), 2);
+        QTRY_COMPARE_EQ(fixture.memoryTransfer.enqueueAttempts(), QList<quint32>({ 0, 0, 1 }));
+
+        fixture.thread.stop();
+        QCOMPARE_EQ(fixture.errorCount.load(), 0);
+    }
+
+    void captureThread_reportsNoDevice_whenDeviceHangsUp()
+    {
+        int pipeFds[2] = {};
+        QCOMPARE_EQ(qt_safe_pipe(pipeFds), 0);
+
+        CaptureThreadFixture fixture(pipeFds[0]);
+        fixture.thread.start();
+
+        qt_safe_close(pipeFds[1]);
+
+        QTRY_COMPARE_EQ(fixture.errorCount.load(), 1);
+        QCOMPARE_EQ(fixture.errors, QList<int>{ ENODEV });
+        QVERIFY(fixture.thread.wait());
+        QCOMPARE_EQ(fixture.frameCount.load(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_QV4L2CaptureThread)
+
+#include "tst_qv4l2capturethread.moc"
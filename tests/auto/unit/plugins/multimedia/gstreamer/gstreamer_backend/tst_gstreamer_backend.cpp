@@ -5,7 +5,12 @@
 
 #include <QtTest/qtest.h>
 
+#include <QtCore/qbuffer.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qresource.h>
 #include <QtCore/qtemporaryfile.h>
+#include <QtCore/qtimer.h>
 #include <QtMultimedia/qmediaformat.h>
 #include <QtGstreamerMediaPluginImpl/private/qgst_handle_types_p.h>
 #include <QtGstreamerMediaPluginImpl/private/qgst_p.h>
@@ -13,6 +18,7 @@
 #include <QtGstreamerMediaPluginImpl/private/qgst_discoverer_p.h>
 #include <QtGstreamerMediaPluginImpl/private/qgstpipeline_p.h>
 #include <QtGstreamerMediaPluginImpl/private/qgstreamermetadata_p.h>
+#include <QtGstreamerMediaPluginImpl/private/qgstreamer_qiodevice_handler_p.h>
 
 #include <set>
 #include <variant>
@@ -51,6 +57,167 @@ QGString makeQGString(std::string_view str)
 
 const bool validateBitRates = GST_CHECK_VERSION(1, 24, 0);
 
+QByteArray makeTestData(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = char(i * 31 + i / 251);
+    return data;
+}
+
+// Like a network stream: the data can only be read once, and the end is reported by read()
+// returning -1
+class SequentialBuffer : public QBuffer
+{
+public:
+    using QBuffer::QBuffer;
+
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 bytesRead = QBuffer::readData(data, maxSize);
+        return bytesRead == 0 ? -1 : bytesRead;
+    }
+};
+
+// Produces a chunk of data on each timer tick, from the thread of the device
+class ThrottledProducer : public QIODevice
+{
+public:
+    ThrottledProducer(QByteArray data, qsizetype chunkSize, std::chrono::milliseconds interval)
+        : m_data(std::move(data)), m_chunkSize(chunkSize)
+    {
+        m_timer.setInterval(interval);
+        connect(&m_timer, &QTimer::timeout, this, [this] {
+            m_produced = qMin(m_produced + m_chunkSize, m_data.size());
+            if (m_produced == m_data.size())
+                m_timer.stop();
+            emit readyRead();
+        });
+    }
+
+    bool open(OpenMode mode) override
+    {
+        m_timer.start();
+        return QIODevice::open(mode);
+    }
+
+    bool isSequential() const override { return true; }
+
+    qint64 bytesAvailable() const override
+    {
+        return m_produced - m_consumed + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        if (m_consumed == m_data.size())
+            return -1;
+
+        const qint64 size = qMin(maxSize, m_produced - m_consumed);
+        memcpy(data, m_data.constData() + m_consumed, size);
+        m_consumed += size;
+        return size;
+    }
+
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    const QByteArray m_data;
+    const qsizetype m_chunkSize;
+    qsizetype m_produced = 0;
+    qsizetype m_consumed = 0;
+    QTimer m_timer;
+};
+
+struct GstSourceResult
+{
+    QByteArray data;
+    QList<const guint8 *> bufferData; // address of the data of each buffer
+    bool endOfStream = false;
+    bool buffering = false;
+    QString error;
+};
+
+// Plays the source element through a fakesink while running the event loop of this thread
+GstSourceResult readWithGstSource(const QByteArray &sourceDescription)
+{
+    using namespace std::chrono_literals;
+
+    struct Sink
+    {
+        QMutex mutex;
+        QByteArray data;
+        QList<const guint8 *> bufferData;
+    } sink;
+
+    GstSourceResult result;
+
+    const QByteArray description =
+            sourceDescription + " ! fakesink name=sink signal-handoffs=true sync=false"_ba;
+    QGstElement pipeline = QGstElement::createFromPipelineDescription(description.constData());
+    if (!pipeline) {
+        result.error = u"Can't create the pipeline"_s;
+        return result;
+    }
+
+    QGstBin bin{ qGstSafeCast<GstBin>(pipeline.element()), QGstBin::NeedsRef };
+    g_signal_connect(bin.findByName("sink").element(), "handoff",
+                     G_CALLBACK(+[](GstElement *, GstBuffer *buffer, GstPad *, gpointer sink) {
+                         GstMapInfo info;
+                         if (!gst_buffer_map(buffer, &info, GST_MAP_READ))
+                             return;
+                         auto *s = static_cast<Sink *>(sink);
+                         QMutexLocker locker(&s->mutex);
+                         s->data.append(reinterpret_cast<const char *>(info.data), info.size);
+                         s->bufferData.append(info.data);
+                         gst_buffer_unmap(buffer, &info);
+                     }),
+                     &sink);
+
+    QGstBusHandle bus{ gst_element_get_bus(pipeline.element()), QGstBusHandle::HasRef };
+    gst_element_set_state(pipeline.element(), GST_STATE_PLAYING);
+
+    const QDeadlineTimer deadline(10s);
+    while (!result.endOfStream && result.error.isEmpty() && !deadline.hasExpired()) {
+        QTest::qWait(1);
+        while (GstMessage *message = gst_bus_pop(bus.get())) {
+            switch (GST_MESSAGE_TYPE(message)) {
+            case GST_MESSAGE_EOS:
+                result.endOfStream = true;
+                break;
+            case GST_MESSAGE_BUFFERING:
+                result.buffering = true;
+                break;
+            case GST_MESSAGE_ERROR:
+                result.error = u"Pipeline error"_s;
+                break;
+            default:
+                break;
+            }
+            gst_message_unref(message);
+        }
+    }
+
+    gst_element_set_state(pipeline.element(), GST_STATE_NULL);
+    // let the device thread delete the stream reader
+    QCoreApplication::processEvents();
+
+    result.data = sink.data;
+    result.bufferData = sink.bufferData;
+    return result;
+}
+
+// Plays the device through qiodevicesrc, running the event loop of the device thread
+GstSourceResult readWithQIODeviceSrc(QIODevice *device)
+{
+    return readWithGstSource("qiodevicesrc uri=\""_ba + qGstRegisterQIODevice(device).toEncoded()
+                             + "\""_ba);
+}
+
 } // namespace
 
 QGstTagListHandle tst_GStreamer::parseTagList(const char *str)
@@ -592,6 +759,79 @@ void tst_GStreamer::QGstDiscoverer_filtersOutVideoStream_whenStreamIdIsNull()
     QVERIFY(!result->videoStreams[0].streamID.isNull());
 }
 
+void tst_GStreamer::qiodevicesrc_readsRandomAccessDevice()
+{
+    const QByteArray data = makeTestData(1024 * 1024);
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    GstSourceResult result = readWithQIODeviceSrc(&buffer);
+
+    QCOMPARE(result.error, QString());
+    QVERIFY(result.endOfStream);
+    QCOMPARE_EQ(result.data.size(), data.size());
+    QCOMPARE_EQ(result.data, data);
+}
+
+void tst_GStreamer::qiodevicesrc_readsSequentialDevice_inPushMode()
+{
+    const QByteArray data = makeTestData(3 * 1024 * 1024 + 123);
+    SequentialBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    GstSourceResult result = readWithQIODeviceSrc(&buffer);
+
+    QCOMPARE(result.error, QString());
+    QVERIFY(result.endOfStream);
+    QCOMPARE_EQ(result.data.size(), data.size());
+    QCOMPARE_EQ(result.data, data);
+}
+
+void tst_GStreamer::qiodevicesrc_readsThrottledProducer_andPostsBufferingMessages()
+{
+    using namespace std::chrono_literals;
+
+    const QByteArray data = makeTestData(1024 * 1024);
+    ThrottledProducer producer(data, 16 * 1024, 2ms);
+    QVERIFY(producer.open(QIODevice::ReadOnly));
+
+    GstSourceResult result = readWithQIODeviceSrc(&producer);
+
+    QCOMPARE(result.error, QString());
+    QVERIFY(result.endOfStream);
+    QVERIFY(result.buffering);
+    QCOMPARE_EQ(result.data.size(), data.size());
+    QCOMPARE_EQ(result.data, data);
+}
+
+void tst_GStreamer::qrcsrc_wrapsUncompressedResourceData_withoutCopying()
+{
+    const QResource resource(u":/metadata_test_file.mp4"_s);
+    QVERIFY(resource.isValid());
+    if (resource.compressionAlgorithm() != QResource::NoCompression)
+        QSKIP("The test resource is compressed, it is read by copying");
+
+    const auto *resourceBegin = resource.data();
+    const auto *resourceEnd = resourceBegin + resource.size();
+
+    GstSourceResult result = readWithGstSource("qrcsrc uri=qrc:/metadata_test_file.mp4"_ba);
+
+    QCOMPARE(result.error, QString());
+    QVERIFY(result.endOfStream);
+    QCOMPARE_EQ(result.data.size(), resource.size());
+    QCOMPARE_EQ(result.data, QByteArrayView(resourceBegin, resource.size()));
+
+    QCOMPARE_GT(result.bufferData.size(), 1);
+    qint64 offset = 0;
+    for (const guint8 *data : std::as_const(result.bufferData)) {
+        QVERIFY(data >= resourceBegin && data < resourceEnd);
+        QCOMPARE_EQ(data - resourceBegin, offset);
+        offset += 16384; // default block size
+    }
+}
+
 QTEST_GUILESS_MAIN(tst_GStreamer)
 
 #include "moc_tst_gstreamer_backend.cpp"
@@ -57,6 +57,12 @@ private slots:
     void QGstDiscoverer_discoverMedia_withRotation();
     void QGstDiscoverer_filtersOutVideoStream_whenStreamIdIsNull();
 
+    void qiodevicesrc_readsRandomAccessDevice();
+    void qiodevicesrc_readsSequentialDevice_inPushMode();
+    void qiodevicesrc_readsThrottledProducer_andPostsBufferingMessages();
+
+    void qrcsrc_wrapsUncompressedResourceData_withoutCopying();
+
 private:
     QGstreamerIntegration integration;
 };
@@ -0,0 +1,388 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+
+#include <QtCore/qrandom.h>
+#include <QtSpatialAudio/qaudioengine.h>
+#include <QtSpatialAudio/qaudiolistener.h>
+#include <QtSpatialAudio/qaudioroom.h>
+#include <QtSpatialAudio/qspatialsound.h>
+#include <QtSpatialAudio/private/qaudioengine_p.h>
+#include <QtSpatialAudio/private/qaudioroomindex_p.h>
+#include <QtSpatialAudio/private/qspatialsound_p.h>
+
+#include <limits>
+#include <memory>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using Wall = QAudioRoom::Wall;
+
+namespace {
+
+QAudioRoomGeometry box(QVector3D position, QVector3D dimensions, QQuaternion rotation = {})
+{
+    QAudioRoomGeometry room;
+    room.position = position;
+    room.dimensions = dimensions;
+    room.rotation = rotation;
+    return room;
+}
+
+// The lookup the engine did before rooms were indexed
+int linearRoomAt(const QList<QAudioRoomGeometry> &rooms, QVector3D pos)
+{
+    int result = -1;
+    float resultVolume = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < rooms.size(); ++i) {
+        if (rooms[i].volume() <= resultVolume && rooms[i].contains(pos)) {
+            result = i;
+            resultVolume = rooms[i].volume();
+        }
+    }
+    return result;
+}
+
+// Rooms of 4 x 3 x 4 meters on a grid, sharing their walls
+QList<QAudioRoomGeometry> floorPlan(int columns, int rows)
+{
+    QList<QAudioRoomGeometry> rooms;
+    for (int x = 0; x < columns; ++x) {
+        for (int z = 0; z < rows; ++z)
+            rooms.append(box({ 4.f * x, 1.5f, 4.f * z }, { 4.f, 3.f, 4.f }));
+    }
+    return rooms;
+}
+
+// A floor plan with closets in some rooms, inside the outline of the building
+QList<QAudioRoomGeometry> buildingWithNestedRooms()
+{
+    QList<QAudioRoomGeometry> rooms;
+    rooms.append(box({ 18.f, 1.5f, 18.f }, { 44.f, 3.f, 44.f }));
+    rooms.append(floorPlan(10, 10));
+    for (int i = 0; i < 10; ++i)
+        rooms.append(box({ 8.f * i + 1.f, 1.5f, 4.f * i + 1.f }, { 1.f, 2.5f, 1.f }));
+    return rooms;
+}
+
+QList<QAudioRoomGeometry> randomRotatedRooms()
+{
+    QRandomGenerator random(7);
+    QList<QAudioRoomGeometry> rooms;
+    for (int i = 0; i < 200; ++i) {
+        const QVector3D position(float(random.bounded(100.)), float(random.bounded(10.)),
+                                 float(random.bounded(100.)));
+        const QVector3D dimensions(1.f + float(random.bounded(20.)),
+                                   1.f + float(random.bounded(5.)),
+                                   1.f + float(random.bounded(20.)));
+        const auto rotation = QQuaternion::fromEulerAngles(float(random.bounded(360.)),
+                                                           float(random.bounded(360.)),
+                                                           float(random.bounded(360.)));
+        rooms.append(box(position, dimensions, rotation));
+    }
+    return rooms;
+}
+
+} // namespace
+
+class tst_QAudioRoom : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roomAt_returnsNoRoom_forEmptyIndex();
+    void roomAt_returnsSmallestRoom_whenRoomsAreNested();
+    void roomAt_returnsLastRoom_whenRoomsAreEqual();
+    void roomAt_handlesRotatedRooms();
+    void roomAt_skipsExcludedRoom();
+    void roomAt_matchesLinearScan_data();
+    void roomAt_matchesLinearScan();
+
+    void connections_areEmpty_forClosedWalls();
+    void connections_followOpening_intoAdjacentRoom();
+    void connections_areNotMirrored_whenBothRoomsHaveOpenings();
+    void connections_leadOutside_whenNoRoomIsBehindOpening();
+    void connections_splitOpening_betweenRoomsBehindWall();
+
+    void engine_tracksRoomOfListener();
+    void engine_passesSoundThroughOpening_fromConnectedRoom();
+};
+
+void tst_QAudioRoom::roomAt_returnsNoRoom_forEmptyIndex()
+{
+    QAudioRoomIndex index;
+    QCOMPARE(index.roomAt({}), -1);
+
+    index.build({});
+    QCOMPARE(index.roomAt({}), -1);
+    QVERIFY(index.connections(0).empty());
+}
+
+void tst_QAudioRoom::roomAt_returnsSmallestRoom_whenRoomsAreNested()
+{
+    QAudioRoomIndex index;
+    index.build({
+            box({}, { 100.f, 10.f, 100.f }),
+            box({}, { 10.f, 3.f, 10.f }),
+            box({ 2.f, 0.f, 2.f }, { 1.f, 1.f, 1.f }),
+    });
+
+    QCOMPARE(index.roomAt({ 2.f, 0.f, 2.f }), 2);
+    QCOMPARE(index.roomAt({ -2.f, 0.f, -2.f }), 1);
+    QCOMPARE(index.roomAt({ 20.f, 0.f, 20.f }), 0);
+    QCOMPARE(index.roomAt({ 60.f, 0.f, 0.f }), -1);
+}
+
+void tst_QAudioRoom::roomAt_returnsLastRoom_whenRoomsAreEqual()
+{
+    QAudioRoomIndex index;
+    index.build({ box({}, { 4.f, 3.f, 4.f }), box({}, { 4.f, 3.f, 4.f }) });
+
+    QCOMPARE(index.roomAt({}), 1);
+    QCOMPARE(index.roomAt({}, 1), 0);
+}
+
+void tst_QAudioRoom::roomAt_handlesRotatedRooms()
+{
+    QAudioRoomIndex index;
+    index.build({ box({ 10.f, 0.f, 0.f }, { 10.f, 2.f, 2.f },
+                      QQuaternion::fromAxisAndAngle(0.f, 1.f, 0.f, 90.f)) });
+
+    // The room extends along the z axis
+    QCOMPARE(index.roomAt({ 10.f, 0.f, 4.f }), 0);
+    QCOMPARE(index.roomAt({ 10.f, 0.f, -4.f }), 0);
+    QCOMPARE(index.roomAt({ 14.f, 0.f, 0.f }), -1);
+}
+
+void tst_QAudioRoom::roomAt_skipsExcludedRoom()
+{
+    QAudioRoomIndex index;
+    index.build({ box({}, { 10.f, 10.f, 10.f }), box({}, { 2.f, 2.f, 2.f }) });
+
+    QCOMPARE(index.roomAt({}), 1);
+    QCOMPARE(index.roomAt({}, 1), 0);
+    QCOMPARE(index.roomAt({}, 0), 1);
+}
+
+void tst_QAudioRoom::roomAt_matchesLinearScan_data()
+{
+    QTest::addColumn<QList<QAudioRoomGeometry>>("rooms");
+
+    QTest::addRow("floor plan 4x4") << floorPlan(4, 4);
+    QTest::addRow("floor plan 32x32") << floorPlan(32, 32);
+    QTest::addRow("building with nested rooms") << buildingWithNestedRooms();
+    QTest::addRow("random rotated rooms") << randomRotatedRooms();
+}
+
+void tst_QAudioRoom::roomAt_matchesLinearScan()
+{
+    QFETCH(QList<QAudioRoomGeometry>, rooms);
+
+    QAudioRoomIndex index;
+    index.build(rooms);
+    QCOMPARE(index.size(), rooms.size());
+
+    QRandomGenerator random(42);
+    for (int i = 0; i < 10000; ++i) {
+        const QVector3D pos(float(random.bounded(140.)) - 10.f, float(random.bounded(14.)) - 2.f,
+                            float(random.bounded(140.)) - 10.f);
+        QCOMPARE(index.roomAt(pos), linearRoomAt(rooms, pos));
+    }
+
+    // Room centers and corners
+    for (const auto &room : rooms) {
+        for (QVector3D offset : { QVector3D(), QVector3D(0.49f, 0.49f, 0.49f) }) {
+            const QVector3D pos = room.toWorldCoordinates(offset * room.dimensions);
+            QCOMPARE(index.roomAt(pos), linearRoomAt(rooms, pos));
+        }
+    }
+}
+
+void tst_QAudioRoom::connections_areEmpty_forClosedWalls()
+{
+    QAudioRoomIndex index;
+    index.build(floorPlan(3, 3));
+
+    for (int i = 0; i < index.size(); ++i)
+        QVERIFY(index.connections(i).empty());
+}
+
+void tst_QAudioRoom::connections_followOpening_intoAdjacentRoom()
+{
+    QList<QAudioRoomGeometry> rooms = floorPlan(2, 1);
+    rooms[0].wallOpening[Wall::RightWall] = 0.25f;
+
+    QAudioRoomIndex index;
+    index.build(rooms);
+
+    QCOMPARE(index.connections(0).size(), qsizetype(1));
+    const auto connection = index.connections(0).front();
+    QCOMPARE(connection.room, 1);
+    QCOMPARE(connection.wall, Wall::RightWall);
+    QCOMPARE(connection.openingArea, 3.f);
+    QCOMPARE(index.openingFraction(0, Wall::RightWall, 1), 0.25f);
+    QCOMPARE(index.openingFraction(0, Wall::LeftWall, 1), 0.f);
+    QCOMPARE(index.openingFraction(0, Wall::RightWall, -1), 0.f);
+
+    // The other room sees the opening in its facing wall
+    QCOMPARE(index.connections(1).size(), qsizetype(1));
+    QCOMPARE(index.connections(1).front().room, 0);
+    QCOMPARE(index.openingFraction(1, Wall::LeftWall, 0), 0.25f);
+}
+
+void tst_QAudioRoom::connections_areNotMirrored_whenBothRoomsHaveOpenings()
+{
+    QList<QAudioRoomGeometry> rooms = floorPlan(2, 1);
+    rooms[0].wallOpening[Wall::RightWall] = 0.25f;
+    rooms[1].wallOpening[Wall::LeftWall] = 0.5f;
+
+    QAudioRoomIndex index;
+    index.build(rooms);
+
+    QCOMPARE(index.connections(0).size(), qsizetype(1));
+    QCOMPARE(index.openingFraction(0, Wall::RightWall, 1), 0.25f);
+    QCOMPARE(index.connections(1).size(), qsizetype(1));
+    QCOMPARE(index.openingFraction(1, Wall::LeftWall, 0), 0.5f);
+}
+
+void tst_QAudioRoom::connections_leadOutside_whenNoRoomIsBehindOpening()
+{
+    QList<QAudioRoomGeometry> rooms = floorPlan(2, 1);
+    rooms[0].wallOpening[Wall::Ceiling] = 1.f;
+    rooms[0].wallOpening[Wall::LeftWall] = 0.5f;
+
+    QAudioRoomIndex index;
+    index.build(rooms);
+
+    QCOMPARE(index.connections(0).size(), qsizetype(2));
+    QCOMPARE(index.openingFraction(0, Wall::Ceiling, -1), 1.f);
+    QCOMPARE(index.openingFraction(0, Wall::LeftWall, -1), 0.5f);
+    QVERIFY(index.connections(1).empty());
+}
+
+void tst_QAudioRoom::connections_splitOpening_betweenRoomsBehindWall()
+{
+    // A corridor along the x axis, with three rooms behind its back wall
+    QList<QAudioRoomGeometry> rooms = {
+        box({ 0.f, 1.5f, 0.f }, { 12.f, 3.f, 2.f }),
+        box({ -4.f, 1.5f, 3.f }, { 4.f, 3.f, 4.f }),
+        box({ 0.f, 1.5f, 3.f }, { 4.f, 3.f, 4.f }),
+        box({ 4.f, 1.5f, 3.f }, { 4.f, 3.f, 4.f }),
+    };
+    rooms[0].wallOpening[Wall::BackWall] = 1.f;
+
+    QAudioRoomIndex index;
+    index.build(rooms);
+
+    QCOMPARE(index.connections(0).size(), qsizetype(3));
+    for (int room = 1; room <= 3; ++room) {
+        QCOMPARE(index.openingFraction(0, Wall::BackWall, room), 1.f / 3.f);
+        QCOMPARE(index.connections(room).size(), qsizetype(1));
+        QCOMPARE(index.connections(room).front().wall, Wall::FrontWall);
+        QCOMPARE(index.connections(room).front().room, 0);
+    }
+}
+
+void tst_QAudioRoom::engine_tracksRoomOfListener()
+{
+    QAudioEngine engine;
+    engine.setDistanceScale(QAudioEngine::DistanceScaleMeter);
+    QAudioEnginePrivate *d = QAudioEnginePrivate::get(&engine);
+
+    QAudioRoom roomA(&engine);
+    roomA.setPosition({ 0.f, 1.5f, 0.f });
+    roomA.setDimensions({ 4.f, 3.f, 4.f });
+    QAudioRoom roomB(&engine);
+    roomB.setPosition({ 4.f, 1.5f, 0.f });
+    roomB.setDimensions({ 4.f, 3.f, 4.f });
+
+    QAudioListener listener(&engine);
+    auto updateRooms = [&] {
+        QMutexLocker locker(&d->mutex);
+        d->updateRooms();
+    };
+
+    listener.setPosition({ 0.f, 1.5f, 0.f });
+    updateRooms();
+    QCOMPARE(d->currentRoom, &roomA);
+
+    listener.setPosition({ 4.5f, 1.5f, 0.f });
+    updateRooms();
+    QCOMPARE(d->currentRoom, &roomB);
+
+    // Moving the room away from the listener
+    roomB.setPosition({ 40.f, 1.5f, 0.f });
+    updateRooms();
+    QCOMPARE(d->currentRoom, nullptr);
+}
+
+void tst_QAudioRoom::engine_passesSoundThroughOpening_fromConnectedRoom()
+{
+    QAudioEngine engine;
+    engine.setDistanceScale(QAudioEngine::DistanceScaleMeter);
+    QAudioEnginePrivate *d = QAudioEnginePrivate::get(&engine);
+
+    // Three rooms in a row, with brick walls
+    std::unique_ptr<QAudioRoom> rooms[3];
+    for (int i = 0; i < 3; ++i) {
+        rooms[i] = std::make_unique<QAudioRoom>(&engine);
+        rooms[i]->setPosition({ 4.f * i, 1.5f, 0.f });
+        rooms[i]->setDimensions({ 4.f, 3.f, 4.f });
+        for (int wall = 0; wall < 6; ++wall)
+            rooms[i]->setWallMaterial(Wall(wall), QAudioRoom::BrickBare);
+    }
+
+    QAudioListener listener(&engine);
+    listener.setPosition({ 0.f, 1.5f, 0.f });
+
+    QSpatialSound nextRoomSound(&engine);
+    nextRoomSound.setPosition({ 4.f, 1.5f, 0.f });
+    QSpatialSound farRoomSound(&engine);
+    farRoomSound.setPosition({ 8.f, 1.5f, 0.f });
+    QSpatialSoundPrivate *nextSound = QSpatialSoundPrivate::get(&nextRoomSound);
+    QSpatialSoundPrivate *farSound = QSpatialSoundPrivate::get(&farRoomSound);
+
+    auto updateRooms = [&] {
+        QMutexLocker locker(&d->mutex);
+        d->updateRooms();
+    };
+
+    updateRooms();
+    QCOMPARE(d->currentRoom, rooms[0].get());
+    QVERIFY(nextSound->outsideListenerRoom);
+    QCOMPARE(nextSound->roomEffectsGain, 0.f);
+    QCOMPARE(nextSound->wallDampening, 0.4f);
+
+    // Half of the wall to the next room opens
+    rooms[0]->setWallOpening(Wall::RightWall, 0.5f);
+    QCOMPARE(rooms[0]->wallOpening(Wall::RightWall), 0.5f);
+    updateRooms();
+    QCOMPARE(nextSound->roomEffectsGain, 0.5f);
+    QCOMPARE(nextSound->wallDampening, 0.7f);
+    QCOMPARE(nextSound->wallOcclusion, 1.f);
+
+    // The opening doesn't lead to the room behind the next one
+    QCOMPARE(farSound->roomEffectsGain, 0.f);
+    QCOMPARE(farSound->wallDampening, 0.4f);
+
+    // The sound moves into the listener's room
+    nextRoomSound.setPosition({ 1.f, 1.5f, 0.f });
+    updateRooms();
+    QVERIFY(!nextSound->outsideListenerRoom);
+    QCOMPARE(nextSound->roomEffectsGain, 1.f);
+    QCOMPARE(nextSound->wallDampening, 1.f);
+
+    // Outside of all rooms, no walls are in the way
+    listener.setPosition({ 0.f, 10.f, 0.f });
+    updateRooms();
+    QCOMPARE(d->currentRoom, nullptr);
+    QCOMPARE(farSound->wallDampening, 1.f);
+    QCOMPARE(farSound->roomEffectsGain, 1.f);
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioRoom)
+
+#include "tst_qaudioroom.moc"
@@ -0,0 +1,317 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+
+#include <QtMultimedia/qaudiobuffer.h>
+#include <QtSpatialAudio/qaudioengine.h>
+#include <QtSpatialAudio/qaudiolistener.h>
+#include <QtSpatialAudio/qspatialsound.h>
+#include <QtSpatialAudio/private/qaudioengine_p.h>
+#include <QtSpatialAudio/private/qspatialsound_p.h>
+
+#include <cmath>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using Rendering = QSpatialSoundPrivate::Rendering;
+using RenderingQuality = QAudioEngine::RenderingQuality;
+
+namespace {
+
+// Each change of the rendering is faded over this number of buffers
+constexpr int fadeBuffers = QSpatialSoundPrivate::fadeFrames / QAudioEnginePrivate::bufferSize;
+
+// One second of a looped sine, instead of decoding a file
+void setSine(QSpatialSound &sound, int sampleRate)
+{
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(1);
+    format.setSampleFormat(QAudioFormat::Float);
+
+    QAudioBuffer buffer(sampleRate, format);
+    float *data = buffer.data<float>();
+    for (int i = 0; i < sampleRate; ++i)
+        data[i] = 0.5f * std::sin(2.f * float(M_PI) * 440.f * i / sampleRate);
+
+    QSpatialSoundPrivate *d = QSpatialSoundPrivate::get(&sound);
+    d->buffers = { buffer };
+    d->m_loops = QSpatialSound::Infinite;
+    d->play();
+}
+
+// An engine in headphone mode with automatic quality, driven as the audio thread does, but
+// without an audio device. The listener is at the origin.
+class AutomaticQualityEngine
+{
+public:
+    AutomaticQualityEngine() : d(QAudioEnginePrivate::get(&engine))
+    {
+        engine.setDistanceScale(QAudioEngine::DistanceScaleMeter);
+        engine.setRenderingQuality(RenderingQuality::Automatic);
+        listener.setPosition({});
+    }
+
+    void updateSourceRendering()
+    {
+        QMutexLocker locker(&d->mutex);
+        d->updateSourceRendering(/*ambisonicOutput=*/false);
+    }
+
+    void renderBuffer()
+    {
+        short output[2 * QAudioEnginePrivate::bufferSize];
+        QMutexLocker locker(&d->mutex);
+        QVERIFY(d->renderBuffer(output, 2, nullptr));
+    }
+
+    // Whether the sound passes its next buffer to its sources
+    bool renderSound(QSpatialSoundPrivate *sound)
+    {
+        float buf[QAudioEnginePrivate::bufferSize] = {};
+        QMutexLocker locker(&d->mutex);
+        return sound->renderBuffer(buf, QAudioEnginePrivate::bufferSize);
+    }
+
+    QAudioEngine engine;
+    QAudioEnginePrivate *d;
+    QAudioListener listener{ &engine };
+};
+
+} // namespace
+
+class tst_QSpatialSound : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void automaticRendering_followsDistanceAndGainThresholds_data();
+    void automaticRendering_followsDistanceAndGainThresholds();
+    void automaticRendering_keepsCurrentRendering_withinHysteresis_data();
+    void automaticRendering_keepsCurrentRendering_withinHysteresis();
+
+    void renderingQuality_isAdjustedToDistance_whenAutomatic();
+    void renderingQuality_crossFadesToNewSource_whenRenderingChanges();
+    void renderingQuality_waitsForCrossFade_beforeNextChange();
+    void renderingQuality_fadesOutAndStopsRendering_whenSoundIsInaudible();
+    void renderingQuality_isFixed_whenSetOnSound();
+};
+
+void tst_QSpatialSound::automaticRendering_followsDistanceAndGainThresholds_data()
+{
+    QTest::addColumn<float>("distance");
+    QTest::addColumn<float>("gain");
+    QTest::addColumn<Rendering>("expected");
+
+    QTest::newRow("near") << 1.f << 1.f << Rendering::BinauralHigh;
+    QTest::newRow("below high quality distance") << 2.9f << 1.f << Rendering::BinauralHigh;
+    QTest::newRow("at high quality distance") << 3.f << 1.f << Rendering::BinauralMedium;
+    QTest::newRow("below medium quality distance") << 9.9f << 1.f << Rendering::BinauralMedium;
+    QTest::newRow("at medium quality distance") << 10.f << 1.f << Rendering::BinauralLow;
+    QTest::newRow("below low quality distance") << 24.9f << 1.f << Rendering::BinauralLow;
+    QTest::newRow("at low quality distance") << 25.f << 1.f << Rendering::StereoPanning;
+
+    QTest::newRow("quiet, near") << 1.f << 0.02f << Rendering::BinauralMedium;
+    QTest::newRow("quiet, medium distance") << 5.f << 0.02f << Rendering::BinauralLow;
+    QTest::newRow("quiet, low distance") << 20.f << 0.02f << Rendering::StereoPanning;
+    QTest::newRow("quiet, far") << 30.f << 0.02f << Rendering::StereoPanning;
+
+    QTest::newRow("inaudible, near") << 1.f << 0.0005f << Rendering::Culled;
+    QTest::newRow("inaudible, far") << 30.f << 0.0005f << Rendering::Culled;
+}
+
+void tst_QSpatialSound::automaticRendering_followsDistanceAndGainThresholds()
+{
+    QFETCH(float, distance);
+    QFETCH(float, gain);
+    QFETCH(Rendering, expected);
+
+    QCOMPARE(QSpatialSoundPrivate::automaticRendering(distance, gain), expected);
+}
+
+void tst_QSpatialSound::automaticRendering_keepsCurrentRendering_withinHysteresis_data()
+{
+    QTest::addColumn<float>("distance");
+    QTest::addColumn<float>("gain");
+    QTest::addColumn<Rendering>("current");
+    QTest::addColumn<Rendering>("expected");
+
+    QTest::newRow("high, slightly beyond its distance")
+            << 3.2f << 1.f << Rendering::BinauralHigh << Rendering::BinauralHigh;
+    QTest::newRow("high, beyond the hysteresis")
+            << 3.4f << 1.f << Rendering::BinauralHigh << Rendering::BinauralMedium;
+    QTest::newRow("medium, slightly within high quality distance")
+            << 2.8f << 1.f << Rendering::BinauralMedium << Rendering::BinauralMedium;
+    QTest::newRow("medium, within the hysteresis")
+            << 2.6f << 1.f << Rendering::BinauralMedium << Rendering::BinauralHigh;
+    QTest::newRow("stereo panning, slightly within low quality distance")
+            << 24.f << 1.f << Rendering::StereoPanning << Rendering::StereoPanning;
+
+    QTest::newRow("quiet, slightly above quiet gain")
+            << 1.f << 0.031f << Rendering::BinauralMedium << Rendering::BinauralMedium;
+    QTest::newRow("quiet, above the hysteresis")
+            << 1.f << 0.034f << Rendering::BinauralMedium << Rendering::BinauralHigh;
+
+    QTest::newRow("culled, slightly above inaudible gain")
+            << 1.f << 0.00105f << Rendering::Culled << Rendering::Culled;
+    QTest::newRow("culled, above the hysteresis")
+            << 1.f << 0.0012f << Rendering::Culled << Rendering::BinauralMedium;
+    QTest::newRow("audible, slightly below inaudible gain")
+            << 1.f << 0.00095f << Rendering::BinauralMedium << Rendering::BinauralMedium;
+}
+
+void tst_QSpatialSound::automaticRendering_keepsCurrentRendering_withinHysteresis()
+{
+    QFETCH(float, distance);
+    QFETCH(float, gain);
+    QFETCH(Rendering, current);
+    QFETCH(Rendering, expected);
+
+    QCOMPARE(QSpatialSoundPrivate::automaticRendering(distance, gain, current), expected);
+}
+
+void tst_QSpatialSound::renderingQuality_isAdjustedToDistance_whenAutomatic()
+{
+    AutomaticQualityEngine engine;
+
+    QSpatialSound nearSound(&engine.engine);
+    nearSound.setPosition({ 0.f, 0.f, 1.f });
+    QSpatialSound middleSound(&engine.engine);
+    middleSound.setPosition({ 0.f, 0.f, 5.f });
+    QSpatialSound farSound(&engine.engine);
+    farSound.setPosition({ 0.f, 0.f, 15.f });
+
+    engine.updateSourceRendering();
+
+    QCOMPARE(QSpatialSoundPrivate::get(&nearSound)->rendering, Rendering::BinauralHigh);
+    QCOMPARE(QSpatialSoundPrivate::get(&middleSound)->rendering, Rendering::BinauralMedium);
+    QCOMPARE(QSpatialSoundPrivate::get(&farSound)->rendering, Rendering::BinauralLow);
+    QCOMPARE(QSpatialSoundPrivate::get(&farSound)->sourceRendering, Rendering::BinauralLow);
+}
+
+void tst_QSpatialSound::renderingQuality_crossFadesToNewSource_whenRenderingChanges()
+{
+    AutomaticQualityEngine engine;
+
+    QSpatialSound sound(&engine.engine);
+    sound.setPosition({ 0.f, 0.f, 1.f });
+    setSine(sound, engine.engine.sampleRate());
+    QSpatialSoundPrivate *sd = QSpatialSoundPrivate::get(&sound);
+
+    engine.updateSourceRendering();
+    QCOMPARE(sd->rendering, Rendering::BinauralHigh);
+    QVERIFY(!sd->isFading());
+
+    const int highQualitySourceId = sd->sourceId;
+
+    sound.setPosition({ 0.f, 0.f, 5.f });
+    engine.updateSourceRendering();
+
+    QCOMPARE(sd->rendering, Rendering::BinauralMedium);
+    QCOMPARE(sd->sourceRendering, Rendering::BinauralMedium);
+    QCOMPARE(sd->fadingSourceId, highQualitySourceId);
+    QCOMPARE_NE(sd->sourceId, highQualitySourceId);
+    QCOMPARE(sd->fadingSourceGain, 1.f);
+    QCOMPARE(sd->sourceGain, 0.f);
+
+    // The new source fades in while the previous one fades out
+    for (int i = 1; i <= fadeBuffers; ++i) {
+        engine.renderBuffer();
+        QCOMPARE(sd->sourceGain, float(i) / fadeBuffers);
+        QCOMPARE(sd->fadingSourceGain, 1.f - float(i) / fadeBuffers);
+    }
+
+    // The previous source is destroyed once it has rendered its silent buffer
+    QCOMPARE(sd->fadingSourceId, highQualitySourceId);
+    engine.renderBuffer();
+    QCOMPARE(sd->fadingSourceId, -1);
+    QVERIFY(!sd->isFading());
+}
+
+void tst_QSpatialSound::renderingQuality_waitsForCrossFade_beforeNextChange()
+{
+    AutomaticQualityEngine engine;
+
+    QSpatialSound sound(&engine.engine);
+    sound.setPosition({ 0.f, 0.f, 1.f });
+    setSine(sound, engine.engine.sampleRate());
+    QSpatialSoundPrivate *sd = QSpatialSoundPrivate::get(&sound);
+    engine.updateSourceRendering();
+
+    sound.setPosition({ 0.f, 0.f, 5.f });
+    engine.updateSourceRendering();
+    const int mediumQualitySourceId = sd->sourceId;
+    engine.renderBuffer();
+
+    sound.setPosition({ 0.f, 0.f, 15.f });
+    engine.updateSourceRendering();
+    QCOMPARE(sd->rendering, Rendering::BinauralMedium);
+    QCOMPARE(sd->sourceId, mediumQualitySourceId);
+
+    for (int i = 0; i < fadeBuffers; ++i)
+        engine.renderBuffer();
+    QCOMPARE(sd->fadingSourceId, -1);
+
+    engine.updateSourceRendering();
+    QCOMPARE(sd->rendering, Rendering::BinauralLow);
+    QCOMPARE(sd->fadingSourceId, mediumQualitySourceId);
+}
+
+void tst_QSpatialSound::renderingQuality_fadesOutAndStopsRendering_whenSoundIsInaudible()
+{
+    AutomaticQualityEngine engine;
+
+    QSpatialSound sound(&engine.engine);
+    sound.setPosition({ 0.f, 0.f, 1.f });
+    setSine(sound, engine.engine.sampleRate());
+    QSpatialSoundPrivate *sd = QSpatialSoundPrivate::get(&sound);
+    engine.updateSourceRendering();
+    const int sourceId = sd->sourceId;
+
+    // Beyond the distance cutoff, the attenuation silences the sound
+    sound.setPosition({ 0.f, 0.f, 2.f * sound.distanceCutoff() });
+    engine.updateSourceRendering();
+
+    QCOMPARE(sd->rendering, Rendering::Culled);
+    QCOMPARE(sd->sourceId, sourceId);
+    QCOMPARE(sd->fadingSourceId, -1);
+
+    for (int i = 1; i <= fadeBuffers; ++i) {
+        engine.renderBuffer();
+        QCOMPARE(sd->sourceGain, 1.f - float(i) / fadeBuffers);
+    }
+
+    QVERIFY(!sd->isFading());
+    QVERIFY(!engine.renderSound(sd));
+
+    // Coming back into hearing range fades the kept source in again
+    sound.setPosition({ 0.f, 0.f, 1.f });
+    engine.updateSourceRendering();
+
+    QCOMPARE(sd->rendering, Rendering::BinauralHigh);
+    QCOMPARE(sd->sourceId, sourceId);
+    QVERIFY(engine.renderSound(sd));
+    QCOMPARE(sd->sourceGain, 1.f / fadeBuffers);
+}
+
+void tst_QSpatialSound::renderingQuality_isFixed_whenSetOnSound()
+{
+    AutomaticQualityEngine engine;
+
+    QSpatialSound sound(&engine.engine);
+    sound.setRenderingQuality(RenderingQuality::Low);
+    sound.setPosition({ 0.f, 0.f, 1.f });
+    engine.updateSourceRendering();
+    QCOMPARE(QSpatialSoundPrivate::get(&sound)->rendering, Rendering::BinauralLow);
+
+    sound.setPosition({ 0.f, 0.f, 2.f * sound.distanceCutoff() });
+    engine.updateSourceRendering();
+    QCOMPARE(QSpatialSoundPrivate::get(&sound)->rendering, Rendering::BinauralLow);
+}
+
+QTEST_GUILESS_MAIN(tst_QSpatialSound)
+
+#include "tst_qspatialsound.moc"
@@ -0,0 +1,170 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qrandom.h>
+#include <QtTest/qtest.h>
+
+#include <QtMultimedia/private/qaudiohelpers_p.h>
+#include <QtMultimedia/private/qaudio_qspan_support_p.h>
+
+#include <cstring>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+using NativeSampleFormat = QAudioHelperInternal::NativeSampleFormat;
+
+namespace {
+
+// 10ms of stereo audio at 48kHz
+constexpr qsizetype sampleCount = 960;
+
+qsizetype bytesPerSample(NativeSampleFormat format)
+{
+    return qsizetype(QAudioHelperInternal::bytesPerSample(format));
+}
+
+QAudioFormat makeAudioFormat(NativeSampleFormat format)
+{
+    QAudioFormat audioFormat;
+    switch (format) {
+    case NativeSampleFormat::int16_t:
+        audioFormat.setSampleFormat(QAudioFormat::Int16);
+        break;
+    case NativeSampleFormat::int32_t:
+        audioFormat.setSampleFormat(QAudioFormat::Int32);
+        break;
+    case NativeSampleFormat::float32_t:
+        audioFormat.setSampleFormat(QAudioFormat::Float);
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+    return audioFormat;
+}
+
+QByteArray makeRandomSamples(NativeSampleFormat format, qsizetype sampleCount)
+{
+    QRandomGenerator random(42);
+    QByteArray result(sampleCount * bytesPerSample(format), Qt::Uninitialized);
+
+    if (format == NativeSampleFormat::float32_t) {
+        for (qsizetype i = 0; i < sampleCount; ++i) {
+            const float value = float(random.bounded(2.0) - 1.0);
+            std::memcpy(result.data() + i * sizeof(float), &value, sizeof(float));
+        }
+    } else {
+        for (char &byte : result)
+            byte = char(random.bounded(256));
+    }
+    return result;
+}
+
+} // namespace
+
+class tst_bench_QAudioHelpers : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+
+    void convertSampleFormat_data();
+    void convertSampleFormat();
+    void applyVolume_data();
+    void applyVolume();
+};
+
+void tst_bench_QAudioHelpers::cleanup()
+{
+    QAudioHelperInternal::setSimdEnabled(true);
+}
+
+void tst_bench_QAudioHelpers::convertSampleFormat_data()
+{
+    QTest::addColumn<NativeSampleFormat>("sourceFormat");
+    QTest::addColumn<NativeSampleFormat>("destinationFormat");
+    QTest::addColumn<bool>("simd");
+    QTest::addColumn<QAudioHelperInternal::Dithering>("dithering");
+
+    const std::pair<NativeSampleFormat, NativeSampleFormat> conversions[] = {
+        { NativeSampleFormat::float32_t, NativeSampleFormat::int16_t },
+        { NativeSampleFormat::int16_t, NativeSampleFormat::float32_t },
+        { NativeSampleFormat::float32_t, NativeSampleFormat::int32_t },
+        { NativeSampleFormat::int32_t, NativeSampleFormat::float32_t },
+        { NativeSampleFormat::float32_t, NativeSampleFormat::int24_t_3b },
+        { NativeSampleFormat::int24_t_3b, NativeSampleFormat::float32_t },
+        { NativeSampleFormat::int16_t, NativeSampleFormat::int32_t },
+        { NativeSampleFormat::int32_t, NativeSampleFormat::int16_t },
+        { NativeSampleFormat::uint8_t, NativeSampleFormat::float32_t },
+    };
+
+    for (auto [sourceFormat, destinationFormat] : conversions) {
+        for (bool simd : { false, true }) {
+            QTest::addRow("%s to %s, %s", QDebug::toBytes(sourceFormat).constData(),
+                          QDebug::toBytes(destinationFormat).constData(),
+                          simd ? "simd" : "scalar")
+                    << sourceFormat << destinationFormat << simd
+                    << QAudioHelperInternal::Dithering::None;
+        }
+    }
+
+    QTest::addRow("float32_t to int16_t, dithered")
+            << NativeSampleFormat::float32_t << NativeSampleFormat::int16_t << true
+            << QAudioHelperInternal::Dithering::Triangular;
+}
+
+void tst_bench_QAudioHelpers::convertSampleFormat()
+{
+    QFETCH(NativeSampleFormat, sourceFormat);
+    QFETCH(NativeSampleFormat, destinationFormat);
+    QFETCH(bool, simd);
+    QFETCH(QAudioHelperInternal::Dithering, dithering);
+
+    const QByteArray source = makeRandomSamples(sourceFormat, sampleCount);
+    QByteArray destination(sampleCount * bytesPerSample(destinationFormat), Qt::Uninitialized);
+
+    QAudioHelperInternal::setSimdEnabled(simd);
+
+    QBENCHMARK {
+        QAudioHelperInternal::convertSampleFormat(as_bytes(QSpan{ source }), sourceFormat,
+                                                  as_writable_bytes(QSpan{ destination }),
+                                                  destinationFormat, dithering);
+    }
+}
+
+void tst_bench_QAudioHelpers::applyVolume_data()
+{
+    QTest::addColumn<NativeSampleFormat>("format");
+    QTest::addColumn<bool>("simd");
+
+    for (NativeSampleFormat format : { NativeSampleFormat::int16_t, NativeSampleFormat::int32_t,
+                                       NativeSampleFormat::float32_t }) {
+        for (bool simd : { false, true }) {
+            QTest::addRow("%s, %s", QDebug::toBytes(format).constData(),
+                          simd ? "simd" : "scalar")
+                    << format << simd;
+        }
+    }
+}
+
+void tst_bench_QAudioHelpers::applyVolume()
+{
+    QFETCH(NativeSampleFormat, format);
+    QFETCH(bool, simd);
+
+    const QAudioFormat audioFormat = makeAudioFormat(format);
+    QByteArray samples = makeRandomSamples(format, sampleCount);
+
+    QAudioHelperInternal::setSimdEnabled(simd);
+
+    // in place, like the audio sinks do
+    QBENCHMARK {
+        QAudioHelperInternal::applyVolume(0.5f, audioFormat, as_bytes(QSpan{ samples }),
+                                          as_writable_bytes(QSpan{ samples }));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QAudioHelpers)
+
+#include "tst_bench_qaudiohelpers.moc"
@@ -0,0 +1,141 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+
+#include <QtMultimedia/private/qaudioringbuffer_p.h>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+using RingBuffer = QtPrivate::QAudioRingBuffer<float>;
+
+class tst_bench_QAudioRingBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeAndConsume_data();
+    void writeAndConsume();
+    void produceSomeAndConsumeSome_data();
+    void produceSomeAndConsumeSome();
+    void writeAndConsume_concurrently_data();
+    void writeAndConsume_concurrently();
+
+private:
+    static void addBlockSizes();
+};
+
+void tst_bench_QAudioRingBuffer::addBlockSizes()
+{
+    QTest::addColumn<int>("bufferSize");
+    QTest::addColumn<int>("blockSize");
+
+    // audio callbacks typically transfer 64 to 1024 frames of stereo audio
+    for (int blockSize : { 128, 512, 2048 })
+        QTest::addRow("block %d", blockSize) << 8192 << blockSize;
+
+    // the ring buffer wraps around in the middle of every other block
+    QTest::addRow("block 3000, wrapping") << 8192 << 3000;
+}
+
+void tst_bench_QAudioRingBuffer::writeAndConsume_data()
+{
+    addBlockSizes();
+}
+
+void tst_bench_QAudioRingBuffer::writeAndConsume()
+{
+    QFETCH(int, bufferSize);
+    QFETCH(int, blockSize);
+
+    RingBuffer ringBuffer{ bufferSize };
+    const std::vector<float> input(blockSize, 0.5f);
+    std::vector<float> output(blockSize);
+
+    QBENCHMARK {
+        ringBuffer.write(QSpan{ input });
+
+        auto it = output.begin();
+        ringBuffer.consumeAll([&](QSpan<float> region) {
+            it = std::copy(region.begin(), region.end(), it);
+        });
+    }
+}
+
+void tst_bench_QAudioRingBuffer::produceSomeAndConsumeSome_data()
+{
+    addBlockSizes();
+}
+
+// Renders into and mixes out of the ring buffer memory without intermediate copies, the way
+// the audio engines use it
+void tst_bench_QAudioRingBuffer::produceSomeAndConsumeSome()
+{
+    QFETCH(int, bufferSize);
+    QFETCH(int, blockSize);
+
+    RingBuffer ringBuffer{ bufferSize };
+    std::vector<float> output(blockSize);
+
+    QBENCHMARK {
+        ringBuffer.produceSome([](QSpan<float> region) {
+            std::fill(region.begin(), region.end(), 0.5f);
+            return region;
+        }, blockSize);
+
+        auto it = output.begin();
+        ringBuffer.consumeSome([&](QSpan<float> region) {
+            it = std::transform(region.begin(), region.end(), it, it, std::plus<>());
+            return region;
+        });
+    }
+}
+
+void tst_bench_QAudioRingBuffer::writeAndConsume_concurrently_data()
+{
+    addBlockSizes();
+}
+
+// Measures the throughput of 1M samples with the producer and the consumer on different threads,
+// which includes the cost of sharing the read and write positions between the cores
+void tst_bench_QAudioRingBuffer::writeAndConsume_concurrently()
+{
+    QFETCH(int, bufferSize);
+    QFETCH(int, blockSize);
+
+    constexpr qsizetype totalSamples = 1024 * 1024;
+
+    QBENCHMARK {
+        RingBuffer ringBuffer{ bufferSize };
+        const std::vector<float> input(blockSize, 0.5f);
+
+        std::thread producer([&] {
+            qsizetype written = 0;
+            while (written < totalSamples) {
+                const qsizetype toWrite = std::min<qsizetype>(blockSize, totalSamples - written);
+                written += ringBuffer.write(QSpan{ input }.first(toWrite));
+            }
+        });
+
+        qsizetype consumed = 0;
+        float sum = 0;
+        while (consumed < totalSamples) {
+            consumed += ringBuffer.consumeAll([&](QSpan<float> region) {
+                for (float sample : region)
+                    sum += sample;
+            });
+        }
+
+        producer.join();
+        QCOMPARE(sum, totalSamples * 0.5f);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QAudioRingBuffer)
+
+#include "tst_bench_qaudioringbuffer.moc"
@@ -0,0 +1,97 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtMultimedia/qaudiodevice.h>
+#include <QtMultimedia/private/qplatformaudiodevices_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+using namespace std::chrono_literals;
+
+// Runs against a private pulseaudio daemon with null sinks, so that the results don't depend
+// on the audio setup of the machine
+class tst_bench_QPulseAudioBackend : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void startupLatency();
+
+private:
+    QTemporaryDir m_runtimeDir;
+    QProcess m_daemon;
+};
+
+void tst_bench_QPulseAudioBackend::initTestCase()
+{
+    const QString pulseaudio = QStandardPaths::findExecutable(u"pulseaudio"_s);
+    if (pulseaudio.isEmpty())
+        QSKIP("pulseaudio is not installed");
+    QVERIFY(m_runtimeDir.isValid());
+
+    const QString socket = m_runtimeDir.filePath(u"native"_s);
+
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(u"XDG_RUNTIME_DIR"_s, m_runtimeDir.path());
+    env.insert(u"HOME"_s, m_runtimeDir.path());
+    m_daemon.setProcessEnvironment(env);
+    m_daemon.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    m_daemon.start(pulseaudio,
+                   {
+                           u"-n"_s,
+                           u"--daemonize=no"_s,
+                           u"--exit-idle-time=-1"_s,
+                           u"--use-pid-file=no"_s,
+                           u"-L"_s,
+                           u"module-native-protocol-unix auth-anonymous=1 socket="_s + socket,
+                           u"-L"_s,
+                           u"module-null-sink sink_name=tst_sink_1"_s,
+                           u"-L"_s,
+                           u"module-null-sink sink_name=tst_sink_2"_s,
+                   });
+    if (!m_daemon.waitForStarted())
+        QSKIP("Cannot start pulseaudio");
+
+    // the daemon accepts connections once the socket exists
+    if (!QTest::qWaitFor([&] { return QFile::exists(socket); }, 10s))
+        QSKIP("pulseaudio did not come up");
+
+    qputenv("PULSE_SERVER", "unix:" + socket.toLocal8Bit());
+    qputenv("QT_AUDIO_BACKEND", "pulseaudio");
+
+    if (QPlatformAudioDevices::create()->backendName() != QLatin1String("PulseAudio"))
+        QSKIP("The PulseAudio backend is not available");
+}
+
+void tst_bench_QPulseAudioBackend::cleanupTestCase()
+{
+    if (m_daemon.state() != QProcess::NotRunning) {
+        m_daemon.terminate();
+        if (!m_daemon.waitForFinished())
+            m_daemon.kill();
+    }
+}
+
+void tst_bench_QPulseAudioBackend::startupLatency()
+{
+    // Time to first device list, which is what an application sees at startup
+    QBENCHMARK {
+        auto backend = QPlatformAudioDevices::create();
+        QVERIFY(!backend->audioOutputs().isEmpty());
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QPulseAudioBackend)
+
+#include "tst_bench_qpulseaudiobackend.moc"
@@ -0,0 +1,141 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+
+#include <QtCore/qmath.h>
+#include <QtMultimedia/qmediadevices.h>
+#include <QtMultimedia/private/qrtaudioengine_p.h>
+
+#include <cmath>
+#include <vector>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using QtMultimediaPrivate::QRtAudioEngine;
+using QtMultimediaPrivate::QRtAudioEngineVoice;
+using QtMultimediaPrivate::VoiceId;
+using QtMultimediaPrivate::VoicePlayResult;
+
+namespace {
+
+// Mixes a looped one second sine into the output, like a sound effect with volume
+struct SineVoice : public QRtAudioEngineVoice
+{
+    SineVoice(QAudioFormat format, VoiceId id, float frequency)
+        : QRtAudioEngineVoice(id), m_format(format), m_samples(format.sampleRate())
+    {
+        for (size_t i = 0; i != m_samples.size(); ++i)
+            m_samples[i] = std::sin(2.f * float(M_PI) * frequency * i / m_samples.size());
+    }
+
+    bool isActive() noexcept QT_MM_NONBLOCKING override { return true; }
+    const QAudioFormat &format() noexcept override { return m_format; }
+
+    VoicePlayResult play(QSpan<float> buffer) noexcept QT_MM_NONBLOCKING override
+    {
+        const int channelCount = m_format.channelCount();
+        for (qsizetype frame = 0; frame < buffer.size() / channelCount; ++frame) {
+            const float sample = m_samples[m_position] * m_volume;
+            for (int channel = 0; channel != channelCount; ++channel)
+                buffer[frame * channelCount + channel] += sample;
+            m_position = (m_position + 1) % m_samples.size();
+        }
+        return VoicePlayResult::Playing;
+    }
+
+    const QAudioFormat m_format;
+    std::vector<float> m_samples;
+    size_t m_position = 0;
+    float m_volume = 0.1f;
+};
+
+} // namespace
+
+class tst_bench_QRtAudioEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void mixVoices_data();
+    void mixVoices();
+
+private:
+    std::shared_ptr<QRtAudioEngine> m_engine;
+    QAudioFormat m_format;
+};
+
+void tst_bench_QRtAudioEngine::initTestCase()
+{
+    const QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (device.isNull())
+        QSKIP("No audio outputs found");
+
+    m_format = device.preferredFormat();
+    m_format.setSampleFormat(QAudioFormat::Float);
+    if (m_format.channelCount() > 2) {
+        m_format.setChannelCount(2);
+        m_format.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+    }
+
+    m_engine = QRtAudioEngine::getEngineFor(device, m_format);
+    if (!m_engine)
+        QSKIP("QRtAudioEngine is not supported for the default audio output");
+
+    // the engine is driven by the benchmark instead of the audio device. Starting to play
+    // voices does not resume a stopped sink
+    m_engine->audioSink().stop();
+}
+
+void tst_bench_QRtAudioEngine::cleanupTestCase()
+{
+    m_engine.reset();
+}
+
+void tst_bench_QRtAudioEngine::mixVoices_data()
+{
+    QTest::addColumn<int>("voiceCount");
+    QTest::addColumn<int>("frameCount");
+
+    for (int voiceCount : { 1, 8, 32, 128 }) {
+        for (int frameCount : { 256, 1024 })
+            QTest::addRow("%d voices, %d frames", voiceCount, frameCount)
+                    << voiceCount << frameCount;
+    }
+}
+
+void tst_bench_QRtAudioEngine::mixVoices()
+{
+    QFETCH(int, voiceCount);
+    QFETCH(int, frameCount);
+
+    std::vector<std::shared_ptr<SineVoice>> voices;
+    for (int i = 0; i != voiceCount; ++i) {
+        auto voice = std::make_shared<SineVoice>(m_format, QRtAudioEngine::allocateVoiceId(),
+                                                 220.f + 10.f * i);
+        m_engine->play(voice);
+        voices.push_back(std::move(voice));
+    }
+
+    std::vector<float> buffer(frameCount * m_format.channelCount());
+
+    // runs the play commands
+    m_engine->renderForTesting(buffer);
+
+    QBENCHMARK {
+        m_engine->renderForTesting(buffer);
+    }
+
+    for (const auto &voice : voices)
+        m_engine->stop(voice->voiceId());
+    m_engine->renderForTesting(buffer);
+}
+
+QTEST_MAIN(tst_bench_QRtAudioEngine)
+
+#include "tst_bench_qrtaudioengine.moc"
@@ -0,0 +1,92 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtMultimedia/qaudioformat.h>
+#include <QtMultimedia/private/qsamplecache_p.h>
+#include <QtMultimedia/private/qsoundeffectwithplayer_p.h>
+
+#include <vector>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using QtMultimediaPrivate::QSoundEffectVoice;
+using QtMultimediaPrivate::VoiceId;
+
+namespace {
+
+// Stores the floats with the given encoding; the values must be representable by it
+SharedSamplePtr createSample(const std::vector<float> &floats, const QAudioFormat &format,
+                             QSample::Encoding encoding)
+{
+    QByteArray data;
+    for (float value : floats) {
+        switch (encoding) {
+        case QSample::Encoding::Float:
+            data.append(reinterpret_cast<const char *>(&value), sizeof(float));
+            break;
+        case QSample::Encoding::Int16: {
+            const qint16 int16Value = qint16(value * 32768.f);
+            data.append(reinterpret_cast<const char *>(&int16Value), sizeof(qint16));
+            break;
+        }
+        case QSample::Encoding::PackedInt24: {
+            const qint32 int24Value = qint32(value * 8388608.f);
+            data.append(char(int24Value & 0xff));
+            data.append(char((int24Value >> 8) & 0xff));
+            data.append(char((int24Value >> 16) & 0xff));
+            break;
+        }
+        }
+    }
+    return std::make_shared<QSample>(data, format, encoding);
+}
+
+} // namespace
+
+class tst_bench_QSoundEffectVoice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void playVoice_data();
+    void playVoice();
+};
+
+void tst_bench_QSoundEffectVoice::playVoice_data()
+{
+    QTest::addColumn<int>("encoding");
+
+    QTest::newRow("Float") << int(QSample::Encoding::Float);
+    QTest::newRow("Int16") << int(QSample::Encoding::Int16);
+    QTest::newRow("PackedInt24") << int(QSample::Encoding::PackedInt24);
+}
+
+void tst_bench_QSoundEffectVoice::playVoice()
+{
+    QFETCH(const int, encoding);
+
+    // one second of stereo audio
+    constexpr int sampleRate = 48000;
+    std::vector<float> sampleData(2 * sampleRate);
+    for (size_t i = 0; i < sampleData.size(); ++i)
+        sampleData[i] = float(int(i % 256) - 128) / 256.f;
+
+    QAudioFormat sampleFormat;
+    sampleFormat.setSampleFormat(QAudioFormat::Float);
+    sampleFormat.setChannelCount(2);
+    sampleFormat.setSampleRate(sampleRate);
+    const SharedSamplePtr sample = createSample(sampleData, sampleFormat, QSample::Encoding(encoding));
+
+    std::vector<float> buffer(sampleData.size());
+    QBENCHMARK {
+        QSoundEffectVoice voice(VoiceId{ 0 }, sample, 0.8f, false, 1, sampleFormat);
+        voice.playVoice(buffer);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QSoundEffectVoice)
+
+#include "tst_bench_qsoundeffectvoice.moc"
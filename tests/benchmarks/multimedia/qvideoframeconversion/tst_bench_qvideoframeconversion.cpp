@@ -0,0 +1,202 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+
+#include <QtGui/qimage.h>
+#include <QtGui/rhi/qrhi.h>
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/private/qhwvideobuffer_p.h>
+#include <QtMultimedia/private/qvideoframe_p.h>
+#include <QtMultimedia/private/qvideoframeconversionhelper_p.h>
+#include <QtMultimedia/private/qvideoframeconverter_p.h>
+
+#include <memory>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+namespace {
+
+// Frame content doesn't affect the conversion speed much, but keep it deterministic
+QVideoFrame makeFrame(QVideoFrameFormat::PixelFormat pixelFormat, QSize size)
+{
+    QVideoFrame frame(QVideoFrameFormat(size, pixelFormat));
+    if (!frame.map(QVideoFrame::WriteOnly))
+        return {};
+
+    for (int plane = 0; plane < frame.planeCount(); ++plane) {
+        uchar *bits = frame.bits(plane);
+        for (int i = 0; i < frame.mappedBytes(plane); ++i)
+            bits[i] = uchar(i * 7 + plane * 64);
+    }
+    frame.unmap();
+    return frame;
+}
+
+// A buffer of the rhi, so that qImageFromVideoFrame() takes the GPU path. The frame is
+// uploaded from memory, like the frames of the software decoders.
+class RhiVideoBuffer : public QHwVideoBuffer
+{
+public:
+    RhiVideoBuffer(QVideoFrame frame, QRhi *rhi)
+        : QHwVideoBuffer(QVideoFrame::NoHandle, rhi), m_frame(std::move(frame))
+    {
+    }
+
+    QVideoFrameFormat format() const override { return m_frame.surfaceFormat(); }
+
+    MapData map(QVideoFrame::MapMode mode) override
+    {
+        MapData mapData;
+        if (!m_frame.map(mode))
+            return mapData;
+
+        mapData.planeCount = m_frame.planeCount();
+        for (int plane = 0; plane < mapData.planeCount; ++plane) {
+            mapData.bytesPerLine[plane] = m_frame.bytesPerLine(plane);
+            mapData.data[plane] = m_frame.bits(plane);
+            mapData.dataSize[plane] = m_frame.mappedBytes(plane);
+        }
+        return mapData;
+    }
+
+    void unmap() override { m_frame.unmap(); }
+
+private:
+    QVideoFrame m_frame;
+};
+
+} // namespace
+
+class tst_bench_QVideoFrameConversion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void converterForFormat_data();
+    void converterForFormat();
+    void imageFromVideoFrame_cpu_data();
+    void imageFromVideoFrame_cpu();
+    void imageFromVideoFrame_nullRhi_data();
+    void imageFromVideoFrame_nullRhi();
+
+private:
+    static void addFormatsAndResolutions();
+
+    std::unique_ptr<QRhi> m_nullRhi;
+};
+
+void tst_bench_QVideoFrameConversion::initTestCase()
+{
+    QRhiNullInitParams params;
+    m_nullRhi.reset(QRhi::create(QRhi::Null, &params));
+}
+
+void tst_bench_QVideoFrameConversion::cleanupTestCase()
+{
+    m_nullRhi.reset();
+}
+
+void tst_bench_QVideoFrameConversion::addFormatsAndResolutions()
+{
+    QTest::addColumn<QVideoFrameFormat::PixelFormat>("pixelFormat");
+    QTest::addColumn<QSize>("size");
+
+    const QSize sizes[] = { { 640, 480 }, { 1920, 1080 }, { 3840, 2160 } };
+
+    for (int i = QVideoFrameFormat::Format_Invalid + 1; i < QVideoFrameFormat::NPixelFormats;
+         ++i) {
+        const auto pixelFormat = QVideoFrameFormat::PixelFormat(i);
+        if (pixelFormat == QVideoFrameFormat::Format_Jpeg || !qConverterForFormat(pixelFormat))
+            continue;
+
+        for (QSize size : sizes) {
+            QTest::addRow("%s, %dx%d",
+                          qPrintable(QVideoFrameFormat::pixelFormatToString(pixelFormat)),
+                          size.width(), size.height())
+                    << pixelFormat << size;
+        }
+    }
+}
+
+void tst_bench_QVideoFrameConversion::converterForFormat_data()
+{
+    addFormatsAndResolutions();
+}
+
+void tst_bench_QVideoFrameConversion::converterForFormat()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, size);
+
+    QVideoFrame frame = makeFrame(pixelFormat, size);
+    QVERIFY(frame.isValid());
+
+    const VideoFrameConvertFunc convert = qConverterForFormat(pixelFormat);
+    QVERIFY(convert);
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+
+    QVERIFY(frame.map(QVideoFrame::ReadOnly));
+    QBENCHMARK {
+        convert(frame, image.bits());
+    }
+    frame.unmap();
+}
+
+void tst_bench_QVideoFrameConversion::imageFromVideoFrame_cpu_data()
+{
+    addFormatsAndResolutions();
+}
+
+// Includes mapping the frame and allocating the image
+void tst_bench_QVideoFrameConversion::imageFromVideoFrame_cpu()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, size);
+
+    const QVideoFrame frame = makeFrame(pixelFormat, size);
+    QVERIFY(frame.isValid());
+
+    QBENCHMARK {
+        const QImage image = qImageFromVideoFrame(frame, /*forceCpu=*/true);
+        QCOMPARE(image.size(), size);
+    }
+}
+
+void tst_bench_QVideoFrameConversion::imageFromVideoFrame_nullRhi_data()
+{
+    addFormatsAndResolutions();
+}
+
+// The Null backend doesn't render, so this measures the CPU side of the GPU path: creating the
+// pipeline, uploading the planes and reading back the image
+void tst_bench_QVideoFrameConversion::imageFromVideoFrame_nullRhi()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, size);
+
+    if (!m_nullRhi)
+        QSKIP("Cannot create the Null RHI");
+
+    const QVideoFrame memoryFrame = makeFrame(pixelFormat, size);
+    QVERIFY(memoryFrame.isValid());
+
+    const QVideoFrame frame = QVideoFramePrivate::createFrame(
+            std::make_unique<RhiVideoBuffer>(memoryFrame, m_nullRhi.get()),
+            memoryFrame.surfaceFormat());
+
+    QBENCHMARK {
+        const QImage image = qImageFromVideoFrame(frame);
+        QCOMPARE(image.size(), size);
+    }
+}
+
+QTEST_MAIN(tst_bench_QVideoFrameConversion)
+
+#include "tst_bench_qvideoframeconversion.moc"
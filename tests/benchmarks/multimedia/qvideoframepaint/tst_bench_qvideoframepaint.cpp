@@ -0,0 +1,191 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qimage.h>
+#include <QtGui/qpainter.h>
+#include <QtMultimedia/qvideoframe.h>
+#include <QtMultimedia/private/qvideoframeconverter_p.h>
+#include <QtMultimedia/private/qvideotexturehelper_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+QVideoFrame makeFrame(QVideoFrameFormat::PixelFormat pixelFormat, QSize size)
+{
+    QVideoFrame frame(QVideoFrameFormat(size, pixelFormat));
+    if (!frame.map(QVideoFrame::WriteOnly))
+        return {};
+
+    for (int plane = 0; plane < frame.planeCount(); ++plane) {
+        uchar *bits = frame.bits(plane);
+        for (int i = 0; i < frame.mappedBytes(plane); ++i)
+            bits[i] = uchar(i * 7 + plane * 64);
+    }
+    frame.unmap();
+    return frame;
+}
+
+// Mapping for writing drops the images cached in the frame, as if a new frame was painted
+void dropCachedImages(QVideoFrame &frame)
+{
+    if (frame.map(QVideoFrame::WriteOnly))
+        frame.unmap();
+}
+
+// The paint path before it converted straight into the target size: the frame is converted
+// at full resolution, and QPainter scales it.
+void paintFullResolution(QPainter &painter, const QRectF &rect, const QVideoFrame &frame)
+{
+    painter.drawImage(rect, qImageFromVideoFrame(frame, /*forceCpu=*/true));
+}
+
+} // namespace
+
+class tst_bench_QVideoFramePaint : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void paint_data();
+    void paint_fullResolution_data() { paint_data(); }
+    void paint_fullResolution();
+    void paint_newFrame_data() { paint_data(); }
+    void paint_newFrame();
+    void paint_sameFrame_data() { paint_data(); }
+    void paint_sameFrame();
+
+    void subtitles_newLayout();
+    void subtitles_cachedLayout();
+};
+
+void tst_bench_QVideoFramePaint::paint_data()
+{
+    QTest::addColumn<QVideoFrameFormat::PixelFormat>("pixelFormat");
+    QTest::addColumn<QSize>("frameSize");
+    QTest::addColumn<QSize>("targetSize");
+
+    const QVideoFrameFormat::PixelFormat formats[] = {
+        QVideoFrameFormat::Format_YUV420P,
+        QVideoFrameFormat::Format_NV12,
+        QVideoFrameFormat::Format_XRGB8888,
+    };
+    const QSize frameSizes[] = { { 1920, 1080 }, { 3840, 2160 } };
+    const QSize targetSizes[] = { { 640, 360 }, { 1280, 720 } };
+
+    for (auto pixelFormat : formats) {
+        for (QSize frameSize : frameSizes) {
+            for (QSize targetSize : targetSizes) {
+                QTest::addRow("%s, %dx%d to %dx%d",
+                              qPrintable(QVideoFrameFormat::pixelFormatToString(pixelFormat)),
+                              frameSize.width(), frameSize.height(), targetSize.width(),
+                              targetSize.height())
+                        << pixelFormat << frameSize << targetSize;
+            }
+        }
+    }
+}
+
+void tst_bench_QVideoFramePaint::paint_fullResolution()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, frameSize);
+    QFETCH(QSize, targetSize);
+
+    const QVideoFrame frame = makeFrame(pixelFormat, frameSize);
+    QVERIFY(frame.isValid());
+
+    QImage target(targetSize, QImage::Format_RGB32);
+    QPainter painter(&target);
+
+    QBENCHMARK {
+        paintFullResolution(painter, target.rect(), frame);
+    }
+}
+
+void tst_bench_QVideoFramePaint::paint_newFrame()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, frameSize);
+    QFETCH(QSize, targetSize);
+
+    QVideoFrame frame = makeFrame(pixelFormat, frameSize);
+    QVERIFY(frame.isValid());
+
+    QImage target(targetSize, QImage::Format_RGB32);
+    QPainter painter(&target);
+
+    QBENCHMARK {
+        dropCachedImages(frame);
+        frame.paint(&painter, target.rect(), {});
+    }
+}
+
+// Repaints of the same frame, e.g. on expose events or when the player is paused
+void tst_bench_QVideoFramePaint::paint_sameFrame()
+{
+    QFETCH(QVideoFrameFormat::PixelFormat, pixelFormat);
+    QFETCH(QSize, frameSize);
+    QFETCH(QSize, targetSize);
+
+    QVideoFrame frame = makeFrame(pixelFormat, frameSize);
+    QVERIFY(frame.isValid());
+
+    QImage target(targetSize, QImage::Format_RGB32);
+    QPainter painter(&target);
+    frame.paint(&painter, target.rect(), {});
+
+    QBENCHMARK {
+        frame.paint(&painter, target.rect(), {});
+    }
+}
+
+// How subtitles were painted before the layouts were cached
+void tst_bench_QVideoFramePaint::subtitles_newLayout()
+{
+    const QString text = u"The quick brown fox\njumps over the lazy dog"_s;
+    QImage target(QSize(640, 360), QImage::Format_RGB32);
+    QPainter painter(&target);
+
+    QBENCHMARK {
+        QVideoTextureHelper::SubtitleLayout layout;
+        layout.update(target.size(), text);
+        layout.draw(&painter, {});
+    }
+}
+
+void tst_bench_QVideoFramePaint::subtitles_cachedLayout()
+{
+    QVideoFrame frame = makeFrame(QVideoFrameFormat::Format_YUV420P, { 64, 36 });
+    frame.setSubtitleText(u"The quick brown fox\njumps over the lazy dog"_s);
+
+    QImage target(QSize(640, 360), QImage::Format_RGB32);
+    QPainter painter(&target);
+
+    // The frame is tiny and its image is cached, so the subtitles dominate
+    frame.paint(&painter, target.rect(), {});
+
+    QBENCHMARK {
+        frame.paint(&painter, target.rect(), {});
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // Measure the software paint path, as on devices without a GPU
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+    tst_bench_QVideoFramePaint test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_bench_qvideoframepaint.moc"
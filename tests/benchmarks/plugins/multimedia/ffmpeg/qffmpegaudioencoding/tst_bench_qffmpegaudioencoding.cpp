@@ -0,0 +1,166 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtMultimedia/qaudiobufferinput.h>
+#include <QtMultimedia/qmediacapturesession.h>
+#include <QtMultimedia/qmediaformat.h>
+#include <QtMultimedia/qmediarecorder.h>
+#include <QtMultimedia/qwavedecoder.h>
+#include <private/audiogenerationutils_p.h>
+#include <private/qscopedenvironmentvariable_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::chrono::seconds toneDuration = 60s;
+
+// Like a CD rip in an archive
+QAudioFormat toneFormat()
+{
+    QAudioFormat format;
+    format.setSampleFormat(QAudioFormat::Int16);
+    format.setSampleRate(44100);
+    format.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+    return format;
+}
+
+// Reads the PCM data of a WAV file written by QWaveDecoder, in buffers of 100 ms
+class ToneFileReader
+{
+public:
+    explicit ToneFileReader(const QString &fileName) : m_file(fileName)
+    {
+        // QWaveDecoder writes the canonical header
+        if (m_file.open(QIODevice::ReadOnly))
+            m_file.seek(QWaveDecoder::headerLength());
+    }
+
+    QAudioBuffer next()
+    {
+        const QByteArray data = m_file.read(m_format.bytesForDuration(100'000));
+        return data.isEmpty() ? QAudioBuffer{} : QAudioBuffer(data, m_format);
+    }
+
+private:
+    QFile m_file;
+    QAudioFormat m_format = toneFormat();
+};
+
+// Feeds the file to the recorder as fast as it accepts the buffers.
+// Returns false if the recording has failed.
+bool transcode(const QString &inputFileName, const QMediaFormat &mediaFormat,
+               const QString &outputFileName)
+{
+    ToneFileReader reader(inputFileName);
+
+    QAudioBufferInput input(toneFormat());
+    QMediaCaptureSession session;
+    QMediaRecorder recorder;
+    session.setAudioBufferInput(&input);
+    session.setRecorder(&recorder);
+    recorder.setMediaFormat(mediaFormat);
+    recorder.setQuality(QMediaRecorder::HighQuality);
+    recorder.setOutputLocation(QUrl::fromLocalFile(outputFileName));
+    recorder.setAutoStop(true);
+
+    bool endOfStreamSent = false;
+    QObject::connect(&input, &QAudioBufferInput::readyToSendAudioBuffer, &input, [&] {
+        if (endOfStreamSent)
+            return;
+        // An invalid buffer marks the end of the stream
+        const QAudioBuffer buffer = reader.next();
+        endOfStreamSent = !buffer.isValid();
+        input.sendAudioBuffer(buffer);
+    });
+
+    recorder.record();
+
+    const bool stopped = QTest::qWaitFor(
+            [&] { return recorder.recorderState() == QMediaRecorder::StoppedState; }, 120s);
+    return stopped && recorder.error() == QMediaRecorder::NoError;
+}
+
+} // namespace
+
+class tst_bench_QFFmpegAudioEncoding : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void transcode_data();
+    void transcode();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_toneFileName;
+};
+
+// Writes a WAV file with a tone
+void tst_bench_QFFmpegAudioEncoding::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_toneFileName = m_dir.filePath(QStringLiteral("tone.wav"));
+
+    QFile file(m_toneFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QWaveDecoder waveDecoder(&file, toneFormat());
+    QVERIFY(waveDecoder.open(QIODevice::WriteOnly));
+
+    const QByteArray data = createSineWaveData(toneFormat(), toneDuration);
+    QCOMPARE(waveDecoder.write(data), data.size());
+    waveDecoder.close();
+}
+
+void tst_bench_QFFmpegAudioEncoding::transcode_data()
+{
+    QTest::addColumn<QMediaFormat::FileFormat>("fileFormat");
+    QTest::addColumn<QMediaFormat::AudioCodec>("audioCodec");
+    QTest::addColumn<bool>("pipelined");
+
+    const std::tuple<QMediaFormat::FileFormat, QMediaFormat::AudioCodec, const char *> formats[] = {
+        { QMediaFormat::Mpeg4Audio, QMediaFormat::AudioCodec::AAC, "AAC" },
+        { QMediaFormat::Ogg, QMediaFormat::AudioCodec::Opus, "Opus" },
+        { QMediaFormat::FLAC, QMediaFormat::AudioCodec::FLAC, "FLAC" },
+    };
+
+    for (const auto &[fileFormat, audioCodec, name] : formats) {
+        QTest::addRow("%s, single thread", name) << fileFormat << audioCodec << false;
+        QTest::addRow("%s, pipelined", name) << fileFormat << audioCodec << true;
+    }
+}
+
+// Transcodes the minute of the tone file, the way batch conversions through QAudioBufferInput
+// and QMediaRecorder do
+void tst_bench_QFFmpegAudioEncoding::transcode()
+{
+    QFETCH(QMediaFormat::FileFormat, fileFormat);
+    QFETCH(QMediaFormat::AudioCodec, audioCodec);
+    QFETCH(bool, pipelined);
+
+    QMediaFormat mediaFormat(fileFormat);
+    mediaFormat.setAudioCodec(audioCodec);
+    if (!mediaFormat.isSupported(QMediaFormat::Encode))
+        QSKIP("The format is not supported for encoding");
+
+    QScopedEnvironmentVariable pipeline("QT_FFMPEG_AUDIO_ENCODER_PIPELINE", pipelined ? "1" : "0");
+
+    const QString outputFileName = m_dir.filePath(QStringLiteral("transcoded"));
+
+    QBENCHMARK {
+        QVERIFY(::transcode(m_toneFileName, mediaFormat, outputFileName));
+    }
+}
+
+QTEST_MAIN(tst_bench_QFFmpegAudioEncoding)
+
+#include "tst_bench_qffmpegaudioencoding.moc"
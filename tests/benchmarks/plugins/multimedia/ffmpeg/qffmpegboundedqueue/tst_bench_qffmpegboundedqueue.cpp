@@ -0,0 +1,143 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegboundedqueue_p.h>
+
+#include <memory>
+#include <optional>
+#include <queue>
+#include <vector>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+namespace {
+
+using Value = std::shared_ptr<int>;
+
+constexpr int valuesPerProducer = 10000;
+constexpr size_t queueCapacity = 1024;
+
+// The queue the recording engine threads used before BoundedQueue: a std::queue
+// guarded by the consumer's mutex, with a wake-up for every pushed item.
+class MutexQueue
+{
+public:
+    bool push(const Value &value)
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_queue.size() >= queueCapacity)
+            return false;
+        m_queue.push(value);
+        m_condition.wakeAll();
+        return true;
+    }
+
+    std::optional<Value> pop()
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_queue.empty())
+            m_condition.wait(&m_mutex);
+        if (m_queue.empty())
+            return std::nullopt;
+        Value value = std::move(m_queue.front());
+        m_queue.pop();
+        return value;
+    }
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    std::queue<Value> m_queue;
+};
+
+template <typename Queue>
+void runProducersAndConsumer(Queue &queue, int producerCount)
+{
+    const auto value = std::make_shared<int>(0);
+
+    std::vector<std::unique_ptr<QThread>> producers;
+    for (int producer = 0; producer < producerCount; ++producer) {
+        producers.emplace_back(QThread::create([&queue, &value] {
+            for (int i = 0; i < valuesPerProducer; ++i) {
+                while (!queue.push(value))
+                    QThread::yieldCurrentThread();
+            }
+        }));
+        producers.back()->start();
+    }
+
+    for (int received = 0; received < producerCount * valuesPerProducer;) {
+        if (queue.pop())
+            ++received;
+        else
+            QThread::yieldCurrentThread();
+    }
+
+    for (auto &producer : producers)
+        producer->wait();
+}
+
+} // namespace
+
+class tst_bench_QFFmpegBoundedQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void push_singleThread();
+
+    void producersAndConsumer_data();
+    void producersAndConsumer();
+};
+
+void tst_bench_QFFmpegBoundedQueue::push_singleThread()
+{
+    // Producer side cost of handing a frame over to an encoder thread
+    QFFmpeg::BoundedQueue<Value> queue(queueCapacity);
+    const auto value = std::make_shared<int>(0);
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            queue.push(value);
+        while (queue.pop())
+            ;
+    }
+}
+
+void tst_bench_QFFmpegBoundedQueue::producersAndConsumer_data()
+{
+    QTest::addColumn<bool>("lockFree");
+    QTest::addColumn<int>("producerCount");
+
+    // The muxer queue has a producer per encoder
+    for (int producerCount : { 1, 2, 4 }) {
+        QTest::addRow("BoundedQueue, %d producers", producerCount) << true << producerCount;
+        QTest::addRow("mutex queue, %d producers", producerCount) << false << producerCount;
+    }
+}
+
+void tst_bench_QFFmpegBoundedQueue::producersAndConsumer()
+{
+    QFETCH(const bool, lockFree);
+    QFETCH(const int, producerCount);
+
+    QBENCHMARK {
+        if (lockFree) {
+            QFFmpeg::BoundedQueue<Value> queue(queueCapacity);
+            runProducersAndConsumer(queue, producerCount);
+        } else {
+            MutexQueue queue;
+            runProducersAndConsumer(queue, producerCount);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QFFmpegBoundedQueue)
+
+#include "tst_bench_qffmpegboundedqueue.moc"
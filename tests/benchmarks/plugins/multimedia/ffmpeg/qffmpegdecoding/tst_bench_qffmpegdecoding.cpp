@@ -0,0 +1,209 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegcodeccontext_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegdemuxer_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegmediadataholder_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegstreamdecoder_p.h>
+#include <QtMultimedia/qplaybackoptions.h>
+#include <QtMultimediaTestLib/private/capturesessionfixture_p.h>
+
+#include <memory>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace std::chrono_literals;
+using namespace QFFmpeg;
+
+namespace {
+
+using TrackType = QPlatformMediaPlayer::TrackType;
+
+} // namespace
+
+class tst_bench_QFFmpegDecoding : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void demuxAndDecode_data();
+    void demuxAndDecode();
+
+private:
+    // Demuxes the whole file with the playback engine's objects, and decodes the track of the
+    // type, if any. Returns the number of decoded frames, or of demuxed packets if trackType is
+    // NTrackTypes; -1 on failure.
+    int demuxAndDecode(TrackType trackType);
+
+    // keeps the generated file alive
+    std::unique_ptr<CaptureSessionFixture> m_fixture;
+    QUrl m_url;
+
+    // the playback engine objects run on their own thread, like in the player
+    QThread m_thread;
+    std::unique_ptr<QObject> m_threadContext;
+};
+
+// Records 2 seconds of 720p video and stereo audio, generated by the frame generators
+void tst_bench_QFFmpegDecoding::initTestCase()
+{
+    m_fixture = std::make_unique<CaptureSessionFixture>(StreamType::AudioAndVideo);
+
+    m_fixture->m_videoGenerator.setPattern(ImagePattern::ColoredSquares);
+    m_fixture->m_videoGenerator.setSize({ 1280, 720 });
+    m_fixture->m_videoGenerator.setFrameRate(30);
+    m_fixture->m_videoGenerator.setFrameCount(60);
+
+    QAudioFormat audioFormat;
+    audioFormat.setSampleFormat(QAudioFormat::Float);
+    audioFormat.setSampleRate(48000);
+    audioFormat.setChannelConfig(QAudioFormat::ChannelConfigStereo);
+    m_fixture->m_audioGenerator.setFormat(audioFormat);
+    m_fixture->m_audioGenerator.setBufferCount(100);
+    m_fixture->m_audioGenerator.setDuration(2s);
+
+    m_fixture->start(RunMode::Pull, AutoStop::EmitEmpty);
+
+    if (!m_fixture->waitForRecorderStopped(60s)
+        || m_fixture->m_recorder.error() != QMediaRecorder::NoError)
+        QSKIP(qPrintable(QStringLiteral("Cannot generate the test media: ")
+                         + m_fixture->m_recorder.errorString()));
+
+    m_url = m_fixture->m_recorder.actualLocation();
+
+    qRegisterMetaType<QFFmpeg::Packet>();
+    qRegisterMetaType<QFFmpeg::Frame>();
+    qRegisterMetaType<QFFmpeg::TrackPosition>();
+    qRegisterMetaType<QFFmpeg::PlaybackEngineObjectID>();
+
+    m_threadContext = std::make_unique<QObject>();
+    m_threadContext->moveToThread(&m_thread);
+    m_thread.start();
+}
+
+void tst_bench_QFFmpegDecoding::cleanupTestCase()
+{
+    if (m_thread.isRunning()) {
+        m_threadContext.release()->deleteLater();
+        m_thread.quit();
+        m_thread.wait();
+    }
+
+    m_fixture.reset();
+}
+
+int tst_bench_QFFmpegDecoding::demuxAndDecode(TrackType trackType)
+{
+    const QPlaybackOptions options;
+    auto media = MediaDataHolder::create(m_url, nullptr, options, std::make_shared<CancelToken>());
+    if (!media)
+        return -1;
+
+    MediaDataHolder &holder = **media;
+    MediaDataHolder::StreamIndexes streamIndexes = { -1, -1, -1 };
+    std::optional<CodecContext> codecContext;
+
+    if (trackType == QPlatformMediaPlayer::NTrackTypes) {
+        for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i)
+            streamIndexes[i] = holder.currentStreamIndex(TrackType(i));
+    } else {
+        streamIndexes[trackType] = holder.currentStreamIndex(trackType);
+        if (streamIndexes[trackType] < 0)
+            return -1;
+
+        auto maybeCodecContext = CodecContext::create(
+                holder.avContext()->streams[streamIndexes[trackType]], holder.avContext(), options);
+        if (!maybeCodecContext)
+            return -1;
+        codecContext = std::move(maybeCodecContext.value());
+    }
+
+    quint64 objectID = 0;
+    auto demuxer = std::make_unique<Demuxer>(PlaybackEngineObjectID{ ++objectID, 1 },
+                                             holder.avContext(), TrackPosition(0), false,
+                                             LoopOffset{}, streamIndexes, QMediaPlayer::Once);
+    std::unique_ptr<StreamDecoder> decoder;
+
+    std::atomic_int count = 0;
+    QSemaphore finished;
+
+    if (codecContext) {
+        decoder = std::make_unique<StreamDecoder>(PlaybackEngineObjectID{ ++objectID, 1 },
+                                                  *codecContext, TrackPosition(0));
+
+        connect(demuxer.get(), Demuxer::signalByTrackType(trackType), decoder.get(),
+                &StreamDecoder::decode);
+        connect(demuxer.get(), &PlaybackEngineObject::atEnd, decoder.get(),
+                &StreamDecoder::onFinalPacketReceived);
+        connect(decoder.get(), &StreamDecoder::packetProcessed, demuxer.get(),
+                &Demuxer::onPacketProcessed);
+
+        // stands in for the renderer, which hands the frames back once they're shown
+        connect(decoder.get(), &StreamDecoder::requestHandleFrame, decoder.get(),
+                [&, decoder = decoder.get()](Frame frame) {
+                    ++count;
+                    decoder->onFrameProcessed(std::move(frame));
+                });
+        connect(decoder.get(), &PlaybackEngineObject::atEnd, decoder.get(),
+                [&] { finished.release(); });
+    } else {
+        for (int i = 0; i < QPlatformMediaPlayer::NTrackTypes; ++i) {
+            if (streamIndexes[i] < 0)
+                continue;
+            connect(demuxer.get(), Demuxer::signalByTrackType(TrackType(i)), demuxer.get(),
+                    [&, demuxer = demuxer.get()](Packet packet) {
+                        ++count;
+                        demuxer->onPacketProcessed(std::move(packet));
+                    }, Qt::QueuedConnection);
+        }
+        connect(demuxer.get(), &PlaybackEngineObject::atEnd, demuxer.get(),
+                [&] { finished.release(); });
+    }
+
+    demuxer->moveToThread(&m_thread);
+    if (decoder) {
+        decoder->moveToThread(&m_thread);
+        decoder->setPaused(false);
+    }
+    demuxer->setPaused(false);
+
+    finished.acquire();
+
+    // the objects must be destroyed on their thread, and before the media
+    QMetaObject::invokeMethod(m_threadContext.get(), [&] {
+        decoder.reset();
+        demuxer.reset();
+    }, Qt::BlockingQueuedConnection);
+
+    return count;
+}
+
+void tst_bench_QFFmpegDecoding::demuxAndDecode_data()
+{
+    QTest::addColumn<int>("trackType");
+
+    QTest::newRow("demux only") << int(QPlatformMediaPlayer::NTrackTypes);
+    QTest::newRow("decode video") << int(QPlatformMediaPlayer::VideoStream);
+    QTest::newRow("decode audio") << int(QPlatformMediaPlayer::AudioStream);
+}
+
+void tst_bench_QFFmpegDecoding::demuxAndDecode()
+{
+    QFETCH(int, trackType);
+
+    QBENCHMARK {
+        QCOMPARE_GT(demuxAndDecode(TrackType(trackType)), 0);
+    }
+}
+
+QTEST_MAIN(tst_bench_QFFmpegDecoding)
+
+#include "tst_bench_qffmpegdecoding.moc"
@@ -0,0 +1,96 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qfile.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegioutils_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+const QString resourceFileName = u":/multitrack.mkv"_s;
+
+// Reads the whole AVIO context the way demuxers do, in small chunks
+qint64 readAll(AVIOContext *context, int chunkSize = 4096)
+{
+    qint64 result = 0;
+    QByteArray chunk(chunkSize, Qt::Uninitialized);
+    while (true) {
+        const int read = avio_read(context, reinterpret_cast<unsigned char *>(chunk.data()),
+                                   chunkSize);
+        if (read <= 0)
+            break;
+        result += read;
+    }
+    return result;
+}
+
+struct QIODeviceAVIOContext
+{
+    explicit QIODeviceAVIOContext(QIODevice *device)
+    {
+        constexpr int bufferSize = 32768;
+        auto *buffer = static_cast<unsigned char *>(av_malloc(bufferSize));
+        context = avio_alloc_context(buffer, bufferSize, false, device, &QFFmpeg::readQIODevice,
+                                     nullptr, &QFFmpeg::seekQIODevice);
+    }
+
+    ~QIODeviceAVIOContext()
+    {
+        av_freep(&context->buffer);
+        avio_context_free(&context);
+    }
+
+    AVIOContext *context = nullptr;
+};
+
+} // namespace
+
+class tst_bench_QFFmpegIOUtils : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readResource_data();
+    void readResource();
+};
+
+void tst_bench_QFFmpegIOUtils::readResource_data()
+{
+    QTest::addColumn<bool>("memoryMapped");
+
+    QTest::newRow("readQIODevice") << false;
+    QTest::newRow("MappedFileIO") << true;
+}
+
+void tst_bench_QFFmpegIOUtils::readResource()
+{
+    QFETCH(const bool, memoryMapped);
+
+    QFile resource(resourceFileName);
+    QVERIFY(resource.exists());
+    const qint64 size = resource.size();
+
+    QBENCHMARK {
+        QFile file(resourceFileName);
+        if (memoryMapped) {
+            auto io = QFFmpeg::MappedFileIO::create(&file);
+            QVERIFY(io);
+            QCOMPARE_EQ(readAll(io->avioContext()), size);
+        } else {
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QIODeviceAVIOContext io(&file);
+            QCOMPARE_EQ(readAll(io.context), size);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QFFmpegIOUtils)
+
+#include "tst_bench_qffmpegioutils.moc"
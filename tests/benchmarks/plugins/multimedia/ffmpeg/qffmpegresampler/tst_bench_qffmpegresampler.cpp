@@ -0,0 +1,77 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtCore/qbytearray.h>
+#include <QtMultimedia/qaudioformat.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegresampler_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+namespace {
+
+QAudioFormat makeFormat(int sampleRate, int channelCount, QAudioFormat::SampleFormat sampleFormat)
+{
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channelCount);
+    format.setChannelConfig(QAudioFormat::defaultChannelConfigForChannelCount(channelCount));
+    format.setSampleFormat(sampleFormat);
+    return format;
+}
+
+} // namespace
+
+class tst_bench_QFFmpegResampler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void resample_data();
+    void resample();
+};
+
+void tst_bench_QFFmpegResampler::resample_data()
+{
+    QTest::addColumn<QAudioFormat>("inputFormat");
+    QTest::addColumn<QAudioFormat>("outputFormat");
+
+    QTest::newRow("48kHz stereo, int16 to float")
+            << makeFormat(48000, 2, QAudioFormat::Int16)
+            << makeFormat(48000, 2, QAudioFormat::Float);
+    QTest::newRow("48kHz stereo, float to int16")
+            << makeFormat(48000, 2, QAudioFormat::Float)
+            << makeFormat(48000, 2, QAudioFormat::Int16);
+    QTest::newRow("44.1kHz to 48kHz stereo, int16 to float")
+            << makeFormat(44100, 2, QAudioFormat::Int16)
+            << makeFormat(48000, 2, QAudioFormat::Float);
+    QTest::newRow("96kHz to 48kHz stereo, int32 to float")
+            << makeFormat(96000, 2, QAudioFormat::Int32)
+            << makeFormat(48000, 2, QAudioFormat::Float);
+    QTest::newRow("48kHz, 5.1 to stereo, float")
+            << makeFormat(48000, 6, QAudioFormat::Float)
+            << makeFormat(48000, 2, QAudioFormat::Float);
+}
+
+void tst_bench_QFFmpegResampler::resample()
+{
+    QFETCH(QAudioFormat, inputFormat);
+    QFETCH(QAudioFormat, outputFormat);
+
+    auto resampler = QFFmpegResampler::createFromInputFormat(inputFormat, outputFormat);
+    QVERIFY(resampler);
+
+    // 20ms, the size of a typical decoded audio frame; the content doesn't matter
+    const QByteArray input(inputFormat.bytesForDuration(20000), 0x10);
+
+    QBENCHMARK {
+        const QAudioBuffer buffer = resampler->resample(input.constData(), input.size());
+        QVERIFY(buffer.isValid());
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QFFmpegResampler)
+
+#include "tst_bench_qffmpegresampler.moc"
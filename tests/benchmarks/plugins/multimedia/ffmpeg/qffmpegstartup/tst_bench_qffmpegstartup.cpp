@@ -0,0 +1,68 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtMultimedia/qmediaformat.h>
+#include <QtMultimedia/qmediaplayer.h>
+#include <QtMultimedia/private/qplatformmediaintegration_p.h>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+// Measures what an application pays for Qt Multimedia on startup. The first test functions
+// measure the cold path, so they are only meaningful in a fresh process, in the order below.
+class tst_bench_QFFmpegStartup : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_bench_QFFmpegStartup() { qputenv("QT_MEDIA_BACKEND", "ffmpeg"); }
+
+private slots:
+    void firstMediaPlayerConstruction();
+    void firstSupportedFileFormats();
+
+    void mediaPlayerConstruction();
+    void supportedFileFormats();
+};
+
+// Includes loading the plugin and creating the media integration
+void tst_bench_QFFmpegStartup::firstMediaPlayerConstruction()
+{
+    QBENCHMARK_ONCE {
+        QMediaPlayer player;
+    }
+
+    if (QPlatformMediaIntegration::instance()->name() != u"ffmpeg")
+        QSKIP("The FFmpeg media backend is not available");
+}
+
+// Includes creating the format info
+void tst_bench_QFFmpegStartup::firstSupportedFileFormats()
+{
+    QList<QMediaFormat::FileFormat> formats;
+    QBENCHMARK_ONCE {
+        formats = QMediaFormat().supportedFileFormats(QMediaFormat::Decode);
+    }
+
+    QVERIFY(!formats.isEmpty());
+}
+
+void tst_bench_QFFmpegStartup::mediaPlayerConstruction()
+{
+    QBENCHMARK {
+        QMediaPlayer player;
+    }
+}
+
+void tst_bench_QFFmpegStartup::supportedFileFormats()
+{
+    QBENCHMARK {
+        QMediaFormat().supportedFileFormats(QMediaFormat::Decode);
+    }
+}
+
+QTEST_MAIN(tst_bench_QFFmpegStartup)
+
+#include "tst_bench_qffmpegstartup.moc"
@@ -0,0 +1,185 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpeg_p.h>
+#include <QtFFmpegMediaPluginImpl/private/qffmpegvideoframeencoder_p.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+using namespace QFFmpeg;
+
+namespace {
+
+using AVFormatContextUPtr =
+        std::unique_ptr<AVFormatContext,
+                        AVDeleter<decltype(&avformat_free_context), &avformat_free_context>>;
+
+constexpr QSize frameSize(1920, 1080);
+constexpr qreal frameRate = 30.;
+constexpr int frameCount = 60;
+
+// Frames of a moving gradient, like the ones a screen recording sends through QVideoFrameInput
+std::vector<AVFrameUPtr> createFrames()
+{
+    std::vector<AVFrameUPtr> frames;
+    for (int i = 0; i < 8; ++i) {
+        AVFrameUPtr frame = makeAVFrame();
+        frame->format = AV_PIX_FMT_YUV420P;
+        frame->width = frameSize.width();
+        frame->height = frameSize.height();
+        if (av_frame_get_buffer(frame.get(), 0) < 0)
+            return {};
+
+        for (int y = 0; y < frame->height; ++y) {
+            uint8_t *line = frame->data[0] + y * frame->linesize[0];
+            for (int x = 0; x < frame->width; ++x)
+                line[x] = uint8_t(x + y + i * 8);
+        }
+        for (int plane = 1; plane < 3; ++plane)
+            memset(frame->data[plane], 128, frame->linesize[plane] * frame->height / 2);
+
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+struct EncodingResult
+{
+    bool ok = false;
+    // The number of frames sent until the encoder has output the first packet
+    int framesUntilFirstPacket = 0;
+};
+
+EncodingResult encode(const QMediaEncoderSettings &settings,
+                      const std::vector<AVFrameUPtr> &frames)
+{
+    AVFormatContext *contextRaw = nullptr;
+    avformat_alloc_output_context2(&contextRaw, nullptr, "matroska", nullptr);
+    AVFormatContextUPtr context(contextRaw);
+    if (!context)
+        return {};
+
+    VideoFrameEncoder::SourceParams sourceParams;
+    sourceParams.size = frameSize;
+    sourceParams.format = AV_PIX_FMT_YUV420P;
+    sourceParams.swFormat = AV_PIX_FMT_YUV420P;
+    sourceParams.frameRate = frameRate;
+
+    VideoFrameEncoderUPtr encoder = VideoFrameEncoder::create(settings, sourceParams, context.get());
+    if (!encoder)
+        return {};
+
+    EncodingResult result;
+    for (int i = 0; i < frameCount; ++i) {
+        AVFrameUPtr frame(av_frame_clone(frames[i % frames.size()].get()));
+        const qint64 time = qRound64(i * 1'000'000 / frameRate);
+        setAVFrameTime(*frame, encoder->getPts(time), encoder->getTimeBase());
+        if (encoder->sendFrame(std::move(frame)) < 0)
+            return {};
+
+        while (encoder->retrievePacket()) {
+            if (result.framesUntilFirstPacket == 0)
+                result.framesUntilFirstPacket = i + 1;
+        }
+    }
+
+    encoder->sendFrame(nullptr);
+    while (encoder->retrievePacket()) {
+        if (result.framesUntilFirstPacket == 0)
+            result.framesUntilFirstPacket = frameCount;
+    }
+
+    result.ok = result.framesUntilFirstPacket > 0;
+    return result;
+}
+
+} // namespace
+
+class tst_bench_QFFmpegVideoEncoding : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_bench_QFFmpegVideoEncoding()
+    {
+        // Measure the software encoders, whose threading and lookahead can be controlled
+        qputenv("QT_FFMPEG_ENCODING_HW_DEVICE_TYPES", "");
+    }
+
+private slots:
+    void initTestCase();
+
+    void encode_data();
+    void encode();
+
+private:
+    std::vector<AVFrameUPtr> m_frames;
+};
+
+void tst_bench_QFFmpegVideoEncoding::initTestCase()
+{
+    m_frames = createFrames();
+    QVERIFY(!m_frames.empty());
+}
+
+void tst_bench_QFFmpegVideoEncoding::encode_data()
+{
+    QTest::addColumn<QMediaFormat::VideoCodec>("videoCodec");
+    QTest::addColumn<QMediaRecorder::EncoderThreading>("threading");
+    QTest::addColumn<int>("lookahead");
+
+    const std::pair<QMediaFormat::VideoCodec, const char *> codecs[] = {
+        { QMediaFormat::VideoCodec::H264, "H264" },
+        { QMediaFormat::VideoCodec::H265, "H265" },
+        { QMediaFormat::VideoCodec::VP9, "VP9" },
+        { QMediaFormat::VideoCodec::AV1, "AV1" },
+    };
+
+    for (const auto &[codec, name] : codecs) {
+        QTest::addRow("%s, default", name) << codec << QMediaRecorder::AutomaticThreading << -1;
+        QTest::addRow("%s, frame threading", name)
+                << codec << QMediaRecorder::FrameThreading << -1;
+        QTest::addRow("%s, slice threading", name)
+                << codec << QMediaRecorder::SliceThreading << -1;
+        QTest::addRow("%s, zero lookahead", name) << codec << QMediaRecorder::AutomaticThreading << 0;
+    }
+}
+
+// Encodes two seconds of 1080p frames, and reports after how many frames the first
+// packet was output, which is the latency the encoder adds
+void tst_bench_QFFmpegVideoEncoding::encode()
+{
+    QFETCH(QMediaFormat::VideoCodec, videoCodec);
+    QFETCH(QMediaRecorder::EncoderThreading, threading);
+    QFETCH(int, lookahead);
+
+    QMediaFormat mediaFormat(QMediaFormat::Matroska);
+    mediaFormat.setVideoCodec(videoCodec);
+
+    QMediaEncoderSettings settings;
+    settings.setMediaFormat(mediaFormat);
+    settings.setVideoResolution(frameSize);
+    settings.setVideoFrameRate(frameRate);
+    settings.setVideoEncoderThreading(threading);
+    settings.setVideoEncoderLookahead(lookahead);
+
+    EncodingResult result;
+    QBENCHMARK {
+        result = ::encode(settings, m_frames);
+        if (!result.ok)
+            QSKIP("The codec is not available for encoding");
+    }
+
+    qInfo("First packet after %d frames", result.framesUntilFirstPacket);
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QFFmpegVideoEncoding)
+
+#include "tst_bench_qffmpegvideoencoding.moc"
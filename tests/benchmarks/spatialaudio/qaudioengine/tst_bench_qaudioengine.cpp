@@ -0,0 +1,280 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/qtest.h>
+
+#include <QtCore/qmath.h>
+#include <QtCore/qrandom.h>
+#include <QtMultimedia/qaudiobuffer.h>
+#include <QtSpatialAudio/qaudioengine.h>
+#include <QtSpatialAudio/qaudiolistener.h>
+#include <QtSpatialAudio/qaudioroom.h>
+#include <QtSpatialAudio/qspatialsound.h>
+#include <QtSpatialAudio/private/qaudioengine_p.h>
+#include <QtSpatialAudio/private/qaudioroomindex_p.h>
+#include <QtSpatialAudio/private/qspatialsound_p.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// NOLINTBEGIN(readability-convert-member-functions-to-static)
+
+QT_USE_NAMESPACE
+
+namespace {
+
+using RenderingQuality = QAudioEngine::RenderingQuality;
+
+// One second of a looped sine, instead of decoding a file
+void setSine(QSpatialSound &sound, int sampleRate, float frequency)
+{
+    QAudioFormat format;
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(1);
+    format.setSampleFormat(QAudioFormat::Float);
+
+    QAudioBuffer buffer(sampleRate, format);
+    float *data = buffer.data<float>();
+    for (int i = 0; i < sampleRate; ++i)
+        data[i] = 0.5f * std::sin(2.f * float(M_PI) * frequency * i / sampleRate);
+
+    QSpatialSoundPrivate *d = QSpatialSoundPrivate::get(&sound);
+    d->buffers = { buffer };
+    d->m_loops = QSpatialSound::Infinite;
+    d->play();
+}
+
+// Rooms of 4 x 3 x 4 meters on a square floor plan
+int floorPlanColumns(int roomCount)
+{
+    return qCeil(std::sqrt(float(roomCount)));
+}
+
+QVector3D roomCenter(int room, int columns)
+{
+    return QVector3D(4.f * (room % columns), 1.5f, 4.f * (room / columns));
+}
+
+QList<QAudioRoomGeometry> floorPlan(int roomCount)
+{
+    const int columns = floorPlanColumns(roomCount);
+    QList<QAudioRoomGeometry> rooms;
+    for (int i = 0; i < roomCount; ++i) {
+        QAudioRoomGeometry room;
+        room.position = roomCenter(i, columns);
+        room.dimensions = QVector3D(4.f, 3.f, 4.f);
+        rooms.append(room);
+    }
+    return rooms;
+}
+
+// How the engine looked up the room of the listener before rooms were indexed
+int linearRoomAt(const QList<QAudioRoomGeometry> &rooms, QVector3D pos)
+{
+    int result = -1;
+    float resultVolume = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < rooms.size(); ++i) {
+        if (rooms[i].volume() <= resultVolume && rooms[i].contains(pos)) {
+            result = i;
+            resultVolume = rooms[i].volume();
+        }
+    }
+    return result;
+}
+
+QList<QVector3D> randomPositions(int count, float extent)
+{
+    QRandomGenerator random(42);
+    QList<QVector3D> positions;
+    for (int i = 0; i < count; ++i) {
+        positions.append(QVector3D(float(random.bounded(double(extent))) - 2.f, 1.5f,
+                                   float(random.bounded(double(extent))) - 2.f));
+    }
+    return positions;
+}
+
+} // namespace
+
+class tst_bench_QAudioEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void renderBuffer_data();
+    void renderBuffer();
+
+    void roomLookup_data();
+    void roomLookup_linearScan_data() { roomLookup_data(); }
+    void roomLookup_linearScan();
+    void roomLookup_index_data() { roomLookup_data(); }
+    void roomLookup_index();
+
+    void updateRooms_data();
+    void updateRooms();
+};
+
+void tst_bench_QAudioEngine::renderBuffer_data()
+{
+    QTest::addColumn<RenderingQuality>("quality");
+    QTest::addColumn<int>("soundCount");
+
+    const std::pair<RenderingQuality, const char *> qualities[] = {
+        { RenderingQuality::High, "high" },
+        { RenderingQuality::Medium, "medium" },
+        { RenderingQuality::Low, "low" },
+        { RenderingQuality::StereoPanning, "stereo panning" },
+        { RenderingQuality::Automatic, "automatic" },
+    };
+
+    for (const auto &[quality, name] : qualities) {
+        for (int soundCount : { 1, 16, 64, 256 })
+            QTest::addRow("%s, %d sounds", name, soundCount) << quality << soundCount;
+    }
+}
+
+// Renders one buffer of the engine in headphone mode, as the audio thread does, but without
+// an audio device. The sounds are spread over a square of 100 x 100 meters around the listener.
+void tst_bench_QAudioEngine::renderBuffer()
+{
+    QFETCH(RenderingQuality, quality);
+    QFETCH(int, soundCount);
+
+    QAudioEngine engine;
+    engine.setDistanceScale(QAudioEngine::DistanceScaleMeter);
+    engine.setRenderingQuality(quality);
+
+    QAudioListener listener(&engine);
+    listener.setPosition({});
+
+    QRandomGenerator random(42);
+    std::vector<std::unique_ptr<QSpatialSound>> sounds;
+    for (int i = 0; i < soundCount; ++i) {
+        auto sound = std::make_unique<QSpatialSound>(&engine);
+        sound->setPosition(QVector3D(float(random.bounded(100.)) - 50.f, 0.f,
+                                     float(random.bounded(100.)) - 50.f));
+        setSine(*sound, engine.sampleRate(), 220.f + 10.f * i);
+        sounds.push_back(std::move(sound));
+    }
+
+    QAudioEnginePrivate *d = QAudioEnginePrivate::get(&engine);
+    short output[2 * QAudioEnginePrivate::bufferSize];
+
+    QMutexLocker locker(&d->mutex);
+    d->updateSourceRendering(/*ambisonicOutput=*/false);
+
+    // Let the cross-fades of the initial rendering changes finish
+    for (int i = 0; i < 16; ++i)
+        QVERIFY(d->renderBuffer(output, 2, nullptr));
+
+    QBENCHMARK {
+        d->renderBuffer(output, 2, nullptr);
+    }
+}
+
+void tst_bench_QAudioEngine::roomLookup_data()
+{
+    QTest::addColumn<int>("roomCount");
+
+    for (int roomCount : { 16, 256, 1024, 4096 })
+        QTest::addRow("%d rooms", roomCount) << roomCount;
+}
+
+// Finds the rooms of 1000 positions spread over the floor plan
+void tst_bench_QAudioEngine::roomLookup_linearScan()
+{
+    QFETCH(int, roomCount);
+
+    const QList<QAudioRoomGeometry> rooms = floorPlan(roomCount);
+    const QList<QVector3D> positions =
+            randomPositions(1000, 4.f * floorPlanColumns(roomCount));
+
+    int found = 0;
+    QBENCHMARK {
+        for (QVector3D pos : positions)
+            found += linearRoomAt(rooms, pos) >= 0;
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_bench_QAudioEngine::roomLookup_index()
+{
+    QFETCH(int, roomCount);
+
+    QAudioRoomIndex index;
+    index.build(floorPlan(roomCount));
+    const QList<QVector3D> positions =
+            randomPositions(1000, 4.f * floorPlanColumns(roomCount));
+
+    int found = 0;
+    QBENCHMARK {
+        for (QVector3D pos : positions)
+            found += index.roomAt(pos) >= 0;
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_bench_QAudioEngine::updateRooms_data()
+{
+    QTest::addColumn<int>("roomCount");
+    QTest::addColumn<int>("soundCount");
+
+    for (int roomCount : { 16, 256, 1024 }) {
+        for (int soundCount : { 16, 256 })
+            QTest::addRow("%d rooms, %d sounds", roomCount, soundCount) << roomCount << soundCount;
+    }
+}
+
+// The update of the audio thread while the listener walks through a building with doors
+// between the rooms, and a quarter of the sounds move
+void tst_bench_QAudioEngine::updateRooms()
+{
+    QFETCH(int, roomCount);
+    QFETCH(int, soundCount);
+
+    QAudioEngine engine;
+    engine.setDistanceScale(QAudioEngine::DistanceScaleMeter);
+
+    const int columns = floorPlanColumns(roomCount);
+    std::vector<std::unique_ptr<QAudioRoom>> rooms;
+    for (int i = 0; i < roomCount; ++i) {
+        auto room = std::make_unique<QAudioRoom>(&engine);
+        room->setPosition(roomCenter(i, columns));
+        room->setDimensions(QVector3D(4.f, 3.f, 4.f));
+        for (auto wall : { QAudioRoom::RightWall, QAudioRoom::BackWall })
+            room->setWallOpening(wall, 0.2f);
+        rooms.push_back(std::move(room));
+    }
+
+    QAudioListener listener(&engine);
+    listener.setPosition(roomCenter(0, columns));
+
+    std::vector<std::unique_ptr<QSpatialSound>> sounds;
+    for (QVector3D pos : randomPositions(soundCount, 4.f * columns)) {
+        auto sound = std::make_unique<QSpatialSound>(&engine);
+        sound->setPosition(pos);
+        sounds.push_back(std::move(sound));
+    }
+
+    QAudioEnginePrivate *d = QAudioEnginePrivate::get(&engine);
+    auto updateRooms = [d] {
+        QMutexLocker locker(&d->mutex);
+        d->updateRooms();
+    };
+    updateRooms();
+    QVERIFY(d->currentRoom);
+
+    int step = 0;
+    QBENCHMARK {
+        ++step;
+        listener.setPosition(roomCenter(step % roomCount, columns));
+        for (size_t i = step % 4; i < sounds.size(); i += 4)
+            sounds[i]->setPosition(sounds[i]->position() + QVector3D(0.1f, 0.f, 0.f));
+        updateRooms();
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QAudioEngine)
+
+#include "tst_bench_qaudioengine.moc"